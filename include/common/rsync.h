@@ -15,7 +15,9 @@ void stopRsync();
 void startRsync();
 int  uploadRsync(char* id, char* path);
 int  downloadRsync(char* id, char* path);
+int  downloadRsyncFile(char* id, char* name, char* dst);
 int  deleteRsync(char* id);
+int  deleteRsyncFiles(char* id, SArray* names);
 
 #ifdef __cplusplus
 }
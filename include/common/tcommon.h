@@ -242,6 +242,14 @@ typedef struct SColumnInfoData {
   bool        reassigned; // if current column data is reassigned.
 } SColumnInfoData;
 
+// equal condition on a normal column, the constant operand is normalized to int64 for integer types
+typedef struct SColumnEqCond {
+  int16_t colId;
+  int8_t  type;
+  int64_t val;
+  char*   pData;  // var data type operand, in varstr format
+} SColumnEqCond;
+
 typedef struct SQueryTableDataCond {
   uint64_t     suid;
   int32_t      order;  // desc|asc order to iterate the data block
@@ -254,6 +262,7 @@ typedef struct SQueryTableDataCond {
   int64_t      startVersion;
   int64_t      endVersion;
   bool         notLoadData;    // response the actual data, not only the rows in the attribute of info.row of ssdatablock
+  SArray*      pEqCondList;    // SColumnEqCond, used to skip the data blocks by the block bloom filter
 } SQueryTableDataCond;
 
 int32_t tEncodeDataBlock(void** buf, const SSDataBlock* pBlock);
@@ -368,6 +377,13 @@ typedef struct SNonSortExecInfo {
   int32_t blkNums;
 } SNonSortExecInfo;
 
+typedef struct SExchangeExecInfo {
+  int32_t numOfSources;
+  int32_t slowestVgId;     // source with the largest accumulated fetch latency
+  int64_t slowestWait;     // accumulated fetch latency of the slowest source, in us
+  int64_t waitTime;        // time the operator is blocked on waiting for fetch rsp, in us
+} SExchangeExecInfo;
+
 
 typedef struct STUidTagInfo {
   char*    name;
@@ -125,6 +125,8 @@ extern char *   tsSvrCrashReportUri;
 extern int32_t tsQueryBufferSize;  // maximum allowed usage buffer size in MB for each data node during query processing
 extern int64_t tsQueryBufferSizeBytes;    // maximum allowed usage buffer size in byte for each data node
 extern int32_t tsCacheLazyLoadThreshold;  // cost threshold for last/last_row loading cache as much as possible
+extern int32_t tsWinResCacheSize;         // per-vnode interval aggregate state cache size in MB, 0 to disable it
+extern int32_t tsExchangeMaxPendingRspSize;  // not consumed fetch rsp size in MB that holds back new fetch of exchange
 
 // query client
 extern int32_t tsQueryPolicy;
@@ -179,6 +181,7 @@ extern int64_t  tsMinDiskFreeSize;
 extern bool tsStartUdfd;
 extern char tsUdfdResFuncs[];
 extern char tsUdfdLdLibPath[];
+extern int32_t tsUdfShmSize;
 
 // schemaless
 extern char tsSmlChildTableName[];
@@ -200,6 +203,7 @@ extern int32_t tsCompactPullupInterval;
 extern int32_t tsMqRebalanceInterval;
 extern int32_t tsStreamCheckpointInterval;
 extern float   tsSinkDataRate;
+extern int32_t tsStreamExecLatency;
 extern int32_t tsStreamNodeCheckInterval;
 extern int32_t tsTtlUnit;
 extern int32_t tsTtlPushIntervalSec;
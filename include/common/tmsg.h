@@ -580,6 +580,7 @@ void    tFreeSSubmitRsp(SSubmitRsp* pRsp);
 
 #define COL_SMA_ON     ((int8_t)0x1)
 #define COL_IDX_ON     ((int8_t)0x2)
+#define COL_BLOOM_ON   ((int8_t)0x4)
 #define COL_SET_NULL   ((int8_t)0x10)
 #define COL_SET_VAL    ((int8_t)0x20)
 #define COL_IS_SYSINFO ((int8_t)0x40)
@@ -589,6 +590,7 @@ void    tFreeSSubmitRsp(SSubmitRsp* pRsp);
 
 #define IS_BSMA_ON(s)  (((s)->flags & 0x01) == COL_SMA_ON)
 #define IS_IDX_ON(s)   (((s)->flags & 0x02) == COL_IDX_ON)
+#define IS_BLOOM_ON(s) (((s)->flags & 0x04) == COL_BLOOM_ON)
 #define IS_SET_NULL(s) (((s)->flags & COL_SET_NULL) == COL_SET_NULL)
 
 #define SSCHMEA_SET_IDX_ON(s) \
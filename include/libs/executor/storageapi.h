@@ -120,6 +120,7 @@ typedef struct SRowBuffPos {
   bool  beUsed;
   bool  needFree;
   bool  beUpdated;
+  bool  beReferenced;  // reference bit of the clock eviction
 } SRowBuffPos;
 
 // tq
@@ -234,6 +235,13 @@ typedef struct SStoreSnapshotFn {
   int32_t (*getTableInfoFromSnapshot)(SSnapContext* ctx, void** pBuf, int32_t* contLen, int16_t* type, int64_t* uid);
 } SStoreSnapshotFn;
 
+// partial aggregate state of one interval window, cached by vnode
+typedef struct SWinResCacheItem {
+  STimeWindow win;
+  int32_t     len;
+  void*       pData;
+} SWinResCacheItem;
+
 typedef struct SStoreMeta {
   SMTbCursor* (*openTableMetaCursor)(void* pVnode);                     // metaOpenTbCursor
   void (*closeTableMetaCursor)(SMTbCursor* pTbCur);                     // metaCloseTbCursor
@@ -260,6 +268,12 @@ typedef struct SStoreMeta {
   int32_t (*putCachedTableList)(void* pVnode, uint64_t suid, const void* pKey, int32_t keyLen, void* pPayload,
                                 int32_t payloadLen, double selectivityRatio);
 
+  // the list of SWinResCacheItem returned by getCachedWinRes and passed to putCachedWinRes is owned by the receiver
+  int32_t (*getCachedWinRes)(void* pVnode, uint64_t suid, const uint8_t* pKey, int32_t keyLen, STimeWindow* pRange,
+                             SArray** pList, int64_t* pSeq);
+  int32_t (*putCachedWinRes)(void* pVnode, uint64_t suid, const uint8_t* pKey, int32_t keyLen, const SInterval* pInterval,
+                             const STimeWindow* pRange, SArray* pList, int64_t seq);
+
   void* (*storeGetIndexInfo)();
   void* (*getInvertIndex)(void* pVnode);
   // support filter and non-filter cases. [vnodeGetCtbIdList & vnodeGetCtbIdListByFilter]
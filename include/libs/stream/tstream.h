@@ -374,22 +374,52 @@ typedef struct SSinkRecorder {
   int64_t dataSize;
 } SSinkRecorder;
 
+#define STREAM_EXEC_HISTO_SLOTS 16
+
+typedef enum {
+  STREAM_EXEC_HISTO_BATCH_SIZE = 0,  // number of input blocks in one batch
+  STREAM_EXEC_HISTO_EXEC_TIME,       // execution time of one batch, in ms
+  STREAM_EXEC_HISTO_QUEUE_TIME,      // time the first block of one batch waited in inputQ, in ms
+  STREAM_EXEC_HISTO_MAX,
+} EStreamExecHisto;
+
+// log2 histogram, slot i counts the values in [2^(i-1), 2^i), the last slot counts all the larger ones
+typedef struct SStreamExecHisto {
+  int64_t count;
+  double  sum;
+  int64_t slots[STREAM_EXEC_HISTO_SLOTS];
+} SStreamExecHisto;
+
+typedef struct SStreamExecSummary {
+  double avg;
+  double p99;
+} SStreamExecSummary;
+
+typedef struct STaskBatchInfo {
+  int32_t          maxBlocks;   // adaptive limit of the number of input blocks merged into one batch
+  double           blockCost;   // moving average of the execution time of one input block, in ms
+  int64_t          firstTs;     // enqueue time of the first block of current batch, in us
+  SStreamExecHisto histo[STREAM_EXEC_HISTO_MAX];
+  SStreamExecHisto reported[STREAM_EXEC_HISTO_MAX];  // snapshot at the last hb, only accessed by the hb timer
+} STaskBatchInfo;
+
 typedef struct STaskExecStatisInfo {
-  int64_t       created;
-  int64_t       init;
-  int64_t       start;
-  int64_t       step1Start;
-  double        step1El;
-  int64_t       step2Start;
-  double        step2El;
-  int32_t       updateCount;
-  int64_t       latestUpdateTs;
-  int32_t       processDataBlocks;
-  int64_t       processDataSize;
-  int32_t       dispatch;
-  int64_t       dispatchDataSize;
-  int32_t       checkpoint;
-  SSinkRecorder sink;
+  int64_t        created;
+  int64_t        init;
+  int64_t        start;
+  int64_t        step1Start;
+  double         step1El;
+  int64_t        step2Start;
+  double         step2El;
+  int32_t        updateCount;
+  int64_t        latestUpdateTs;
+  int32_t        processDataBlocks;
+  int64_t        processDataSize;
+  int32_t        dispatch;
+  int64_t        dispatchDataSize;
+  int32_t        checkpoint;
+  SSinkRecorder  sink;
+  STaskBatchInfo batch;
 } STaskExecStatisInfo;
 
 typedef struct SHistoryTaskInfo {
@@ -680,6 +710,8 @@ typedef struct STaskStatusEntry {
   double  inputRate;
   double  sinkQuota;     // existed quota size for sink task
   double  sinkDataSize;  // sink to dst data size
+  int32_t maxBatchBlocks;  // current limit of input blocks in one batch
+  SStreamExecSummary execStat[STREAM_EXEC_HISTO_MAX];  // batch statistics since the last hb, see EStreamExecHisto
 } STaskStatusEntry;
 
 typedef struct SStreamHbMsg {
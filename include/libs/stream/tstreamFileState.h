@@ -49,6 +49,8 @@ void              streamFileStateClear(SStreamFileState* pFileState);
 bool              needClearDiskBuff(SStreamFileState* pFileState);
 void              streamFileStateReleaseBuff(SStreamFileState* pFileState, SRowBuffPos* pPos, bool used);
 int32_t           streamFileStateClearBuff(SStreamFileState* pFileState, SRowBuffPos* pPos);
+void              streamFileStateWaitSpill(SStreamFileState* pFileState);
+void              streamFileStateGetHitRatio(SStreamFileState* pFileState, double* pMemRatio, double* pDiskRatio);
 
 int32_t getRowBuff(SStreamFileState* pFileState, void* pKey, int32_t keyLen, void** pVal, int32_t* pVLen);
 int32_t deleteRowBuff(SStreamFileState* pFileState, const void* pKey, int32_t keyLen);
@@ -69,6 +71,8 @@ void* getRowStateBuff(SStreamFileState* pFileState);
 void* getStateFileStore(SStreamFileState* pFileState);
 bool isDeteled(SStreamFileState* pFileState, TSKEY ts);
 bool isFlushedState(SStreamFileState* pFileState, TSKEY ts, TSKEY gap);
+void putSessionDiskRange(SStreamFileState* pFileState, const SSessionKey* pKey);
+bool mayHaveSessionOnDisk(SStreamFileState* pFileState, uint64_t groupId, TSKEY skey, TSKEY ekey);
 SRowBuffPos* getNewRowPosForWrite(SStreamFileState* pFileState);
 int32_t getRowStateRowSize(SStreamFileState* pFileState);
 
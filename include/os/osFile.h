@@ -117,6 +117,11 @@ int32_t taosCompressFile(char *srcFileName, char *destFileName);
 
 int32_t taosSetFileHandlesLimit();
 
+// map the POSIX shared memory object of the name, which is created with the size if create is true
+void   *taosShmMap(const char *name, int64_t size, bool create);
+int32_t taosShmUnmap(void *ptr, int64_t size);
+int32_t taosShmUnlink(const char *name);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,10 +51,14 @@ extern "C" {
 
 // compression algorithm save first byte higher 7 bit
 #define ALGO_SZ_LOSSY 1  // SZ compress
+#define ALGO_ALP      2  // decimal floating values encoded as integers with a shared exponent
 
 #define HEAD_MODE(x) x % 2
 #define HEAD_ALGO(x) x / 2
 
+// only write the encodings that older releases can read: no bit-packed integers, ALP floats or dictionary columns
+extern bool tsLegacyCmprFormat;
+
 #ifdef TD_TSZ
 extern bool lossyFloat;
 extern bool lossyDouble;
@@ -136,6 +140,15 @@ int32_t tsDecompressBigint(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int
 // for internal usage
 int32_t getWordLength(char type);
 
+int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type);
+int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type);
+int32_t tsCompressDoubleImp(const char *const input, const int32_t nelements, char *const output);
+int32_t tsDecompressDoubleImp(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressDoubleXorImp(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressFloatImp(const char *const input, const int32_t nelements, char *const output);
+int32_t tsDecompressFloatImp(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressFloatXorImp(const char *const input, const int32_t nelements, char *const output);
+
 int32_t tsDecompressIntImpl_Hw(const char *const input, const int32_t nelements, char *const output, const char type);
 int32_t tsDecompressFloatImplAvx512(const char *const input, const int32_t nelements, char *const output);
 int32_t tsDecompressFloatImplAvx2(const char *const input, const int32_t nelements, char *const output);
@@ -162,7 +162,7 @@ int uploadRsync(char* id, char* path){
 #else
   if(path[strlen(path) - 1] != '/'){
 #endif
-    snprintf(command, PATH_MAX, "rsync -av --delete --timeout=10 --bwlimit=100000 %s/ rsync://%s/checkpoint/%s/",
+    snprintf(command, PATH_MAX, "rsync -av --timeout=10 --bwlimit=100000 %s/ rsync://%s/checkpoint/%s/",
 #ifdef WINDOWS
              pathTransform
 #else
@@ -170,7 +170,7 @@ int uploadRsync(char* id, char* path){
 #endif
              , tsSnodeAddress, id);
   }else{
-    snprintf(command, PATH_MAX, "rsync -av --delete --timeout=10 --bwlimit=100000 %s rsync://%s/checkpoint/%s/",
+    snprintf(command, PATH_MAX, "rsync -av --timeout=10 --bwlimit=100000 %s rsync://%s/checkpoint/%s/",
 #ifdef WINDOWS
              pathTransform
 #else
@@ -212,6 +212,31 @@ int downloadRsync(char* id, char* path){
   return 0;
 }
 
+// download the single file name in the remote dir of id to dst
+int downloadRsyncFile(char* id, char* name, char* dst){
+#ifdef WINDOWS
+  char pathTransform[PATH_MAX] = {0};
+  changeDirFromWindowsToLinux(dst, pathTransform);
+#endif
+  char command[PATH_MAX] = {0};
+  snprintf(command, PATH_MAX, "rsync -av --timeout=10 --bwlimit=100000 rsync://%s/checkpoint/%s/%s %s",
+           tsSnodeAddress, id, name,
+#ifdef WINDOWS
+           pathTransform
+#else
+           dst
+#endif
+           );
+
+  int code = execCommand(command);
+  if(code != 0){
+    uError("[rsync] get file failed code:%d," ERRNO_ERR_FORMAT, code, ERRNO_ERR_DATA);
+    return -1;
+  }
+  uDebug("[rsync] down file:%s of data:%s successful", name, id);
+  return 0;
+}
+
 int deleteRsync(char* id){
   char* tmp = "./tmp_empty/";
   int code = taosMkDir(tmp);
@@ -231,5 +256,54 @@ int deleteRsync(char* id){
   }
   uDebug("[rsync] delete data:%s successful", id);
 
+  return 0;
+}
+
+// delete the given files in the remote dir of id, by syncing an empty dir with only these files included
+int deleteRsyncFiles(char* id, SArray* names){
+  if (taosArrayGetSize(names) == 0) return 0;
+
+  char tmp[PATH_MAX] = {0};
+  snprintf(tmp, PATH_MAX, "./tmp_empty_%s/", id);
+  int code = taosMkDir(tmp);
+  if(code != 0){
+    uError("[rsync] make tmp dir failed. code:%d," ERRNO_ERR_FORMAT, code, ERRNO_ERR_DATA);
+    return -1;
+  }
+
+  char filter[PATH_MAX] = {0};
+  snprintf(filter, PATH_MAX, "./rsync_filter_%s", id);
+  TdFilePtr pFile = taosOpenFile(filter, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+  if (pFile == NULL) {
+    uError("[rsync] open filter file error, file:%s," ERRNO_ERR_FORMAT, filter, ERRNO_ERR_DATA);
+    taosRemoveDir(tmp);
+    return -1;
+  }
+  for (int i = 0; i < taosArrayGetSize(names); i++) {
+    char* name = taosArrayGetP(names, i);
+    if (taosWriteFile(pFile, name, strlen(name)) <= 0 || taosWriteFile(pFile, "\n", 1) <= 0) {
+      uError("[rsync] write filter file error, file:%s," ERRNO_ERR_FORMAT, filter, ERRNO_ERR_DATA);
+      taosCloseFile(&pFile);
+      taosRemoveFile(filter);
+      taosRemoveDir(tmp);
+      return -1;
+    }
+  }
+  taosCloseFile(&pFile);
+
+  char command[PATH_MAX] = {0};
+  snprintf(command, PATH_MAX,
+           "rsync -r --delete --timeout=10 --include-from=%s \"--exclude=*\" %s rsync://%s/checkpoint/%s/", filter,
+           tmp, tsSnodeAddress, id);
+
+  code = execCommand(command);
+  taosRemoveFile(filter);
+  taosRemoveDir(tmp);
+  if(code != 0){
+    uError("[rsync] delete files failed code:%d," ERRNO_ERR_FORMAT, code, ERRNO_ERR_DATA);
+    return -1;
+  }
+  uDebug("[rsync] delete %d files of data:%s successful", (int)taosArrayGetSize(names), id);
+
   return 0;
 }
\ No newline at end of file
@@ -479,6 +479,112 @@ int32_t colDataAssign(SColumnInfoData* pColumnInfoData, const SColumnInfoData* p
   return 0;
 }
 
+static FORCE_INLINE bool colDataHasValueInColData(const SColData* pColData, int32_t iVal) {
+  switch (pColData->flag) {
+    case HAS_VALUE:
+      return true;
+    case (HAS_VALUE | HAS_NONE):
+    case (HAS_VALUE | HAS_NULL):
+      return GET_BIT1(pColData->pBitMap, iVal) == 1;
+    case (HAS_VALUE | HAS_NULL | HAS_NONE):
+      return GET_BIT2(pColData->pBitMap, iVal) == 2;
+    default:
+      return false;
+  }
+}
+
+static void colDataAssignNullFromBit1Map(SColumnInfoData* pColumnInfoData, const uint8_t* pBitMap, int32_t numOfRows) {
+  // the bitmap of SColData is lsb first and marks values, while the null bitmap is msb first and marks nulls
+  int32_t len = BitmapLen(numOfRows);
+  for (int32_t i = 0; i < len; ++i) {
+    uint8_t v = pBitMap[i];
+    uint8_t bm = 0;
+    if (v != UINT8_MAX) {
+      for (int32_t j = 0; j < 8; ++j) {
+        if (((v >> j) & ONE) == 0) {
+          bm |= (1u << (7u - j));
+        }
+      }
+    }
+    pColumnInfoData->nullbitmap[i] = bm;
+  }
+
+  if (BitPos(numOfRows) != 0) {
+    pColumnInfoData->nullbitmap[len - 1] &= (uint8_t)(UINT8_MAX << (8u - BitPos(numOfRows)));
+  }
+}
+
+/*
+ * Convert numOfRows values of a SColData starting from startRow into the rows [0, numOfRows) of the column in a batch,
+ * instead of going through SColVal and colDataSetVal for each cell. Both NONE and NULL values are set as NULL.
+ */
+int32_t colDataAssignFromColData(SColumnInfoData* pColumnInfoData, const SColData* pColData, int32_t startRow,
+                                 int32_t numOfRows) {
+  int32_t type = pColumnInfoData->info.type;
+  if (type != pColData->type || type == TSDB_DATA_TYPE_JSON || startRow < 0 ||
+      (int64_t)startRow + numOfRows > pColData->nVal) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  if (numOfRows <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (0 == (pColData->flag & HAS_VALUE)) {
+    colDataSetNNULL(pColumnInfoData, 0, numOfRows);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (IS_VAR_DATA_TYPE(type)) {
+    SVarColAttr* pAttr = &pColumnInfoData->varmeta;
+    int32_t      code = colDataReserve(pColumnInfoData, pAttr->length + pColData->nData + VARSTR_HEADER_SIZE * numOfRows);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      int32_t iVal = startRow + i;
+      if (!colDataHasValueInColData(pColData, iVal)) {
+        colDataSetNull_var(pColumnInfoData, i);
+        pColumnInfoData->hasNull = true;
+        continue;
+      }
+
+      int32_t nData =
+          ((iVal + 1 < pColData->nVal) ? pColData->aOffset[iVal + 1] : pColData->nData) - pColData->aOffset[iVal];
+      char* p = pColumnInfoData->pData + pAttr->length;
+      varDataSetLen(p, nData);
+      memcpy(varDataVal(p), pColData->pData + pColData->aOffset[iVal], nData);
+      pAttr->offset[i] = pAttr->length;
+      pAttr->length += varDataTLen(p);
+    }
+
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // fixed length values keep a slot for each row in SColData, including NONE and NULL ones
+  int32_t bytes = pColumnInfoData->info.bytes;
+  memcpy(pColumnInfoData->pData, pColData->pData + (size_t)bytes * startRow, (size_t)bytes * numOfRows);
+
+  if (pColData->flag == HAS_VALUE) {
+    memset(pColumnInfoData->nullbitmap, 0, BitmapLen(numOfRows));
+  } else if (startRow == 0 && (pColData->flag == (HAS_VALUE | HAS_NONE) || pColData->flag == (HAS_VALUE | HAS_NULL))) {
+    colDataAssignNullFromBit1Map(pColumnInfoData, pColData->pBitMap, numOfRows);
+    pColumnInfoData->hasNull = true;
+  } else {
+    // the source bitmap is not byte aligned with the destination, check the rows one by one
+    memset(pColumnInfoData->nullbitmap, 0, BitmapLen(numOfRows));
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      if (!colDataHasValueInColData(pColData, startRow + i)) {
+        colDataSetNull_f(pColumnInfoData->nullbitmap, i);
+      }
+    }
+    pColumnInfoData->hasNull = true;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 size_t blockDataGetNumOfCols(const SSDataBlock* pBlock) { return taosArrayGetSize(pBlock->pDataBlock); }
 
 size_t blockDataGetNumOfRows(const SSDataBlock* pBlock) { return pBlock->info.rows; }
@@ -3185,6 +3185,537 @@ int32_t tGetColData(uint8_t *pBuf, SColData *pColData) {
     if ((MIN) > (VAL)) (MIN) = (VAL);        \
   } while (0)
 
+#if __AVX2__
+// A column with values and only one kind of null marks each row by one bit of the bitmap, so a byte of the bitmap is
+// the lane mask of 8 rows. Columns with both NONE and NULL rows use 2-bit bitmaps and go through the scalar loops.
+static FORCE_INLINE bool tColDataCanCalcSMAVec(SColData *pColData) {
+  if (!tsSIMDEnable || !tsAVX2Enable) {
+    return false;
+  }
+
+  return pColData->flag == HAS_VALUE || pColData->flag == (HAS_VALUE | HAS_NULL) ||
+         pColData->flag == (HAS_VALUE | HAS_NONE);
+}
+
+static FORCE_INLINE int64_t tColDataGetNarrowVal(const void *pData, int32_t iVal, int8_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return ((const int8_t *)pData)[iVal];
+    case TSDB_DATA_TYPE_SMALLINT:
+      return ((const int16_t *)pData)[iVal];
+    case TSDB_DATA_TYPE_INT:
+      return ((const int32_t *)pData)[iVal];
+    case TSDB_DATA_TYPE_UTINYINT:
+      return ((const uint8_t *)pData)[iVal];
+    case TSDB_DATA_TYPE_USMALLINT:
+      return ((const uint16_t *)pData)[iVal];
+    default:
+      return ((const uint32_t *)pData)[iVal];
+  }
+}
+
+static FORCE_INLINE __m256i tColDataLoadNarrowAVX2(const void *pData, int32_t iVal, int8_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)((const int8_t *)pData + iVal)));
+    case TSDB_DATA_TYPE_SMALLINT:
+      return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)((const int16_t *)pData + iVal)));
+    case TSDB_DATA_TYPE_UTINYINT:
+      return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)((const uint8_t *)pData + iVal)));
+    case TSDB_DATA_TYPE_USMALLINT:
+      return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)((const uint16_t *)pData + iVal)));
+    default:
+      return _mm256_loadu_si256((const __m256i *)((const int32_t *)pData + iVal));
+  }
+}
+
+// 8, 16 and 32 bits integers are widened to 32 bits lanes, and the sum is accumulated in 64 bits lanes
+static FORCE_INLINE int32_t tColDataCalcSMANarrowAVX2(const void *pData, const uint8_t *pBitMap, int32_t nVal,
+                                                      int8_t type, int64_t *sum, int64_t *max, int64_t *min) {
+  bool          isUInt = (type == TSDB_DATA_TYPE_UINT);
+  const __m256i bitSel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  const __m256i initMax = _mm256_set1_epi32((int32_t)*max);
+  const __m256i initMin = _mm256_set1_epi32((int32_t)*min);
+  __m256i       vMax = initMax;
+  __m256i       vMin = initMin;
+  __m256i       vSum = _mm256_setzero_si256();
+  int32_t       nRounds = nVal >> 3;
+  int32_t       nValid = 0;
+
+  for (int32_t r = 0; r < nRounds; r++) {
+    __m256i v = tColDataLoadNarrowAVX2(pData, r << 3, type);
+    __m256i vInMax = v, vInMin = v;
+    if (pBitMap) {
+      __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(pBitMap[r]), bitSel), bitSel);
+      vInMax = _mm256_blendv_epi8(initMax, v, mask);
+      vInMin = _mm256_blendv_epi8(initMin, v, mask);
+      v = _mm256_and_si256(v, mask);
+      nValid += __builtin_popcount(pBitMap[r]);
+    }
+
+    if (isUInt) {
+      vMax = _mm256_max_epu32(vMax, vInMax);
+      vMin = _mm256_min_epu32(vMin, vInMin);
+      vSum = _mm256_add_epi64(vSum, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(v)));
+      vSum = _mm256_add_epi64(vSum, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1)));
+    } else {
+      vMax = _mm256_max_epi32(vMax, vInMax);
+      vMin = _mm256_min_epi32(vMin, vInMin);
+      vSum = _mm256_add_epi64(vSum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+      vSum = _mm256_add_epi64(vSum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+  }
+
+  int32_t aMax[8], aMin[8];
+  int64_t aSum[4];
+  _mm256_storeu_si256((__m256i *)aMax, vMax);
+  _mm256_storeu_si256((__m256i *)aMin, vMin);
+  _mm256_storeu_si256((__m256i *)aSum, vSum);
+  for (int32_t i = 0; i < 8; i++) {
+    int64_t lMax = isUInt ? (int64_t)(uint32_t)aMax[i] : aMax[i];
+    int64_t lMin = isUInt ? (int64_t)(uint32_t)aMin[i] : aMin[i];
+    if (*max < lMax) *max = lMax;
+    if (*min > lMin) *min = lMin;
+  }
+  *sum = aSum[0] + aSum[1] + aSum[2] + aSum[3];
+
+  return pBitMap ? nValid : (nRounds << 3);
+}
+
+// 64 bits integers, the unsigned ones are compared as signed ones after flipping the sign bit
+static FORCE_INLINE int32_t tColDataCalcSMAWideAVX2(const int64_t *pData, const uint8_t *pBitMap, int32_t nVal,
+                                                    bool isUInt, int64_t *sum, int64_t *max, int64_t *min) {
+  const __m256i bitSel = _mm256_setr_epi64x(1, 2, 4, 8);
+  const __m256i flip = _mm256_set1_epi64x(isUInt ? INT64_MIN : 0);
+  const __m256i initMax = _mm256_xor_si256(_mm256_set1_epi64x(*max), flip);
+  const __m256i initMin = _mm256_xor_si256(_mm256_set1_epi64x(*min), flip);
+  __m256i       vMax = initMax;
+  __m256i       vMin = initMin;
+  __m256i       vSum = _mm256_setzero_si256();
+  int32_t       nRounds = nVal >> 3;
+  int32_t       nValid = 0;
+
+  for (int32_t r = 0; r < nRounds; r++) {
+    for (int32_t h = 0; h < 2; h++) {
+      __m256i v = _mm256_loadu_si256((const __m256i *)(pData + (r << 3) + (h << 2)));
+      __m256i vCmp = _mm256_xor_si256(v, flip);
+      __m256i vInMax = vCmp, vInMin = vCmp;
+      if (pBitMap) {
+        __m256i sel = _mm256_set1_epi64x((pBitMap[r] >> (h << 2)) & 0xF);
+        __m256i mask = _mm256_cmpeq_epi64(_mm256_and_si256(sel, bitSel), bitSel);
+        vInMax = _mm256_blendv_epi8(initMax, vCmp, mask);
+        vInMin = _mm256_blendv_epi8(initMin, vCmp, mask);
+        v = _mm256_and_si256(v, mask);
+      }
+
+      vMax = _mm256_blendv_epi8(vMax, vInMax, _mm256_cmpgt_epi64(vInMax, vMax));
+      vMin = _mm256_blendv_epi8(vMin, vInMin, _mm256_cmpgt_epi64(vMin, vInMin));
+      vSum = _mm256_add_epi64(vSum, v);
+    }
+    if (pBitMap) nValid += __builtin_popcount(pBitMap[r]);
+  }
+
+  int64_t aMax[4], aMin[4], aSum[4];
+  _mm256_storeu_si256((__m256i *)aMax, _mm256_xor_si256(vMax, flip));
+  _mm256_storeu_si256((__m256i *)aMin, _mm256_xor_si256(vMin, flip));
+  _mm256_storeu_si256((__m256i *)aSum, vSum);
+  for (int32_t i = 0; i < 4; i++) {
+    if (isUInt) {
+      if (*(uint64_t *)max < (uint64_t)aMax[i]) *max = aMax[i];
+      if (*(uint64_t *)min > (uint64_t)aMin[i]) *min = aMin[i];
+    } else {
+      if (*max < aMax[i]) *max = aMax[i];
+      if (*min > aMin[i]) *min = aMin[i];
+    }
+  }
+  *sum = aSum[0] + aSum[1] + aSum[2] + aSum[3];
+
+  return pBitMap ? nValid : (nRounds << 3);
+}
+
+// only the max and min of float and double are calculated in lanes, since the sum must be accumulated in row order to
+// get exactly the same result as before
+static FORCE_INLINE int32_t tColDataCalcMaxMinDoubleAVX2(const double *pData, const uint8_t *pBitMap, int32_t nVal,
+                                                         double *max, double *min) {
+  const __m256i bitSel = _mm256_setr_epi64x(1, 2, 4, 8);
+  const __m256d initMax = _mm256_set1_pd(*max);
+  const __m256d initMin = _mm256_set1_pd(*min);
+  __m256d       vMax = initMax;
+  __m256d       vMin = initMin;
+  int32_t       nRounds = nVal >> 3;
+
+  for (int32_t r = 0; r < nRounds; r++) {
+    for (int32_t h = 0; h < 2; h++) {
+      __m256d v = _mm256_loadu_pd(pData + (r << 3) + (h << 2));
+      __m256d vInMax = v, vInMin = v;
+      if (pBitMap) {
+        __m256i sel = _mm256_set1_epi64x((pBitMap[r] >> (h << 2)) & 0xF);
+        __m256d mask = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(sel, bitSel), bitSel));
+        vInMax = _mm256_blendv_pd(initMax, v, mask);
+        vInMin = _mm256_blendv_pd(initMin, v, mask);
+      }
+
+      // NaN in the first operand is ignored, the same as the comparisons of the scalar loop
+      vMax = _mm256_max_pd(vInMax, vMax);
+      vMin = _mm256_min_pd(vInMin, vMin);
+    }
+  }
+
+  double aMax[4], aMin[4];
+  _mm256_storeu_pd(aMax, vMax);
+  _mm256_storeu_pd(aMin, vMin);
+  for (int32_t i = 0; i < 4; i++) {
+    if (*max < aMax[i]) *max = aMax[i];
+    if (*min > aMin[i]) *min = aMin[i];
+  }
+
+  return nRounds << 3;
+}
+
+static FORCE_INLINE int32_t tColDataCalcMaxMinFloatAVX2(const float *pData, const uint8_t *pBitMap, int32_t nVal,
+                                                        float *max, float *min) {
+  const __m256i bitSel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  const __m256  initMax = _mm256_set1_ps(*max);
+  const __m256  initMin = _mm256_set1_ps(*min);
+  __m256        vMax = initMax;
+  __m256        vMin = initMin;
+  int32_t       nRounds = nVal >> 3;
+
+  for (int32_t r = 0; r < nRounds; r++) {
+    __m256 v = _mm256_loadu_ps(pData + (r << 3));
+    __m256 vInMax = v, vInMin = v;
+    if (pBitMap) {
+      __m256i sel = _mm256_set1_epi32(pBitMap[r]);
+      __m256  mask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(sel, bitSel), bitSel));
+      vInMax = _mm256_blendv_ps(initMax, v, mask);
+      vInMin = _mm256_blendv_ps(initMin, v, mask);
+    }
+
+    vMax = _mm256_max_ps(vInMax, vMax);
+    vMin = _mm256_min_ps(vInMin, vMin);
+  }
+
+  float aMax[8], aMin[8];
+  _mm256_storeu_ps(aMax, vMax);
+  _mm256_storeu_ps(aMin, vMin);
+  for (int32_t i = 0; i < 8; i++) {
+    if (*max < aMax[i]) *max = aMax[i];
+    if (*min > aMin[i]) *min = aMin[i];
+  }
+
+  return nRounds << 3;
+}
+#endif
+
+// The AVX-512 kernels are built for the avx512f target whatever the compiler flags are, and are only called when the
+// CPU supports AVX-512.
+#if __AVX2__ && (defined(__GNUC__) || defined(__clang__))
+#define COL_SMA_AVX512        1
+#define COL_SMA_AVX512_KERNEL __attribute__((target("avx512f")))
+#endif
+
+#if COL_SMA_AVX512
+static FORCE_INLINE COL_SMA_AVX512_KERNEL __m512i tColDataLoadNarrowAVX512(const void *pData, int32_t iVal,
+                                                                           int8_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i *)((const int8_t *)pData + iVal)));
+    case TSDB_DATA_TYPE_SMALLINT:
+      return _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)((const int16_t *)pData + iVal)));
+    case TSDB_DATA_TYPE_UTINYINT:
+      return _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)((const uint8_t *)pData + iVal)));
+    case TSDB_DATA_TYPE_USMALLINT:
+      return _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)((const uint16_t *)pData + iVal)));
+    default:
+      return _mm512_loadu_si512((const void *)((const int32_t *)pData + iVal));
+  }
+}
+
+// with AVX-512, two bytes of the bitmap are the lane mask of 16 rows directly
+static COL_SMA_AVX512_KERNEL int32_t tColDataCalcSMANarrowAVX512(const void *pData, const uint8_t *pBitMap,
+                                                                 int32_t nVal, int8_t type, int64_t *sum, int64_t *max,
+                                                                 int64_t *min) {
+  bool    isUInt = (type == TSDB_DATA_TYPE_UINT);
+  __m512i vMax = _mm512_set1_epi32((int32_t)*max);
+  __m512i vMin = _mm512_set1_epi32((int32_t)*min);
+  __m512i vSum = _mm512_setzero_si512();
+  int32_t nRounds = nVal >> 4;
+  int32_t nValid = 0;
+
+  for (int32_t r = 0; r < nRounds; r++) {
+    __mmask16 k = pBitMap ? (__mmask16)(pBitMap[r << 1] | (pBitMap[(r << 1) + 1] << 8)) : (__mmask16)0xFFFF;
+    __m512i   v = tColDataLoadNarrowAVX512(pData, r << 4, type);
+    __m512i   lo, hi;
+    if (isUInt) {
+      vMax = _mm512_mask_max_epu32(vMax, k, vMax, v);
+      vMin = _mm512_mask_min_epu32(vMin, k, vMin, v);
+      lo = _mm512_cvtepu32_epi64(_mm512_castsi512_si256(v));
+      hi = _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(v, 1));
+    } else {
+      vMax = _mm512_mask_max_epi32(vMax, k, vMax, v);
+      vMin = _mm512_mask_min_epi32(vMin, k, vMin, v);
+      lo = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v));
+      hi = _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1));
+    }
+    vSum = _mm512_mask_add_epi64(vSum, (__mmask8)k, vSum, lo);
+    vSum = _mm512_mask_add_epi64(vSum, (__mmask8)(k >> 8), vSum, hi);
+    nValid += __builtin_popcount(k);
+  }
+
+  if (isUInt) {
+    *max = (uint32_t)_mm512_reduce_max_epu32(vMax);
+    *min = (uint32_t)_mm512_reduce_min_epu32(vMin);
+  } else {
+    *max = _mm512_reduce_max_epi32(vMax);
+    *min = _mm512_reduce_min_epi32(vMin);
+  }
+  *sum = _mm512_reduce_add_epi64(vSum);
+
+  return nValid;
+}
+
+static COL_SMA_AVX512_KERNEL int32_t tColDataCalcSMAWideAVX512(const int64_t *pData, const uint8_t *pBitMap,
+                                                               int32_t nVal, bool isUInt, int64_t *sum, int64_t *max,
+                                                               int64_t *min) {
+  __m512i vMax = _mm512_set1_epi64(*max);
+  __m512i vMin = _mm512_set1_epi64(*min);
+  __m512i vSum = _mm512_setzero_si512();
+  int32_t nRounds = nVal >> 3;
+  int32_t nValid = 0;
+
+  for (int32_t r = 0; r < nRounds; r++) {
+    __mmask8 k = pBitMap ? (__mmask8)pBitMap[r] : (__mmask8)0xFF;
+    __m512i  v = _mm512_loadu_si512((const void *)(pData + (r << 3)));
+    if (isUInt) {
+      vMax = _mm512_mask_max_epu64(vMax, k, vMax, v);
+      vMin = _mm512_mask_min_epu64(vMin, k, vMin, v);
+    } else {
+      vMax = _mm512_mask_max_epi64(vMax, k, vMax, v);
+      vMin = _mm512_mask_min_epi64(vMin, k, vMin, v);
+    }
+    vSum = _mm512_mask_add_epi64(vSum, k, vSum, v);
+    nValid += __builtin_popcount(k);
+  }
+
+  if (isUInt) {
+    *max = (int64_t)_mm512_reduce_max_epu64(vMax);
+    *min = (int64_t)_mm512_reduce_min_epu64(vMin);
+  } else {
+    *max = _mm512_reduce_max_epi64(vMax);
+    *min = _mm512_reduce_min_epi64(vMin);
+  }
+  *sum = _mm512_reduce_add_epi64(vSum);
+
+  return nValid;
+}
+
+static COL_SMA_AVX512_KERNEL int32_t tColDataCalcMaxMinDoubleAVX512(const double *pData, const uint8_t *pBitMap,
+                                                                    int32_t nVal, double *max, double *min) {
+  __m512d vMax = _mm512_set1_pd(*max);
+  __m512d vMin = _mm512_set1_pd(*min);
+  int32_t nRounds = nVal >> 3;
+
+  for (int32_t r = 0; r < nRounds; r++) {
+    __mmask8 k = pBitMap ? (__mmask8)pBitMap[r] : (__mmask8)0xFF;
+    __m512d  v = _mm512_loadu_pd(pData + (r << 3));
+    vMax = _mm512_mask_max_pd(vMax, k, v, vMax);
+    vMin = _mm512_mask_min_pd(vMin, k, v, vMin);
+  }
+
+  double aMax[8], aMin[8];
+  _mm512_storeu_pd(aMax, vMax);
+  _mm512_storeu_pd(aMin, vMin);
+  for (int32_t i = 0; i < 8; i++) {
+    if (*max < aMax[i]) *max = aMax[i];
+    if (*min > aMin[i]) *min = aMin[i];
+  }
+
+  return nRounds << 3;
+}
+
+static COL_SMA_AVX512_KERNEL int32_t tColDataCalcMaxMinFloatAVX512(const float *pData, const uint8_t *pBitMap,
+                                                                   int32_t nVal, float *max, float *min) {
+  __m512  vMax = _mm512_set1_ps(*max);
+  __m512  vMin = _mm512_set1_ps(*min);
+  int32_t nRounds = nVal >> 4;
+
+  for (int32_t r = 0; r < nRounds; r++) {
+    __mmask16 k = pBitMap ? (__mmask16)(pBitMap[r << 1] | (pBitMap[(r << 1) + 1] << 8)) : (__mmask16)0xFFFF;
+    __m512    v = _mm512_loadu_ps(pData + (r << 4));
+    vMax = _mm512_mask_max_ps(vMax, k, v, vMax);
+    vMin = _mm512_mask_min_ps(vMin, k, v, vMin);
+  }
+
+  float aMax[16], aMin[16];
+  _mm512_storeu_ps(aMax, vMax);
+  _mm512_storeu_ps(aMin, vMin);
+  for (int32_t i = 0; i < 16; i++) {
+    if (*max < aMax[i]) *max = aMax[i];
+    if (*min > aMin[i]) *min = aMin[i];
+  }
+
+  return nRounds << 4;
+}
+#endif
+
+#if __AVX2__
+static void tColDataCalcSMANarrowVec(SColData *pColData, int8_t type, int64_t *sum, int64_t *max, int64_t *min,
+                                     int16_t *numOfNull) {
+  const uint8_t *pBitMap = (pColData->flag == HAS_VALUE) ? NULL : pColData->pBitMap;
+  int32_t        nVal = pColData->nVal;
+  int32_t        nValid = 0;
+  int32_t        iVal = 0;
+
+#if COL_SMA_AVX512
+  if (tsAVX512Enable) {
+    nValid = tColDataCalcSMANarrowAVX512(pColData->pData, pBitMap, nVal, type, sum, max, min);
+    iVal = (nVal >> 4) << 4;
+  } else {
+#endif
+    nValid = tColDataCalcSMANarrowAVX2(pColData->pData, pBitMap, nVal, type, sum, max, min);
+    iVal = (nVal >> 3) << 3;
+#if COL_SMA_AVX512
+  }
+#endif
+
+  for (; iVal < nVal; iVal++) {
+    if (pBitMap && GET_BIT1(pBitMap, iVal) == 0) continue;
+    int64_t val = tColDataGetNarrowVal(pColData->pData, iVal, type);
+    CALC_SUM_MAX_MIN(*sum, *max, *min, val);
+    nValid++;
+  }
+  *numOfNull = nVal - nValid;
+}
+
+static void tColDataCalcSMAWideVec(SColData *pColData, bool isUInt, int64_t *sum, int64_t *max, int64_t *min,
+                                   int16_t *numOfNull) {
+  const uint8_t *pBitMap = (pColData->flag == HAS_VALUE) ? NULL : pColData->pBitMap;
+  const int64_t *pData = (const int64_t *)pColData->pData;
+  int32_t        nVal = pColData->nVal;
+  int32_t        nValid = 0;
+  int32_t        iVal = (nVal >> 3) << 3;
+
+#if COL_SMA_AVX512
+  if (tsAVX512Enable) {
+    nValid = tColDataCalcSMAWideAVX512(pData, pBitMap, nVal, isUInt, sum, max, min);
+  } else {
+#endif
+    nValid = tColDataCalcSMAWideAVX2(pData, pBitMap, nVal, isUInt, sum, max, min);
+#if COL_SMA_AVX512
+  }
+#endif
+
+  for (; iVal < nVal; iVal++) {
+    if (pBitMap && GET_BIT1(pBitMap, iVal) == 0) continue;
+    if (isUInt) {
+      CALC_SUM_MAX_MIN(*(uint64_t *)sum, *(uint64_t *)max, *(uint64_t *)min, (uint64_t)pData[iVal]);
+    } else {
+      CALC_SUM_MAX_MIN(*sum, *max, *min, pData[iVal]);
+    }
+    nValid++;
+  }
+  *numOfNull = nVal - nValid;
+}
+
+static void tColDataCalcSMADoubleVec(SColData *pColData, int64_t *sum, int64_t *max, int64_t *min,
+                                     int16_t *numOfNull) {
+  const uint8_t *pBitMap = (pColData->flag == HAS_VALUE) ? NULL : pColData->pBitMap;
+  const double  *pData = (const double *)pColData->pData;
+  int32_t        nVal = pColData->nVal;
+  int32_t        iVal = 0;
+  double         initMax = *(double *)max;
+  double         initMin = *(double *)min;
+
+#if COL_SMA_AVX512
+  if (tsAVX512Enable) {
+    iVal = tColDataCalcMaxMinDoubleAVX512(pData, pBitMap, nVal, (double *)max, (double *)min);
+  } else {
+#endif
+    iVal = tColDataCalcMaxMinDoubleAVX2(pData, pBitMap, nVal, (double *)max, (double *)min);
+#if COL_SMA_AVX512
+  }
+#endif
+
+  for (; iVal < nVal; iVal++) {
+    if (pBitMap && GET_BIT1(pBitMap, iVal) == 0) continue;
+    if (*(double *)max < pData[iVal]) *(double *)max = pData[iVal];
+    if (*(double *)min > pData[iVal]) *(double *)min = pData[iVal];
+  }
+
+  // -0.0 and +0.0 are equal, the scalar loop keeps the first one of them, but the lanes may keep either
+  if (*(double *)max == 0 || *(double *)min == 0) {
+    *(double *)max = initMax;
+    *(double *)min = initMin;
+    for (iVal = 0; iVal < nVal; iVal++) {
+      if (pBitMap && GET_BIT1(pBitMap, iVal) == 0) continue;
+      if (*(double *)max < pData[iVal]) *(double *)max = pData[iVal];
+      if (*(double *)min > pData[iVal]) *(double *)min = pData[iVal];
+    }
+  }
+
+  double  s = 0;
+  int32_t nValid = 0;
+  for (iVal = 0; iVal < nVal; iVal++) {
+    bool isValid = (pBitMap == NULL || GET_BIT1(pBitMap, iVal));
+    s += isValid ? pData[iVal] : 0;
+    nValid += isValid;
+  }
+  *(double *)sum = s;
+  *numOfNull = nVal - nValid;
+}
+
+static void tColDataCalcSMAFloatVec(SColData *pColData, int64_t *sum, int64_t *max, int64_t *min,
+                                    int16_t *numOfNull) {
+  const uint8_t *pBitMap = (pColData->flag == HAS_VALUE) ? NULL : pColData->pBitMap;
+  const float   *pData = (const float *)pColData->pData;
+  int32_t        nVal = pColData->nVal;
+  int32_t        iVal = 0;
+  float          fMax = (float)*(double *)max;
+  float          fMin = (float)*(double *)min;
+  float          initMax = fMax;
+  float          initMin = fMin;
+
+#if COL_SMA_AVX512
+  if (tsAVX512Enable) {
+    iVal = tColDataCalcMaxMinFloatAVX512(pData, pBitMap, nVal, &fMax, &fMin);
+  } else {
+#endif
+    iVal = tColDataCalcMaxMinFloatAVX2(pData, pBitMap, nVal, &fMax, &fMin);
+#if COL_SMA_AVX512
+  }
+#endif
+
+  for (; iVal < nVal; iVal++) {
+    if (pBitMap && GET_BIT1(pBitMap, iVal) == 0) continue;
+    if (fMax < pData[iVal]) fMax = pData[iVal];
+    if (fMin > pData[iVal]) fMin = pData[iVal];
+  }
+
+  // the same as doubles, the sign of a zero max or min is taken from the scalar loop
+  if (fMax == 0 || fMin == 0) {
+    fMax = initMax;
+    fMin = initMin;
+    for (iVal = 0; iVal < nVal; iVal++) {
+      if (pBitMap && GET_BIT1(pBitMap, iVal) == 0) continue;
+      if (fMax < pData[iVal]) fMax = pData[iVal];
+      if (fMin > pData[iVal]) fMin = pData[iVal];
+    }
+  }
+  *(double *)max = fMax;
+  *(double *)min = fMin;
+
+  double  s = 0;
+  int32_t nValid = 0;
+  for (iVal = 0; iVal < nVal; iVal++) {
+    bool isValid = (pBitMap == NULL || GET_BIT1(pBitMap, iVal));
+    s += isValid ? pData[iVal] : 0;
+    nValid += isValid;
+  }
+  *(double *)sum = s;
+  *numOfNull = nVal - nValid;
+}
+#endif
+
 static FORCE_INLINE void tColDataCalcSMABool(SColData *pColData, int64_t *sum, int64_t *max, int64_t *min,
                                              int16_t *numOfNull) {
   *sum = 0;
@@ -3224,6 +3755,13 @@ static FORCE_INLINE void tColDataCalcSMATinyInt(SColData *pColData, int64_t *sum
   *min = INT8_MAX;
   *numOfNull = 0;
 
+#if __AVX2__
+  if (tColDataCanCalcSMAVec(pColData)) {
+    tColDataCalcSMANarrowVec(pColData, TSDB_DATA_TYPE_TINYINT, sum, max, min, numOfNull);
+    return;
+  }
+#endif
+
   int8_t val;
   if (HAS_VALUE == pColData->flag) {
     for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
@@ -3256,6 +3794,13 @@ static FORCE_INLINE void tColDataCalcSMATinySmallInt(SColData *pColData, int64_t
   *min = INT16_MAX;
   *numOfNull = 0;
 
+#if __AVX2__
+  if (tColDataCanCalcSMAVec(pColData)) {
+    tColDataCalcSMANarrowVec(pColData, TSDB_DATA_TYPE_SMALLINT, sum, max, min, numOfNull);
+    return;
+  }
+#endif
+
   int16_t val;
   if (HAS_VALUE == pColData->flag) {
     for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
@@ -3288,6 +3833,13 @@ static FORCE_INLINE void tColDataCalcSMAInt(SColData *pColData, int64_t *sum, in
   *min = INT32_MAX;
   *numOfNull = 0;
 
+#if __AVX2__
+  if (tColDataCanCalcSMAVec(pColData)) {
+    tColDataCalcSMANarrowVec(pColData, TSDB_DATA_TYPE_INT, sum, max, min, numOfNull);
+    return;
+  }
+#endif
+
   int32_t val;
   if (HAS_VALUE == pColData->flag) {
     for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
@@ -3320,6 +3872,13 @@ static FORCE_INLINE void tColDataCalcSMABigInt(SColData *pColData, int64_t *sum,
   *min = INT64_MAX;
   *numOfNull = 0;
 
+#if __AVX2__
+  if (tColDataCanCalcSMAVec(pColData)) {
+    tColDataCalcSMAWideVec(pColData, false, sum, max, min, numOfNull);
+    return;
+  }
+#endif
+
   int64_t val;
   if (HAS_VALUE == pColData->flag) {
     for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
@@ -3352,6 +3911,13 @@ static FORCE_INLINE void tColDataCalcSMAFloat(SColData *pColData, int64_t *sum,
   *(double *)min = FLT_MAX;
   *numOfNull = 0;
 
+#if __AVX2__
+  if (tColDataCanCalcSMAVec(pColData)) {
+    tColDataCalcSMAFloatVec(pColData, sum, max, min, numOfNull);
+    return;
+  }
+#endif
+
   float val;
   if (HAS_VALUE == pColData->flag) {
     for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
@@ -3384,6 +3950,13 @@ static FORCE_INLINE void tColDataCalcSMADouble(SColData *pColData, int64_t *sum,
   *(double *)min = DBL_MAX;
   *numOfNull = 0;
 
+#if __AVX2__
+  if (tColDataCanCalcSMAVec(pColData)) {
+    tColDataCalcSMADoubleVec(pColData, sum, max, min, numOfNull);
+    return;
+  }
+#endif
+
   double val;
   if (HAS_VALUE == pColData->flag) {
     for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
@@ -3416,6 +3989,13 @@ static FORCE_INLINE void tColDataCalcSMAUTinyInt(SColData *pColData, int64_t *su
   *(uint64_t *)min = UINT8_MAX;
   *numOfNull = 0;
 
+#if __AVX2__
+  if (tColDataCanCalcSMAVec(pColData)) {
+    tColDataCalcSMANarrowVec(pColData, TSDB_DATA_TYPE_UTINYINT, sum, max, min, numOfNull);
+    return;
+  }
+#endif
+
   uint8_t val;
   if (HAS_VALUE == pColData->flag) {
     for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
@@ -3448,6 +4028,13 @@ static FORCE_INLINE void tColDataCalcSMATinyUSmallInt(SColData *pColData, int64_
   *(uint64_t *)min = UINT16_MAX;
   *numOfNull = 0;
 
+#if __AVX2__
+  if (tColDataCanCalcSMAVec(pColData)) {
+    tColDataCalcSMANarrowVec(pColData, TSDB_DATA_TYPE_USMALLINT, sum, max, min, numOfNull);
+    return;
+  }
+#endif
+
   uint16_t val;
   if (HAS_VALUE == pColData->flag) {
     for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
@@ -3480,6 +4067,13 @@ static FORCE_INLINE void tColDataCalcSMAUInt(SColData *pColData, int64_t *sum, i
   *(uint64_t *)min = UINT32_MAX;
   *numOfNull = 0;
 
+#if __AVX2__
+  if (tColDataCanCalcSMAVec(pColData)) {
+    tColDataCalcSMANarrowVec(pColData, TSDB_DATA_TYPE_UINT, sum, max, min, numOfNull);
+    return;
+  }
+#endif
+
   uint32_t val;
   if (HAS_VALUE == pColData->flag) {
     for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
@@ -3512,6 +4106,13 @@ static FORCE_INLINE void tColDataCalcSMAUBigInt(SColData *pColData, int64_t *sum
   *(uint64_t *)min = UINT64_MAX;
   *numOfNull = 0;
 
+#if __AVX2__
+  if (tColDataCanCalcSMAVec(pColData)) {
+    tColDataCalcSMAWideVec(pColData, true, sum, max, min, numOfNull);
+    return;
+  }
+#endif
+
   uint64_t val;
   if (HAS_VALUE == pColData->flag) {
     for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
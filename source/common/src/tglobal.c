@@ -17,6 +17,7 @@
 #include "tglobal.h"
 #include "defines.h"
 #include "os.h"
+#include "tcompression.h"
 #include "tconfig.h"
 #include "tgrant.h"
 #include "tlog.h"
@@ -194,8 +195,14 @@ char    tsTagFilterCache = 0;
 // positive value (in MB)
 int32_t tsQueryBufferSize = -1;
 int64_t tsQueryBufferSizeBytes = -1;
+
+// per-vnode memory in MB used to cache partial interval aggregate states of recent queries, 0 to disable it
+int32_t tsWinResCacheSize = 0;
 int32_t tsCacheLazyLoadThreshold = 500;
 
+// the size in MB of the arrived but not consumed fetch rsp of an exchange operator, above which no new fetch is sent
+int32_t tsExchangeMaxPendingRspSize = 64;
+
 int32_t  tsDiskCfgNum = 0;
 SDiskCfg tsDiskCfg[TFS_MAX_DISKS] = {0};
 int64_t  tsMinDiskFreeSize = TFS_MIN_DISK_FREE_SIZE;
@@ -252,6 +259,7 @@ int32_t tsCompactPullupInterval = 10;
 int32_t tsMqRebalanceInterval = 2;
 int32_t tsStreamCheckpointInterval = 60;
 float   tsSinkDataRate = 2.0;
+int32_t tsStreamExecLatency = 100;  // latency target of one batch of stream input blocks, in ms
 int32_t tsStreamNodeCheckInterval = 15;
 int32_t tsTtlUnit = 86400;
 int32_t tsTtlPushIntervalSec = 10;
@@ -260,6 +268,7 @@ int32_t tsGrantHBInterval = 60;
 int32_t tsUptimeInterval = 300;    // seconds
 char    tsUdfdResFuncs[512] = "";  // udfd resident funcs that teardown when udfd exits
 char    tsUdfdLdLibPath[512] = "";
+int32_t tsUdfShmSize = 16;         // MB, shared memory of each udf session to pass data to udfd, 0 to disable
 bool    tsDisableStream = false;
 int64_t tsStreamBufferSize = 128 * 1024 * 1024;
 bool    tsFilterScalarMode = false;
@@ -591,6 +600,10 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
     return -1;
   if (cfgAddInt32(pCfg, "queryBufferSize", tsQueryBufferSize, -1, 500000000000, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
     return -1;
+  if (cfgAddInt32(pCfg, "winResCacheSize", tsWinResCacheSize, 0, 65536, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddInt32(pCfg, "exchangeMaxPendingRspSize", tsExchangeMaxPendingRspSize, 1, 65536, CFG_SCOPE_SERVER,
+                  CFG_DYN_NONE) != 0)
+    return -1;
   if (cfgAddInt32(pCfg, "queryRspPolicy", tsQueryRspPolicy, 0, 1, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER) != 0) return -1;
 
   tsNumOfRpcThreads = tsNumOfCores / 2;
@@ -743,6 +756,7 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddBool(pCfg, "udf", tsStartUdfd, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
   if (cfgAddString(pCfg, "udfdResFuncs", tsUdfdResFuncs, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
   if (cfgAddString(pCfg, "udfdLdLibPath", tsUdfdLdLibPath, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddInt32(pCfg, "udfShmSize", tsUdfShmSize, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
 
   if (cfgAddBool(pCfg, "disableStream", tsDisableStream, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER) != 0) return -1;
   if (cfgAddInt64(pCfg, "streamBufferSize", tsStreamBufferSize, 0, INT64_MAX, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
@@ -752,6 +766,8 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
                   CFG_DYN_ENT_SERVER) != 0)
     return -1;
   if (cfgAddFloat(pCfg, "streamSinkDataRate", tsSinkDataRate, 0.1, 5, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddInt32(pCfg, "streamExecLatency", tsStreamExecLatency, 1, 60000, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER) != 0)
+    return -1;
 
   if (cfgAddInt32(pCfg, "cacheLazyLoadThreshold", tsCacheLazyLoadThreshold, 0, 100000, CFG_SCOPE_SERVER,
                   CFG_DYN_ENT_SERVER) != 0)
@@ -764,6 +780,7 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "curRange", tsCurRange, 0, 65536, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
   if (cfgAddBool(pCfg, "ifAdtFse", tsIfAdtFse, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
   if (cfgAddString(pCfg, "compressor", tsCompressor, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddBool(pCfg, "legacyCmprFormat", tsLegacyCmprFormat, CFG_SCOPE_SERVER, CFG_DYN_SERVER) != 0) return -1;
 
   if (cfgAddBool(pCfg, "filterScalarMode", tsFilterScalarMode, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
   if (cfgAddInt32(pCfg, "maxStreamBackendCache", tsMaxStreamBackendCache, 16, 1024, CFG_SCOPE_SERVER,
@@ -1121,6 +1138,8 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsMinIntervalTime = cfgGetItem(pCfg, "minIntervalTime")->i32;
   tsCountAlwaysReturnValue = cfgGetItem(pCfg, "countAlwaysReturnValue")->i32;
   tsQueryBufferSize = cfgGetItem(pCfg, "queryBufferSize")->i32;
+  tsWinResCacheSize = cfgGetItem(pCfg, "winResCacheSize")->i32;
+  tsExchangeMaxPendingRspSize = cfgGetItem(pCfg, "exchangeMaxPendingRspSize")->i32;
 
   tsNumOfRpcThreads = cfgGetItem(pCfg, "numOfRpcThreads")->i32;
   tsNumOfRpcSessions = cfgGetItem(pCfg, "numOfRpcSessions")->i32;
@@ -1192,6 +1211,7 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsStartUdfd = cfgGetItem(pCfg, "udf")->bval;
   tstrncpy(tsUdfdResFuncs, cfgGetItem(pCfg, "udfdResFuncs")->str, sizeof(tsUdfdResFuncs));
   tstrncpy(tsUdfdLdLibPath, cfgGetItem(pCfg, "udfdLdLibPath")->str, sizeof(tsUdfdLdLibPath));
+  tsUdfShmSize = cfgGetItem(pCfg, "udfShmSize")->i32;
   if (tsQueryBufferSize >= 0) {
     tsQueryBufferSizeBytes = tsQueryBufferSize * 1048576UL;
   }
@@ -1205,11 +1225,13 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsCurRange = cfgGetItem(pCfg, "curRange")->i32;
   tsIfAdtFse = cfgGetItem(pCfg, "ifAdtFse")->bval;
   tstrncpy(tsCompressor, cfgGetItem(pCfg, "compressor")->str, sizeof(tsCompressor));
+  tsLegacyCmprFormat = cfgGetItem(pCfg, "legacyCmprFormat")->bval;
 
   tsDisableStream = cfgGetItem(pCfg, "disableStream")->bval;
   tsStreamBufferSize = cfgGetItem(pCfg, "streamBufferSize")->i64;
   tsStreamCheckpointInterval = cfgGetItem(pCfg, "checkpointInterval")->i32;
   tsSinkDataRate = cfgGetItem(pCfg, "streamSinkDataRate")->fval;
+  tsStreamExecLatency = cfgGetItem(pCfg, "streamExecLatency")->i32;
 
   tsFilterScalarMode = cfgGetItem(pCfg, "filterScalarMode")->bval;
   tsMaxStreamBackendCache = cfgGetItem(pCfg, "maxStreamBackendCache")->i32;
@@ -1474,7 +1496,9 @@ static int32_t taosCfgDynamicOptionsForServer(SConfig *pCfg, char *name) {
         {"minDiskFreeSize", &tsMinDiskFreeSize},
 
         {"cacheLazyLoadThreshold", &tsCacheLazyLoadThreshold},
+        {"legacyCmprFormat", &tsLegacyCmprFormat},
         {"checkpointInterval", &tsStreamCheckpointInterval},
+        {"streamExecLatency", &tsStreamExecLatency},
         {"keepAliveIdle", &tsKeepAliveIdle},
         {"logKeepDays", &tsLogKeepDays},
         {"maxStreamBackendCache", &tsMaxStreamBackendCache},
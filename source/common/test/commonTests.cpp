@@ -408,6 +408,260 @@ TEST(testCase, var_dataBlock_split_test) {
   }
 }
 
+static void appendColDataTestValue(SColData* pColData, int32_t i, bool withNone) {
+  SColVal cv = {0};
+  cv.cid = pColData->cid;
+  cv.type = pColData->type;
+  if (i % 7 == 3) {
+    cv.flag = CV_FLAG_NULL;
+  } else if (withNone && i % 11 == 5) {
+    cv.flag = CV_FLAG_NONE;
+  } else if (IS_VAR_DATA_TYPE(pColData->type)) {
+    static char buf[32];
+    cv.flag = CV_FLAG_VALUE;
+    cv.value.nData = sprintf(buf, "value_%d", i);
+    cv.value.pData = (uint8_t*)buf;
+  } else {
+    cv.flag = CV_FLAG_VALUE;
+    cv.value.val = i * 3;
+  }
+  tColDataAppendValue(pColData, &cv);
+}
+
+static void setColumnByColVal(SColumnInfoData* pColInfo, SColData* pColData, int32_t startRow, int32_t numOfRows) {
+  char buf[64];
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    SColVal cv;
+    tColDataGetValue(pColData, startRow + i, &cv);
+    if (!COL_VAL_IS_VALUE(&cv)) {
+      colDataSetNULL(pColInfo, i);
+    } else if (IS_VAR_DATA_TYPE(cv.type)) {
+      memcpy(varDataVal(buf), cv.value.pData, cv.value.nData);
+      varDataSetLen(buf, cv.value.nData);
+      colDataSetVal(pColInfo, i, buf, false);
+    } else {
+      colDataSetVal(pColInfo, i, (const char*)&cv.value.val, false);
+    }
+  }
+}
+
+TEST(testCase, colDataAssignFromColData_test) {
+  const int32_t numOfRows = 1000000;
+  int8_t        types[] = {TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BINARY};
+  int32_t       bytes[] = {8, 4, 32};
+
+  for (int32_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+    SColData colData;
+    tColDataInit(&colData, 2, types[t], 0);
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      appendColDataTestValue(&colData, i, types[t] != TSDB_DATA_TYPE_INT);
+    }
+
+    SColumnInfoData expect = createColumnInfoData(types[t], bytes[t], 2);
+    SColumnInfoData actual = createColumnInfoData(types[t], bytes[t], 2);
+    ASSERT_EQ(colInfoDataEnsureCapacity(&expect, numOfRows, true), 0);
+    ASSERT_EQ(colInfoDataEnsureCapacity(&actual, numOfRows, true), 0);
+
+    int64_t st = taosGetTimestampUs();
+    setColumnByColVal(&expect, &colData, 0, numOfRows);
+    int64_t el1 = taosGetTimestampUs() - st;
+
+    st = taosGetTimestampUs();
+    ASSERT_EQ(colDataAssignFromColData(&actual, &colData, 0, numOfRows), 0);
+    int64_t el2 = taosGetTimestampUs() - st;
+
+    printf("type:%d, %d rows, per value: %.2f Mrows/s, batch: %.2f Mrows/s\n", types[t], numOfRows,
+           numOfRows / (double)TMAX(el1, 1), numOfRows / (double)TMAX(el2, 1));
+
+    ASSERT_EQ(expect.hasNull, actual.hasNull);
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      ASSERT_EQ(colDataIsNull_s(&expect, i), colDataIsNull_s(&actual, i));
+      if (colDataIsNull_s(&expect, i)) {
+        continue;
+      }
+      char* p1 = colDataGetData(&expect, i);
+      char* p2 = colDataGetData(&actual, i);
+      if (IS_VAR_DATA_TYPE(types[t])) {
+        ASSERT_EQ(varDataTLen(p1), varDataTLen(p2));
+        ASSERT_EQ(memcmp(p1, p2, varDataTLen(p1)), 0);
+      } else {
+        ASSERT_EQ(memcmp(p1, p2, bytes[t]), 0);
+      }
+    }
+
+    colDataDestroy(&expect);
+    colDataDestroy(&actual);
+
+    // a range that does not start at a byte boundary of the bitmap
+    const int32_t startRow = 13, num = 1000;
+    expect = createColumnInfoData(types[t], bytes[t], 2);
+    actual = createColumnInfoData(types[t], bytes[t], 2);
+    ASSERT_EQ(colInfoDataEnsureCapacity(&expect, num, true), 0);
+    ASSERT_EQ(colInfoDataEnsureCapacity(&actual, num, true), 0);
+    setColumnByColVal(&expect, &colData, startRow, num);
+    ASSERT_EQ(colDataAssignFromColData(&actual, &colData, startRow, num), 0);
+    ASSERT_NE(colDataAssignFromColData(&actual, &colData, numOfRows - 1, 2), 0);
+
+    for (int32_t i = 0; i < num; ++i) {
+      ASSERT_EQ(colDataIsNull_s(&expect, i), colDataIsNull_s(&actual, i));
+      if (colDataIsNull_s(&expect, i)) {
+        continue;
+      }
+      char* p1 = colDataGetData(&expect, i);
+      char* p2 = colDataGetData(&actual, i);
+      if (IS_VAR_DATA_TYPE(types[t])) {
+        ASSERT_EQ(varDataTLen(p1), varDataTLen(p2));
+        ASSERT_EQ(memcmp(p1, p2, varDataTLen(p1)), 0);
+      } else {
+        ASSERT_EQ(memcmp(p1, p2, bytes[t]), 0);
+      }
+    }
+
+    colDataDestroy(&expect);
+    colDataDestroy(&actual);
+    tColDataDestroy(&colData);
+  }
+}
+
+static void appendSMATestValue(SColData* pColData, int32_t i, int32_t nullMode) {
+  SColVal cv = {0};
+  cv.cid = pColData->cid;
+  cv.type = pColData->type;
+  if (nullMode > 0 && i % 7 == 3) {
+    cv.flag = CV_FLAG_NULL;
+  } else if (nullMode > 1 && i % 11 == 5) {
+    cv.flag = CV_FLAG_NONE;
+  } else {
+    cv.flag = CV_FLAG_VALUE;
+    int64_t v = ((int64_t)taosRand() << 33) ^ ((int64_t)taosRand() << 16) ^ taosRand();
+    if (pColData->type == TSDB_DATA_TYPE_FLOAT) {
+      *(float*)&cv.value.val = (i % 97 == 0) ? NAN : (float)(v % 1000000) / 7.0f;
+    } else if (pColData->type == TSDB_DATA_TYPE_DOUBLE) {
+      *(double*)&cv.value.val = (i % 97 == 0) ? NAN : (double)(v % 100000000) / 7.0;
+    } else {
+      cv.value.val = v;
+    }
+  }
+  tColDataAppendValue(pColData, &cv);
+}
+
+TEST(testCase, colDataCalcSMA_test) {
+  const int32_t numOfRows = 4096 + 13;
+  const int32_t loops = 1000;
+  int8_t        types[] = {TSDB_DATA_TYPE_TINYINT,  TSDB_DATA_TYPE_SMALLINT,  TSDB_DATA_TYPE_INT,
+                           TSDB_DATA_TYPE_BIGINT,   TSDB_DATA_TYPE_FLOAT,     TSDB_DATA_TYPE_DOUBLE,
+                           TSDB_DATA_TYPE_UTINYINT, TSDB_DATA_TYPE_USMALLINT, TSDB_DATA_TYPE_UINT,
+                           TSDB_DATA_TYPE_UBIGINT,  TSDB_DATA_TYPE_TIMESTAMP};
+  bool          hasAVX2 = __builtin_cpu_supports("avx2");
+  bool          hasAVX512 = __builtin_cpu_supports("avx512f");
+  char          simd = tsSIMDEnable, avx2 = tsAVX2Enable, avx512 = tsAVX512Enable;
+
+  for (int32_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+    // no null, one kind of null, both NULL and NONE
+    for (int32_t nullMode = 0; nullMode < 3; ++nullMode) {
+      SColData colData = {0};
+      tColDataInit(&colData, 2, types[t], 0);
+      for (int32_t i = 0; i < numOfRows; ++i) {
+        appendSMATestValue(&colData, i, nullMode);
+      }
+
+      int64_t expect[3] = {0}, actual[3] = {0};
+      int16_t expectNull = 0, actualNull = 0;
+
+      tsSIMDEnable = 0;
+      int64_t st = taosGetTimestampUs();
+      for (int32_t l = 0; l < loops; ++l) {
+        tColDataCalcSMA[types[t]](&colData, &expect[0], &expect[1], &expect[2], &expectNull);
+      }
+      int64_t el = taosGetTimestampUs() - st;
+      printf("type:%d, null mode:%d, scalar: %.2f Mrows/s", types[t], nullMode,
+             (double)numOfRows * loops / TMAX(el, 1));
+
+      for (int32_t isa = 0; isa < 2; ++isa) {
+        if ((isa == 0 && !hasAVX2) || (isa == 1 && !hasAVX512)) {
+          continue;
+        }
+
+        tsSIMDEnable = 1;
+        tsAVX2Enable = 1;
+        tsAVX512Enable = isa;
+        st = taosGetTimestampUs();
+        for (int32_t l = 0; l < loops; ++l) {
+          tColDataCalcSMA[types[t]](&colData, &actual[0], &actual[1], &actual[2], &actualNull);
+        }
+        el = taosGetTimestampUs() - st;
+        printf(", %s: %.2f Mrows/s", isa ? "avx512" : "avx2", (double)numOfRows * loops / TMAX(el, 1));
+
+        ASSERT_EQ(memcmp(expect, actual, sizeof(expect)), 0);
+        ASSERT_EQ(expectNull, actualNull);
+      }
+      printf("\n");
+
+      tColDataDestroy(&colData);
+    }
+  }
+
+  tsSIMDEnable = simd;
+  tsAVX2Enable = avx2;
+  tsAVX512Enable = avx512;
+}
+
+TEST(testCase, colDataCalcSMA_signed_zero_test) {
+  bool hasAVX2 = __builtin_cpu_supports("avx2");
+  bool hasAVX512 = __builtin_cpu_supports("avx512f");
+  char simd = tsSIMDEnable, avx2 = tsAVX2Enable, avx512 = tsAVX512Enable;
+
+  // the max or min is a zero, and both -0.0 and +0.0 are in the column, in different orders
+  const double patterns[][4] = {{-0.0, 0.0, -1.5, -2.5}, {0.0, -0.0, -1.5, -2.5}, {-0.0, 0.0, 1.5, 2.5},
+                                {0.0, -0.0, 1.5, 2.5},   {-0.0, -0.0, 0.0, 0.0}, {0.0, 0.0, -0.0, -0.0}};
+
+  for (int8_t type : {TSDB_DATA_TYPE_FLOAT, TSDB_DATA_TYPE_DOUBLE}) {
+    for (int32_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); ++p) {
+      for (int32_t nullMode = 0; nullMode < 2; ++nullMode) {
+        SColData colData = {0};
+        tColDataInit(&colData, 2, type, 0);
+        for (int32_t i = 0; i < 100; ++i) {
+          SColVal cv = COL_VAL_VALUE(2, type, (SValue){0});
+          double  v = patterns[p][(i * 7 + i / 13) % 4];
+          if (nullMode && i % 5 == 0) {
+            cv.flag = CV_FLAG_NULL;
+          } else if (type == TSDB_DATA_TYPE_FLOAT) {
+            *(float*)&cv.value.val = (float)v;
+          } else {
+            *(double*)&cv.value.val = v;
+          }
+          tColDataAppendValue(&colData, &cv);
+        }
+
+        int64_t expect[3] = {0}, actual[3] = {0};
+        int16_t expectNull = 0, actualNull = 0;
+
+        tsSIMDEnable = 0;
+        tColDataCalcSMA[type](&colData, &expect[0], &expect[1], &expect[2], &expectNull);
+
+        for (int32_t isa = 0; isa < 2; ++isa) {
+          if ((isa == 0 && !hasAVX2) || (isa == 1 && !hasAVX512)) {
+            continue;
+          }
+
+          tsSIMDEnable = 1;
+          tsAVX2Enable = 1;
+          tsAVX512Enable = isa;
+          tColDataCalcSMA[type](&colData, &actual[0], &actual[1], &actual[2], &actualNull);
+          ASSERT_EQ(memcmp(expect, actual, sizeof(expect)), 0) << "type:" << (int32_t)type << " pattern:" << p;
+          ASSERT_EQ(expectNull, actualNull);
+        }
+
+        tColDataDestroy(&colData);
+      }
+    }
+  }
+
+  tsSIMDEnable = simd;
+  tsAVX2Enable = avx2;
+  tsAVX512Enable = avx512;
+}
+
 void check_tm(const STm* tm, int32_t y, int32_t mon, int32_t d, int32_t h, int32_t m, int32_t s, int64_t fsec) {
   ASSERT_EQ(tm->tm.tm_year, y);
   ASSERT_EQ(tm->tm.tm_mon, mon);
@@ -92,6 +92,26 @@ static int32_t mndFindSuperTableTagId(const SStbObj *pStb, const char *tagName,
   return -1;
 }
 
+// an index on a normal column turns on the block bloom filter of it, the primary timestamp column is excluded
+static int32_t mndFindSuperTableBloomColId(const SStbObj *pStb, const char *colName, int8_t *hasIdx) {
+  for (int32_t col = 1; col < pStb->numOfColumns; col++) {
+    if (strcasecmp(pStb->pColumns[col].name, colName) == 0) {
+      if (IS_BLOOM_ON(&pStb->pColumns[col])) {
+        *hasIdx = 1;
+      }
+      return col;
+    }
+  }
+
+  return -1;
+}
+
+static bool mndIsBloomIdx(const SStbObj *pStb, const char *colName) {
+  int8_t hasIdx = 0;
+  return mndFindSuperTableTagId(pStb, colName, &hasIdx) < 0 && mndFindSuperTableBloomColId(pStb, colName, &hasIdx) >= 0;
+}
+
+// the bloom filter flag of a normal column is a part of the column schema, and is sent to vnodes by altering the stb
 int mndSetCreateIdxRedoActions(SMnode *pMnode, STrans *pTrans, SDbObj *pDb, SStbObj *pStb, SIdxObj *pIdx) {
   SSdb   *pSdb = pMnode->pSdb;
   SVgObj *pVgroup = NULL;
@@ -116,7 +136,7 @@ int mndSetCreateIdxRedoActions(SMnode *pMnode, STrans *pTrans, SDbObj *pDb, SStb
     action.epSet = mndGetVgroupEpset(pMnode, pVgroup);
     action.pCont = pReq;
     action.contLen = contLen;
-    action.msgType = TDMT_VND_CREATE_INDEX;
+    action.msgType = mndIsBloomIdx(pStb, pIdx->colName) ? TDMT_VND_ALTER_STB : TDMT_VND_CREATE_INDEX;
     if (mndTransAppendRedoAction(pTrans, &action) != 0) {
       taosMemoryFree(pReq);
       sdbCancelFetch(pSdb, pIter);
@@ -567,8 +587,12 @@ int32_t mndRetrieveTagIdx(SRpcMsg *pReq, SShowObj *pShow, SSDataBlock *pBlock, i
 
     pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
 
+    SStbObj *pStb = mndAcquireStb(pMnode, pIdx->stb);
+    bool     isBloom = (pStb != NULL) && mndIsBloomIdx(pStb, pIdx->colName);
+    mndReleaseStb(pMnode, pStb);
+
     char tag[TSDB_TABLE_FNAME_LEN + VARSTR_HEADER_SIZE] = {0};
-    STR_TO_VARSTR(tag, (char *)"tag_index");
+    STR_TO_VARSTR(tag, isBloom ? (char *)"bloom_index" : (char *)"tag_index");
     colDataSetVal(pColInfo, numOfRows, (const char *)tag, false);
 
     numOfRows++;
@@ -590,6 +614,41 @@ static int32_t mndCheckIndexReq(SCreateTagIndexReq *pReq) {
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t mndSetUpdateBloomStbCommitLogs(SMnode *pMnode, STrans *pTrans, SStbObj *pOld, SStbObj *pNew,
+                                              char *colName, int on) {
+  int8_t  hasIdx = 0;
+  int32_t col = mndFindSuperTableBloomColId(pOld, colName, &hasIdx);
+  if (col < 0) {
+    terrno = TSDB_CODE_MND_TAG_NOT_EXIST;
+    return -1;
+  }
+  if (mndCheckColAndTagModifiable(pMnode, pOld->name, pOld->uid, pOld->pColumns[col].colId) != 0) {
+    return -1;
+  }
+  if (mndAllocStbSchemas(pOld, pNew) != 0) {
+    return -1;
+  }
+  SSchema *pCol = pNew->pColumns + col;
+
+  if (on == 1) {
+    if (hasIdx) {
+      terrno = TSDB_CODE_MND_TAG_INDEX_ALREADY_EXIST;
+      return -1;
+    }
+    pCol->flags |= COL_BLOOM_ON;
+  } else {
+    pCol->flags &= ~COL_BLOOM_ON;
+  }
+  pNew->colVer++;
+
+  SSdbRaw *pCommitRaw = mndStbActionEncode(pNew);
+  if (pCommitRaw == NULL) return -1;
+  if (mndTransAppendCommitlog(pTrans, pCommitRaw) != 0) return -1;
+  if (sdbSetRawStatus(pCommitRaw, SDB_STATUS_READY) != 0) return -1;
+
+  return 0;
+}
+
 static int32_t mndSetUpdateIdxStbCommitLogs(SMnode *pMnode, STrans *pTrans, SStbObj *pOld, SStbObj *pNew, char *tagName,
                                             int on) {
   taosRLockLatch(&pOld->lock);
@@ -603,8 +662,7 @@ static int32_t mndSetUpdateIdxStbCommitLogs(SMnode *pMnode, STrans *pTrans, SStb
   int8_t  hasIdx = 0;
   int32_t tag = mndFindSuperTableTagId(pOld, tagName, &hasIdx);
   if (tag < 0) {
-    terrno = TSDB_CODE_MND_TAG_NOT_EXIST;
-    return -1;
+    return mndSetUpdateBloomStbCommitLogs(pMnode, pTrans, pOld, pNew, tagName, on);
   }
   col_id_t colId = pOld->pTags[tag].colId;
   if (mndCheckColAndTagModifiable(pMnode, pOld->name, pOld->uid, colId) != 0) {
@@ -707,6 +765,35 @@ int8_t mndCheckIndexNameByTagName(SMnode *pMnode, SIdxObj *pIdxObj) {
   mndReleaseDb(pMnode, pDb);
   return exist;
 }
+static int32_t mndAddBloomIndex(SMnode *pMnode, SRpcMsg *pReq, SCreateTagIndexReq *req, SDbObj *pDb, SStbObj *pStb,
+                                SIdxObj *pIdx) {
+  int8_t  hasIdx = 0;
+  int32_t col = mndFindSuperTableBloomColId(pStb, req->colName, &hasIdx);
+  if (col < 0) {
+    terrno = TSDB_CODE_MND_TAG_NOT_EXIST;
+    return -1;
+  }
+  if (hasIdx) {
+    terrno = TSDB_CODE_MND_TAG_INDEX_ALREADY_EXIST;
+    return -1;
+  }
+
+  // the block bloom filter is stored along with the column sma
+  SSchema *pCol = pStb->pColumns + col;
+  if (!IS_BSMA_ON(pCol) || pCol->type == TSDB_DATA_TYPE_BOOL || IS_FLOAT_TYPE(pCol->type) ||
+      pCol->type == TSDB_DATA_TYPE_JSON || pCol->type == TSDB_DATA_TYPE_VARBINARY ||
+      pCol->type == TSDB_DATA_TYPE_GEOMETRY) {
+    terrno = TSDB_CODE_MND_INVALID_STB_OPTION;
+    return -1;
+  }
+
+  if (mndCheckColAndTagModifiable(pMnode, pStb->name, pStb->uid, pCol->colId) != 0) {
+    return -1;
+  }
+
+  return mndAddIndexImpl(pMnode, pReq, pDb, pStb, pIdx);
+}
+
 static int32_t mndAddIndex(SMnode *pMnode, SRpcMsg *pReq, SCreateTagIndexReq *req, SDbObj *pDb, SStbObj *pStb) {
   int32_t code = -1;
   SIdxObj idxObj = {0};
@@ -723,8 +810,7 @@ static int32_t mndAddIndex(SMnode *pMnode, SRpcMsg *pReq, SCreateTagIndexReq *re
   int8_t  hasIdx = 0;
   int32_t tag = mndFindSuperTableTagId(pStb, req->colName, &hasIdx);
   if (tag < 0) {
-    terrno = TSDB_CODE_MND_TAG_NOT_EXIST;
-    return -1;
+    return mndAddBloomIndex(pMnode, pReq, req, pDb, pStb, &idxObj);
   }
   int8_t exist = 0;
   if (tag == 0 && hasIdx == 1) {
@@ -775,7 +861,11 @@ static int32_t mndDropIdx(SMnode *pMnode, SRpcMsg *pReq, SDbObj *pDb, SIdxObj *p
   if (mndSetDropIdxCommitLogs(pMnode, pTrans, pIdx) != 0) goto _OVER;
 
   if (mndSetUpdateIdxStbCommitLogs(pMnode, pTrans, pStb, &newObj, pIdx->colName, 0) != 0) goto _OVER;
-  if (mndSetDropIdxRedoActions(pMnode, pTrans, pDb, &newObj, pIdx) != 0) goto _OVER;
+  if (mndIsBloomIdx(pStb, pIdx->colName)) {
+    if (mndSetCreateIdxRedoActions(pMnode, pTrans, pDb, &newObj, pIdx) != 0) goto _OVER;
+  } else {
+    if (mndSetDropIdxRedoActions(pMnode, pTrans, pDb, &newObj, pIdx) != 0) goto _OVER;
+  }
   if (mndTransPrepare(pMnode, pTrans) != 0) goto _OVER;
 
   code = 0;
@@ -2181,7 +2181,8 @@ static int32_t mndAlterStbAndUpdateTagIdxImp(SMnode *pMnode, SRpcMsg *pReq, SDbO
     mndTransSetRpcRsp(pTrans, pCont, contLen);
   }
 
-  if (pAlter->alterType == TSDB_ALTER_TABLE_DROP_TAG) {
+  if (pAlter->alterType == TSDB_ALTER_TABLE_DROP_TAG || pAlter->alterType == TSDB_ALTER_TABLE_DROP_COLUMN) {
+    // the index on a normal column is the block bloom filter of it
     SIdxObj idxObj = {0};
     SField *pField0 = taosArrayGet(pAlter->pFields, 0);
     bool    exist = false;
@@ -2268,6 +2269,7 @@ static int32_t mndAlterStb(SMnode *pMnode, SRpcMsg *pReq, const SMAlterStbReq *p
     case TSDB_ALTER_TABLE_DROP_COLUMN:
       pField0 = taosArrayGet(pAlter->pFields, 0);
       code = mndDropSuperTableColumn(pMnode, pOld, &stbObj, pField0->name);
+      updateTagIndex = true;
       break;
     case TSDB_ALTER_TABLE_UPDATE_COLUMN_BYTES:
       pField0 = taosArrayGet(pAlter->pFields, 0);
@@ -1703,6 +1703,24 @@ static void setTaskAttrInResBlock(SStreamObj *pStream, SStreamTask *pTask, SSDat
 
   pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
   colDataSetVal(pColInfo, numOfRows, (const char *)vbuf, false);
+
+  // batch statistics since the last hb: blocks in one batch, exec time and time waited in inputQ of one batch
+  char batchBuf[32 + VARSTR_HEADER_SIZE] = {0};
+  char statBuf[32] = {0};
+
+  SStreamExecSummary *pStat = &pe->execStat[STREAM_EXEC_HISTO_BATCH_SIZE];
+  snprintf(statBuf, tListLen(statBuf), "%.1f p99:%.0f max:%d", pStat->avg, pStat->p99, pe->maxBatchBlocks);
+  STR_TO_VARSTR(batchBuf, statBuf);
+  pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+  colDataSetVal(pColInfo, numOfRows, (const char *)batchBuf, false);
+
+  for (int32_t i = STREAM_EXEC_HISTO_EXEC_TIME; i <= STREAM_EXEC_HISTO_QUEUE_TIME; ++i) {
+    pStat = &pe->execStat[i];
+    snprintf(statBuf, tListLen(statBuf), "%.2fms p99:%.0fms", pStat->avg, pStat->p99);
+    STR_TO_VARSTR(batchBuf, statBuf);
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    colDataSetVal(pColInfo, numOfRows, (const char *)batchBuf, false);
+  }
 }
 
 static int32_t getNumOfTasks(SArray *pTaskList) {
@@ -172,6 +172,10 @@ void         tsdbReaderSetCloseFlag(STsdbReader *pReader);
 int64_t      tsdbGetLastTimestamp2(SVnode *pVnode, void *pTableList, int32_t numOfTables, const char *pIdStr);
 void         tsdbSetFilesetDelimited(STsdbReader* pReader);
 void         tsdbReaderSetNotifyCb(STsdbReader* pReader, TsdReaderNotifyCbFn notifyFn, void* param);
+int32_t      tsdbGetCachedWinRes(void *pVnode, uint64_t suid, const uint8_t *pKey, int32_t keyLen, STimeWindow *pRange,
+                                 SArray **pList, int64_t *pSeq);
+int32_t      tsdbPutCachedWinRes(void *pVnode, uint64_t suid, const uint8_t *pKey, int32_t keyLen,
+                                 const SInterval *pInterval, const STimeWindow *pRange, SArray *pList, int64_t seq);
 
 int32_t tsdbReuseCacherowsReader(void *pReader, void *pTableIdList, int32_t numOfTables);
 int32_t tsdbCacherowsReaderOpen(void *pVnode, int32_t type, void *pTableIdList, int32_t numOfTables, int32_t numOfCols,
@@ -205,6 +209,7 @@ typedef struct STqReader {
   int64_t         cachedSchemaSuid;
   int64_t         cachedSchemaUid;
   SSchemaWrapper *pSchemaWrapper;
+  STSchema       *pTSchema;
   SSDataBlock    *pResBlock;
   int64_t         lastTs;
 } STqReader;
@@ -19,6 +19,7 @@
 // #include "../tsdb/tsdbFile2.h"
 // #include "../tsdb/tsdbMerge.h"
 // #include "../tsdb/tsdbSttFileRW.h"
+#include "tbloomfilter.h"
 #include "tsimplehash.h"
 #include "vnodeInt.h"
 
@@ -90,6 +91,10 @@ typedef struct STFileSystem     STFileSystem;
 
 #define TABLE_SAME_SCHEMA(SUID1, UID1, SUID2, UID2) ((SUID1) ? (SUID1) == (SUID2) : (UID1) == (UID2))
 
+// SColData.smaOn carries the COL_BLOOM_ON bit, the block bloom filter is stored along with the column sma
+#define TSDB_COL_SMA_FLAG(FLAGS)    (((FLAGS)&COL_SMA_ON) ? (COL_SMA_ON | ((FLAGS)&COL_BLOOM_ON)) : 0)
+#define TSDB_BLOCK_BLOOM_ERROR_RATE 0.01
+
 #define PAGE_CONTENT_SIZE(PAGE) ((PAGE) - sizeof(TSCKSUM))
 #define LOGIC_TO_FILE_OFFSET(LOFFSET, PAGE) \
   ((LOFFSET) / PAGE_CONTENT_SIZE(PAGE) * (PAGE) + (LOFFSET) % PAGE_CONTENT_SIZE(PAGE))
@@ -206,6 +211,9 @@ int32_t tsdbFidLevel(int32_t fid, STsdbKeepCfg *pKeepCfg, int64_t nowSec);
 int32_t tsdbBuildDeleteSkyline(SArray *aDelData, int32_t sidx, int32_t eidx, SArray *aSkyline);
 int32_t tPutColumnDataAgg(uint8_t *p, SColumnDataAgg *pColAgg);
 int32_t tGetColumnDataAgg(uint8_t *p, SColumnDataAgg *pColAgg);
+bool    tsdbBloomIsTypeSupported(int8_t type);
+int32_t tsdbColDataBuildBloom(SColData *pColData, SBloomFilter **ppBF);
+bool    tsdbBloomNoContain(const SBloomFilter *pBF, int8_t type, int64_t val, const char *pData);
 int32_t tsdbCmprData(uint8_t *pIn, int32_t szIn, int8_t type, int8_t cmprAlg, uint8_t **ppOut, int32_t nOut,
                      int32_t *szOut, uint8_t **ppBuf);
 int32_t tsdbDecmprData(uint8_t *pIn, int32_t szIn, int8_t type, int8_t cmprAlg, uint8_t **ppOut, int32_t szOut,
@@ -395,6 +403,7 @@ struct STsdb {
   SRocksCache          rCache;
   // compact monitor
   struct SCompMonitor *pCompMonitor;
+  struct SWinResCache *pWinResCache;
 };
 
 struct TSDBKEY {
@@ -483,6 +492,7 @@ struct SBlockCol {
   int8_t  type;
   int8_t  smaOn;
   int8_t  flag;      // HAS_NONE|HAS_NULL|HAS_VALUE
+  int8_t  dictOn;    // the offset part saves dictionary codes, and the value part saves the dictionary
   int32_t szOrigin;  // original column value size (only save for variant data type)
   int32_t szBitmap;  // bitmap size, 0 only for flag == HAS_VAL
   int32_t szOffset;  // offset size, 0 only for non-variant-length type
@@ -943,6 +953,12 @@ int32_t tsdbCacheGetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, LRUHan
 int32_t tsdbCacheSetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, uint8_t *pPage);
 int32_t tsdbCacheRelease(SLRUCache *pCache, LRUHandle *h);
 
+// tsdbWinResCache ==============================================================================================
+int32_t tsdbOpenWinResCache(STsdb *pTsdb);
+void    tsdbCloseWinResCache(STsdb *pTsdb);
+void    tsdbWinResCacheInvalidate(STsdb *pTsdb, tb_uid_t suid, TSKEY skey, TSKEY ekey);
+void    tsdbWinResCacheClear(STsdb *pTsdb);
+
 int32_t tsdbCacheDeleteLastrow(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
 int32_t tsdbCacheDeleteLast(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
 int32_t tsdbCacheDelete(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
@@ -989,9 +1005,9 @@ static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
 
   pIter->pRow = &pIter->row;
   if (pIter->pNode->flag == TSDBROW_ROW_FMT) {
-    pIter->row = tsdbRowFromTSRow(pIter->pNode->version, pIter->pNode->pData);
+    pIter->row = tsdbRowFromTSRow(pIter->pNode->version, (SRow *)pIter->pNode->pData);
   } else if (pIter->pNode->flag == TSDBROW_COL_FMT) {
-    pIter->row = tsdbRowFromBlockData(pIter->pNode->pData, pIter->pNode->iRow);
+    pIter->row = tsdbRowFromBlockData((SBlockData *)pIter->pNode->pData, pIter->pNode->iRow);
   } else {
     ASSERT(0);
   }
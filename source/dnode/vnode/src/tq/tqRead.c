@@ -280,6 +280,8 @@ void tqReaderClose(STqReader* pReader) {
     tDeleteSchemaWrapper(pReader->pSchemaWrapper);
   }
 
+  taosMemoryFreeClear(pReader->pTSchema);
+
   if (pReader->pColIdList) {
     taosArrayDestroy(pReader->pColIdList);
   }
@@ -594,7 +596,7 @@ static int32_t doSetVal(SColumnInfoData* pColumnInfoData, int32_t rowIndex, SCol
   int32_t code = TSDB_CODE_SUCCESS;
 
   if (IS_STR_DATA_TYPE(pColVal->type)) {
-    char val[65535 + 2] = {0};
+    char val[65535 + 2];
     if (pColVal->value.pData != NULL) {
       memcpy(varDataVal(val), pColVal->value.pData, pColVal->value.nData);
       varDataSetLen(val, pColVal->value.nData);
@@ -609,6 +611,46 @@ static int32_t doSetVal(SColumnInfoData* pColumnInfoData, int32_t rowIndex, SCol
   return code;
 }
 
+// refresh the cached schema wrapper and the STSchema built from it, if the submit block comes from another table or
+// schema version
+static int32_t tqUpdateCachedSchema(STqReader* pReader, int64_t suid, int64_t uid, int32_t sversion) {
+  if ((suid != 0 && pReader->cachedSchemaSuid == suid) || (suid == 0 && pReader->cachedSchemaUid == uid)) {
+    if (pReader->cachedSchemaVer == sversion && pReader->pSchemaWrapper != NULL && pReader->pTSchema != NULL) {
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
+  tDeleteSchemaWrapper(pReader->pSchemaWrapper);
+
+  pReader->pSchemaWrapper = metaGetTableSchema(pReader->pVnodeMeta, uid, sversion, 1);
+  if (pReader->pSchemaWrapper == NULL) {
+    tqWarn("vgId:%d, cannot found schema wrapper for table: suid:%" PRId64 ", uid:%" PRId64
+           "version %d, possibly dropped table",
+           pReader->pWalReader->pWal->cfg.vgId, suid, uid, sversion);
+    pReader->cachedSchemaSuid = 0;
+    pReader->cachedSchemaUid = 0;
+    terrno = TSDB_CODE_TQ_TABLE_SCHEMA_NOT_FOUND;
+    return -1;
+  }
+
+  taosMemoryFreeClear(pReader->pTSchema);
+  SSchemaWrapper* pWrapper = pReader->pSchemaWrapper;
+  pReader->pTSchema = tBuildTSchema(pWrapper->pSchema, pWrapper->nCols, pWrapper->version);
+  if (pReader->pTSchema == NULL) {
+    pReader->cachedSchemaSuid = 0;
+    pReader->cachedSchemaUid = 0;
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  pReader->cachedSchemaUid = uid;
+  pReader->cachedSchemaSuid = suid;
+  pReader->cachedSchemaVer = sversion;
+
+  ASSERT(pReader->cachedSchemaVer == pReader->pSchemaWrapper->version);
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char* id) {
   tqTrace("tq reader retrieve data block %p, index:%d", pReader->msg.msgStr, pReader->nextBlk);
   SSubmitTbData* pSubmitTbData = taosArrayGet(pReader->submit.aSubmitTbData, pReader->nextBlk++);
@@ -627,31 +669,16 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
   pBlock->info.id.uid = uid;
   pBlock->info.version = pReader->msg.ver;
 
-  if ((suid != 0 && pReader->cachedSchemaSuid != suid) || (suid == 0 && pReader->cachedSchemaUid != uid) ||
-      (pReader->cachedSchemaVer != sversion)) {
-    tDeleteSchemaWrapper(pReader->pSchemaWrapper);
-
-    pReader->pSchemaWrapper = metaGetTableSchema(pReader->pVnodeMeta, uid, sversion, 1);
-    if (pReader->pSchemaWrapper == NULL) {
-      tqWarn("vgId:%d, cannot found schema wrapper for table: suid:%" PRId64 ", uid:%" PRId64
-             "version %d, possibly dropped table",
-             vgId, suid, uid, pReader->cachedSchemaVer);
-      pReader->cachedSchemaSuid = 0;
-      terrno = TSDB_CODE_TQ_TABLE_SCHEMA_NOT_FOUND;
-      return -1;
-    }
-
-    pReader->cachedSchemaUid = uid;
-    pReader->cachedSchemaSuid = suid;
-    pReader->cachedSchemaVer = sversion;
+  if (tqUpdateCachedSchema(pReader, suid, uid, sversion) < 0) {
+    return -1;
+  }
 
-    ASSERT(pReader->cachedSchemaVer == pReader->pSchemaWrapper->version);
-    if (blockDataGetNumOfCols(pBlock) == 0) {
-      int32_t code = buildResSDataBlock(pReader->pResBlock, pReader->pSchemaWrapper, pReader->pColIdList);
-      if (code != TSDB_CODE_SUCCESS) {
-        tqError("vgId:%d failed to build data block, code:%s", vgId, tstrerror(code));
-        return code;
-      }
+  // the schema may have been cached by tqRetrieveTaosxBlock, before the result block is built
+  if (blockDataGetNumOfCols(pBlock) == 0) {
+    int32_t code = buildResSDataBlock(pReader->pResBlock, pReader->pSchemaWrapper, pReader->pColIdList);
+    if (code != TSDB_CODE_SUCCESS) {
+      tqError("vgId:%d failed to build data block, code:%s", vgId, tstrerror(code));
+      return code;
     }
   }
 
@@ -696,13 +723,18 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
       if (pCol->cid < pColData->info.colId) {
         sourceIdx++;
       } else if (pCol->cid == pColData->info.colId) {
-        for (int32_t i = 0; i < pCol->nVal; i++) {
-          tColDataGetValue(pCol, i, &colVal);
-          int32_t code = doSetVal(pColData, i, &colVal);
-          if (code != TSDB_CODE_SUCCESS) {
-            return code;
+        // convert the whole column in a batch, and fall back to per value conversion if the types do not match
+        int32_t code = colDataAssignFromColData(pColData, pCol, 0, numOfRows);
+        if (code == TSDB_CODE_INVALID_PARA) {
+          code = TSDB_CODE_SUCCESS;
+          for (int32_t i = 0; i < pCol->nVal && code == TSDB_CODE_SUCCESS; i++) {
+            tColDataGetValue(pCol, i, &colVal);
+            code = doSetVal(pColData, i, &colVal);
           }
         }
+        if (code != TSDB_CODE_SUCCESS) {
+          return code;
+        }
         sourceIdx++;
         targetIdx++;
       } else {
@@ -711,48 +743,206 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
       }
     }
   } else {
-    SArray*         pRows = pSubmitTbData->aRowP;
-    SSchemaWrapper* pWrapper = pReader->pSchemaWrapper;
-    STSchema*       pTSchema = tBuildTSchema(pWrapper->pSchema, pWrapper->nCols, pWrapper->version);
+    // transpose the rows one column at a time, so that the schema lookup is done once per column instead of per cell
+    SArray*   pRows = pSubmitTbData->aRowP;
+    STSchema* pTSchema = pReader->pTSchema;
+    int32_t   sourceIdx = 0;
+
+    for (int32_t j = 0; j < colActual; j++) {
+      SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, j);
+      while (sourceIdx < pTSchema->numOfCols && pTSchema->columns[sourceIdx].colId < pColData->info.colId) {
+        sourceIdx++;
+      }
 
-    for (int32_t i = 0; i < numOfRows; i++) {
-      SRow*   pRow = taosArrayGetP(pRows, i);
-      int32_t sourceIdx = 0;
-
-      for (int32_t j = 0; j < colActual; j++) {
-        SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, j);
-        while (1) {
-          SColVal colVal;
-          tRowGet(pRow, pTSchema, sourceIdx, &colVal);
-          if (colVal.cid < pColData->info.colId) {
-            //            tqDebug("colIndex:%d column id:%d in row, ignore, the required colId:%d, total cols in
-            //            schema:%d",
-            //                    sourceIdx, colVal.cid, pColData->info.colId, pTSchema->numOfCols);
-            sourceIdx++;
-            continue;
-          } else if (colVal.cid == pColData->info.colId) {
-            int32_t code = doSetVal(pColData, i, &colVal);
-            if (code != TSDB_CODE_SUCCESS) {
-              return code;
-            }
-
-            sourceIdx++;
-            break;
-          } else {
-            colDataSetNULL(pColData, i);
-            break;
-          }
+      if (sourceIdx >= pTSchema->numOfCols || pTSchema->columns[sourceIdx].colId != pColData->info.colId) {
+        colDataSetNNULL(pColData, 0, numOfRows);
+        continue;
+      }
+
+      for (int32_t i = 0; i < numOfRows; i++) {
+        SRow*   pRow = taosArrayGetP(pRows, i);
+        SColVal colVal;
+        tRowGet(pRow, pTSchema, sourceIdx, &colVal);
+        int32_t code = doSetVal(pColData, i, &colVal);
+        if (code != TSDB_CODE_SUCCESS) {
+          return code;
         }
       }
+
+      sourceIdx++;
+    }
+  }
+
+  return 0;
+}
+
+// the value of the column is NONE, i.e. not assigned in the submit request
+static FORCE_INLINE bool tqColDataIsNone(const SColData* pCol, int32_t iVal) {
+  switch (pCol->flag) {
+    case HAS_NONE:
+      return true;
+    case (HAS_NULL | HAS_NONE):
+    case (HAS_VALUE | HAS_NONE):
+      return GET_BIT1(pCol->pBitMap, iVal) == 0;
+    case (HAS_VALUE | HAS_NULL | HAS_NONE):
+      return GET_BIT2(pCol->pBitMap, iVal) == 0;
+    default:
+      return false;
+  }
+}
+
+static void tqGetColDataAssigned(SArray* pCols, const SSchemaWrapper* pSchema, int32_t iRow, char* assigned) {
+  int32_t numOfCols = taosArrayGetSize(pCols);
+  int32_t j = 0;
+  for (int32_t i = 0; i < pSchema->nCols; i++) {
+    col_id_t colId = pSchema->pSchema[i].colId;
+    while (j < numOfCols && ((SColData*)taosArrayGet(pCols, j))->cid < colId) {
+      j++;
+    }
+
+    SColData* pCol = (j < numOfCols) ? taosArrayGet(pCols, j) : NULL;
+    assigned[i] = (pCol != NULL && pCol->cid == colId && !tqColDataIsNone(pCol, iRow));
+  }
+}
+
+static void tqGetRowAssigned(SRow* pRow, STSchema* pTSchema, char* assigned) {
+  if ((pRow->flag & HAS_NONE) == 0) {
+    memset(assigned, 1, pTSchema->numOfCols);
+    return;
+  }
+
+  for (int32_t i = 0; i < pTSchema->numOfCols; i++) {
+    SColVal colVal;
+    tRowGet(pRow, pTSchema, i, &colVal);
+    assigned[i] = !COL_VAL_IS_NONE(&colVal);
+  }
+}
+
+static int32_t tqAppendTaosxBlock(STqReader* pReader, char* assigned, int32_t numOfRows, int64_t uid, SArray* blocks,
+                                  SArray* schemas) {
+  SSDataBlock     block = {0};
+  SSchemaWrapper* pSW = taosMemoryCalloc(1, sizeof(SSchemaWrapper));
+  if (pSW == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  if (tqMaskBlock(pSW, &block, pReader->pSchemaWrapper, assigned) < 0) {
+    blockDataFreeRes(&block);
+    tDeleteSchemaWrapper(pSW);
+    return -1;
+  }
+  tqTrace("vgId:%d, build new block, col %d", pReader->pWalReader->pWal->cfg.vgId,
+          (int32_t)taosArrayGetSize(block.pDataBlock));
+
+  block.info.id.uid = uid;
+  block.info.version = pReader->msg.ver;
+  if (blockDataEnsureCapacity(&block, numOfRows) < 0) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    blockDataFreeRes(&block);
+    tDeleteSchemaWrapper(pSW);
+    return -1;
+  }
+
+  block.info.rows = numOfRows;
+  if (taosArrayPush(blocks, &block) == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    blockDataFreeRes(&block);
+    tDeleteSchemaWrapper(pSW);
+    return -1;
+  }
+
+  if (taosArrayPush(schemas, &pSW) == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    tDeleteSchemaWrapper(pSW);
+    return -1;
+  }
+
+  return 0;
+}
+
+// copy the rows [startRow, startRow + numOfRows) of the submit columns into the block, one column at a time
+static int32_t tqSetTaosxColData(SSDataBlock* pBlock, SArray* pCols, int32_t startRow, int32_t numOfRows) {
+  int32_t numOfCols = taosArrayGetSize(pCols);
+  int32_t colActual = blockDataGetNumOfCols(pBlock);
+  int32_t sourceIdx = 0;
+
+  for (int32_t targetIdx = 0; targetIdx < colActual; targetIdx++) {
+    SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, targetIdx);
+    while (sourceIdx < numOfCols && ((SColData*)taosArrayGet(pCols, sourceIdx))->cid < pColData->info.colId) {
+      sourceIdx++;
+    }
+
+    SColData* pCol = (sourceIdx < numOfCols) ? taosArrayGet(pCols, sourceIdx) : NULL;
+    if (pCol == NULL || pCol->cid != pColData->info.colId) {
+      colDataSetNNULL(pColData, 0, numOfRows);
+      continue;
+    }
+
+    if (pCol->nVal < startRow + numOfRows) {
+      tqError("tqRetrieveTaosxBlock pCol->nVal:%d < numOfRows:%d", pCol->nVal, startRow + numOfRows);
+      terrno = TSDB_CODE_INVALID_PARA;
+      return -1;
+    }
+
+    // convert the segment in a batch, and fall back to per value conversion if the types do not match
+    int32_t code = colDataAssignFromColData(pColData, pCol, startRow, numOfRows);
+    if (code == TSDB_CODE_INVALID_PARA) {
+      code = TSDB_CODE_SUCCESS;
+      for (int32_t i = 0; i < numOfRows && code == TSDB_CODE_SUCCESS; i++) {
+        SColVal colVal;
+        tColDataGetValue(pCol, startRow + i, &colVal);
+        code = doSetVal(pColData, i, &colVal);
+      }
     }
 
-    taosMemoryFreeClear(pTSchema);
+    if (code != TSDB_CODE_SUCCESS) {
+      terrno = code;
+      return -1;
+    }
+    sourceIdx++;
   }
 
   return 0;
 }
 
-// todo refactor:
+// transpose the rows [startRow, startRow + numOfRows) into the block, one column at a time
+static int32_t tqSetTaosxRowData(SSDataBlock* pBlock, SArray* pRows, STSchema* pTSchema, int32_t startRow,
+                                 int32_t numOfRows) {
+  int32_t colActual = blockDataGetNumOfCols(pBlock);
+  int32_t sourceIdx = 0;
+
+  for (int32_t targetIdx = 0; targetIdx < colActual; targetIdx++) {
+    SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, targetIdx);
+    while (sourceIdx < pTSchema->numOfCols && pTSchema->columns[sourceIdx].colId < pColData->info.colId) {
+      sourceIdx++;
+    }
+
+    if (sourceIdx >= pTSchema->numOfCols || pTSchema->columns[sourceIdx].colId != pColData->info.colId) {
+      colDataSetNNULL(pColData, 0, numOfRows);
+      continue;
+    }
+
+    for (int32_t i = 0; i < numOfRows; i++) {
+      SRow*   pRow = taosArrayGetP(pRows, startRow + i);
+      SColVal colVal;
+      tRowGet(pRow, pTSchema, sourceIdx, &colVal);
+      int32_t code = doSetVal(pColData, i, &colVal);
+      if (code != TSDB_CODE_SUCCESS) {
+        terrno = code;
+        return -1;
+      }
+    }
+    sourceIdx++;
+  }
+
+  return 0;
+}
+
+/*
+ * Rows are split into runs with the same set of assigned (not NONE) columns, and each run is converted into a block
+ * of its own column by column. Only the columns that contain NONE values need to be checked row by row.
+ */
 int32_t tqRetrieveTaosxBlock(STqReader* pReader, SArray* blocks, SArray* schemas, SSubmitTbData** pSubmitTbDataRet) {
   tqDebug("tq reader retrieve data block %p, %d", pReader->msg.msgStr, pReader->nextBlk);
 
@@ -767,234 +957,79 @@ int32_t tqRetrieveTaosxBlock(STqReader* pReader, SArray* blocks, SArray* schemas
   int64_t uid = pSubmitTbData->uid;
   pReader->lastBlkUid = uid;
 
-  tDeleteSchemaWrapper(pReader->pSchemaWrapper);
-  pReader->pSchemaWrapper = metaGetTableSchema(pReader->pVnodeMeta, uid, sversion, 1);
-  if (pReader->pSchemaWrapper == NULL) {
-    tqWarn("vgId:%d, cannot found schema wrapper for table: suid:%" PRId64 ", version %d, possibly dropped table",
-           pReader->pWalReader->pWal->cfg.vgId, uid, pReader->cachedSchemaVer);
-    pReader->cachedSchemaSuid = 0;
-    terrno = TSDB_CODE_TQ_TABLE_SCHEMA_NOT_FOUND;
+  if (tqUpdateCachedSchema(pReader, pSubmitTbData->suid, uid, sversion) < 0) {
     return -1;
   }
 
   SSchemaWrapper* pSchemaWrapper = pReader->pSchemaWrapper;
+  bool            colFormat = (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) != 0;
   int32_t         numOfRows = 0;
+  bool            mayHaveNone = false;
 
-  if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
-    SArray*   pCols = pSubmitTbData->aCol;
-    SColData* pCol = taosArrayGet(pCols, 0);
-    numOfRows = pCol->nVal;
-  } else {
-    SArray* pRows = pSubmitTbData->aRowP;
-    numOfRows = taosArrayGetSize(pRows);
-  }
-
-  int32_t curRow = 0;
-  int32_t lastRow = 0;
-  char*   assigned = taosMemoryCalloc(1, pSchemaWrapper->nCols);
-  if (assigned == NULL) return -1;
-
-  // convert and scan one block
-  if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
+  if (colFormat) {
     SArray* pCols = pSubmitTbData->aCol;
-    int32_t numOfCols = taosArrayGetSize(pCols);
-    for (int32_t i = 0; i < numOfRows; i++) {
-      bool buildNew = false;
-
-      for (int32_t j = 0; j < numOfCols; j++) {
-        SColData* pCol = taosArrayGet(pCols, j);
-        SColVal   colVal;
-        tColDataGetValue(pCol, i, &colVal);
-        if (curRow == 0) {
-          assigned[j] = !COL_VAL_IS_NONE(&colVal);
-          buildNew = true;
-        } else {
-          bool currentRowAssigned = !COL_VAL_IS_NONE(&colVal);
-          if (currentRowAssigned != assigned[j]) {
-            assigned[j] = currentRowAssigned;
-            buildNew = true;
-          }
-        }
+    numOfRows = ((SColData*)taosArrayGet(pCols, 0))->nVal;
+    for (int32_t j = 0; j < taosArrayGetSize(pCols); j++) {
+      SColData* pCol = taosArrayGet(pCols, j);
+      if ((pCol->flag & HAS_NONE) && pCol->flag != HAS_NONE) {
+        mayHaveNone = true;
+        break;
       }
-
-      if (buildNew) {
-        if (taosArrayGetSize(blocks) > 0) {
-          SSDataBlock* pLastBlock = taosArrayGetLast(blocks);
-          pLastBlock->info.rows = curRow - lastRow;
-          lastRow = curRow;
-        }
-
-        SSDataBlock     block = {0};
-        SSchemaWrapper* pSW = taosMemoryCalloc(1, sizeof(SSchemaWrapper));
-        if (pSW == NULL) {
-          terrno = TSDB_CODE_OUT_OF_MEMORY;
-          goto FAIL;
-        }
-
-        if (tqMaskBlock(pSW, &block, pSchemaWrapper, assigned) < 0) {
-          blockDataFreeRes(&block);
-          tDeleteSchemaWrapper(pSW);
-          goto FAIL;
-        }
-        tqTrace("vgId:%d, build new block, col %d", pReader->pWalReader->pWal->cfg.vgId,
-                (int32_t)taosArrayGetSize(block.pDataBlock));
-
-        block.info.id.uid = uid;
-        block.info.version = pReader->msg.ver;
-        if (blockDataEnsureCapacity(&block, numOfRows - curRow) < 0) {
-          terrno = TSDB_CODE_OUT_OF_MEMORY;
-          blockDataFreeRes(&block);
-          tDeleteSchemaWrapper(pSW);
-          goto FAIL;
-        }
-        taosArrayPush(blocks, &block);
-        taosArrayPush(schemas, &pSW);
-      }
-
-      SSDataBlock* pBlock = taosArrayGetLast(blocks);
-
-      tqTrace("vgId:%d, taosx scan, block num: %d", pReader->pWalReader->pWal->cfg.vgId,
-              (int32_t)taosArrayGetSize(blocks));
-
-      int32_t targetIdx = 0;
-      int32_t sourceIdx = 0;
-      int32_t colActual = blockDataGetNumOfCols(pBlock);
-      while (targetIdx < colActual) {
-        SColData*        pCol = taosArrayGet(pCols, sourceIdx);
-        SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, targetIdx);
-        SColVal          colVal;
-
-        if (pCol->cid < pColData->info.colId) {
-          sourceIdx++;
-        } else if (pCol->cid == pColData->info.colId) {
-          tColDataGetValue(pCol, i, &colVal);
-
-          if (IS_STR_DATA_TYPE(colVal.type)) {
-            if (colVal.value.pData != NULL) {
-              char val[65535 + 2];
-              memcpy(varDataVal(val), colVal.value.pData, colVal.value.nData);
-              varDataSetLen(val, colVal.value.nData);
-              if (colDataSetVal(pColData, curRow - lastRow, val, !COL_VAL_IS_VALUE(&colVal)) < 0) {
-                goto FAIL;
-              }
-            } else {
-              colDataSetNULL(pColData, curRow - lastRow);
-            }
-          } else {
-            if (colDataSetVal(pColData, curRow - lastRow, (void*)&colVal.value.val, !COL_VAL_IS_VALUE(&colVal)) < 0) {
-              goto FAIL;
-            }
-          }
-          sourceIdx++;
-          targetIdx++;
-        }
-      }
-
-      curRow++;
     }
   } else {
-    SSchemaWrapper* pWrapper = pReader->pSchemaWrapper;
-    STSchema*       pTSchema = tBuildTSchema(pWrapper->pSchema, pWrapper->nCols, pWrapper->version);
-    SArray*         pRows = pSubmitTbData->aRowP;
-
-    for (int32_t i = 0; i < numOfRows; i++) {
-      SRow* pRow = taosArrayGetP(pRows, i);
-      bool  buildNew = false;
+    numOfRows = taosArrayGetSize(pSubmitTbData->aRowP);
+  }
 
-      for (int32_t j = 0; j < pTSchema->numOfCols; j++) {
-        SColVal colVal;
-        tRowGet(pRow, pTSchema, j, &colVal);
-        if (curRow == 0) {
-          assigned[j] = !COL_VAL_IS_NONE(&colVal);
-          buildNew = true;
-        } else {
-          bool currentRowAssigned = !COL_VAL_IS_NONE(&colVal);
-          if (currentRowAssigned != assigned[j]) {
-            assigned[j] = currentRowAssigned;
-            buildNew = true;
-          }
-        }
+  // the assigned columns of the current run, and of the row being checked
+  char* assigned = taosMemoryCalloc(2, pSchemaWrapper->nCols);
+  if (assigned == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+  char* rowAssigned = assigned + pSchemaWrapper->nCols;
+
+  int32_t startRow = 0;
+  while (startRow < numOfRows) {
+    int32_t endRow = startRow + 1;
+    if (colFormat) {
+      tqGetColDataAssigned(pSubmitTbData->aCol, pSchemaWrapper, startRow, assigned);
+      if (!mayHaveNone) {
+        endRow = numOfRows;
       }
-
-      if (buildNew) {
-        if (taosArrayGetSize(blocks) > 0) {
-          SSDataBlock* pLastBlock = taosArrayGetLast(blocks);
-          pLastBlock->info.rows = curRow - lastRow;
-          lastRow = curRow;
-        }
-
-        SSDataBlock     block = {0};
-        SSchemaWrapper* pSW = taosMemoryCalloc(1, sizeof(SSchemaWrapper));
-        if (pSW == NULL) {
-          terrno = TSDB_CODE_OUT_OF_MEMORY;
-          goto FAIL;
-        }
-
-        if (tqMaskBlock(pSW, &block, pSchemaWrapper, assigned) < 0) {
-          blockDataFreeRes(&block);
-          tDeleteSchemaWrapper(pSW);
-          goto FAIL;
+      for (; endRow < numOfRows; endRow++) {
+        tqGetColDataAssigned(pSubmitTbData->aCol, pSchemaWrapper, endRow, rowAssigned);
+        if (memcmp(assigned, rowAssigned, pSchemaWrapper->nCols) != 0) {
+          break;
         }
-        tqTrace("vgId:%d, build new block, col %d", pReader->pWalReader->pWal->cfg.vgId,
-                (int32_t)taosArrayGetSize(block.pDataBlock));
-
-        block.info.id.uid = uid;
-        block.info.version = pReader->msg.ver;
-        if (blockDataEnsureCapacity(&block, numOfRows - curRow) < 0) {
-          terrno = TSDB_CODE_OUT_OF_MEMORY;
-          blockDataFreeRes(&block);
-          tDeleteSchemaWrapper(pSW);
-          goto FAIL;
+      }
+    } else {
+      tqGetRowAssigned(taosArrayGetP(pSubmitTbData->aRowP, startRow), pReader->pTSchema, assigned);
+      for (; endRow < numOfRows; endRow++) {
+        tqGetRowAssigned(taosArrayGetP(pSubmitTbData->aRowP, endRow), pReader->pTSchema, rowAssigned);
+        if (memcmp(assigned, rowAssigned, pSchemaWrapper->nCols) != 0) {
+          break;
         }
-        taosArrayPush(blocks, &block);
-        taosArrayPush(schemas, &pSW);
       }
+    }
 
-      SSDataBlock* pBlock = taosArrayGetLast(blocks);
-
-      tqTrace("vgId:%d, taosx scan, block num: %d", pReader->pWalReader->pWal->cfg.vgId,
-              (int32_t)taosArrayGetSize(blocks));
+    if (tqAppendTaosxBlock(pReader, assigned, endRow - startRow, uid, blocks, schemas) < 0) {
+      goto FAIL;
+    }
 
-      int32_t targetIdx = 0;
-      int32_t sourceIdx = 0;
-      int32_t colActual = blockDataGetNumOfCols(pBlock);
-      while (targetIdx < colActual) {
-        SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, targetIdx);
-        SColVal          colVal;
-        tRowGet(pRow, pTSchema, sourceIdx, &colVal);
+    tqTrace("vgId:%d, taosx scan, block num: %d", pReader->pWalReader->pWal->cfg.vgId,
+            (int32_t)taosArrayGetSize(blocks));
 
-        if (colVal.cid < pColData->info.colId) {
-          sourceIdx++;
-        } else if (colVal.cid == pColData->info.colId) {
-          if (IS_STR_DATA_TYPE(colVal.type)) {
-            if (colVal.value.pData != NULL) {
-              char val[65535 + 2];
-              memcpy(varDataVal(val), colVal.value.pData, colVal.value.nData);
-              varDataSetLen(val, colVal.value.nData);
-              if (colDataSetVal(pColData, curRow - lastRow, val, !COL_VAL_IS_VALUE(&colVal)) < 0) {
-                goto FAIL;
-              }
-            } else {
-              colDataSetNULL(pColData, curRow - lastRow);
-            }
-          } else {
-            if (colDataSetVal(pColData, curRow - lastRow, (void*)&colVal.value.val, !COL_VAL_IS_VALUE(&colVal)) < 0) {
-              goto FAIL;
-            }
-          }
-          sourceIdx++;
-          targetIdx++;
-        }
-      }
-      curRow++;
+    SSDataBlock* pBlock = taosArrayGetLast(blocks);
+    int32_t      code = colFormat
+                            ? tqSetTaosxColData(pBlock, pSubmitTbData->aCol, startRow, endRow - startRow)
+                            : tqSetTaosxRowData(pBlock, pSubmitTbData->aRowP, pReader->pTSchema, startRow, endRow - startRow);
+    if (code < 0) {
+      goto FAIL;
     }
 
-    taosMemoryFreeClear(pTSchema);
+    startRow = endRow;
   }
 
-  SSDataBlock* pLastBlock = taosArrayGetLast(blocks);
-  pLastBlock->info.rows = curRow - lastRow;
-
   taosMemoryFree(assigned);
   return 0;
 
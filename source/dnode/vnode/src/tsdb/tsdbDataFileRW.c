@@ -414,6 +414,9 @@ int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *rec
 
       size += tGetColumnDataAgg(reader->config->bufArr[0] + size, sma);
 
+      // skip the block bloom filter entries
+      if (sma->colId < 0) continue;
+
       code = TARRAY2_APPEND_PTR(columnDataAggArray, sma);
       TSDB_CHECK_CODE(code, lino, _exit);
     }
@@ -427,6 +430,91 @@ _exit:
   return code;
 }
 
+void tsdbBlockBloomClear(SBlockBloom *pBloom) {
+  tBloomFilterDestroy(pBloom->pBF);
+  pBloom->pBF = NULL;
+}
+
+static int32_t tsdbBlockBloomCreate(int16_t cid, const SColumnDataAgg *sma, SBlockBloom *pBloom) {
+  if (sma->sum <= 0 || sma->max <= 0) {
+    return TSDB_CODE_FILE_CORRUPTED;
+  }
+
+  SBloomFilter *pBF = taosMemoryCalloc(1, sizeof(SBloomFilter));
+  if (pBF == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pBF->numUnits = sma->sum;
+  pBF->numBits = pBF->numUnits * 64;
+  pBF->hashFunctions = sma->max;
+  pBF->hashFn1 = HASH_FUNCTION_1;
+  pBF->hashFn2 = HASH_FUNCTION_2;
+  pBF->buffer = taosMemoryCalloc(pBF->numUnits, sizeof(uint64_t));
+  if (pBF->buffer == NULL) {
+    tBloomFilterDestroy(pBF);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pBloom->cid = cid;
+  pBloom->pBF = pBF;
+  return 0;
+}
+
+int32_t tsdbDataFileReadBlockBloom(SDataFileReader *reader, const SBrinRecord *record, TBlockBloomArray *bloomArray) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  TARRAY2_CLEAR(bloomArray, tsdbBlockBloomClear);
+  if (record->smaSize > 0) {
+    code = tRealloc(&reader->config->bufArr[0], record->smaSize);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    code = tsdbReadFile(reader->fd[TSDB_FTYPE_SMA], record->smaOffset, reader->config->bufArr[0], record->smaSize, 0);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    int32_t size = 0;
+    while (size < record->smaSize) {
+      SColumnDataAgg sma[1];
+
+      size += tGetColumnDataAgg(reader->config->bufArr[0] + size, sma);
+      if (sma->colId >= 0) continue;
+
+      int16_t cid = -sma->colId;
+      if (sma->numOfNull == 0) {
+        SBlockBloom bloom = {0};
+        code = tsdbBlockBloomCreate(cid, sma, &bloom);
+        TSDB_CHECK_CODE(code, lino, _exit);
+
+        code = TARRAY2_APPEND(bloomArray, bloom);
+        if (code) {
+          tsdbBlockBloomClear(&bloom);
+        }
+        TSDB_CHECK_CODE(code, lino, _exit);
+      } else {
+        if (TARRAY2_SIZE(bloomArray) == 0 || TARRAY2_LAST(bloomArray).cid != cid) {
+          TSDB_CHECK_CODE(code = TSDB_CODE_FILE_CORRUPTED, lino, _exit);
+        }
+
+        SBloomFilter *pBF = TARRAY2_LAST(bloomArray).pBF;
+        uint64_t     *units = pBF->buffer;
+        uint64_t      iUnit = (uint64_t)(sma->numOfNull - 1) * 3;
+        if (iUnit < pBF->numUnits) units[iUnit] = sma->sum;
+        if (iUnit + 1 < pBF->numUnits) units[iUnit + 1] = sma->max;
+        if (iUnit + 2 < pBF->numUnits) units[iUnit + 2] = sma->min;
+      }
+    }
+    ASSERT(size == record->smaSize);
+  }
+
+_exit:
+  if (code) {
+    TARRAY2_CLEAR(bloomArray, tsdbBlockBloomClear);
+    TSDB_ERROR_LOG(TD_VID(reader->config->tsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 int32_t tsdbDataFileReadTombBlk(SDataFileReader *reader, const TTombBlkArray **tombBlkArray) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -816,6 +904,54 @@ _exit:
   return code;
 }
 
+/*
+ * The bloom filter of a column is stored in the .sma file as SColumnDataAgg entries with the negative column id, so the
+ * readers not aware of it can simply skip them. The first entry keeps the number of units and hash functions of the
+ * filter, and each of the following entries keeps three units in sum, max and min, with the sequence in numOfNull.
+ */
+static int32_t tsdbDataFileWriteBlockBloom(SDataFileWriter *writer, SColData *colData, SBrinRecord *record) {
+  int32_t       code = 0;
+  int32_t       lino = 0;
+  SBloomFilter *pBF = NULL;
+
+  code = tsdbColDataBuildBloom(colData, &pBF);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  if (pBF == NULL || 1 + (pBF->numUnits + 2) / 3 > INT16_MAX) {
+    goto _exit;
+  }
+
+  uint64_t *units = pBF->buffer;
+  int32_t   nEntry = 1 + (int32_t)((pBF->numUnits + 2) / 3);
+  for (int32_t iEntry = 0; iEntry < nEntry; ++iEntry) {
+    SColumnDataAgg sma[1] = {{.colId = -colData->cid, .numOfNull = iEntry}};
+    if (iEntry == 0) {
+      sma->sum = pBF->numUnits;
+      sma->max = pBF->hashFunctions;
+    } else {
+      uint64_t iUnit = (uint64_t)(iEntry - 1) * 3;
+      sma->sum = (iUnit < pBF->numUnits) ? units[iUnit] : 0;
+      sma->max = (iUnit + 1 < pBF->numUnits) ? units[iUnit + 1] : 0;
+      sma->min = (iUnit + 2 < pBF->numUnits) ? units[iUnit + 2] : 0;
+    }
+
+    int32_t size = tPutColumnDataAgg(NULL, sma);
+
+    code = tRealloc(&writer->config->bufArr[0], record->smaSize + size);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    tPutColumnDataAgg(writer->config->bufArr[0] + record->smaSize, sma);
+    record->smaSize += size;
+  }
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(writer->config->tsdb->pVnode), lino, code);
+  }
+  tBloomFilterDestroy(pBF);
+  return code;
+}
+
 static int32_t tsdbDataFileDoWriteBlockData(SDataFileWriter *writer, SBlockData *bData) {
   if (bData->nRow == 0) return 0;
 
@@ -891,6 +1027,15 @@ static int32_t tsdbDataFileDoWriteBlockData(SDataFileWriter *writer, SBlockData
     record->smaSize += size;
   }
 
+  // the block bloom filters follow all the column sma
+  for (int32_t i = 0; i < bData->nColData; ++i) {
+    SColData *colData = bData->aColData + i;
+    if ((colData->smaOn & COL_BLOOM_ON) == 0) continue;
+
+    code = tsdbDataFileWriteBlockBloom(writer, colData, record);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
   if (record->smaSize > 0) {
     code = tsdbWriteFile(writer->fd[TSDB_FTYPE_SMA], record->smaOffset, writer->config->bufArr[0], record->smaSize);
     TSDB_CHECK_CODE(code, lino, _exit);
@@ -29,6 +29,12 @@ typedef TARRAY2(SBlockIdx) TBlockIdxArray;
 typedef TARRAY2(SDataBlk) TDataBlkArray;
 typedef TARRAY2(SColumnDataAgg) TColumnDataAggArray;
 
+typedef struct {
+  int16_t       cid;
+  SBloomFilter *pBF;
+} SBlockBloom;
+typedef TARRAY2(SBlockBloom) TBlockBloomArray;
+
 typedef struct {
   SFDataPtr brinBlkPtr[1];
   SFDataPtr rsrvd[2];
@@ -64,6 +70,8 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
 // .sma
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray);
+int32_t tsdbDataFileReadBlockBloom(SDataFileReader *reader, const SBrinRecord *record, TBlockBloomArray *bloomArray);
+void    tsdbBlockBloomClear(SBlockBloom *pBloom);
 // .tomb
 int32_t tsdbDataFileReadTombBlk(SDataFileReader *reader, const TTombBlkArray **tombBlkArray);
 int32_t tsdbDataFileReadTombBlock(SDataFileReader *reader, const STombBlk *tombBlk, STombBlock *tData);
@@ -136,6 +136,18 @@ int32_t tsdbInsertTableData(STsdb *pTsdb, int64_t version, SSubmitTbData *pSubmi
   }
   if (code) goto _err;
 
+  // rows of the submit data are ordered by timestamp
+  if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
+    SColData *pColData = (SColData *)TARRAY_DATA(pSubmitTbData->aCol);
+    if (pColData->nVal > 0) {
+      TSKEY *aKey = (TSKEY *)pColData->pData;
+      tsdbWinResCacheInvalidate(pTsdb, suid, aKey[0], aKey[pColData->nVal - 1]);
+    }
+  } else if (TARRAY_SIZE(pSubmitTbData->aRowP) > 0) {
+    SRow **aRow = (SRow **)TARRAY_DATA(pSubmitTbData->aRowP);
+    tsdbWinResCacheInvalidate(pTsdb, suid, aRow[0]->ts, aRow[TARRAY_SIZE(pSubmitTbData->aRowP) - 1]->ts);
+  }
+
   // update
   pMemTable->minVer = TMIN(pMemTable->minVer, version);
   pMemTable->maxVer = TMAX(pMemTable->maxVer, version);
@@ -204,6 +216,7 @@ int32_t tsdbDeleteTableData(STsdb *pTsdb, int64_t version, tb_uid_t suid, tb_uid
   // if (eKey >= pTbData->maxKey && sKey <= pTbData->maxKey) {
   tsdbCacheDel(pTsdb, suid, uid, sKey, eKey);
   //}
+  tsdbWinResCacheInvalidate(pTsdb, suid, sKey, eKey);
 
   tsdbTrace("vgId:%d, delete data from table suid:%" PRId64 " uid:%" PRId64 " skey:%" PRId64 " eKey:%" PRId64
             " at version %" PRId64,
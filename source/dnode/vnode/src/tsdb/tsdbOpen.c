@@ -84,6 +84,11 @@ int tsdbOpen(SVnode *pVnode, STsdb **ppTsdb, const char *dir, STsdbKeepCfg *pKee
     goto _err;
   }
 
+  if (tsdbOpenWinResCache(pTsdb) < 0) {
+    tsdbCloseCache(pTsdb);
+    goto _err;
+  }
+
 #ifdef TD_ENTERPRISE
   if (tsdbOpenCompMonitor(pTsdb) < 0) {
     goto _err;
@@ -117,6 +122,7 @@ int tsdbClose(STsdb **pTsdb) {
 
     tsdbCloseFS(&(*pTsdb)->pFS);
     tsdbCloseCache(*pTsdb);
+    tsdbCloseWinResCache(*pTsdb);
 #ifdef TD_ENTERPRISE
     tsdbCloseCompMonitor(*pTsdb);
 #endif
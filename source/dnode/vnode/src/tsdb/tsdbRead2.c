@@ -351,8 +351,29 @@ static int32_t tsdbReleaseReader(STsdbReader* pReader) {
   return code;
 }
 
+static STsdbReader* getCurrentStepReader(STsdbReader* pReader) {
+  if (pReader->type == TIMEWINDOW_RANGE_EXTERNAL) {
+    if (pReader->step == EXTERNAL_ROWS_PREV) {
+      return pReader->innerReader[0];
+    } else if (pReader->step == EXTERNAL_ROWS_NEXT) {
+      return pReader->innerReader[1];
+    }
+  }
+  return pReader;
+}
+
+// the load time of a file block is recorded once, after all of its requested columns are loaded or it is released
+static void recordFileBlockLoadTime(STsdbReader* pReader) {
+  pReader->cost.blockLoadTime += pReader->status.partialLoadTime;
+  pReader->status.partialLoadTime = 0;
+}
+
 void tsdbReleaseDataBlock2(STsdbReader* pReader) {
   SReaderStatus* pStatus = &pReader->status;
+  STsdbReader*   pTReader = getCurrentStepReader(pReader);
+
+  recordFileBlockLoadTime(pTReader);
+  pTReader->status.blockLoadState = BLOCK_LOAD_NONE;
   if (!pStatus->composedDataBlock) {
     tsdbReleaseReader(pReader);
   }
@@ -374,6 +395,69 @@ static int32_t initResBlockInfo(SResultBlockInfo* pResBlockInfo, int64_t capacit
   return terrno;
 }
 
+static void destroyEqCond(void* p) { taosMemoryFreeClear(((SColumnEqCond*)p)->pData); }
+
+static int32_t initEqCondList(SBlockLoadSuppInfo* pSup, const SArray* pEqCondList) {
+  size_t num = taosArrayGetSize(pEqCondList);
+  if (num == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pSup->pEqCondList = taosArrayInit(num, sizeof(SColumnEqCond));
+  if (pSup->pEqCondList == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    SColumnEqCond cond = *(SColumnEqCond*)taosArrayGet(pEqCondList, i);
+    if (cond.pData != NULL) {
+      char* p = taosMemoryMalloc(varDataTLen(cond.pData));
+      if (p == NULL) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+      memcpy(p, cond.pData, varDataTLen(cond.pData));
+      cond.pData = p;
+    }
+    taosArrayPush(pSup->pEqCondList, &cond);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// only the columns with COL_BLOOM_ON in the current schema have block bloom filters worth probing, so the .sma of the
+// blocks is not read at all if none of the equal conditions is on such a column
+static void removeEqCondWithoutBloom(SBlockLoadSuppInfo* pSup, const STSchema* pSchema) {
+  if (pSup->pEqCondList == NULL) {
+    return;
+  }
+
+  int32_t num = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pSup->pEqCondList); ++i) {
+    SColumnEqCond* pCond = taosArrayGet(pSup->pEqCondList, i);
+
+    bool bloomOn = false;
+    for (int32_t j = 0; pSchema != NULL && j < pSchema->numOfCols; ++j) {
+      if (pSchema->columns[j].colId == pCond->colId) {
+        bloomOn = IS_BLOOM_ON(&pSchema->columns[j]);
+        break;
+      }
+    }
+
+    if (bloomOn) {
+      *(SColumnEqCond*)taosArrayGet(pSup->pEqCondList, num++) = *pCond;
+    } else {
+      destroyEqCond(pCond);
+    }
+  }
+
+  if (num == 0) {
+    taosArrayDestroy(pSup->pEqCondList);
+    pSup->pEqCondList = NULL;
+  } else {
+    taosArrayPopTailBatch(pSup->pEqCondList, taosArrayGetSize(pSup->pEqCondList) - num);
+  }
+}
+
 static int32_t tsdbReaderCreate(SVnode* pVnode, SQueryTableDataCond* pCond, void** ppReader, int32_t capacity,
                                 SSDataBlock* pResBlock, const char* idstr) {
   int32_t      code = 0;
@@ -416,6 +500,11 @@ static int32_t tsdbReaderCreate(SVnode* pVnode, SQueryTableDataCond* pCond, void
   pSup->tsColAgg.colId = PRIMARYKEY_TIMESTAMP_COL_ID;
   setColumnIdSlotList(pSup, pCond->colList, pCond->pSlotList, pCond->numOfCols);
 
+  code = initEqCondList(pSup, pCond->pEqCondList);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _end;
+  }
+
   code = tBlockDataCreate(&pReader->status.fileBlockData);
   if (code != TSDB_CODE_SUCCESS) {
     terrno = code;
@@ -882,7 +971,8 @@ static void copyNumericCols(const SColData* pData, SFileBlockDumpInfo* pDumpInfo
   }
 }
 
-static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader) {
+// only the columns marked in pColMask are copied into the result block, if it is not NULL
+static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader, const bool* pColMask) {
   SReaderStatus*      pStatus = &pReader->status;
   SDataBlockIter*     pBlockIter = &pStatus->blockIter;
   SBlockLoadSuppInfo* pSupInfo = &pReader->suppInfo;
@@ -977,7 +1067,9 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader) {
 
   SColumnInfoData* pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
   if (pSupInfo->colId[i] == PRIMARYKEY_TIMESTAMP_COL_ID) {
-    copyPrimaryTsCol(pBlockData, pDumpInfo, pColData, dumpedRows, asc);
+    if (pColMask == NULL || pColMask[i]) {
+      copyPrimaryTsCol(pBlockData, pDumpInfo, pColData, dumpedRows, asc);
+    }
     i += 1;
   }
 
@@ -1011,16 +1103,20 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader) {
       colIndex += 1;
       i += 1;
     } else {  // the specified column does not exist in file block, fill with null data
-      pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
-      colDataSetNNULL(pColData, 0, dumpedRows);
+      if (pColMask == NULL || pColMask[i]) {
+        pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
+        colDataSetNNULL(pColData, 0, dumpedRows);
+      }
       i += 1;
     }
   }
 
   // fill the mis-matched columns with null value
   while (i < numOfOutputCols) {
-    pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
-    colDataSetNNULL(pColData, 0, dumpedRows);
+    if (pColMask == NULL || pColMask[i]) {
+      pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
+      colDataSetNNULL(pColData, 0, dumpedRows);
+    }
     i += 1;
   }
 
@@ -1072,8 +1168,9 @@ static FORCE_INLINE STSchema* getTableSchemaImpl(STsdbReader* pReader, uint64_t
   return pReader->info.pSchema;
 }
 
-static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
-                                   uint64_t uid) {
+// the elapsed time is returned rather than recorded, since the columns of a block may be loaded in more than one call
+static int32_t doLoadFileBlockDataByCols(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                         uint64_t uid, int16_t* cids, int32_t ncid, double* pElapsed) {
   int32_t   code = 0;
   STSchema* pSchema = pReader->info.pSchema;
   int64_t   st = taosGetTimestampUs();
@@ -1088,13 +1185,11 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
     }
   }
 
-  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(pBlockIter);
   SFileBlockDumpInfo* pDumpInfo = &pReader->status.fBlockDumpInfo;
 
   SBrinRecord* pRecord = &pBlockInfo->record;
-  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, &pSup->colId[1],
-                                           pSup->numOfCols - 1);
+  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, cids, ncid);
   if (code != TSDB_CODE_SUCCESS) {
     tsdbError("%p error occurs in loading file block, global index:%d, table index:%d, brange:%" PRId64 "-%" PRId64
               ", rows:%d, code:%s %s",
@@ -1110,12 +1205,23 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
             pReader, pBlockIter->index, pBlockInfo->tbBlockIdx, pRecord->firstKey, pRecord->lastKey, pRecord->numRow,
             pRecord->minVer, pRecord->maxVer, elapsedTime, pReader->idStr);
 
-  pReader->cost.blockLoadTime += elapsedTime;
+  *pElapsed = elapsedTime;
   pDumpInfo->allDumped = false;
 
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                   uint64_t uid) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  double              el = 0;
+
+  int32_t code =
+      doLoadFileBlockDataByCols(pReader, pBlockIter, pBlockData, uid, &pSup->colId[1], pSup->numOfCols - 1, &el);
+  pReader->cost.blockLoadTime += el;
+  return code;
+}
+
 /**
  * This is an two rectangles overlap cases.
  */
@@ -2385,7 +2491,7 @@ static int32_t buildComposedDataBlock(STsdbReader* pReader) {
   if (isCleanFileDataBlock(pReader, pBlockInfo, pBlockScanInfo, keyInBuf) && (pRecord->numRow <= cap)) {
     if (((asc && (pRecord->firstKey < keyInBuf.ts)) || (!asc && (pRecord->lastKey > keyInBuf.ts))) &&
         (pBlockScanInfo->sttKeyInfo.status == STT_FILE_NO_DATA)) {
-      code = copyBlockDataToSDataBlock(pReader);
+      code = copyBlockDataToSDataBlock(pReader, NULL);
       if (code) {
         goto _end;
       }
@@ -4056,6 +4162,13 @@ int32_t tsdbReaderOpen2(void* pVnode, SQueryTableDataCond* pCond, void* pTableLi
     }
   }
 
+  removeEqCondWithoutBloom(&pReader->suppInfo, pReader->info.pSchema);
+  for (int32_t i = 0; i < tListLen(pReader->innerReader); ++i) {
+    if (pReader->innerReader[i] != NULL) {
+      removeEqCondWithoutBloom(&pReader->innerReader[i]->suppInfo, pReader->info.pSchema);
+    }
+  }
+
   STsdbReader* p = (pReader->innerReader[0] != NULL) ? pReader->innerReader[0] : pReader;
   pReader->status.pTableMap =
       createDataBlockScanInfo(p, &pReader->blockInfoBuf, pTableList, &pReader->status.uidList, numOfTables);
@@ -4111,6 +4224,8 @@ void tsdbReaderClose2(STsdbReader* pReader) {
 
   SBlockLoadSuppInfo* pSupInfo = &pReader->suppInfo;
   TARRAY2_DESTROY(&pSupInfo->colAggArray, NULL);
+  TARRAY2_DESTROY(&pSupInfo->bloomArray, tsdbBlockBloomClear);
+  taosArrayDestroyEx(pSupInfo->pEqCondList, destroyEqCond);
   for (int32_t i = 0; i < pSupInfo->numOfCols; ++i) {
     if (pSupInfo->buildBuf[i] != NULL) {
       taosMemoryFreeClear(pSupInfo->buildBuf[i]);
@@ -4122,6 +4237,7 @@ void tsdbReaderClose2(STsdbReader* pReader) {
   }
 
   taosMemoryFree(pSupInfo->colId);
+  taosMemoryFree(pSupInfo->colLoaded);
   tBlockDataDestroy(&pReader->status.fileBlockData);
   cleanupDataBlockIterator(&pReader->status.blockIter);
 
@@ -4161,12 +4277,13 @@ void tsdbReaderClose2(STsdbReader* pReader) {
       ", fileBlocks-load-time:%.2f ms, "
       "build in-memory-block-time:%.2f ms, sttBlocks:%" PRId64 ", sttBlocks-time:%.2f ms, sttStatisBlock:%" PRId64
       ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64
-      ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
+      ", composed-blocks-time:%.2fms, bloom-filter-blocks:%" PRId64
+      ", STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
       "ms, initSttBlockReader:%.2fms, %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
       pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
       pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks,
-      pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
+      pCost->buildComposedBlockTime, pCost->bloomFilterBlocks, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
       pCost->createSkylineIterTime, pCost->initSttBlockReader, pReader->idStr);
 
   taosMemoryFree(pReader->idStr);
@@ -4678,10 +4795,70 @@ int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock,
   return code;
 }
 
-static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
+// all equal conditions are AND-ed, so the block can be skipped if any value is definitely not in the block
+static int32_t checkBlockBloomFilter(STsdbReader* pReader, SFileDataBlockInfo* pBlockInfo, bool* mayMatch) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+
+  *mayMatch = true;
+  if (pSup->pEqCondList == NULL || pBlockInfo->record.smaSize <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = tsdbDataFileReadBlockBloom(pReader->pFileReader, &pBlockInfo->record, &pSup->bloomArray);
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%p failed to load block bloom filter, uid:%" PRIu64 ", code:%s, %s", pReader, pBlockInfo->uid,
+              tstrerror(code), pReader->idStr);
+    return code;
+  }
+
+  size_t num = taosArrayGetSize(pSup->pEqCondList);
+  for (int32_t i = 0; i < num && *mayMatch; ++i) {
+    SColumnEqCond* pCond = taosArrayGet(pSup->pEqCondList, i);
+
+    SBlockBloom* pBloom = NULL;
+    TARRAY2_FOREACH_PTR(&pSup->bloomArray, pBloom) {
+      if (pBloom->cid == pCond->colId) {
+        *mayMatch = !tsdbBloomNoContain(pBloom->pBF, pCond->type, pCond->val, pCond->pData);
+        break;
+      }
+    }
+  }
+
+  TARRAY2_CLEAR(&pSup->bloomArray, tsdbBlockBloomClear);
+  return TSDB_CODE_SUCCESS;
+}
+
+// mark the columns to load in this round, return the number of them besides the primary timestamp column
+static int32_t prepareLoadColumns(SBlockLoadSuppInfo* pSup, const SArray* pIdList, bool loadRest) {
+  int32_t ncid = 0;
+  for (int32_t i = 0; i < pSup->numOfCols; ++i) {
+    if (pSup->colId[i] == PRIMARYKEY_TIMESTAMP_COL_ID) {
+      pSup->colLoaded[i] = !loadRest;
+      continue;
+    }
+
+    bool load = true;
+    if (loadRest) {
+      load = !pSup->colLoaded[i];
+    } else if (pIdList != NULL) {
+      load = (taosArraySearch(pIdList, &pSup->colId[i], compareInt16Val, TD_EQ) != NULL);
+    }
+
+    pSup->colLoaded[i] = load;
+    if (load) {
+      pSup->loadColId[ncid++] = pSup->colId[i];
+    }
+  }
+
+  return ncid;
+}
+
+static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader, const SArray* pIdList) {
   SReaderStatus*      pStatus = &pReader->status;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
   int32_t             code = TSDB_CODE_SUCCESS;
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(&pStatus->blockIter);
+  SSDataBlock*        pResBlock = pReader->resBlockInfo.pResBlock;
 
   if (pReader->code != TSDB_CODE_SUCCESS) {
     return NULL;
@@ -4692,39 +4869,104 @@ static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
     return NULL;
   }
 
-  code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
+  EBlockLoadState state = pStatus->blockLoadState;
+  if (state == BLOCK_LOAD_COMPLETE) {
+    pStatus->blockLoadState = BLOCK_LOAD_NONE;
+    return pResBlock;
+  }
+
+  if (state == BLOCK_LOAD_NONE) {
+    bool mayMatch = true;
+    code = checkBlockBloomFilter(pReader, pBlockInfo, &mayMatch);
+    if (code != TSDB_CODE_SUCCESS) {
+      terrno = code;
+      return NULL;
+    }
+
+    if (!mayMatch) {
+      int64_t ts = ASCENDING_TRAVERSE(pReader->info.order) ? pBlockInfo->record.lastKey : pBlockInfo->record.firstKey;
+
+      setBlockAllDumped(&pStatus->fBlockDumpInfo, ts, pReader->info.order);
+      pResBlock->info.rows = 0;
+      pReader->cost.bloomFilterBlocks += 1;
+      pStatus->blockLoadState = (pIdList != NULL) ? BLOCK_LOAD_COMPLETE : BLOCK_LOAD_NONE;
+      return pResBlock;
+    }
+  }
+
+  // load the requested columns only, and keep the dump position for loading the rest columns of the same block
+  bool*   pColMask = NULL;
+  int32_t ncid = pSup->numOfCols - 1;
+  if (pIdList != NULL || state == BLOCK_LOAD_PARTIAL) {
+    ncid = prepareLoadColumns(pSup, pIdList, state == BLOCK_LOAD_PARTIAL);
+    pColMask = pSup->colLoaded;
+  }
+
+  bool               partial = (pIdList != NULL && ncid < pSup->numOfCols - 1);
+  SFileBlockDumpInfo dumpInfo = pStatus->fBlockDumpInfo;
+  if (state == BLOCK_LOAD_PARTIAL) {  // dump the rest columns from the same start position
+    pStatus->fBlockDumpInfo = pStatus->partialDumpInfo;
+  }
+
+  int16_t* cids = (pColMask != NULL) ? pSup->loadColId : &pSup->colId[1];
+  double   el = 0;
+  code = doLoadFileBlockDataByCols(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid, cids,
+                                   ncid, &el);
+  pStatus->partialLoadTime += el;
   if (code != TSDB_CODE_SUCCESS) {
     tBlockDataReset(&pStatus->fileBlockData);
+    pStatus->blockLoadState = BLOCK_LOAD_NONE;
+    recordFileBlockLoadTime(pReader);
     terrno = code;
     return NULL;
   }
 
-  code = copyBlockDataToSDataBlock(pReader);
+  code = copyBlockDataToSDataBlock(pReader, pColMask);
   if (code != TSDB_CODE_SUCCESS) {
     tBlockDataReset(&pStatus->fileBlockData);
+    pStatus->blockLoadState = BLOCK_LOAD_NONE;
+    recordFileBlockLoadTime(pReader);
     terrno = code;
     return NULL;
   }
 
-  return pReader->resBlockInfo.pResBlock;
+  if (partial) {
+    pStatus->partialDumpInfo = dumpInfo;
+    pStatus->blockLoadState = BLOCK_LOAD_PARTIAL;
+  } else {
+    pStatus->blockLoadState = (pIdList != NULL) ? BLOCK_LOAD_COMPLETE : BLOCK_LOAD_NONE;
+    recordFileBlockLoadTime(pReader);
+  }
+
+  return pResBlock;
 }
 
+/**
+ * If pIdList is not NULL, only the columns in it are loaded for the file block, and the caller should either retrieve
+ * the block again with NULL to get the rest columns, or release the block. The read lock is kept until then.
+ */
 SSDataBlock* tsdbRetrieveDataBlock2(STsdbReader* pReader, SArray* pIdList) {
-  STsdbReader* pTReader = pReader;
-  if (pReader->type == TIMEWINDOW_RANGE_EXTERNAL) {
-    if (pReader->step == EXTERNAL_ROWS_PREV) {
-      pTReader = pReader->innerReader[0];
-    } else if (pReader->step == EXTERNAL_ROWS_NEXT) {
-      pTReader = pReader->innerReader[1];
-    }
-  }
+  STsdbReader* pTReader = getCurrentStepReader(pReader);
 
   SReaderStatus* pStatus = &pTReader->status;
   if (pStatus->composedDataBlock || pReader->info.execMode == READER_EXEC_ROWS) {
     return pTReader->resBlockInfo.pResBlock;
   }
 
-  SSDataBlock* ret = doRetrieveDataBlock(pTReader);
+  if (pIdList != NULL && pTReader->suppInfo.colLoaded == NULL) {
+    SBlockLoadSuppInfo* pSup = &pTReader->suppInfo;
+    pSup->colLoaded = taosMemoryCalloc(pSup->numOfCols, sizeof(bool) + sizeof(int16_t));
+    if (pSup->colLoaded == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return NULL;
+    }
+    pSup->loadColId = (int16_t*)((char*)pSup->colLoaded + sizeof(bool) * pSup->numOfCols);
+  }
+
+  SSDataBlock* ret = doRetrieveDataBlock(pTReader, pIdList);
+  if (ret != NULL && pStatus->blockLoadState != BLOCK_LOAD_NONE) {
+    return ret;
+  }
 
   qTrace("tsdb/read-retrieve: %p, unlock read mutex", pReader);
   tsdbReleaseReader(pReader);
@@ -4760,6 +5002,8 @@ int32_t tsdbReaderReset2(STsdbReader* pReader, SQueryTableDataCond* pCond) {
   pReader->info.window = updateQueryTimeWindow(pReader->pTsdb, &pCond->twindows);
   pStatus->loadFromFile = true;
   pStatus->pTableIter = NULL;
+  pStatus->blockLoadState = BLOCK_LOAD_NONE;
+  recordFileBlockLoadTime(pReader);
 
   // allocate buffer in order to load data blocks from file
   memset(&pReader->suppInfo.tsColAgg, 0, sizeof(SColumnDataAgg));
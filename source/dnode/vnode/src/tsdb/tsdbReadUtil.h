@@ -117,6 +117,7 @@ typedef struct SReadCostSummary {
   SSttBlockLoadCostInfo sttCost;
   int64_t composedBlocks;
   double  buildComposedBlockTime;
+  int64_t bloomFilterBlocks;
   double  createScanInfoList;
   double  createSkylineIterTime;
   double  initSttBlockReader;
@@ -153,6 +154,10 @@ typedef struct SBlockLoadSuppInfo {
   int32_t             numOfCols;
   char**              buildBuf;  // build string tmp buffer, todo remove it later after all string format being updated.
   bool                smaValid;  // the sma on all queried columns are activated
+  SArray*             pEqCondList;  // SColumnEqCond, probed against the block bloom filters
+  TBlockBloomArray    bloomArray;
+  bool*               colLoaded;  // the columns loaded for the current file block, when loaded by column list
+  int16_t*            loadColId;
 } SBlockLoadSuppInfo;
 
 // each blocks in stt file not overlaps with in-memory/data-file/tomb-files, and not overlap with any other blocks in stt-file
@@ -196,6 +201,12 @@ typedef struct SFileBlockDumpInfo {
   bool    allDumped;
 } SFileBlockDumpInfo;
 
+typedef enum {
+  BLOCK_LOAD_NONE = 0,
+  BLOCK_LOAD_PARTIAL,   // only the requested columns of the file block are loaded
+  BLOCK_LOAD_COMPLETE,  // the whole block is loaded when requesting part of the columns
+} EBlockLoadState;
+
 typedef struct SReaderStatus {
   bool                  suspendInvoked;
   bool                  loadFromFile;       // check file stage
@@ -204,6 +215,9 @@ typedef struct SReaderStatus {
   STableBlockScanInfo** pTableIter;         // table iterator used in building in-memory buffer data blocks.
   STableUidList         uidList;            // check tables in uid order, to avoid the repeatly load of blocks in STT.
   SFileBlockDumpInfo    fBlockDumpInfo;
+  EBlockLoadState       blockLoadState;
+  SFileBlockDumpInfo    partialDumpInfo;  // dump position before the partial load of current block
+  double                partialLoadTime;  // load time of the columns already loaded of current block
   STFileSet*            pCurrentFileset;  // current opened file set
   SBlockData            fileBlockData;
   SFilesetIter          fileIter;
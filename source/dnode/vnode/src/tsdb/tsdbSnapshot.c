@@ -1115,6 +1115,7 @@ int32_t tsdbSnapWriterClose(STsdbSnapWriter** writer, int8_t rollback) {
     writer[0]->tsdb->pFS->fsstate = TSDB_FS_STATE_NORMAL;
 
     taosThreadMutexUnlock(&writer[0]->tsdb->mutex);
+    tsdbWinResCacheClear(writer[0]->tsdb);
   }
 
   tsdbIterMergerClose(&writer[0]->ctx->tombIterMerger);
@@ -523,6 +523,7 @@ int32_t tsdbSnapRAWWriterClose(STsdbSnapRAWWriter** writer, int8_t rollback) {
     writer[0]->tsdb->pFS->fsstate = TSDB_FS_STATE_NORMAL;
 
     taosThreadMutexUnlock(&writer[0]->tsdb->mutex);
+    tsdbWinResCacheClear(writer[0]->tsdb);
   }
 
   TARRAY2_DESTROY(writer[0]->fopArr, NULL);
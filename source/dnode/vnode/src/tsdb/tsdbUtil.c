@@ -15,6 +15,7 @@
 
 #include "tdataformat.h"
 #include "tsdb.h"
+#include "vnd.h"
 
 // SMapData =======================================================================
 void tMapDataReset(SMapData *pMapData) {
@@ -370,6 +371,9 @@ int32_t tGetSttBlk(uint8_t *p, void *ph) {
 }
 
 // SBlockCol ======================================================
+// the dictionary encoded mark is saved with the column flag
+#define BLOCK_COL_DICT_ON ((int8_t)0x40)
+
 int32_t tPutBlockCol(uint8_t *p, void *ph) {
   int32_t    n = 0;
   SBlockCol *pBlockCol = (SBlockCol *)ph;
@@ -379,7 +383,7 @@ int32_t tPutBlockCol(uint8_t *p, void *ph) {
   n += tPutI16v(p ? p + n : p, pBlockCol->cid);
   n += tPutI8(p ? p + n : p, pBlockCol->type);
   n += tPutI8(p ? p + n : p, pBlockCol->smaOn);
-  n += tPutI8(p ? p + n : p, pBlockCol->flag);
+  n += tPutI8(p ? p + n : p, pBlockCol->dictOn ? (pBlockCol->flag | BLOCK_COL_DICT_ON) : pBlockCol->flag);
   n += tPutI32v(p ? p + n : p, pBlockCol->szOrigin);
 
   if (pBlockCol->flag != HAS_NULL) {
@@ -412,6 +416,9 @@ int32_t tGetBlockCol(uint8_t *p, void *ph) {
   n += tGetI8(p + n, &pBlockCol->flag);
   n += tGetI32v(p + n, &pBlockCol->szOrigin);
 
+  pBlockCol->dictOn = (pBlockCol->flag & BLOCK_COL_DICT_ON) ? 1 : 0;
+  pBlockCol->flag &= ~BLOCK_COL_DICT_ON;
+
   ASSERT(pBlockCol->flag && (pBlockCol->flag != HAS_NONE));
 
   pBlockCol->szBitmap = 0;
@@ -1127,7 +1134,7 @@ int32_t tBlockDataInit(SBlockData *pBlockData, TABLEID *pId, STSchema *pTSchema,
       }
 
       tColDataInit(&pBlockData->aColData[iCid], pTColumn->colId, pTColumn->type,
-                   (pTColumn->flags & COL_SMA_ON) ? 1 : 0);
+                   TSDB_COL_SMA_FLAG(pTColumn->flags));
 
       iColumn++;
       pTColumn = (iColumn < pTSchema->numOfCols) ? &pTSchema->columns[iColumn] : NULL;
@@ -1139,7 +1146,7 @@ int32_t tBlockDataInit(SBlockData *pBlockData, TABLEID *pId, STSchema *pTSchema,
     for (int32_t iColData = 0; iColData < pBlockData->nColData; iColData++) {
       STColumn *pTColumn = &pTSchema->columns[iColData + 1];
       tColDataInit(&pBlockData->aColData[iColData], pTColumn->colId, pTColumn->type,
-                   (pTColumn->flags & COL_SMA_ON) ? 1 : 0);
+                   TSDB_COL_SMA_FLAG(pTColumn->flags));
     }
   }
 
@@ -1310,6 +1317,142 @@ void tBlockDataGetColData(SBlockData *pBlockData, int16_t cid, SColData **ppColD
   *ppColData = NULL;
 }
 
+// the columns of a wide block are compressed on the vnode-compress workers, each task handles a range of columns
+#define TSDB_CMPR_TASK_MIN_COLS  4
+#define TSDB_CMPR_MAX_TASKS      8
+#define TSDB_CMPR_PARALLEL_NROWS 1024
+
+typedef struct {
+  SBlockData *pBlockData;
+  int8_t      cmprAlg;
+  int32_t     startCol;
+  int32_t     endCol;
+  SBlockCol  *aBlockCol;
+  uint8_t    *pOut;
+  int32_t     nOut;
+  uint8_t    *pBuf;
+  bool        done;
+  int32_t     code;
+} SColCmprTask;
+
+static int32_t tsdbCmprColDataTask(void *arg) {
+  SColCmprTask *pTask = (SColCmprTask *)arg;
+
+  pTask->nOut = 0;
+  pTask->code = 0;
+  for (int32_t iColData = pTask->startCol; iColData < pTask->endCol; iColData++) {
+    SColData  *pColData = tBlockDataGetColDataByIdx(pTask->pBlockData, iColData);
+    SBlockCol *pBlockCol = &pTask->aBlockCol[iColData];
+
+    ASSERT(pColData->flag);
+
+    *pBlockCol = (SBlockCol){.cid = pColData->cid,
+                             .type = pColData->type,
+                             .smaOn = pColData->smaOn,
+                             .flag = pColData->flag,
+                             .szOrigin = pColData->nData};
+
+    if (pColData->flag == HAS_NONE || pColData->flag == HAS_NULL) continue;
+
+    pTask->code = tsdbCmprColData(pColData, pTask->cmprAlg, pBlockCol, &pTask->pOut, pTask->nOut, &pTask->pBuf);
+    if (pTask->code) break;
+
+    pBlockCol->offset = pTask->nOut;
+    pTask->nOut = pTask->nOut + pBlockCol->szBitmap + pBlockCol->szOffset + pBlockCol->szValue;
+  }
+
+  pTask->done = true;
+  return pTask->code;
+}
+
+static bool tsdbCmprColDataInParallel(SBlockData *pBlockData, int8_t cmprAlg) {
+  return cmprAlg != NO_COMPRESSION && vnodeAsyncHandle[2] != NULL &&
+         pBlockData->nColData >= TSDB_CMPR_TASK_MIN_COLS * 2 && pBlockData->nRow >= TSDB_CMPR_PARALLEL_NROWS;
+}
+
+/**
+ * Compress the column ranges of the block concurrently, one range is compressed by the current thread. The results
+ * are then appended in column order, so the output is the same as that of compressing the columns one by one.
+ */
+static int32_t tsdbCmprColDataParallel(SBlockData *pBlockData, int8_t cmprAlg, SDiskDataHdr *pHdr, uint8_t *aBuf[],
+                                       int32_t aBufN[]) {
+  int32_t      code = 0;
+  int32_t      nTask = TMIN(pBlockData->nColData / TSDB_CMPR_TASK_MIN_COLS, TSDB_CMPR_MAX_TASKS);
+  SColCmprTask aTask[TSDB_CMPR_MAX_TASKS] = {0};
+  int64_t      aTaskId[TSDB_CMPR_MAX_TASKS] = {0};
+
+  SBlockCol *aBlockCol = taosMemoryMalloc(sizeof(SBlockCol) * pBlockData->nColData);
+  if (aBlockCol == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < nTask; i++) {
+    aTask[i] = (SColCmprTask){.pBlockData = pBlockData,
+                              .cmprAlg = cmprAlg,
+                              .startCol = (int32_t)((int64_t)pBlockData->nColData * i / nTask),
+                              .endCol = (int32_t)((int64_t)pBlockData->nColData * (i + 1) / nTask),
+                              .aBlockCol = aBlockCol};
+  }
+
+  for (int32_t i = 1; i < nTask; i++) {
+    if (vnodeAsync(vnodeAsyncHandle[2], EVA_PRIORITY_HIGH, tsdbCmprColDataTask, NULL, &aTask[i], &aTaskId[i]) != 0) {
+      aTaskId[i] = 0;
+    }
+  }
+
+  tsdbCmprColDataTask(&aTask[0]);
+
+  for (int32_t i = 1; i < nTask; i++) {
+    if (aTaskId[i] > 0) {
+      vnodeAWait(vnodeAsyncHandle[2], aTaskId[i]);
+    }
+
+    // not scheduled or cancelled
+    if (!aTask[i].done) {
+      tsdbCmprColDataTask(&aTask[i]);
+    }
+  }
+
+  for (int32_t i = 0; i < nTask; i++) {
+    code = aTask[i].code;
+    if (code) goto _exit;
+  }
+
+  // merge in column order
+  for (int32_t i = 0; i < nTask; i++) {
+    SColCmprTask *pTask = &aTask[i];
+
+    if (pTask->nOut > 0) {
+      code = tRealloc(&aBuf[0], aBufN[0] + pTask->nOut);
+      if (code) goto _exit;
+      memcpy(aBuf[0] + aBufN[0], pTask->pOut, pTask->nOut);
+    }
+
+    for (int32_t iColData = pTask->startCol; iColData < pTask->endCol; iColData++) {
+      SBlockCol *pBlockCol = &aBlockCol[iColData];
+
+      if (pBlockCol->flag == HAS_NONE) continue;
+      if (pBlockCol->flag != HAS_NULL) {
+        pBlockCol->offset += aBufN[0];
+      }
+
+      code = tRealloc(&aBuf[1], pHdr->szBlkCol + tPutBlockCol(NULL, pBlockCol));
+      if (code) goto _exit;
+      pHdr->szBlkCol += tPutBlockCol(aBuf[1] + pHdr->szBlkCol, pBlockCol);
+    }
+
+    aBufN[0] += pTask->nOut;
+  }
+
+_exit:
+  for (int32_t i = 0; i < nTask; i++) {
+    tFree(aTask[i].pOut);
+    tFree(aTask[i].pBuf);
+  }
+  taosMemoryFree(aBlockCol);
+  return code;
+}
+
 int32_t tCmprBlockData(SBlockData *pBlockData, int8_t cmprAlg, uint8_t **ppOut, int32_t *szOut, uint8_t *aBuf[],
                        int32_t aBufN[]) {
   int32_t code = 0;
@@ -1324,30 +1467,35 @@ int32_t tCmprBlockData(SBlockData *pBlockData, int8_t cmprAlg, uint8_t **ppOut,
   // encode =================
   // columns AND SBlockCol
   aBufN[0] = 0;
-  for (int32_t iColData = 0; iColData < pBlockData->nColData; iColData++) {
-    SColData *pColData = tBlockDataGetColDataByIdx(pBlockData, iColData);
+  if (tsdbCmprColDataInParallel(pBlockData, cmprAlg)) {
+    code = tsdbCmprColDataParallel(pBlockData, cmprAlg, &hdr, aBuf, aBufN);
+    if (code) goto _exit;
+  } else {
+    for (int32_t iColData = 0; iColData < pBlockData->nColData; iColData++) {
+      SColData *pColData = tBlockDataGetColDataByIdx(pBlockData, iColData);
 
-    ASSERT(pColData->flag);
+      ASSERT(pColData->flag);
 
-    if (pColData->flag == HAS_NONE) continue;
+      if (pColData->flag == HAS_NONE) continue;
 
-    SBlockCol blockCol = {.cid = pColData->cid,
-                          .type = pColData->type,
-                          .smaOn = pColData->smaOn,
-                          .flag = pColData->flag,
-                          .szOrigin = pColData->nData};
+      SBlockCol blockCol = {.cid = pColData->cid,
+                            .type = pColData->type,
+                            .smaOn = pColData->smaOn,
+                            .flag = pColData->flag,
+                            .szOrigin = pColData->nData};
 
-    if (pColData->flag != HAS_NULL) {
-      code = tsdbCmprColData(pColData, cmprAlg, &blockCol, &aBuf[0], aBufN[0], &aBuf[2]);
-      if (code) goto _exit;
+      if (pColData->flag != HAS_NULL) {
+        code = tsdbCmprColData(pColData, cmprAlg, &blockCol, &aBuf[0], aBufN[0], &aBuf[2]);
+        if (code) goto _exit;
 
-      blockCol.offset = aBufN[0];
-      aBufN[0] = aBufN[0] + blockCol.szBitmap + blockCol.szOffset + blockCol.szValue;
-    }
+        blockCol.offset = aBufN[0];
+        aBufN[0] = aBufN[0] + blockCol.szBitmap + blockCol.szOffset + blockCol.szValue;
+      }
 
-    code = tRealloc(&aBuf[1], hdr.szBlkCol + tPutBlockCol(NULL, &blockCol));
-    if (code) goto _exit;
-    hdr.szBlkCol += tPutBlockCol(aBuf[1] + hdr.szBlkCol, &blockCol);
+      code = tRealloc(&aBuf[1], hdr.szBlkCol + tPutBlockCol(NULL, &blockCol));
+      if (code) goto _exit;
+      hdr.szBlkCol += tPutBlockCol(aBuf[1] + hdr.szBlkCol, &blockCol);
+    }
   }
 
   // SBlockCol
@@ -1538,6 +1686,90 @@ int32_t tGetColumnDataAgg(uint8_t *p, SColumnDataAgg *pColAgg) {
   return n;
 }
 
+// BLOOM ==============================
+bool tsdbBloomIsTypeSupported(int8_t type) {
+  return IS_INTEGER_TYPE(type) || type == TSDB_DATA_TYPE_TIMESTAMP || type == TSDB_DATA_TYPE_VARCHAR ||
+         type == TSDB_DATA_TYPE_NCHAR;
+}
+
+// integer values are hashed as int64 so that the constant of a query condition can be probed regardless of its width
+static FORCE_INLINE void tsdbBloomGetKey(int8_t type, SValue *pValue, int64_t *iKey, const char **pKey,
+                                         uint32_t *len) {
+  if (IS_VAR_DATA_TYPE(type)) {
+    *pKey = (const char *)pValue->pData;
+    *len = pValue->nData;
+  } else {
+    GET_TYPED_DATA(*iKey, int64_t, type, &pValue->val);
+    *pKey = (const char *)iKey;
+    *len = sizeof(int64_t);
+  }
+}
+
+static int64_t tsdbColDataBloomRuns(SColData *pColData, SBloomFilter *pBF) {
+  SColVal     cv;
+  int64_t     nRun = 0;
+  int64_t     iKey = 0, iPrev = 0;
+  const char *pKey = NULL, *pPrev = NULL;
+  uint32_t    len = 0, lenPrev = 0;
+
+  for (int32_t iVal = 0; iVal < pColData->nVal; ++iVal) {
+    tColDataGetValue(pColData, iVal, &cv);
+    if (!COL_VAL_IS_VALUE(&cv)) continue;
+
+    tsdbBloomGetKey(pColData->type, &cv.value, &iKey, &pKey, &len);
+    if (pPrev != NULL && len == lenPrev && memcmp(pKey, pPrev, len) == 0) continue;
+
+    nRun++;
+    if (pBF) {
+      (void)tBloomFilterPut(pBF, pKey, len);
+    }
+
+    if (pKey == (const char *)&iKey) {
+      iPrev = iKey;
+      pPrev = (const char *)&iPrev;
+    } else {
+      pPrev = pKey;
+    }
+    lenPrev = len;
+  }
+
+  return nRun;
+}
+
+int32_t tsdbColDataBuildBloom(SColData *pColData, SBloomFilter **ppBF) {
+  *ppBF = NULL;
+  if (!tsdbBloomIsTypeSupported(pColData->type) || (pColData->flag & HAS_VALUE) == 0) {
+    return 0;
+  }
+
+  // the number of value runs is the upper bound of the distinct values, so the filter never gets full by only
+  // putting the first value of each run
+  int64_t nRun = tsdbColDataBloomRuns(pColData, NULL);
+
+  SBloomFilter *pBF = tBloomFilterInit(nRun, TSDB_BLOCK_BLOOM_ERROR_RATE);
+  if (pBF == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  tsdbColDataBloomRuns(pColData, pBF);
+
+  *ppBF = pBF;
+  return 0;
+}
+
+bool tsdbBloomNoContain(const SBloomFilter *pBF, int8_t type, int64_t val, const char *pData) {
+  const char *pKey = (const char *)&val;
+  uint32_t    len = sizeof(int64_t);
+  if (IS_VAR_DATA_TYPE(type)) {
+    pKey = varDataVal(pData);
+    len = varDataLen(pData);
+  }
+
+  uint64_t h1 = (uint64_t)pBF->hashFn1(pKey, len);
+  uint64_t h2 = (uint64_t)pBF->hashFn2(pKey, len);
+  return tBloomFilterNoContain(pBF, h1, h2) == TSDB_CODE_SUCCESS;
+}
+
 int32_t tsdbCmprData(uint8_t *pIn, int32_t szIn, int8_t type, int8_t cmprAlg, uint8_t **ppOut, int32_t nOut,
                      int32_t *szOut, uint8_t **ppBuf) {
   int32_t code = 0;
@@ -1604,6 +1836,197 @@ _exit:
   return code;
 }
 
+/*
+ * Dictionary encoding of var data columns. The value of each row is replaced by its code in the dictionary of
+ * distinct values in the block, null and none rows are coded as empty values. The offset part saves the compressed
+ * codes, and the value part saves the raw size of the dictionary followed by the compressed dictionary:
+ *   | nDict | length of each entry | entries |
+ */
+#define TSDB_DICT_MIN_ROWS 64
+#define TSDB_DICT_MAX_SIZE 1024
+#define TSDB_DICT_MAX_RATE 8  // the number of distinct values is at most 1/8 of the rows
+
+typedef struct {
+  int32_t offset;
+  int32_t length;
+} SDictEntry;
+
+static int32_t tsdbCmprColDataByDict(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol, uint8_t **ppOut,
+                                     int32_t nOut, uint8_t **ppBuf) {
+  int32_t     code = 0;
+  int32_t     maxDict = TMIN(TSDB_DICT_MAX_SIZE, pColData->nVal / TSDB_DICT_MAX_RATE);
+  int32_t     nDict = 0;
+  int32_t     szDict = 0;
+  int32_t     emptyCode = -1;
+  int32_t    *aCode = NULL;
+  uint8_t    *pDict = NULL;
+  SDictEntry *aEntry = NULL;
+
+  SSHashObj *pHash = tSimpleHashInit(maxDict, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+  aCode = taosMemoryMalloc(sizeof(int32_t) * pColData->nVal);
+  aEntry = taosMemoryMalloc(sizeof(SDictEntry) * (maxDict + 1));
+  if (pHash == NULL || aCode == NULL || aEntry == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
+    int32_t  offset = pColData->aOffset[iVal];
+    int32_t  length = ((iVal + 1 < pColData->nVal) ? pColData->aOffset[iVal + 1] : pColData->nData) - offset;
+    int32_t *pCode = NULL;
+
+    if (length == 0) {
+      pCode = (emptyCode >= 0) ? &emptyCode : NULL;
+    } else {
+      pCode = tSimpleHashGet(pHash, pColData->pData + offset, length);
+    }
+
+    if (pCode == NULL) {
+      // too many distinct values, or the dictionary is not much smaller
+      if (nDict >= maxDict || (szDict + length) * 2 > pColData->nData) goto _exit;
+
+      aEntry[nDict] = (SDictEntry){.offset = offset, .length = length};
+      if (length == 0) {
+        emptyCode = nDict;
+      } else if (tSimpleHashPut(pHash, pColData->pData + offset, length, &nDict, sizeof(int32_t)) != 0) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+      aCode[iVal] = nDict++;
+      szDict += length;
+    } else {
+      aCode[iVal] = *pCode;
+    }
+  }
+
+  // codes
+  code = tsdbCmprData((uint8_t *)aCode, sizeof(int32_t) * pColData->nVal, TSDB_DATA_TYPE_INT, cmprAlg, ppOut, nOut,
+                      &pBlockCol->szOffset, ppBuf);
+  if (code) goto _exit;
+
+  // dictionary
+  int32_t szRaw = sizeof(int32_t) * (nDict + 1) + szDict;
+  pDict = taosMemoryMalloc(szRaw);
+  if (pDict == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  int32_t n = 0;
+  memcpy(pDict + n, &nDict, sizeof(int32_t));
+  n += sizeof(int32_t);
+  for (int32_t i = 0; i < nDict; i++) {
+    memcpy(pDict + n, &aEntry[i].length, sizeof(int32_t));
+    n += sizeof(int32_t);
+  }
+  for (int32_t i = 0; i < nDict; i++) {
+    memcpy(pDict + n, pColData->pData + aEntry[i].offset, aEntry[i].length);
+    n += aEntry[i].length;
+  }
+
+  int32_t nValueOut = nOut + pBlockCol->szOffset;
+  code = tRealloc(ppOut, nValueOut + sizeof(int32_t));
+  if (code) goto _exit;
+  memcpy(*ppOut + nValueOut, &szRaw, sizeof(int32_t));
+
+  code = tsdbCmprData(pDict, szRaw, pColData->type, cmprAlg, ppOut, nValueOut + sizeof(int32_t), &pBlockCol->szValue,
+                      ppBuf);
+  if (code) goto _exit;
+
+  pBlockCol->szValue += sizeof(int32_t);
+  pBlockCol->dictOn = 1;
+
+_exit:
+  if (!pBlockCol->dictOn) {
+    pBlockCol->szOffset = 0;
+    pBlockCol->szValue = 0;
+  }
+  tSimpleHashCleanup(pHash);
+  taosMemoryFree(aCode);
+  taosMemoryFree(aEntry);
+  taosMemoryFree(pDict);
+  return code;
+}
+
+static int32_t tsdbDecmprColDataByDict(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, SColData *pColData,
+                                       uint8_t **ppBuf) {
+  int32_t  code = 0;
+  uint8_t *pCode = NULL;
+  uint8_t *pDict = NULL;
+  int32_t *aOffset = NULL;
+  int32_t  szRaw = 0;
+
+  code = tsdbDecmprData(pIn, pBlockCol->szOffset, TSDB_DATA_TYPE_INT, cmprAlg, &pCode, sizeof(int32_t) * pColData->nVal,
+                        ppBuf);
+  if (code) goto _exit;
+
+  uint8_t *p = pIn + pBlockCol->szOffset;
+  memcpy(&szRaw, p, sizeof(int32_t));
+  if (szRaw < (int32_t)sizeof(int32_t)) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+
+  code = tsdbDecmprData(p + sizeof(int32_t), pBlockCol->szValue - sizeof(int32_t), pColData->type, cmprAlg, &pDict,
+                        szRaw, ppBuf);
+  if (code) goto _exit;
+
+  int32_t nDict = 0;
+  memcpy(&nDict, pDict, sizeof(int32_t));
+  if (nDict <= 0 || sizeof(int32_t) * (nDict + 1) > szRaw) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+
+  // offset of each entry in the dictionary
+  aOffset = taosMemoryMalloc(sizeof(int32_t) * (nDict + 1));
+  if (aOffset == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  aOffset[0] = sizeof(int32_t) * (nDict + 1);
+  for (int32_t i = 0; i < nDict; i++) {
+    int32_t length = 0;
+    memcpy(&length, pDict + sizeof(int32_t) * (i + 1), sizeof(int32_t));
+    aOffset[i + 1] = aOffset[i] + length;
+    if (length < 0 || aOffset[i + 1] > szRaw) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      goto _exit;
+    }
+  }
+
+  // expand the codes
+  code = tRealloc((uint8_t **)&pColData->aOffset, sizeof(int32_t) * pColData->nVal);
+  if (code) goto _exit;
+  code = tRealloc(&pColData->pData, pColData->nData);
+  if (code) goto _exit;
+
+  int32_t *aCode = (int32_t *)pCode;
+  int32_t  nData = 0;
+  for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
+    int32_t c = aCode[iVal];
+    if (c < 0 || c >= nDict || nData + aOffset[c + 1] - aOffset[c] > pColData->nData) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      goto _exit;
+    }
+
+    pColData->aOffset[iVal] = nData;
+    memcpy(pColData->pData + nData, pDict + aOffset[c], aOffset[c + 1] - aOffset[c]);
+    nData += aOffset[c + 1] - aOffset[c];
+  }
+
+  if (nData != pColData->nData) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+  }
+
+_exit:
+  tFree(pCode);
+  tFree(pDict);
+  taosMemoryFree(aOffset);
+  return code;
+}
+
 int32_t tsdbCmprColData(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol, uint8_t **ppOut, int32_t nOut,
                         uint8_t **ppBuf) {
   int32_t code = 0;
@@ -1630,6 +2053,19 @@ int32_t tsdbCmprColData(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol
   }
   size += pBlockCol->szBitmap;
 
+  // dictionary codes and dictionary of low cardinality var data
+  pBlockCol->dictOn = 0;
+  if (IS_VAR_DATA_TYPE(pColData->type) && pColData->flag != (HAS_NULL | HAS_NONE) && pColData->nData &&
+      cmprAlg != NO_COMPRESSION && pColData->nVal >= TSDB_DICT_MIN_ROWS && !tsLegacyCmprFormat) {
+    code = tsdbCmprColDataByDict(pColData, cmprAlg, pBlockCol, ppOut, nOut + size, ppBuf);
+    if (code) goto _exit;
+
+    if (pBlockCol->dictOn) {
+      size += pBlockCol->szOffset + pBlockCol->szValue;
+      goto _exit;
+    }
+  }
+
   // offset
   if (IS_VAR_DATA_TYPE(pColData->type) && pColData->flag != (HAS_NULL | HAS_NONE)) {
     code = tsdbCmprData((uint8_t *)pColData->aOffset, sizeof(int32_t) * pColData->nVal, TSDB_DATA_TYPE_INT, cmprAlg,
@@ -1676,6 +2112,11 @@ int32_t tsdbDecmprColData(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, in
   }
   p += pBlockCol->szBitmap;
 
+  if (pBlockCol->dictOn) {
+    code = tsdbDecmprColDataByDict(p, pBlockCol, cmprAlg, pColData, ppBuf);
+    goto _exit;
+  }
+
   // offset
   if (pBlockCol->szOffset) {
     code = tsdbDecmprData(p, pBlockCol->szOffset, TSDB_DATA_TYPE_INT, cmprAlg, (uint8_t **)&pColData->aOffset,
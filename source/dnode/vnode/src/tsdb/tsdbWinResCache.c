@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tsdb.h"
+
+/*
+ * Cache of the partial aggregate states of interval windows, produced by earlier queries on this vnode.
+ *
+ * Each entry belongs to one super table and one query shape (the digest provided by the executor), and holds
+ * a contiguous covered time range together with the states of all non-empty windows inside of it. Writes and
+ * deletes on a child table shrink the covered range of the entries of its super table, so windows that are
+ * served from the cache always reflect the current data. A query that runs concurrently with writes registers
+ * the write sequence number when it looks up the cache, before its reader takes the version range, and the writes
+ * that happen afterwards are applied to the entry it puts back. Since the applied version of the vnode advances
+ * before the rows are inserted and the cache is invalidated, every write counted in the registered sequence number
+ * is visible to the reader.
+ */
+
+#define WIN_RES_CACHE_KEY_LEN     (sizeof(uint64_t) + 16)
+#define WIN_RES_CACHE_MAX_RECORDS 64
+
+typedef struct SWinResWriteRecord {
+  int64_t seq;
+  TSKEY   skey;
+  TSKEY   ekey;
+} SWinResWriteRecord;
+
+typedef struct SWinResCacheEntry {
+  uint64_t    suid;
+  SInterval   interval;
+  STimeWindow range;   // covered range, windows inside of it that have no item contain no data
+  SArray*     pItems;  // SArray<SWinResCacheItem>, ordered by the window start key
+  int64_t     size;
+  int64_t     accTime;
+  char        key[WIN_RES_CACHE_KEY_LEN];
+} SWinResCacheEntry;
+
+typedef struct SWinResTableInfo {
+  int64_t            seq;  // sequence number of the last write on this super table
+  int32_t            numOfRecords;
+  SWinResWriteRecord records[WIN_RES_CACHE_MAX_RECORDS];
+  SArray*            pEntries;  // SArray<SWinResCacheEntry*>
+} SWinResTableInfo;
+
+typedef struct SWinResCache {
+  TdThreadMutex lock;
+  SHashObj*     pTableInfo;  // suid -> SWinResTableInfo*
+  SHashObj*     pEntries;    // key -> SWinResCacheEntry*
+  int64_t       size;
+  int64_t       accTimes;
+  int32_t       numOfTables;
+} SWinResCache;
+
+static void freeWinResCacheItem(void* p) { taosMemoryFreeClear(((SWinResCacheItem*)p)->pData); }
+
+static void freeWinResTableInfo(void* p) {
+  SWinResTableInfo* pInfo = *(SWinResTableInfo**)p;
+  taosArrayDestroy(pInfo->pEntries);
+  taosMemoryFree(pInfo);
+}
+
+static void destroyWinResCacheEntry(SWinResCacheEntry* pEntry) {
+  if (pEntry != NULL) {
+    taosArrayDestroyEx(pEntry->pItems, freeWinResCacheItem);
+    taosMemoryFree(pEntry);
+  }
+}
+
+static void initWinResCacheKey(char* buf, uint64_t suid, const uint8_t* pKey, int32_t keyLen) {
+  memset(buf, 0, WIN_RES_CACHE_KEY_LEN);
+  *(uint64_t*)buf = suid;
+  memcpy(buf + sizeof(uint64_t), pKey, TMIN(keyLen, WIN_RES_CACHE_KEY_LEN - sizeof(uint64_t)));
+}
+
+static TSKEY getWinResNextWinStart(const SInterval* pInterval, TSKEY ts) {
+  TSKEY skey = taosTimeTruncate(ts, pInterval);
+  return taosTimeAdd(skey, pInterval->interval, pInterval->intervalUnit, pInterval->precision);
+}
+
+static void setWinResEntryRangeStart(SWinResCacheEntry* pEntry, TSKEY skey) {
+  if (skey <= pEntry->range.skey) {
+    return;
+  }
+
+  pEntry->range.skey = skey;
+
+  int32_t num = 0;
+  while (num < taosArrayGetSize(pEntry->pItems) &&
+         ((SWinResCacheItem*)taosArrayGet(pEntry->pItems, num))->win.skey < skey) {
+    SWinResCacheItem* pItem = taosArrayGet(pEntry->pItems, num);
+    pEntry->size -= pItem->len;
+    freeWinResCacheItem(pItem);
+    num += 1;
+  }
+  taosArrayPopFrontBatch(pEntry->pItems, num);
+}
+
+static void setWinResEntryRangeEnd(SWinResCacheEntry* pEntry, TSKEY ekey) {
+  if (ekey >= pEntry->range.ekey) {
+    return;
+  }
+
+  pEntry->range.ekey = ekey;
+
+  while (taosArrayGetSize(pEntry->pItems) > 0) {
+    SWinResCacheItem* pItem = taosArrayGetLast(pEntry->pItems);
+    if (pItem->win.ekey <= ekey) {
+      break;
+    }
+    pEntry->size -= pItem->len;
+    freeWinResCacheItem(pItem);
+    taosArrayPop(pEntry->pItems);
+  }
+}
+
+// drop the windows that overlap with [skey, ekey], and keep the longest remained part of the covered range
+static void invalidateWinResEntry(SWinResCacheEntry* pEntry, TSKEY skey, TSKEY ekey) {
+  if (ekey < pEntry->range.skey || skey > pEntry->range.ekey) {
+    return;
+  }
+
+  if (skey <= pEntry->range.skey && ekey >= pEntry->range.ekey) {
+    setWinResEntryRangeEnd(pEntry, pEntry->range.skey - 1);
+    return;
+  }
+
+  TSKEY cutStart = taosTimeTruncate(skey, &pEntry->interval);
+  TSKEY cutEnd = (ekey >= pEntry->range.ekey) ? pEntry->range.ekey : getWinResNextWinStart(&pEntry->interval, ekey);
+
+  if (cutStart - pEntry->range.skey >= pEntry->range.ekey - cutEnd) {
+    setWinResEntryRangeEnd(pEntry, cutStart - 1);
+  } else {
+    setWinResEntryRangeStart(pEntry, cutEnd);
+  }
+}
+
+// the partial windows that begin before the earliest valid timestamp of the vnode are not usable anymore
+static void trimWinResEntryByKeep(STsdb* pTsdb, SWinResCacheEntry* pEntry) {
+  STsdbKeepCfg* pCfg = &pTsdb->keepCfg;
+  int64_t       earlyTs = taosGetTimestamp(pCfg->precision) - (tsTickPerMin[pCfg->precision] * pCfg->keep2) + 1;
+  if (earlyTs <= pEntry->range.skey) {
+    return;
+  }
+
+  TSKEY skey = taosTimeTruncate(earlyTs, &pEntry->interval);
+  if (skey < earlyTs) {
+    skey = getWinResNextWinStart(&pEntry->interval, earlyTs);
+  }
+  setWinResEntryRangeStart(pEntry, skey);
+}
+
+static bool isWinResEntryEmpty(const SWinResCacheEntry* pEntry) { return pEntry->range.skey > pEntry->range.ekey; }
+
+static void removeWinResEntry(SWinResCache* pCache, SWinResTableInfo* pInfo, int32_t index) {
+  SWinResCacheEntry* pEntry = taosArrayGetP(pInfo->pEntries, index);
+  taosArrayRemove(pInfo->pEntries, index);
+  taosHashRemove(pCache->pEntries, pEntry->key, WIN_RES_CACHE_KEY_LEN);
+  pCache->size -= pEntry->size;
+  destroyWinResCacheEntry(pEntry);
+}
+
+static void addWinResWriteRecord(SWinResTableInfo* pInfo, TSKEY skey, TSKEY ekey) {
+  pInfo->seq += 1;
+
+  // merge the two oldest records when full, which may only make the invalidation of in-progress queries wider
+  if (pInfo->numOfRecords == WIN_RES_CACHE_MAX_RECORDS) {
+    SWinResWriteRecord* p = pInfo->records;
+    p[1].skey = TMIN(p[0].skey, p[1].skey);
+    p[1].ekey = TMAX(p[0].ekey, p[1].ekey);
+    memmove(p, p + 1, sizeof(SWinResWriteRecord) * (WIN_RES_CACHE_MAX_RECORDS - 1));
+    pInfo->numOfRecords -= 1;
+  }
+
+  pInfo->records[pInfo->numOfRecords++] = (SWinResWriteRecord){.seq = pInfo->seq, .skey = skey, .ekey = ekey};
+}
+
+static void invalidateWinResTableEntries(SWinResCache* pCache, SWinResTableInfo* pInfo, TSKEY skey, TSKEY ekey) {
+  for (int32_t i = (int32_t)taosArrayGetSize(pInfo->pEntries) - 1; i >= 0; --i) {
+    SWinResCacheEntry* pEntry = taosArrayGetP(pInfo->pEntries, i);
+
+    int64_t size = pEntry->size;
+    invalidateWinResEntry(pEntry, skey, ekey);
+    pCache->size -= (size - pEntry->size);
+
+    if (isWinResEntryEmpty(pEntry)) {
+      removeWinResEntry(pCache, pInfo, i);
+    }
+  }
+}
+
+static void evictWinResEntries(SWinResCache* pCache, int64_t capacity) {
+  while (pCache->size > capacity) {
+    SWinResTableInfo* pVictimInfo = NULL;
+    int32_t           victim = -1;
+    int64_t           accTime = INT64_MAX;
+
+    void* p = taosHashIterate(pCache->pTableInfo, NULL);
+    while (p != NULL) {
+      SWinResTableInfo* pInfo = *(SWinResTableInfo**)p;
+      for (int32_t i = 0; i < taosArrayGetSize(pInfo->pEntries); ++i) {
+        SWinResCacheEntry* pEntry = taosArrayGetP(pInfo->pEntries, i);
+        if (pEntry->accTime < accTime) {
+          accTime = pEntry->accTime;
+          pVictimInfo = pInfo;
+          victim = i;
+        }
+      }
+      p = taosHashIterate(pCache->pTableInfo, p);
+    }
+
+    if (pVictimInfo == NULL) {
+      break;
+    }
+    removeWinResEntry(pCache, pVictimInfo, victim);
+  }
+}
+
+int32_t tsdbOpenWinResCache(STsdb* pTsdb) {
+  if (tsWinResCacheSize <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SWinResCache* pCache = taosMemoryCalloc(1, sizeof(SWinResCache));
+  if (pCache == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  pCache->pTableInfo = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT), false, HASH_NO_LOCK);
+  pCache->pEntries = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  if (pCache->pTableInfo == NULL || pCache->pEntries == NULL) {
+    taosHashCleanup(pCache->pTableInfo);
+    taosHashCleanup(pCache->pEntries);
+    taosMemoryFree(pCache);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  taosHashSetFreeFp(pCache->pTableInfo, freeWinResTableInfo);
+  taosThreadMutexInit(&pCache->lock, NULL);
+
+  pTsdb->pWinResCache = pCache;
+  return TSDB_CODE_SUCCESS;
+}
+
+void tsdbCloseWinResCache(STsdb* pTsdb) {
+  SWinResCache* pCache = pTsdb->pWinResCache;
+  if (pCache == NULL) {
+    return;
+  }
+
+  void* p = taosHashIterate(pCache->pEntries, NULL);
+  while (p != NULL) {
+    destroyWinResCacheEntry(*(SWinResCacheEntry**)p);
+    p = taosHashIterate(pCache->pEntries, p);
+  }
+
+  taosHashCleanup(pCache->pEntries);
+  taosHashCleanup(pCache->pTableInfo);
+  taosThreadMutexDestroy(&pCache->lock);
+  taosMemoryFreeClear(pTsdb->pWinResCache);
+}
+
+void tsdbWinResCacheInvalidate(STsdb* pTsdb, tb_uid_t suid, TSKEY skey, TSKEY ekey) {
+  SWinResCache* pCache = pTsdb->pWinResCache;
+  if (pCache == NULL || suid == 0 || atomic_load_32(&pCache->numOfTables) == 0) {
+    return;
+  }
+
+  taosThreadMutexLock(&pCache->lock);
+
+  SWinResTableInfo** pInfo = taosHashGet(pCache->pTableInfo, &suid, sizeof(suid));
+  if (pInfo != NULL) {
+    addWinResWriteRecord(*pInfo, skey, ekey);
+    invalidateWinResTableEntries(pCache, *pInfo, skey, ekey);
+  }
+
+  taosThreadMutexUnlock(&pCache->lock);
+}
+
+void tsdbWinResCacheClear(STsdb* pTsdb) {
+  SWinResCache* pCache = pTsdb->pWinResCache;
+  if (pCache == NULL) {
+    return;
+  }
+
+  taosThreadMutexLock(&pCache->lock);
+
+  void* p = taosHashIterate(pCache->pTableInfo, NULL);
+  while (p != NULL) {
+    SWinResTableInfo* pInfo = *(SWinResTableInfo**)p;
+    addWinResWriteRecord(pInfo, INT64_MIN, INT64_MAX);
+    invalidateWinResTableEntries(pCache, pInfo, INT64_MIN, INT64_MAX);
+    p = taosHashIterate(pCache->pTableInfo, p);
+  }
+
+  taosThreadMutexUnlock(&pCache->lock);
+}
+
+int32_t tsdbGetCachedWinRes(void* pVnode, uint64_t suid, const uint8_t* pKey, int32_t keyLen, STimeWindow* pRange,
+                            SArray** pList, int64_t* pSeq) {
+  STsdb*        pTsdb = ((SVnode*)pVnode)->pTsdb;
+  SWinResCache* pCache = pTsdb->pWinResCache;
+  int32_t       code = TSDB_CODE_SUCCESS;
+
+  *pList = NULL;
+  *pSeq = -1;
+  if (pCache == NULL) {
+    return code;
+  }
+
+  char key[WIN_RES_CACHE_KEY_LEN];
+  initWinResCacheKey(key, suid, pKey, keyLen);
+
+  taosThreadMutexLock(&pCache->lock);
+
+  SWinResTableInfo*  pInfo = NULL;
+  SWinResTableInfo** p = taosHashGet(pCache->pTableInfo, &suid, sizeof(suid));
+  if (p == NULL) {
+    pInfo = taosMemoryCalloc(1, sizeof(SWinResTableInfo));
+    if (pInfo == NULL || (pInfo->pEntries = taosArrayInit(4, POINTER_BYTES)) == NULL ||
+        taosHashPut(pCache->pTableInfo, &suid, sizeof(suid), &pInfo, POINTER_BYTES) != 0) {
+      if (pInfo != NULL) {
+        taosArrayDestroy(pInfo->pEntries);
+        taosMemoryFree(pInfo);
+      }
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _end;
+    }
+    atomic_add_fetch_32(&pCache->numOfTables, 1);
+  } else {
+    pInfo = *p;
+  }
+
+  *pSeq = pInfo->seq;
+
+  SWinResCacheEntry** ppEntry = taosHashGet(pCache->pEntries, key, WIN_RES_CACHE_KEY_LEN);
+  if (ppEntry == NULL) {
+    goto _end;
+  }
+
+  SWinResCacheEntry* pEntry = *ppEntry;
+
+  int64_t size = pEntry->size;
+  trimWinResEntryByKeep(pTsdb, pEntry);
+  pCache->size -= (size - pEntry->size);
+
+  if (isWinResEntryEmpty(pEntry)) {
+    for (int32_t i = 0; i < taosArrayGetSize(pInfo->pEntries); ++i) {
+      if (taosArrayGetP(pInfo->pEntries, i) == pEntry) {
+        removeWinResEntry(pCache, pInfo, i);
+        break;
+      }
+    }
+    goto _end;
+  }
+
+  size_t  numOfItems = taosArrayGetSize(pEntry->pItems);
+  SArray* pRes = taosArrayInit(numOfItems, sizeof(SWinResCacheItem));
+  if (pRes == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _end;
+  }
+
+  for (int32_t i = 0; i < numOfItems; ++i) {
+    SWinResCacheItem* pItem = taosArrayGet(pEntry->pItems, i);
+    SWinResCacheItem  item = {.win = pItem->win, .len = pItem->len, .pData = taosMemoryMalloc(pItem->len)};
+    if (item.pData == NULL) {
+      taosArrayDestroyEx(pRes, freeWinResCacheItem);
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _end;
+    }
+
+    memcpy(item.pData, pItem->pData, pItem->len);
+    taosArrayPush(pRes, &item);
+  }
+
+  pEntry->accTime = ++pCache->accTimes;
+  *pRange = pEntry->range;
+  *pList = pRes;
+
+_end:
+  taosThreadMutexUnlock(&pCache->lock);
+  return code;
+}
+
+int32_t tsdbPutCachedWinRes(void* pVnode, uint64_t suid, const uint8_t* pKey, int32_t keyLen,
+                            const SInterval* pInterval, const STimeWindow* pRange, SArray* pList, int64_t seq) {
+  STsdb*        pTsdb = ((SVnode*)pVnode)->pTsdb;
+  SWinResCache* pCache = pTsdb->pWinResCache;
+  int64_t       capacity = tsWinResCacheSize * 1048576L;
+
+  if (pCache == NULL || seq < 0) {
+    taosArrayDestroyEx(pList, freeWinResCacheItem);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SWinResCacheEntry* pEntry = taosMemoryCalloc(1, sizeof(SWinResCacheEntry));
+  if (pEntry == NULL) {
+    taosArrayDestroyEx(pList, freeWinResCacheItem);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pEntry->suid = suid;
+  pEntry->interval = *pInterval;
+  pEntry->range = *pRange;
+  pEntry->pItems = pList;
+  pEntry->size = sizeof(SWinResCacheEntry) + taosArrayGetSize(pList) * sizeof(SWinResCacheItem);
+  for (int32_t i = 0; i < taosArrayGetSize(pList); ++i) {
+    pEntry->size += ((SWinResCacheItem*)taosArrayGet(pList, i))->len;
+  }
+  initWinResCacheKey(pEntry->key, suid, pKey, keyLen);
+
+  // a single query result is not allowed to occupy too much of the cache
+  if (pEntry->size > capacity / 4) {
+    tsdbDebug("vgId:%d, suid:%" PRIu64 " window result too large to cache, size:%" PRId64, TD_VID(pTsdb->pVnode), suid,
+              pEntry->size);
+    destroyWinResCacheEntry(pEntry);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  taosThreadMutexLock(&pCache->lock);
+
+  SWinResTableInfo** p = taosHashGet(pCache->pTableInfo, &suid, sizeof(suid));
+  if (p == NULL) {
+    goto _discard;
+  }
+
+  SWinResTableInfo* pInfo = *p;
+
+  // the writes happened after the lookup of this query may not be seen by it
+  for (int32_t i = 0; i < pInfo->numOfRecords; ++i) {
+    if (pInfo->records[i].seq > seq) {
+      invalidateWinResEntry(pEntry, pInfo->records[i].skey, pInfo->records[i].ekey);
+    }
+  }
+  trimWinResEntryByKeep(pTsdb, pEntry);
+  if (isWinResEntryEmpty(pEntry)) {
+    goto _discard;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pInfo->pEntries); ++i) {
+    SWinResCacheEntry* pExist = taosArrayGetP(pInfo->pEntries, i);
+    if (memcmp(pExist->key, pEntry->key, WIN_RES_CACHE_KEY_LEN) == 0) {
+      removeWinResEntry(pCache, pInfo, i);
+      break;
+    }
+  }
+
+  if (taosArrayPush(pInfo->pEntries, &pEntry) == NULL) {
+    goto _discard;
+  }
+  if (taosHashPut(pCache->pEntries, pEntry->key, WIN_RES_CACHE_KEY_LEN, &pEntry, POINTER_BYTES) != 0) {
+    taosArrayPop(pInfo->pEntries);
+    goto _discard;
+  }
+
+  pEntry->accTime = ++pCache->accTimes;
+  pCache->size += pEntry->size;
+  evictWinResEntries(pCache, capacity);
+
+  tsdbDebug("vgId:%d, suid:%" PRIu64 " cache %d window results in range [%" PRId64 ", %" PRId64
+            "], cache size:%" PRId64,
+            TD_VID(pTsdb->pVnode), suid, (int32_t)taosArrayGetSize(pList), pEntry->range.skey, pEntry->range.ekey,
+            pCache->size);
+
+  taosThreadMutexUnlock(&pCache->lock);
+  return TSDB_CODE_SUCCESS;
+
+_discard:
+  taosThreadMutexUnlock(&pCache->lock);
+  destroyWinResCacheEntry(pEntry);
+  return TSDB_CODE_SUCCESS;
+}
@@ -97,6 +97,9 @@ void initMetadataAPI(SStoreMeta* pMeta) {
   pMeta->getCachedTableList = metaGetCachedTableUidList;
   pMeta->putCachedTableList = metaUidFilterCachePut;
 
+  pMeta->getCachedWinRes = tsdbGetCachedWinRes;
+  pMeta->putCachedWinRes = tsdbPutCachedWinRes;
+
   pMeta->metaGetCachedTbGroup = metaGetCachedTbGroup;
   pMeta->metaPutTbGroupToCache = metaPutTbGroupToCache;
 
@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <taoserror.h>
+#include <tmsg.h>
+#include <tsdb.h>
+#include <vnd.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+const int64_t START_TS = 1700000000000;
+
+// the value of a column of a row, it is null when the returned length is COL_NULL, and none when it is COL_NONE
+typedef int32_t (*FColValue)(int32_t iRow, int8_t type, char *buf);
+
+const int32_t COL_NULL = -1;
+const int32_t COL_NONE = -2;
+
+int32_t fixedValue(int32_t iRow, int8_t type, char *buf) {
+  int64_t v = (int64_t)iRow * 7919 % 100003 - 50000;
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+      *(int8_t *)buf = iRow & 1;
+      break;
+    case TSDB_DATA_TYPE_TINYINT:
+      *(int8_t *)buf = (int8_t)v;
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      *(int16_t *)buf = (int16_t)v;
+      break;
+    case TSDB_DATA_TYPE_INT:
+      *(int32_t *)buf = (int32_t)v;
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      *(float *)buf = v * 0.25f;
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      *(double *)buf = v * 0.125;
+      break;
+    default:
+      *(int64_t *)buf = v * 1000003;
+      break;
+  }
+  return TYPE_BYTES[type];
+}
+
+int32_t varValue(int32_t iRow, int8_t type, char *buf) { return sprintf(buf, "value_%d", iRow * 31 % 977); }
+
+int32_t mostlyNullValue(int32_t iRow, int8_t type, char *buf) {
+  return (iRow % 13 == 0) ? fixedValue(iRow, type, buf) : -1;
+}
+
+int32_t nullValue(int32_t iRow, int8_t type, char *buf) { return -1; }
+
+// a few distinct values, including the empty one
+int32_t lowCardValue(int32_t iRow, int8_t type, char *buf) {
+  int32_t k = iRow * 2654435761u % 7;
+  return (k == 0) ? 0 : sprintf(buf, "device_%d", k);
+}
+
+int32_t lowCardNullValue(int32_t iRow, int8_t type, char *buf) {
+  return (iRow % 5 == 1) ? COL_NULL : lowCardValue(iRow, type, buf);
+}
+
+int32_t lowCardNullNoneValue(int32_t iRow, int8_t type, char *buf) {
+  if (iRow % 5 == 1) return COL_NULL;
+  if (iRow % 3 == 2) return COL_NONE;
+  return lowCardValue(iRow, type, buf);
+}
+
+int32_t nullNoneValue(int32_t iRow, int8_t type, char *buf) { return (iRow & 1) ? COL_NULL : COL_NONE; }
+
+int32_t highCardValue(int32_t iRow, int8_t type, char *buf) { return sprintf(buf, "unique_%d", iRow); }
+
+typedef struct {
+  int8_t    type;
+  int32_t   bytes;
+  FColValue fp;
+  bool      none;  // the column is not written by any row
+} SColDef;
+
+class TsdbBlockData {
+ public:
+  TsdbBlockData(const std::vector<SColDef> &cols) : cols_(cols) {
+    std::vector<SSchema> aSchema(cols.size() + 1);
+    aSchema[0] = (SSchema){.type = TSDB_DATA_TYPE_TIMESTAMP, .flags = COL_SMA_ON, .colId = PRIMARYKEY_TIMESTAMP_COL_ID,
+                           .bytes = TYPE_BYTES[TSDB_DATA_TYPE_TIMESTAMP]};
+    for (int32_t i = 0; i < cols.size(); i++) {
+      aSchema[i + 1] =
+          (SSchema){.type = cols[i].type, .flags = COL_SMA_ON, .colId = (col_id_t)(i + 2), .bytes = cols[i].bytes};
+    }
+    pTSchema_ = tBuildTSchema(aSchema.data(), aSchema.size(), 1);
+
+    memset(&blockData_, 0, sizeof(blockData_));
+    tBlockDataCreate(&blockData_);
+    TABLEID id = {.suid = 1, .uid = 2};
+    EXPECT_EQ(tBlockDataInit(&blockData_, &id, pTSchema_, NULL, 0), 0);
+  }
+
+  ~TsdbBlockData() {
+    tBlockDataDestroy(&blockData_);
+    taosMemoryFree(pTSchema_);
+  }
+
+  void appendRows(int32_t nRows, int32_t startRow = 0) {
+    SArray *aColVal = taosArrayInit(cols_.size() + 1, sizeof(SColVal));
+
+    // the var data values are referred by the column values until the row is built
+    std::vector<std::vector<char>> aBuf(cols_.size(), std::vector<char>(64));
+
+    for (int32_t iRow = startRow; iRow < startRow + nRows; iRow++) {
+      taosArrayClear(aColVal);
+
+      SValue  ts = {.val = START_TS + iRow};
+      SColVal tsVal = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, ts);
+      taosArrayPush(aColVal, &tsVal);
+
+      for (int32_t i = 0; i < cols_.size(); i++) {
+        const SColDef &col = cols_[i];
+        char          *buf = aBuf[i].data();
+        SColVal        cv;
+        int32_t        len = col.none ? -1 : col.fp(iRow, col.type, buf);
+
+        if (col.none || len == COL_NONE) {
+          cv = COL_VAL_NONE(i + 2, col.type);
+        } else if (len < 0) {
+          cv = COL_VAL_NULL(i + 2, col.type);
+        } else if (IS_VAR_DATA_TYPE(col.type)) {
+          SValue v = {0};
+          v.nData = len;
+          v.pData = (uint8_t *)buf;
+          cv = COL_VAL_VALUE(i + 2, col.type, v);
+        } else {
+          SValue v = {0};
+          memcpy(&v.val, buf, len);
+          cv = COL_VAL_VALUE(i + 2, col.type, v);
+        }
+        taosArrayPush(aColVal, &cv);
+      }
+
+      SRow *pRow = NULL;
+      ASSERT_EQ(tRowBuild(aColVal, pTSchema_, &pRow), 0);
+      TSDBROW row = tsdbRowFromTSRow(iRow, pRow);
+      ASSERT_EQ(tBlockDataAppendRow(&blockData_, &row, pTSchema_, 2), 0);
+      tRowDestroy(pRow);
+    }
+
+    taosArrayDestroy(aColVal);
+  }
+
+  SBlockData *get() { return &blockData_; }
+
+ private:
+  std::vector<SColDef> cols_;
+  STSchema            *pTSchema_;
+  SBlockData           blockData_;
+};
+
+std::vector<uint8_t> compressBlock(SBlockData *pBlockData, int8_t cmprAlg) {
+  uint8_t *aBuf[4] = {0};
+  int32_t  aBufN[4] = {0};
+  uint8_t *pOut = NULL;
+  int32_t  szOut = 0;
+
+  EXPECT_EQ(tCmprBlockData(pBlockData, cmprAlg, &pOut, &szOut, aBuf, aBufN), 0);
+  std::vector<uint8_t> out(pOut, pOut + szOut);
+
+  tFree(pOut);
+  for (int32_t i = 0; i < 4; i++) tFree(aBuf[i]);
+  return out;
+}
+
+void checkSameColData(SColData *pExpect, SColData *pActual) {
+  ASSERT_EQ(pExpect->cid, pActual->cid);
+  ASSERT_EQ(pExpect->type, pActual->type);
+  ASSERT_EQ(pExpect->nVal, pActual->nVal);
+
+  for (int32_t iVal = 0; iVal < pExpect->nVal; iVal++) {
+    SColVal expect, actual;
+    tColDataGetValue(pExpect, iVal, &expect);
+    tColDataGetValue(pActual, iVal, &actual);
+
+    ASSERT_EQ(expect.flag, actual.flag) << "cid:" << pExpect->cid << " row:" << iVal;
+    if (!COL_VAL_IS_VALUE(&expect)) continue;
+
+    if (IS_VAR_DATA_TYPE(expect.type)) {
+      ASSERT_EQ(expect.value.nData, actual.value.nData) << "cid:" << pExpect->cid << " row:" << iVal;
+      ASSERT_EQ(memcmp(expect.value.pData, actual.value.pData, expect.value.nData), 0);
+    } else {
+      ASSERT_EQ(memcmp(&expect.value.val, &actual.value.val, TYPE_BYTES[expect.type]), 0)
+          << "cid:" << pExpect->cid << " row:" << iVal;
+    }
+  }
+}
+
+// decompress the block and check each column against the original one
+void checkDecompressedBlock(SBlockData *pBlockData, std::vector<uint8_t> &encoded) {
+  SBlockData decoded = {0};
+  uint8_t   *aBuf[1] = {0};
+
+  tBlockDataCreate(&decoded);
+  ASSERT_EQ(tDecmprBlockData(encoded.data(), encoded.size(), &decoded, aBuf), 0);
+  ASSERT_EQ(decoded.nRow, pBlockData->nRow);
+  ASSERT_EQ(memcmp(decoded.aTSKEY, pBlockData->aTSKEY, sizeof(TSKEY) * pBlockData->nRow), 0);
+  ASSERT_EQ(memcmp(decoded.aVersion, pBlockData->aVersion, sizeof(int64_t) * pBlockData->nRow), 0);
+
+  for (int32_t iColData = 0; iColData < pBlockData->nColData; iColData++) {
+    SColData *pColData = tBlockDataGetColDataByIdx(pBlockData, iColData);
+    SColData *pDecoded = NULL;
+
+    tBlockDataGetColData(&decoded, pColData->cid, &pDecoded);
+    if (pColData->flag == HAS_NONE) {
+      ASSERT_TRUE(pDecoded == NULL || pDecoded->flag == HAS_NONE);
+      continue;
+    }
+
+    ASSERT_TRUE(pDecoded != NULL) << "cid:" << pColData->cid;
+    checkSameColData(pColData, pDecoded);
+  }
+
+  tFree(aBuf[0]);
+  tBlockDataDestroy(&decoded);
+}
+
+std::vector<SColDef> mixedColumns() {
+  std::vector<SColDef> cols = {
+      {TSDB_DATA_TYPE_INT, 4, fixedValue},
+      {TSDB_DATA_TYPE_BIGINT, 8, fixedValue},
+      {TSDB_DATA_TYPE_DOUBLE, 8, fixedValue},
+      {TSDB_DATA_TYPE_VARCHAR, 32, varValue},
+      {TSDB_DATA_TYPE_BOOL, 1, fixedValue},
+      {TSDB_DATA_TYPE_FLOAT, 4, mostlyNullValue},
+      {TSDB_DATA_TYPE_NCHAR, 64, varValue},
+      {TSDB_DATA_TYPE_SMALLINT, 2, fixedValue},
+      {TSDB_DATA_TYPE_INT, 4, nullValue},
+      {TSDB_DATA_TYPE_TINYINT, 1, fixedValue},
+      {TSDB_DATA_TYPE_BIGINT, 8, fixedValue, true},
+      {TSDB_DATA_TYPE_UBIGINT, 8, mostlyNullValue},
+      {TSDB_DATA_TYPE_VARCHAR, 16, mostlyNullValue},
+      {TSDB_DATA_TYPE_DOUBLE, 8, fixedValue},
+  };
+  return cols;
+}
+
+// compress the block with the columns compressed by the current thread, and then by the vnode-compress workers
+void checkParallelCmpr(SBlockData *pBlockData, int8_t cmprAlg) {
+  ASSERT_TRUE(vnodeAsyncHandle[2] == NULL);
+  std::vector<uint8_t> serial = compressBlock(pBlockData, cmprAlg);
+
+  ASSERT_EQ(vnodeAsyncInit(&vnodeAsyncHandle[2], "vnode-compress"), 0);
+  ASSERT_EQ(vnodeAsyncSetWorkers(vnodeAsyncHandle[2], 4), 0);
+  std::vector<uint8_t> parallel = compressBlock(pBlockData, cmprAlg);
+  vnodeAsyncDestroy(&vnodeAsyncHandle[2]);
+  vnodeAsyncHandle[2] = NULL;
+
+  ASSERT_EQ(serial.size(), parallel.size());
+  ASSERT_TRUE(serial == parallel);
+  checkDecompressedBlock(pBlockData, parallel);
+}
+
+std::vector<SBlockCol> getBlockCols(std::vector<uint8_t> &encoded) {
+  SDiskDataHdr hdr = {0};
+  uint8_t     *p = encoded.data();
+
+  p += tGetDiskDataHdr(p, &hdr);
+  p += hdr.szUid + hdr.szVer + hdr.szKey;
+
+  std::vector<SBlockCol> cols;
+  for (int32_t n = 0; n < hdr.szBlkCol;) {
+    SBlockCol blockCol = {0};
+    n += tGetBlockCol(p + n, &blockCol);
+    cols.push_back(blockCol);
+  }
+  return cols;
+}
+
+// the dictionary encoded mark of each var data column of the encoded block
+std::vector<bool> getDictOn(std::vector<uint8_t> &encoded) {
+  std::vector<bool> dictOn;
+  for (SBlockCol &blockCol : getBlockCols(encoded)) {
+    if (IS_VAR_DATA_TYPE(blockCol.type)) {
+      dictOn.push_back(blockCol.dictOn);
+    }
+  }
+  return dictOn;
+}
+
+// compress the block, decompress it, and compress the decompressed block again as compaction does
+std::vector<uint8_t> checkCmprRoundTrip(SBlockData *pBlockData, int8_t cmprAlg) {
+  std::vector<uint8_t> encoded = compressBlock(pBlockData, cmprAlg);
+  checkDecompressedBlock(pBlockData, encoded);
+
+  SBlockData decoded = {0};
+  uint8_t   *aBuf[1] = {0};
+  tBlockDataCreate(&decoded);
+  EXPECT_EQ(tDecmprBlockData(encoded.data(), encoded.size(), &decoded, aBuf), 0);
+
+  std::vector<uint8_t> recoded = compressBlock(&decoded, cmprAlg);
+  EXPECT_TRUE(encoded == recoded);
+  checkDecompressedBlock(pBlockData, recoded);
+
+  tFree(aBuf[0]);
+  tBlockDataDestroy(&decoded);
+  return encoded;
+}
+
+}  // namespace
+
+TEST(tsdbUtilTest, parallelCmprSameAsSerial) {
+  std::vector<SColDef> cols = mixedColumns();
+
+  for (int8_t cmprAlg : {ONE_STAGE_COMP, TWO_STAGE_COMP}) {
+    for (int32_t nRows : {1024, 4096, 10000}) {
+      TsdbBlockData block(cols);
+      block.appendRows(nRows);
+      checkParallelCmpr(block.get(), cmprAlg);
+    }
+  }
+}
+
+TEST(tsdbUtilTest, parallelCmprColumnRanges) {
+  // the column ranges of the tasks are uneven when the number of columns is not a multiple of the tasks
+  for (int32_t nCols : {8, 9, 17, 33, 40}) {
+    std::vector<SColDef> all = mixedColumns();
+    std::vector<SColDef> cols;
+    for (int32_t i = 0; i < nCols; i++) {
+      cols.push_back(all[i % all.size()]);
+    }
+
+    TsdbBlockData block(cols);
+    block.appendRows(2048);
+    checkParallelCmpr(block.get(), TWO_STAGE_COMP);
+  }
+}
+
+TEST(tsdbUtilTest, dictCmprRoundTrip) {
+  std::vector<SColDef> cols = {
+      {TSDB_DATA_TYPE_VARCHAR, 32, lowCardValue},      {TSDB_DATA_TYPE_NCHAR, 64, lowCardNullValue},
+      {TSDB_DATA_TYPE_VARBINARY, 32, lowCardValue},    {TSDB_DATA_TYPE_VARCHAR, 32, lowCardNullNoneValue},
+      {TSDB_DATA_TYPE_VARCHAR, 32, highCardValue},     {TSDB_DATA_TYPE_NCHAR, 64, nullValue},
+      {TSDB_DATA_TYPE_VARCHAR, 16, nullNoneValue},     {TSDB_DATA_TYPE_VARCHAR, 16, varValue, true},
+      {TSDB_DATA_TYPE_INT, 4, fixedValue},
+  };
+
+  for (int8_t cmprAlg : {ONE_STAGE_COMP, TWO_STAGE_COMP}) {
+    TsdbBlockData block(cols);
+    block.appendRows(4096);
+
+    std::vector<uint8_t> encoded = checkCmprRoundTrip(block.get(), cmprAlg);
+    std::vector<bool>    dictOn = getDictOn(encoded);
+
+    // all null, and null mixed with none, have no values to encode; the none column is not written
+    std::vector<bool> expect = {true, true, true, true, false, false, false};
+    ASSERT_EQ(dictOn.size(), expect.size());
+    for (int32_t i = 0; i < expect.size(); i++) ASSERT_EQ(dictOn[i], expect[i]) << "column:" << i;
+  }
+
+  // too few rows, or no compression
+  {
+    TsdbBlockData block(cols);
+    block.appendRows(63);
+    std::vector<uint8_t> encoded = checkCmprRoundTrip(block.get(), TWO_STAGE_COMP);
+    for (bool on : getDictOn(encoded)) ASSERT_FALSE(on);
+  }
+  {
+    TsdbBlockData block(cols);
+    block.appendRows(1000);
+    std::vector<uint8_t> encoded = checkCmprRoundTrip(block.get(), NO_COMPRESSION);
+    for (bool on : getDictOn(encoded)) ASSERT_FALSE(on);
+  }
+}
+
+TEST(tsdbUtilTest, dictCmprCardinality) {
+  // the dictionary is used while the distinct values are at most 1/8 of the rows
+  for (int32_t nDistinct : {1, 2, 100, 255, 256, 300, 1024, 1025}) {
+    std::vector<SColDef> cols = {{TSDB_DATA_TYPE_VARCHAR, 32, highCardValue}};
+    TsdbBlockData        block(cols);
+    int32_t              nRows = 2048;
+
+    for (int32_t iRow = 0; iRow < nRows; iRow++) {
+      block.appendRows(1, iRow % nDistinct);
+    }
+
+    std::vector<uint8_t> encoded = checkCmprRoundTrip(block.get(), TWO_STAGE_COMP);
+    ASSERT_EQ(getDictOn(encoded)[0], nDistinct <= nRows / 8) << "distinct:" << nDistinct;
+  }
+}
+
+TEST(tsdbUtilTest, legacyCmprFormat) {
+  std::vector<SColDef> cols = {
+      {TSDB_DATA_TYPE_VARCHAR, 32, lowCardValue},
+      {TSDB_DATA_TYPE_BIGINT, 8, fixedValue},
+      {TSDB_DATA_TYPE_DOUBLE, 8, fixedValue},
+  };
+
+  TsdbBlockData block(cols);
+  block.appendRows(4096);
+
+  tsLegacyCmprFormat = true;
+  std::vector<uint8_t> encoded = checkCmprRoundTrip(block.get(), ONE_STAGE_COMP);
+  tsLegacyCmprFormat = false;
+
+  // no dictionary, and the integer and float values are encoded as older releases do
+  std::vector<SBlockCol> blockCols = getBlockCols(encoded);
+  ASSERT_EQ(blockCols.size(), cols.size());
+  ASSERT_FALSE(blockCols[0].dictOn);
+
+  SDiskDataHdr hdr = {0};
+  int32_t      n = tGetDiskDataHdr(encoded.data(), &hdr);
+  uint8_t     *pData = encoded.data() + n + hdr.szUid + hdr.szVer + hdr.szKey + hdr.szBlkCol;
+
+  uint8_t intCodec = pData[blockCols[1].offset + blockCols[1].szBitmap];
+  ASSERT_TRUE(intCodec == 0 || intCodec == 1);  // simple8b or copy
+  uint8_t floatHead = pData[blockCols[2].offset + blockCols[2].szBitmap];
+  ASSERT_NE(HEAD_ALGO(floatHead), ALGO_ALP);
+
+  // the version and key columns are integers as well
+  uint8_t verCodec = encoded[n + hdr.szUid];
+  ASSERT_TRUE(verCodec == 0 || verCodec == 1);
+}
+
+#pragma GCC diagnostic pop
@@ -108,6 +108,8 @@ extern "C" {
 #define EXPLAIN_SRC_SCAN_FORMAT "src_scan=%d,%d"
 #define EXPLAIN_PLAN_BLOCKING "blocking=%d"
 #define EXPLAIN_MERGE_MODE_FORMAT "mode=%s"
+#define EXPLAIN_EXCHANGE_WAIT_FORMAT "Fetch Wait: %.3f ms"
+#define EXPLAIN_EXCHANGE_SLOWEST_FORMAT "slowest_source=vgId:%d(%.3f ms)"
 
 #define COMMAND_RESET_LOG "resetLog"
 #define COMMAND_SCHEDULE_POLICY "schedulePolicy"
@@ -754,6 +754,21 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
       EXPLAIN_ROW_END();
       QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
 
+      if (EXPLAIN_MODE_ANALYZE == ctx->mode && pResNode->pExecInfo) {
+        SExplainExecInfo  *execInfo = taosArrayGet(pResNode->pExecInfo, 0);
+        SExchangeExecInfo *pExecInfo = (SExchangeExecInfo *)execInfo->verboseInfo;
+        if (pExecInfo) {
+          EXPLAIN_ROW_NEW(level + 1, EXPLAIN_EXCHANGE_WAIT_FORMAT, pExecInfo->waitTime / 1000.0);
+          if (pExecInfo->slowestWait > 0) {
+            EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+            EXPLAIN_ROW_APPEND(EXPLAIN_EXCHANGE_SLOWEST_FORMAT, pExecInfo->slowestVgId,
+                               pExecInfo->slowestWait / 1000.0);
+          }
+          EXPLAIN_ROW_END();
+          QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+        }
+      }
+
       if (verbose) {
         EXPLAIN_ROW_NEW(level + 1, EXPLAIN_OUTPUT_FORMAT);
         EXPLAIN_ROW_APPEND(EXPLAIN_COLUMNS_FORMAT,
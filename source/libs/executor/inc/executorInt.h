@@ -200,6 +200,16 @@ typedef struct SExchangeInfo {
   uint64_t            self;
   SLimitInfo          limitInfo;
   int64_t             openedTs;  // start exec time stamp, todo: move to SLoadRemoteDataInfo
+
+  // source index(+1) of the arrived fetch rsp, in arrival order, filled by the rsp callback without lock
+  int32_t* pReadyRing;
+  int32_t  ringCap;             // power of 2, not less than the number of sources
+  int32_t  ringHead;
+  int32_t  ringTail;
+  int64_t  pendingRspBytes;     // size of the arrived fetch rsp that are not consumed yet
+  int64_t  maxPendingRspBytes;  // no new fetch request is sent once pendingRspBytes exceeds it
+  SArray*  pDeferredSources;    // SArray<int32_t>, sources whose next fetch is held back by pendingRspBytes
+  int64_t  waitTime;            // time spent on waiting for fetch rsp, in us
 } SExchangeInfo;
 
 typedef struct SScanInfo {
@@ -239,6 +249,29 @@ typedef struct STableMetaCacheInfo {
   uint64_t   cacheHit;
 } STableMetaCacheInfo;
 
+typedef struct SLateMaterializeInfo {
+  SArray* pFilterColIds;  // column ids referenced by the filter, loaded before the other columns
+  int64_t numOfBlocks;
+  int64_t numOfSkipped;   // blocks that no row passes the filter, the rest columns are not loaded
+  bool    disabled;
+} SLateMaterializeInfo;
+
+// the value of the order column of the last row kept by the top-N sort, data blocks that can not provide any row ahead
+// of it are skipped by the table scan according to the block SMA.
+typedef struct STopNBound {
+  int32_t slotId;
+  int16_t colId;
+  int8_t  type;
+  int32_t order;
+  bool    nullFirst;
+  bool    valid;
+  union {
+    int64_t  i;
+    uint64_t u;
+    double   d;
+  };
+} STopNBound;
+
 typedef struct STableScanBase {
   STsdbReader*           dataReader;
   SFileBlockLoadRecorder readRecorder;
@@ -252,8 +285,10 @@ typedef struct STableScanBase {
   int32_t                dataBlockLoadFlag;
   SLimitInfo             limitInfo;
   // there are more than one table list exists in one task, if only one vnode exists.
-  STableListInfo* pTableListInfo;
-  TsdReader       readerAPI;
+  STableListInfo*      pTableListInfo;
+  TsdReader            readerAPI;
+  SLateMaterializeInfo lateMaterialize;
+  STopNBound*          pTopNBound;  // owned by the parent sort operator
 } STableScanBase;
 
 typedef struct STableScanInfo {
@@ -271,6 +306,8 @@ typedef struct STableScanInfo {
   bool            countOnly;
   //  TsdReader    readerAPI;
   bool            filesetDelimited;
+  SArray*         pScanRanges;  // SArray<STimeWindow>, scanned one after another instead of cond.twindows if not NULL
+  int32_t         scanRangeIndex;
 } STableScanInfo;
 
 typedef struct STableMergeScanInfo {
@@ -474,6 +511,86 @@ typedef struct SOptrBasicInfo {
   int32_t        outputTsOrder;
 } SOptrBasicInfo;
 
+typedef struct SWinResCacheSupp {
+  bool        enabled;
+  uint64_t    suid;
+  int64_t     seq;     // write sequence number of the super table when the cache is looked up
+  STimeWindow range;   // the windows entirely covered by the query time range
+  uint8_t     digest[16];  // digest of the query plan and the queried table list
+} SWinResCacheSupp;
+
+// rows of sliding windows are aggregated only once into the non-overlapping panes, and the intermediate results of each
+// pane are combined into all the time windows covering it.
+typedef struct SIntervalPaneSupp {
+  bool            enabled;
+  int64_t         size;      // gcd of interval and sliding
+  int64_t         anchor;    // start key of a time window, all panes are aligned to it
+  bool            anchored;
+  bool            open;      // the current pane has rows that are not combined into time windows yet
+  STimeWindow     win;
+  uint64_t        groupId;
+  int32_t         scanFlag;
+  SResultRow*     pRow;      // intermediate results of the current pane
+  SqlFunctionCtx* pCtx;      // copy of the function ctx, referring to the results of the current pane
+} SIntervalPaneSupp;
+
+// time windows of the ordered input of one group are kept in a ring buffer indexed by the window sequence number, and
+// are emitted as soon as they are closed, instead of the result row hash and paged buffer.
+typedef struct SIntervalOrderedSupp {
+  bool         enabled;
+  int64_t      anchor;     // start key of the first time window, the sequence number of which is 0
+  bool         anchored;
+  int64_t      startWin;   // sequence number of the oldest open time window
+  int32_t      numOfOpen;
+  int32_t      capacity;
+  uint64_t     groupId;
+  SResultRow** pRows;
+} SIntervalOrderedSupp;
+
+// one slot of the open addressing group hash table, the slot is empty if keyLen is 0
+typedef struct SGroupHashSlot {
+  uint64_t           hashVal;
+  int64_t            keyOffset;  // offset of the output group id and the window key in pKeys
+  int32_t            keyLen;     // length of the window key, groupId of the input block included
+  SResultRowPosition pos;
+} SGroupHashSlot;
+
+// flat hash table with linear probing that maps the group keys to the result rows in the disk based buffer
+typedef struct SGroupHashTable {
+  SGroupHashSlot* pSlots;
+  int32_t         capacity;  // number of slots, power of 2
+  int32_t         size;      // number of groups
+  char*           pKeys;
+  int64_t         keysLen;
+  int64_t         keysCap;
+} SGroupHashTable;
+
+// consecutive rows of the input block that belong to the same group
+typedef struct SGroupRun {
+  int32_t  startRow;
+  int32_t  numOfRows;
+  int32_t  keyOffset;  // offset of the window key in pRunKeys
+  int32_t  keyLen;
+  uint64_t hashVal;
+} SGroupRun;
+
+typedef struct SGroupbyOperatorInfo {
+  SOptrBasicInfo  binfo;
+  SAggSupporter   aggSup;
+  SArray*         pGroupCols;     // group by columns, SArray<SColumn>
+  SArray*         pGroupColVals;  // current group column values, SArray<SGroupKeys>
+  bool            isInit;         // denote if current val is initialized or not
+  int32_t         groupKeyLen;    // total group by column width
+  SGroupResInfo   groupResInfo;
+  SExprSupp       scalarSup;
+  SGroupHashTable groupHash;
+  SArray*         pRuns;          // SArray<SGroupRun>, runs of the current input block
+  char*           pRunKeys;       // window keys of the runs
+  int32_t         runKeysLen;
+  int32_t         runKeysCap;
+  int32_t         maxGroups;      // too many groups in the batch model, MAX_INTERVAL_TIME_WINDOW by default
+} SGroupbyOperatorInfo;
+
 typedef struct SIntervalAggOperatorInfo {
   SOptrBasicInfo     binfo;              // basic info
   SAggSupporter      aggSup;             // aggregate supporter
@@ -495,6 +612,9 @@ typedef struct SIntervalAggOperatorInfo {
   uint64_t      curGroupId;  // initialize to UINT64_MAX
   uint64_t      handledGroupNum;
   BoundedQueue* pBQ;
+  SWinResCacheSupp winResSup;
+  SIntervalPaneSupp paneSup;
+  SIntervalOrderedSupp orderedSup;
 } SIntervalAggOperatorInfo;
 
 typedef struct SMergeAlignedIntervalAggOperatorInfo {
@@ -703,6 +823,7 @@ SSchemaWrapper* extractQueriedColumnSchema(SScanPhysiNode* pScanNode);
 int32_t initQueriedTableSchemaInfo(SReadHandle* pHandle, SScanPhysiNode* pScanNode, const char* dbName,
                                    SExecTaskInfo* pTaskInfo);
 void    cleanupQueriedTableScanInfo(void* p);
+void    setTableScanTimeRanges(STableScanInfo* pTableScanInfo, SArray* pRanges);
 
 void initBasicInfo(SOptrBasicInfo* pInfo, SSDataBlock* pBlock);
 void cleanupBasicInfo(SOptrBasicInfo* pInfo);
@@ -712,6 +833,9 @@ void    cleanupExprSupp(SExprSupp* pSup);
 
 int32_t initAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols, size_t keyBufSize,
                    const char* pkey, void* pState, SFunctionStateStore* pStore);
+// the result rows are located by the caller itself, pResultRowHashTable is left NULL
+int32_t initAggSupWithoutRowHash(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols,
+                                 size_t keyBufSize, const char* pkey, void* pState, SFunctionStateStore* pStore);
 void    cleanupAggSup(SAggSupporter* pAggSup);
 
 void initResultSizeInfo(SResultInfo* pResultInfo, int32_t numOfRows);
@@ -733,6 +857,8 @@ bool applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo
 
 void applyAggFunctionOnPartialTuples(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SColumnInfoData* pTimeWindowData,
                                      int32_t offset, int32_t forwardStep, int32_t numOfTotal, int32_t numOfOutput);
+void compactFunctions(SqlFunctionCtx* pDestCtx, SqlFunctionCtx* pSourceCtx, int32_t numOfOutput,
+                      SExecTaskInfo* pTaskInfo, SColumnInfoData* pTimeWindowData);
 
 int32_t extractDataBlockFromFetchRsp(SSDataBlock* pRes, char* pData, SArray* pColList, char** pNextStart);
 void    updateLoadRemoteInfo(SLoadRemoteDataInfo* pInfo, int64_t numOfRows, int32_t dataLen, int64_t startTs,
@@ -785,6 +911,7 @@ uint64_t calGroupIdByData(SPartitionBySupporter* pParSup, SExprSupp* pExprSup, S
 
 int32_t finalizeResultRows(SDiskbasedBuf* pBuf, SResultRowPosition* resultRowPosition, SExprSupp* pSup,
                            SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo);
+int32_t finalizeResultRow(SResultRow* pRow, SExprSupp* pSup, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo);
 
 bool    groupbyTbname(SNodeList* pGroupList);
 void    getNextIntervalWindow(SInterval* pInterval, STimeWindow* tw, int32_t order);
@@ -864,6 +991,8 @@ SSDataBlock* getNextBlockFromDownstreamImpl(struct SOperatorInfo* pOperator, int
 bool inSlidingWindow(SInterval* pInterval, STimeWindow* pWin, SDataBlockInfo* pBlockInfo);
 bool inCalSlidingWindow(SInterval* pInterval, STimeWindow* pWin, TSKEY calStart, TSKEY calEnd, EStreamType blockType);
 bool compareVal(const char* v, const SStateKeys* pKey);
+// index of the first true value in pFlags[start, rows), rows if there is none
+int32_t getNextTrueIndex(const bool* pFlags, int32_t start, int32_t rows);
 bool inWinRange(STimeWindow* range, STimeWindow* cur);
 
 int32_t getNextQualifiedWindow(SInterval* pInterval, STimeWindow* pNext, SDataBlockInfo* pDataBlockInfo,
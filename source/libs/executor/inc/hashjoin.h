@@ -20,6 +20,7 @@ extern "C" {
 #endif
 
 #define HASH_JOIN_DEFAULT_PAGE_SIZE 10485760
+#define HASH_JOIN_DETECT_MAX_CACHE_SIZE 67108864  // max bytes cached of one side while detecting the build table
 
 #pragma pack(push, 1) 
 typedef struct SBufRowInfo {
@@ -81,6 +82,11 @@ typedef struct SHJoinTableInfo {
   int32_t        valBufSize;
   SArray*        valVarCols;
   bool           valColExist;
+
+  SArray*        pCachedBlks;
+  int32_t        cachedBlkIdx;
+  int64_t        cachedSize;
+  bool           inputDone;
 } SHJoinTableInfo;
 
 typedef struct SHJoinExecInfo {
@@ -104,6 +110,8 @@ typedef struct SHJoinOperatorInfo {
   SArray*          pRowBufs;
   SNode*           pCond;
   SSHashObj*       pKeyHash;
+  bool             buildTableDetect;
+  int64_t          detectMaxCacheSize;
   bool             keyHashBuilt;
   SHJoinCtx        ctx;
   SHJoinExecInfo   execInfo;
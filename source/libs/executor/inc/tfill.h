@@ -77,6 +77,8 @@ typedef struct SFillInfo {
   SFillColInfo*    pFillCol;  // column info for fill operations
   SFillTagColInfo* pTags;     // tags value for filling gap
   const char*      id;
+  TSKEY*           pGapKeys;     // timestamps of the rows generated for one gap
+  int32_t          gapKeysCap;   // capacity of pGapKeys in rows
 } SFillInfo;
 
 typedef struct SResultCellData {
@@ -67,6 +67,7 @@ typedef struct STupleHandle STupleHandle;
 
 typedef SSDataBlock* (*_sort_fetch_block_fn_t)(void* param);
 typedef int32_t (*_sort_merge_compar_fn_t)(const void* p1, const void* p2, void* param);
+typedef void (*_sort_pq_bound_fn_t)(const void* pVal, void* param);
 
 /**
  *
@@ -82,6 +83,16 @@ SSortHandle* tsortCreateSortHandle(SArray* pOrderInfo, int32_t type, int32_t pag
 
 void tsortSetForceUsePQSort(SSortHandle* pHandle);
 
+/**
+ * set the callback to report the value of given slot of the last row kept by the pq sort, it is invoked after each
+ * input data block once the priority queue is full, and the value is NULL if the column of the last row is null.
+ * @param pHandle
+ * @param slotId
+ * @param fp
+ * @param param
+ */
+void tsortSetPQBoundFn(SSortHandle* pHandle, int32_t slotId, _sort_pq_bound_fn_t fp, void* param);
+
 /**
  *
  * @param pSortHandle
@@ -59,7 +59,10 @@ static int32_t doAggregateImpl(SOperatorInfo* pOperator, SqlFunctionCtx* pCtx);
 static SSDataBlock* getAggregateResult(SOperatorInfo* pOperator);
 
 static int32_t doInitAggInfoSup(SAggSupporter* pAggSup, SqlFunctionCtx* pCtx, int32_t numOfOutput, size_t keyBufSize,
-                         const char* pKey);
+                                const char* pKey, bool withRowHash);
+static int32_t doInitAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols,
+                            size_t keyBufSize, const char* pkey, void* pState, SFunctionStateStore* pStore,
+                            bool withRowHash);
 
 static int32_t addNewResultRowBuf(SResultRow* pWindowRes, SDiskbasedBuf* pResultBuf, uint32_t size);
 
@@ -461,17 +464,19 @@ int32_t addNewResultRowBuf(SResultRow* pWindowRes, SDiskbasedBuf* pResultBuf, ui
   return 0;
 }
 
-int32_t doInitAggInfoSup(SAggSupporter* pAggSup, SqlFunctionCtx* pCtx, int32_t numOfOutput, size_t keyBufSize,
-                         const char* pKey) {
+static int32_t doInitAggInfoSup(SAggSupporter* pAggSup, SqlFunctionCtx* pCtx, int32_t numOfOutput, size_t keyBufSize,
+                                const char* pKey, bool withRowHash) {
   int32_t code = 0;
   //  _hash_fn_t hashFn = taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY);
 
   pAggSup->currentPageId = -1;
   pAggSup->resultRowSize = getResultRowSize(pCtx, numOfOutput);
   pAggSup->keyBuf = taosMemoryCalloc(1, keyBufSize + POINTER_BYTES + sizeof(int64_t));
-  pAggSup->pResultRowHashTable = tSimpleHashInit(100, taosFastHash);
+  if (withRowHash) {
+    pAggSup->pResultRowHashTable = tSimpleHashInit(100, taosFastHash);
+  }
 
-  if (pAggSup->keyBuf == NULL || pAggSup->pResultRowHashTable == NULL) {
+  if (pAggSup->keyBuf == NULL || (withRowHash && pAggSup->pResultRowHashTable == NULL)) {
     return TSDB_CODE_OUT_OF_MEMORY;
   }
 
@@ -504,14 +509,15 @@ void cleanupAggSup(SAggSupporter* pAggSup) {
   destroyDiskbasedBuf(pAggSup->pResultBuf);
 }
 
-int32_t initAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols, size_t keyBufSize,
-                   const char* pkey, void* pState, SFunctionStateStore* pStore) {
+static int32_t doInitAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols,
+                            size_t keyBufSize, const char* pkey, void* pState, SFunctionStateStore* pStore,
+                            bool withRowHash) {
   int32_t code = initExprSupp(pSup, pExprInfo, numOfCols, pStore);
   if (code != TSDB_CODE_SUCCESS) {
     return code;
   }
 
-  code = doInitAggInfoSup(pAggSup, pSup->pCtx, numOfCols, keyBufSize, pkey);
+  code = doInitAggInfoSup(pAggSup, pSup->pCtx, numOfCols, keyBufSize, pkey, withRowHash);
   if (code != TSDB_CODE_SUCCESS) {
     return code;
   }
@@ -529,6 +535,16 @@ int32_t initAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t initAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols, size_t keyBufSize,
+                   const char* pkey, void* pState, SFunctionStateStore* pStore) {
+  return doInitAggSup(pSup, pAggSup, pExprInfo, numOfCols, keyBufSize, pkey, pState, pStore, true);
+}
+
+int32_t initAggSupWithoutRowHash(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols,
+                                 size_t keyBufSize, const char* pkey, void* pState, SFunctionStateStore* pStore) {
+  return doInitAggSup(pSup, pAggSup, pExprInfo, numOfCols, keyBufSize, pkey, pState, pStore, false);
+}
+
 void applyAggFunctionOnPartialTuples(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SColumnInfoData* pTimeWindowData,
                                      int32_t offset, int32_t forwardStep, int32_t numOfTotal, int32_t numOfOutput) {
   for (int32_t k = 0; k < numOfOutput; ++k) {
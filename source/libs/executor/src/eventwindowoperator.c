@@ -286,12 +286,7 @@ int32_t eventWindowAggImpl(SOperatorInfo* pOperator, SEventWindowOperatorInfo* p
   int32_t startIndex = pInfo->inWindow ? 0 : -1;
   while (rowIndex < pBlock->info.rows) {
     if (pInfo->inWindow) {  // let's find the first end value
-      for (rowIndex = startIndex; rowIndex < pBlock->info.rows; ++rowIndex) {
-        if (((bool*)pe->pData)[rowIndex]) {
-          break;
-        }
-      }
-
+      rowIndex = getNextTrueIndex((bool*)pe->pData, startIndex, pBlock->info.rows);
       if (rowIndex < pBlock->info.rows) {
         doEventWindowAggImpl(pInfo, pSup, startIndex, rowIndex, pBlock, tsList, pTaskInfo);
         doUpdateNumOfRows(pSup->pCtx, pInfo->pRow, pSup->numOfExprs, pSup->rowEntryInfoOffset);
@@ -314,13 +309,11 @@ int32_t eventWindowAggImpl(SOperatorInfo* pOperator, SEventWindowOperatorInfo* p
         doEventWindowAggImpl(pInfo, pSup, startIndex, pBlock->info.rows - 1, pBlock, tsList, pTaskInfo);
       }
     } else {  // find the first start value that is fulfill for the start condition
-      for (; rowIndex < pBlock->info.rows; ++rowIndex) {
-        if (((bool*)ps->pData)[rowIndex]) {
-          doKeepNewWindowStartInfo(pRowSup, tsList, rowIndex, gid);
-          pInfo->inWindow = true;
-          startIndex = rowIndex;
-          break;
-        }
+      rowIndex = getNextTrueIndex((bool*)ps->pData, rowIndex, pBlock->info.rows);
+      if (rowIndex < pBlock->info.rows) {
+        doKeepNewWindowStartInfo(pRowSup, tsList, rowIndex, gid);
+        pInfo->inWindow = true;
+        startIndex = rowIndex;
       }
 
       if (pInfo->inWindow) {
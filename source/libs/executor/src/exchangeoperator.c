@@ -22,6 +22,7 @@
 #include "query.h"
 #include "querytask.h"
 #include "tdatablock.h"
+#include "tglobal.h"
 #include "thash.h"
 #include "tmsg.h"
 #include "tname.h"
@@ -43,6 +44,8 @@ typedef struct SSourceDataInfo {
   SArray*            pSrcUidList;
   int32_t            srcOpType;
   bool               tableSeq;
+  int32_t            rspLen;
+  int64_t            fetchWait;  // accumulated latency of the fetch requests, in us
 } SSourceDataInfo;
 
 static void  destroyExchangeOperatorInfo(void* param);
@@ -59,6 +62,60 @@ static int32_t prepareLoadRemoteData(SOperatorInfo* pOperator);
 static int32_t handleLimitOffset(SOperatorInfo* pOperator, SLimitInfo* pLimitInfo, SSDataBlock* pBlock,
                                  bool holdDataInBuf);
 static int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDataInfo);
+static int32_t getExchangeExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len);
+
+static int32_t popReadySource(SExchangeInfo* pExchangeInfo) {
+  if (pExchangeInfo->ringHead == atomic_load_32(&pExchangeInfo->ringTail)) {
+    return -1;
+  }
+
+  // the slot is reserved by the rsp callback before it is filled, wait for the callback to finish it
+  int32_t* pSlot = &pExchangeInfo->pReadyRing[((uint32_t)pExchangeInfo->ringHead) & (pExchangeInfo->ringCap - 1)];
+  int32_t  val = 0;
+  while ((val = atomic_load_32(pSlot)) == 0) {
+    sched_yield();
+  }
+
+  atomic_store_32(pSlot, 0);
+  pExchangeInfo->ringHead += 1;
+  return val - 1;
+}
+
+static void pushReadySource(SExchangeInfo* pExchangeInfo, int32_t index) {
+  int32_t pos = atomic_fetch_add_32(&pExchangeInfo->ringTail, 1);
+  atomic_store_32(&pExchangeInfo->pReadyRing[((uint32_t)pos) & (pExchangeInfo->ringCap - 1)], index + 1);
+}
+
+static void consumeSourceRsp(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDataInfo) {
+  atomic_sub_fetch_64(&pExchangeInfo->pendingRspBytes, pDataInfo->rspLen);
+  pDataInfo->rspLen = 0;
+}
+
+static int32_t sendFetchRequestOrDefer(SExchangeInfo* pExchangeInfo, SExecTaskInfo* pTaskInfo, int32_t sourceIndex) {
+  if (atomic_load_64(&pExchangeInfo->pendingRspBytes) > pExchangeInfo->maxPendingRspBytes) {
+    qDebug("%s too many pending fetch rsp, %" PRId64 " bytes, defer fetch of source %d", GET_TASKID(pTaskInfo),
+           pExchangeInfo->pendingRspBytes, sourceIndex);
+    taosArrayPush(pExchangeInfo->pDeferredSources, &sourceIndex);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  return doSendFetchDataRequest(pExchangeInfo, pTaskInfo, sourceIndex);
+}
+
+static int32_t sendDeferredFetchRequests(SExchangeInfo* pExchangeInfo, SExecTaskInfo* pTaskInfo) {
+  while (taosArrayGetSize(pExchangeInfo->pDeferredSources) > 0 &&
+         atomic_load_64(&pExchangeInfo->pendingRspBytes) <= pExchangeInfo->maxPendingRspBytes) {
+    int32_t sourceIndex = *(int32_t*)taosArrayGet(pExchangeInfo->pDeferredSources, 0);
+    taosArrayRemove(pExchangeInfo->pDeferredSources, 0);
+
+    int32_t code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, sourceIndex);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
 
 static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeInfo* pExchangeInfo,
                                            SExecTaskInfo* pTaskInfo) {
@@ -73,23 +130,30 @@ static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeIn
   SSourceDataInfo* pDataInfo = NULL;
 
   while (1) {
+    code = sendDeferredFetchRequests(pExchangeInfo, pTaskInfo);
+    if (code != TSDB_CODE_SUCCESS) {
+      goto _error;
+    }
+
     qDebug("prepare wait for ready, %p, %s", pExchangeInfo, GET_TASKID(pTaskInfo));
+    int64_t st = taosGetTimestampUs();
     tsem_wait(&pExchangeInfo->ready);
+    pExchangeInfo->waitTime += taosGetTimestampUs() - st;
 
     if (isTaskKilled(pTaskInfo)) {
       T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
     }
 
-    for (int32_t i = 0; i < totalSources; ++i) {
+    // handle the fetch rsp in the order of arrival, so that a slow source does not hold back the others
+    int32_t i = popReadySource(pExchangeInfo);
+    while (i >= 0) {
       pDataInfo = taosArrayGet(pExchangeInfo->pSourceDataInfo, i);
-      if (pDataInfo->status == EX_SOURCE_DATA_EXHAUSTED) {
-        continue;
-      }
-
       if (pDataInfo->status != EX_SOURCE_DATA_READY) {
+        i = popReadySource(pExchangeInfo);
         continue;
       }
 
+      consumeSourceRsp(pExchangeInfo, pDataInfo);
       if (pDataInfo->code != TSDB_CODE_SUCCESS) {
         code = pDataInfo->code;
         goto _error;
@@ -103,7 +167,7 @@ static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeIn
       if (pRsp->numOfRows == 0) {
         if (NULL != pDataInfo->pSrcUidList) {
           pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
-          code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, i);
+          code = sendFetchRequestOrDefer(pExchangeInfo, pTaskInfo, i);
           if (code != TSDB_CODE_SUCCESS) {
             taosMemoryFreeClear(pDataInfo->pRsp);
             goto _error;
@@ -147,14 +211,14 @@ static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeIn
 
       if (pDataInfo->status != EX_SOURCE_DATA_EXHAUSTED || NULL != pDataInfo->pSrcUidList) {
         pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
-        code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, i);
+        code = sendFetchRequestOrDefer(pExchangeInfo, pTaskInfo, i);
         if (code != TSDB_CODE_SUCCESS) {
           taosMemoryFreeClear(pDataInfo->pRsp);
           goto _error;
         }
       }
       return;
-    }  // end loop
+    }
 
     int32_t complete1 = getCompletedSources(pExchangeInfo->pSourceDataInfo);
     if (complete1 == totalSources) {
@@ -304,6 +368,19 @@ static int32_t initExchangeOperator(SExchangePhysiNode* pExNode, SExchangeInfo*
     tSimpleHashPut(pInfo->pHashSources, &pNode->addr.nodeId, sizeof(pNode->addr.nodeId), &idx, sizeof(idx));
   }
 
+  // each source has at most one outstanding fetch request, so the ring never holds more than numOfSources items
+  pInfo->ringCap = 1;
+  while (pInfo->ringCap < numOfSources) {
+    pInfo->ringCap <<= 1;
+  }
+
+  pInfo->maxPendingRspBytes = tsExchangeMaxPendingRspSize * 1048576L;
+  pInfo->pReadyRing = taosMemoryCalloc(pInfo->ringCap, sizeof(int32_t));
+  pInfo->pDeferredSources = taosArrayInit(4, sizeof(int32_t));
+  if (pInfo->pReadyRing == NULL || pInfo->pDeferredSources == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
   initLimitInfo(pExNode->node.pLimit, pExNode->node.pSlimit, &pInfo->limitInfo);
   pInfo->self = taosAddRef(exchangeObjRefPool, pInfo);
 
@@ -343,8 +420,8 @@ SOperatorInfo* createExchangeOperatorInfo(void* pTransporter, SExchangePhysiNode
     goto _error;
   }
 
-  pOperator->fpSet =
-      createOperatorFpSet(prepareLoadRemoteData, loadRemoteData, NULL, destroyExchangeOperatorInfo, optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+  pOperator->fpSet = createOperatorFpSet(prepareLoadRemoteData, loadRemoteData, NULL, destroyExchangeOperatorInfo,
+                                         optrDefaultBufFn, getExchangeExplainExecInfo, optrDefaultGetNextExtFn, NULL);
   return pOperator;
 
 _error:
@@ -383,6 +460,9 @@ void doDestroyExchangeOperatorInfo(void* param) {
 
   blockDataDestroy(pExInfo->pDummyBlock);
   tSimpleHashCleanup(pExInfo->pHashSources);
+
+  taosMemoryFreeClear(pExInfo->pReadyRing);
+  taosArrayDestroy(pExInfo->pDeferredSources);
   
   tsem_destroy(&pExInfo->ready);
   taosMemoryFreeClear(param);
@@ -400,6 +480,7 @@ int32_t loadRemoteDataCallback(void* param, SDataBuf* pMsg, int32_t code) {
 
   int32_t          index = pWrapper->sourceIndex;
   SSourceDataInfo* pSourceDataInfo = taosArrayGet(pExchangeInfo->pSourceDataInfo, index);
+  pSourceDataInfo->fetchWait += taosGetTimestampUs() - pSourceDataInfo->startTime;
 
   if (code == TSDB_CODE_SUCCESS) {
     pSourceDataInfo->pRsp = pMsg->pData;
@@ -421,6 +502,12 @@ int32_t loadRemoteDataCallback(void* param, SDataBuf* pMsg, int32_t code) {
   }
 
   pSourceDataInfo->status = EX_SOURCE_DATA_READY;
+  if (!pExchangeInfo->seqLoadData) {
+    pSourceDataInfo->rspLen = (code == TSDB_CODE_SUCCESS) ? pMsg->len : 0;
+    atomic_add_fetch_64(&pExchangeInfo->pendingRspBytes, pSourceDataInfo->rspLen);
+    pushReadySource(pExchangeInfo, index);
+  }
+
   code = tsem_post(&pExchangeInfo->ready);
   if (code != TSDB_CODE_SUCCESS) {
     code = TAOS_SYSTEM_ERROR(code);
@@ -480,6 +567,10 @@ int32_t doSendFetchDataRequest(SExchangeInfo* pExchangeInfo, SExecTaskInfo* pTas
     int32_t  code =
         (*pTaskInfo->localFetch.fp)(pTaskInfo->localFetch.handle, pSource->schedId, pTaskInfo->id.queryId,
                                     pSource->taskId, 0, pSource->execId, &pBuf.pData, pTaskInfo->localFetch.explainRes);
+    // the local rsp is counted in the pending rsp bytes as the remote one
+    if (code == TSDB_CODE_SUCCESS && pBuf.pData != NULL) {
+      pBuf.len = sizeof(SRetrieveTableRsp) + htonl(((SRetrieveTableRsp*)pBuf.pData)->compLen);
+    }
     loadRemoteDataCallback(pWrapper, &pBuf, code);
     taosMemoryFree(pWrapper);
   } else {
@@ -921,3 +1012,26 @@ int32_t handleLimitOffset(SOperatorInfo* pOperator, SLimitInfo* pLimitInfo, SSDa
     return PROJECT_RETRIEVE_CONTINUE;
   }
 }
+
+int32_t getExchangeExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SExchangeInfo*     pExchangeInfo = pOptr->info;
+  SExchangeExecInfo* pExecInfo = taosMemoryCalloc(1, sizeof(SExchangeExecInfo));
+  if (pExecInfo == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pExecInfo->numOfSources = taosArrayGetSize(pExchangeInfo->pSourceDataInfo);
+  pExecInfo->waitTime = pExchangeInfo->waitTime;
+  for (int32_t i = 0; i < pExecInfo->numOfSources; ++i) {
+    SSourceDataInfo* pDataInfo = taosArrayGet(pExchangeInfo->pSourceDataInfo, i);
+    if (pDataInfo->fetchWait > pExecInfo->slowestWait) {
+      SDownstreamSourceNode* pSource = taosArrayGet(pExchangeInfo->pSources, pDataInfo->index);
+      pExecInfo->slowestWait = pDataInfo->fetchWait;
+      pExecInfo->slowestVgId = pSource->addr.nodeId;
+    }
+  }
+
+  *pOptrExplain = pExecInfo;
+  *len = sizeof(SExchangeExecInfo);
+  return TSDB_CODE_SUCCESS;
+}
@@ -1713,6 +1713,99 @@ SColumn extractColumnFromColumnNode(SColumnNode* pColNode) {
   return c;
 }
 
+#define MAX_EQ_COND_NUM 8
+
+static bool isEqCondValueMatched(const SColumnNode* pCol, const SValueNode* pVal) {
+  int8_t colType = pCol->node.resType.type;
+  int8_t valType = pVal->node.resType.type;
+  if (pVal->isNull || pCol->colType != COLUMN_TYPE_COLUMN || pCol->colId == PRIMARYKEY_TIMESTAMP_COL_ID) {
+    return false;
+  }
+
+  if (colType == valType) {
+    return IS_INTEGER_TYPE(colType) || colType == TSDB_DATA_TYPE_TIMESTAMP || colType == TSDB_DATA_TYPE_VARCHAR ||
+           colType == TSDB_DATA_TYPE_NCHAR;
+  }
+
+  // the integer constants are bigint by default, only accept the value that stays exact in any comparison type
+  return (IS_INTEGER_TYPE(colType) || colType == TSDB_DATA_TYPE_TIMESTAMP) && valType == TSDB_DATA_TYPE_BIGINT &&
+         pVal->datum.i >= -(1LL << 53) && pVal->datum.i <= (1LL << 53);
+}
+
+static int32_t extractEqCond(SNode* pNode, SArray* pList) {
+  if (nodeType(pNode) != QUERY_NODE_OPERATOR || ((SOperatorNode*)pNode)->opType != OP_TYPE_EQUAL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SOperatorNode* pOper = (SOperatorNode*)pNode;
+  SNode*         pLeft = pOper->pLeft;
+  SNode*         pRight = pOper->pRight;
+  if (nodeType(pLeft) == QUERY_NODE_VALUE) {
+    TSWAP(pLeft, pRight);
+  }
+
+  if (pRight == NULL || nodeType(pLeft) != QUERY_NODE_COLUMN || nodeType(pRight) != QUERY_NODE_VALUE) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnNode* pCol = (SColumnNode*)pLeft;
+  SValueNode*  pVal = (SValueNode*)pRight;
+  if (!isEqCondValueMatched(pCol, pVal) || taosArrayGetSize(pList) >= MAX_EQ_COND_NUM) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnEqCond cond = {.colId = pCol->colId, .type = pCol->node.resType.type};
+  if (IS_VAR_DATA_TYPE(cond.type)) {
+    cond.pData = taosMemoryMalloc(varDataTLen(pVal->datum.p));
+    if (cond.pData == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    memcpy(cond.pData, pVal->datum.p, varDataTLen(pVal->datum.p));
+  } else {
+    cond.val = pVal->datum.i;
+  }
+
+  taosArrayPush(pList, &cond);
+  return TSDB_CODE_SUCCESS;
+}
+
+static void destroyEqCond(void* p) { taosMemoryFreeClear(((SColumnEqCond*)p)->pData); }
+
+// the equal conditions on normal columns, which are always AND-ed with the rest conditions, are used to skip the data
+// blocks by the block bloom filter
+static int32_t initEqCondList(SQueryTableDataCond* pCond, SNode* pConditions) {
+  if (pConditions == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SArray* pList = taosArrayInit(4, sizeof(SColumnEqCond));
+  if (pList == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (nodeType(pConditions) == QUERY_NODE_LOGIC_CONDITION &&
+      ((SLogicConditionNode*)pConditions)->condType == LOGIC_COND_TYPE_AND) {
+    SNode* pNode = NULL;
+    FOREACH(pNode, ((SLogicConditionNode*)pConditions)->pParameterList) {
+      code = extractEqCond(pNode, pList);
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+    }
+  } else {
+    code = extractEqCond(pConditions, pList);
+  }
+
+  if (code != TSDB_CODE_SUCCESS || taosArrayGetSize(pList) == 0) {
+    taosArrayDestroyEx(pList, destroyEqCond);
+    return code;
+  }
+
+  pCond->pEqCondList = pList;
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t initQueryTableDataCond(SQueryTableDataCond* pCond, const STableScanPhysiNode* pTableScanNode, const SReadHandle* readHandle) {
   pCond->order = pTableScanNode->scanSeq[0] > 0 ? TSDB_ORDER_ASC : TSDB_ORDER_DESC;
   pCond->numOfCols = LIST_LENGTH(pTableScanNode->scan.pScanCols);
@@ -1756,12 +1849,14 @@ int32_t initQueryTableDataCond(SQueryTableDataCond* pCond, const STableScanPhysi
   }
 
   pCond->numOfCols = j;
-  return TSDB_CODE_SUCCESS;
+  return initEqCondList(pCond, pTableScanNode->scan.node.pConditions);
 }
 
 void cleanupQueryTableDataCond(SQueryTableDataCond* pCond) {
   taosMemoryFreeClear(pCond->colList);
   taosMemoryFreeClear(pCond->pSlotList);
+  taosArrayDestroyEx(pCond->pEqCondList, destroyEqCond);
+  pCond->pEqCondList = NULL;
 }
 
 int32_t convertFillType(int32_t mode) {
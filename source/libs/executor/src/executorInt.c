@@ -616,24 +616,14 @@ void copyResultrowToDataBlock(SExprInfo* pExprInfo, int32_t numOfExprs, SResultR
 }
 
 // todo refactor. SResultRow has direct pointer in miainfo
-int32_t finalizeResultRows(SDiskbasedBuf* pBuf, SResultRowPosition* resultRowPosition, SExprSupp* pSup,
-                           SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo) {
-  SFilePage* page = getBufPage(pBuf, resultRowPosition->pageId);
-  if (page == NULL) {
-    qError("failed to get buffer, code:%s, %s", tstrerror(terrno), GET_TASKID(pTaskInfo));
-    T_LONG_JMP(pTaskInfo->env, terrno);
-  }
-
-  SResultRow* pRow = (SResultRow*)((char*)page + resultRowPosition->offset);
-
+int32_t finalizeResultRow(SResultRow* pRow, SExprSupp* pSup, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo) {
   SqlFunctionCtx* pCtx = pSup->pCtx;
   SExprInfo*      pExprInfo = pSup->pExprInfo;
   const int32_t*  rowEntryOffset = pSup->rowEntryInfoOffset;
 
   doUpdateNumOfRows(pCtx, pRow, pSup->numOfExprs, rowEntryOffset);
   if (pRow->numOfRows == 0) {
-    releaseBufPage(pBuf, page);
-    return 0;
+    return TSDB_CODE_SUCCESS;
   }
 
   int32_t size = pBlock->info.capacity;
@@ -643,15 +633,30 @@ int32_t finalizeResultRows(SDiskbasedBuf* pBuf, SResultRowPosition* resultRowPos
 
   int32_t code = blockDataEnsureCapacity(pBlock, size);
   if (TAOS_FAILED(code)) {
-    releaseBufPage(pBuf, page);
     qError("%s ensure result data capacity failed, code %s", GET_TASKID(pTaskInfo), tstrerror(code));
-    T_LONG_JMP(pTaskInfo->env, code);
+    return code;
   }
 
   copyResultrowToDataBlock(pExprInfo, pSup->numOfExprs, pRow, pCtx, pBlock, rowEntryOffset, pTaskInfo);
+  pBlock->info.rows += pRow->numOfRows;
+  return TSDB_CODE_SUCCESS;
+}
 
+int32_t finalizeResultRows(SDiskbasedBuf* pBuf, SResultRowPosition* resultRowPosition, SExprSupp* pSup,
+                           SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo) {
+  SFilePage* page = getBufPage(pBuf, resultRowPosition->pageId);
+  if (page == NULL) {
+    qError("failed to get buffer, code:%s, %s", tstrerror(terrno), GET_TASKID(pTaskInfo));
+    T_LONG_JMP(pTaskInfo->env, terrno);
+  }
+
+  SResultRow* pRow = (SResultRow*)((char*)page + resultRowPosition->offset);
+
+  int32_t code = finalizeResultRow(pRow, pSup, pBlock, pTaskInfo);
   releaseBufPage(pBuf, page);
-  pBlock->info.rows += pRow->numOfRows;
+  if (TAOS_FAILED(code)) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
   return 0;
 }
 
@@ -1168,3 +1173,12 @@ bool compareVal(const char* v, const SStateKeys* pKey) {
     return memcmp(pKey->pData, v, pKey->bytes) == 0;
   }
 }
+
+int32_t getNextTrueIndex(const bool* pFlags, int32_t start, int32_t rows) {
+  if (start >= rows) {
+    return rows;
+  }
+
+  const bool* p = memchr(pFlags + start, true, rows - start);
+  return (p != NULL) ? (int32_t)(p - pFlags) : rows;
+}
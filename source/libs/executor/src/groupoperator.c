@@ -28,17 +28,15 @@
 #include "thash.h"
 #include "ttypes.h"
 
-typedef struct SGroupbyOperatorInfo {
-  SOptrBasicInfo binfo;
-  SAggSupporter  aggSup;
-  SArray*        pGroupCols;     // group by columns, SArray<SColumn>
-  SArray*        pGroupColVals;  // current group column values, SArray<SGroupKeys>
-  bool           isInit;         // denote if current val is initialized or not
-  char*          keyBuf;         // group by keys for hash
-  int32_t        groupKeyLen;    // total group by column width
-  SGroupResInfo  groupResInfo;
-  SExprSupp      scalarSup;
-} SGroupbyOperatorInfo;
+#ifdef WINDOWS
+#define GROUP_HASH_PREFETCH(_p)
+#else
+#define GROUP_HASH_PREFETCH(_p) __builtin_prefetch((_p))
+#endif
+
+#define GROUP_HASH_INIT_CAPACITY 1024
+#define GROUP_HASH_PREFETCH_DIST 8
+#define GROUP_HASH_NEED_RESIZE(_t, _n) (((int64_t)(_t)->size + (_n)) * 4 > (int64_t)(_t)->capacity * 3)
 
 // The sort in partition may be needed later.
 typedef struct SPartitionOperatorInfo {
@@ -64,10 +62,17 @@ typedef struct SPartitionOperatorInfo {
 
 static void*    getCurrentDataGroupInfo(const SPartitionOperatorInfo* pInfo, SDataGroupInfo** pGroupInfo, int32_t len);
 static int32_t* setupColumnOffset(const SSDataBlock* pBlock, int32_t rowCapacity);
-static int32_t  setGroupResultOutputBuf(SOperatorInfo* pOperator, SOptrBasicInfo* binfo, int32_t numOfCols, char* pData,
-                                        int32_t bytes, uint64_t groupId, SDiskbasedBuf* pBuf, SAggSupporter* pAggSup);
 static SArray*  extractColumnInfo(SNodeList* pNodeList);
 
+static void cleanupGroupHashTable(SGroupHashTable* pTable) {
+  taosMemoryFreeClear(pTable->pSlots);
+  taosMemoryFreeClear(pTable->pKeys);
+  pTable->capacity = 0;
+  pTable->size = 0;
+  pTable->keysLen = 0;
+  pTable->keysCap = 0;
+}
+
 static void freeGroupKey(void* param) {
   SGroupKeys* pKey = (SGroupKeys*)param;
   taosMemoryFree(pKey->pData);
@@ -80,7 +85,9 @@ static void destroyGroupOperatorInfo(void* param) {
   }
 
   cleanupBasicInfo(&pInfo->binfo);
-  taosMemoryFreeClear(pInfo->keyBuf);
+  cleanupGroupHashTable(&pInfo->groupHash);
+  taosArrayDestroy(pInfo->pRuns);
+  taosMemoryFreeClear(pInfo->pRunKeys);
   taosArrayDestroy(pInfo->pGroupCols);
   taosArrayDestroyEx(pInfo->pGroupColVals, freeGroupKey);
   cleanupExprSupp(&pInfo->scalarSup);
@@ -116,6 +123,11 @@ static int32_t initGroupOptrInfo(SArray** pGroupColVals, int32_t* keyLen, char**
   int32_t nullFlagSize = sizeof(int8_t) * numOfGroupCols;
   (*keyLen) += nullFlagSize;
 
+  // the group operator builds the keys of the runs in its own buffer
+  if (keyBuf == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
   (*keyBuf) = taosMemoryCalloc(1, (*keyLen));
   if ((*keyBuf) == NULL) {
     return TSDB_CODE_OUT_OF_MEMORY;
@@ -272,6 +284,170 @@ static void doAssignGroupKeys(SqlFunctionCtx* pCtx, int32_t numOfOutput, int32_t
   }
 }
 
+// make room for numOfNewGroups more groups, the slots are rehashed into a larger array if the load factor exceeds 0.75
+static int32_t ensureGroupHashCapacity(SGroupHashTable* pTable, int32_t numOfNewGroups) {
+  if (pTable->pSlots != NULL && !GROUP_HASH_NEED_RESIZE(pTable, numOfNewGroups)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int64_t newCapacity = (pTable->capacity == 0) ? GROUP_HASH_INIT_CAPACITY : pTable->capacity;
+  while (((int64_t)pTable->size + numOfNewGroups) * 4 > newCapacity * 3) {
+    newCapacity <<= 1u;
+  }
+  if (newCapacity > INT32_MAX) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  SGroupHashSlot* pSlots = taosMemoryCalloc(newCapacity, sizeof(SGroupHashSlot));
+  if (pSlots == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  uint64_t mask = newCapacity - 1;
+  for (int32_t i = 0; i < pTable->capacity; ++i) {
+    SGroupHashSlot* pSlot = &pTable->pSlots[i];
+    if (pSlot->keyLen == 0) {
+      continue;
+    }
+
+    uint64_t idx = pSlot->hashVal & mask;
+    while (pSlots[idx].keyLen != 0) {
+      idx = (idx + 1) & mask;
+    }
+    pSlots[idx] = *pSlot;
+  }
+
+  taosMemoryFree(pTable->pSlots);
+  pTable->pSlots = pSlots;
+  pTable->capacity = (int32_t)newCapacity;
+  return TSDB_CODE_SUCCESS;
+}
+
+// return the slot of the key, or the empty slot where the key should be put
+static SGroupHashSlot* findGroupHashSlot(SGroupHashTable* pTable, const char* pKey, int32_t keyLen, uint64_t hashVal) {
+  uint64_t mask = pTable->capacity - 1;
+  uint64_t idx = hashVal & mask;
+  while (1) {
+    SGroupHashSlot* pSlot = &pTable->pSlots[idx];
+    if (pSlot->keyLen == 0) {
+      return pSlot;
+    }
+
+    if (pSlot->hashVal == hashVal && pSlot->keyLen == keyLen &&
+        memcmp(pTable->pKeys + pSlot->keyOffset + sizeof(uint64_t), pKey, keyLen) == 0) {
+      return pSlot;
+    }
+    idx = (idx + 1) & mask;
+  }
+}
+
+static int32_t putGroupHashKey(SGroupHashTable* pTable, SGroupHashSlot* pSlot, const char* pKey, int32_t keyLen,
+                               uint64_t hashVal) {
+  int64_t len = sizeof(uint64_t) + keyLen;
+  if (pTable->keysLen + len > pTable->keysCap) {
+    int64_t newCap = TMAX(pTable->keysCap * 2, TMAX(pTable->keysLen + len, 4096));
+    char*   p = taosMemoryRealloc(pTable->pKeys, newCap);
+    if (p == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    pTable->pKeys = p;
+    pTable->keysCap = newCap;
+  }
+
+  // the group id of the output block is only calculated once for each group
+  uint64_t groupId = calcGroupId((char*)pKey, keyLen);
+  char*    pDst = pTable->pKeys + pTable->keysLen;
+  memcpy(pDst, &groupId, sizeof(uint64_t));
+  memcpy(pDst + sizeof(uint64_t), pKey, keyLen);
+
+  pSlot->hashVal = hashVal;
+  pSlot->keyOffset = pTable->keysLen;
+  pSlot->keyLen = keyLen;
+  pTable->keysLen += len;
+  pTable->size += 1;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void appendGroupRun(SOperatorInfo* pOperator, SSDataBlock* pBlock, int32_t startRow, int32_t numOfRows) {
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+
+  int32_t maxLen = GET_RES_WINDOW_KEY_LEN(pInfo->groupKeyLen);
+  if (pInfo->runKeysLen + maxLen > pInfo->runKeysCap) {
+    int32_t newCap = TMAX(pInfo->runKeysCap * 2, pInfo->runKeysLen + maxLen);
+    char*   p = taosMemoryRealloc(pInfo->pRunKeys, newCap);
+    if (p == NULL) {
+      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+    }
+    pInfo->pRunKeys = p;
+    pInfo->runKeysCap = newCap;
+  }
+
+  // same layout as the key of the result row hash table: groupId of the input block followed by the group keys
+  char*   pKey = pInfo->pRunKeys + pInfo->runKeysLen;
+  int32_t len = buildGroupKeys(pKey + sizeof(uint64_t), pInfo->pGroupColVals);
+  memcpy(pKey, &pBlock->info.id.groupId, sizeof(uint64_t));
+
+  SGroupRun run = {.startRow = startRow,
+                   .numOfRows = numOfRows,
+                   .keyOffset = pInfo->runKeysLen,
+                   .keyLen = GET_RES_WINDOW_KEY_LEN(len)};
+  if (taosArrayPush(pInfo->pRuns, &run) == NULL) {
+    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+  }
+  pInfo->runKeysLen += run.keyLen;
+}
+
+static SResultRow* setGroupHashResultRow(SOperatorInfo* pOperator, const SGroupRun* pRun) {
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SAggSupporter*        pSup = &pInfo->aggSup;
+  SResultRowInfo*       pResultRowInfo = &pInfo->binfo.resultRowInfo;
+  SDiskbasedBuf*        pResultBuf = pSup->pResultBuf;
+  const char*           pKey = pInfo->pRunKeys + pRun->keyOffset;
+
+  SGroupHashSlot* pSlot = findGroupHashSlot(&pInfo->groupHash, pKey, pRun->keyLen, pRun->hashVal);
+  SResultRow*     pResult = NULL;
+  if (pSlot->keyLen != 0) {
+    pResult = getResultRowByPos(pResultBuf, &pSlot->pos, true);
+    if (NULL == pResult) {
+      T_LONG_JMP(pTaskInfo->env, terrno);
+    }
+  }
+
+  // close current opened result row
+  if (pResultRowInfo->cur.pageId != -1 && ((pResult == NULL) || (pResult->pageId != pResultRowInfo->cur.pageId))) {
+    SFilePage* pPage = getBufPage(pResultBuf, pResultRowInfo->cur.pageId);
+    if (pPage == NULL) {
+      qError("failed to get buffer, code:%s, %s", tstrerror(terrno), GET_TASKID(pTaskInfo));
+      T_LONG_JMP(pTaskInfo->env, terrno);
+    }
+    releaseBufPage(pResultBuf, pPage);
+  }
+
+  if (pResult == NULL) {
+    pResult = getNewResultRow(pResultBuf, &pSup->currentPageId, pSup->resultRowSize);
+    if (pResult == NULL) {
+      T_LONG_JMP(pTaskInfo->env, terrno);
+    }
+
+    pSlot->pos = (SResultRowPosition){.pageId = pResult->pageId, .offset = pResult->offset};
+    int32_t code = putGroupHashKey(&pInfo->groupHash, pSlot, pKey, pRun->keyLen, pRun->hashVal);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+  }
+
+  pResultRowInfo->cur = (SResultRowPosition){.pageId = pResult->pageId, .offset = pResult->offset};
+
+  // too many groups in query
+  if (pTaskInfo->execModel == OPTR_EXEC_MODEL_BATCH && pInfo->groupHash.size > pInfo->maxGroups) {
+    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_QRY_TOO_MANY_TIMEWINDOW);
+  }
+
+  return pResult;
+}
+
 static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
   SGroupbyOperatorInfo* pInfo = pOperator->info;
@@ -283,11 +459,12 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   //    return;
   //  }
 
-  int32_t len = 0;
   terrno = TSDB_CODE_SUCCESS;
+  taosArrayClear(pInfo->pRuns);
+  pInfo->runKeysLen = 0;
 
+  // 1. split the block into runs of rows with identical group keys
   int32_t num = 0;
-  uint64_t groupId = 0;
   for (int32_t j = 0; j < pBlock->info.rows; ++j) {
     // Compare with the previous row of this column, and do not set the output buffer again if they are identical.
     if (!pInfo->isInit) {
@@ -316,35 +493,45 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
       continue;
     }
 
-    len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
-    int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf,
-                                          len, pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
-    if (ret != TSDB_CODE_SUCCESS) {  // null data, too many state code
-      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
-    }
-
-    int32_t rowIndex = j - num;
-    applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
-                                    pOperator->exprSupp.numOfExprs);
-
-    // assign the group keys or user input constant values if required
-    doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+    appendGroupRun(pOperator, pBlock, j - num, num);
     recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, j);
     num = 1;
   }
 
   if (num > 0) {
-    len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
-    int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf,
-                                          len, pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
-    if (ret != TSDB_CODE_SUCCESS) {
-      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
+    appendGroupRun(pOperator, pBlock, pBlock->info.rows - num, num);
+  }
+
+  // 2. hash the keys of all runs in one pass, and reserve the slots for the groups that may be new, so that the slots
+  // do not move while the runs are aggregated.
+  SGroupHashTable* pTable = &pInfo->groupHash;
+  int32_t          numOfRuns = taosArrayGetSize(pInfo->pRuns);
+  int32_t          code = ensureGroupHashCapacity(pTable, numOfRuns);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  SGroupRun* pRuns = TARRAY_DATA(pInfo->pRuns);
+  for (int32_t i = 0; i < numOfRuns; ++i) {
+    pRuns[i].hashVal = MurmurHash3_64(pInfo->pRunKeys + pRuns[i].keyOffset, pRuns[i].keyLen);
+  }
+
+  // 3. locate the result row of each run and apply the aggregate functions on all rows of the run at once
+  uint64_t mask = pTable->capacity - 1;
+  for (int32_t i = 0; i < numOfRuns; ++i) {
+    if (i + GROUP_HASH_PREFETCH_DIST < numOfRuns) {
+      GROUP_HASH_PREFETCH(&pTable->pSlots[pRuns[i + GROUP_HASH_PREFETCH_DIST].hashVal & mask]);
     }
 
-    int32_t rowIndex = pBlock->info.rows - num;
-    applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
+    SGroupRun*  pRun = &pRuns[i];
+    SResultRow* pResult = setGroupHashResultRow(pOperator, pRun);
+    setResultRowInitCtx(pResult, pCtx, pOperator->exprSupp.numOfExprs, pOperator->exprSupp.rowEntryInfoOffset);
+
+    applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, pRun->startRow, pRun->numOfRows, pBlock->info.rows,
                                     pOperator->exprSupp.numOfExprs);
-    doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+
+    // assign the group keys or user input constant values if required
+    doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, pRun->startRow);
   }
 }
 
@@ -372,14 +559,81 @@ static SSDataBlock* buildGroupResultDataBlock(SOperatorInfo* pOperator) {
 
 bool hasRemainResultByHash(SOperatorInfo* pOperator) {
   SGroupbyOperatorInfo* pInfo = pOperator->info;
-  SSHashObj* pHashmap = pInfo->aggSup.pResultRowHashTable;
-  return pInfo->groupResInfo.index < tSimpleHashGetSize(pHashmap);
+  return pInfo->groupResInfo.index < pInfo->groupHash.size;
+}
+
+static void doCopyToSDataBlockByGroupHash(SOperatorInfo* pOperator, SSDataBlock* pBlock, bool ignoreGroup) {
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SExprSupp*            pSup = &pOperator->exprSupp;
+  SGroupResInfo*        pGroupResInfo = &pInfo->groupResInfo;
+  SGroupHashTable*      pTable = &pInfo->groupHash;
+  SDiskbasedBuf*        pBuf = pInfo->aggSup.pResultBuf;
+
+  // iter is the next slot to be checked
+  for (; pGroupResInfo->iter < pTable->capacity; ++pGroupResInfo->iter) {
+    SGroupHashSlot* pSlot = &pTable->pSlots[pGroupResInfo->iter];
+    if (pSlot->keyLen == 0) {
+      continue;
+    }
+
+    uint64_t groupId = 0;
+    memcpy(&groupId, pTable->pKeys + pSlot->keyOffset, sizeof(uint64_t));
+
+    SFilePage* page = getBufPage(pBuf, pSlot->pos.pageId);
+    if (page == NULL) {
+      qError("failed to get buffer, code:%s, %s", tstrerror(terrno), GET_TASKID(pTaskInfo));
+      T_LONG_JMP(pTaskInfo->env, terrno);
+    }
+
+    SResultRow* pRow = (SResultRow*)((char*)page + pSlot->pos.offset);
+    doUpdateNumOfRows(pSup->pCtx, pRow, pSup->numOfExprs, pSup->rowEntryInfoOffset);
+
+    // no results, continue to check the next one
+    if (pRow->numOfRows == 0) {
+      pGroupResInfo->index += 1;
+      releaseBufPage(pBuf, page);
+      continue;
+    }
+
+    if (!ignoreGroup) {
+      if (pBlock->info.id.groupId == 0) {
+        pBlock->info.id.groupId = groupId;
+      } else if (pBlock->info.id.groupId != groupId) {
+        // current value belongs to different group, it can't be packed into one datablock
+        releaseBufPage(pBuf, page);
+        break;
+      }
+    }
+
+    if (pBlock->info.rows + pRow->numOfRows > pBlock->info.capacity) {
+      uint32_t newSize = pBlock->info.rows + pRow->numOfRows;
+      blockDataEnsureCapacity(pBlock, newSize);
+      qDebug("datablock capacity not sufficient, expand to required:%d, current capacity:%d, %s", newSize,
+             pBlock->info.capacity, GET_TASKID(pTaskInfo));
+    }
+
+    pGroupResInfo->index += 1;
+    copyResultrowToDataBlock(pSup->pExprInfo, pSup->numOfExprs, pRow, pSup->pCtx, pBlock, pSup->rowEntryInfoOffset,
+                             pTaskInfo);
+
+    releaseBufPage(pBuf, page);
+    pBlock->info.rows += pRow->numOfRows;
+    if (pBlock->info.rows >= pOperator->resultInfo.threshold) {
+      pGroupResInfo->iter += 1;
+      break;
+    }
+  }
+
+  qDebug("%s result generated, rows:%" PRId64 ", groupId:%" PRIu64, GET_TASKID(pTaskInfo), pBlock->info.rows,
+         pBlock->info.id.groupId);
+  pBlock->info.dataLoad = 1;
+  blockDataUpdateTsWindow(pBlock, 0);
 }
 
 void doBuildResultDatablockByHash(SOperatorInfo* pOperator, SOptrBasicInfo* pbInfo, SGroupResInfo* pGroupResInfo,
                                   SDiskbasedBuf* pBuf) {
   SGroupbyOperatorInfo* pInfo = pOperator->info;
-  SSHashObj*            pHashmap = pInfo->aggSup.pResultRowHashTable;
   SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
 
   SSDataBlock* pBlock = pInfo->binfo.pRes;
@@ -394,12 +648,10 @@ void doBuildResultDatablockByHash(SOperatorInfo* pOperator, SOptrBasicInfo* pbIn
 
   pBlock->info.id.groupId = 0;
   if (!pInfo->binfo.mergeResultBlock) {
-    doCopyToSDataBlockByHash(pTaskInfo, pBlock, &pOperator->exprSupp, pInfo->aggSup.pResultBuf, &pInfo->groupResInfo,
-                             pHashmap, pOperator->resultInfo.threshold, false);
+    doCopyToSDataBlockByGroupHash(pOperator, pBlock, false);
   } else {
     while (hasRemainResultByHash(pOperator)) {
-      doCopyToSDataBlockByHash(pTaskInfo, pBlock, &pOperator->exprSupp, pInfo->aggSup.pResultBuf, &pInfo->groupResInfo,
-                               pHashmap, pOperator->resultInfo.threshold, true);
+      doCopyToSDataBlockByGroupHash(pOperator, pBlock, true);
       if (pBlock->info.rows >= pOperator->resultInfo.threshold) {
         break;
       }
@@ -423,8 +675,7 @@ static SSDataBlock* buildGroupResultDataBlockByHash(SOperatorInfo* pOperator) {
     if (!hasRemainResultByHash(pOperator)) {
       setOperatorCompleted(pOperator);
       // clean hash after completed
-      tSimpleHashCleanup(pInfo->aggSup.pResultRowHashTable);
-      pInfo->aggSup.pResultRowHashTable = NULL;
+      cleanupGroupHashTable(&pInfo->groupHash);
       break;
     }
     if (pRes->info.rows > 0) {
@@ -535,15 +786,24 @@ SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode*
   initResultSizeInfo(&pOperator->resultInfo, 4096);
   blockDataEnsureCapacity(pInfo->binfo.pRes, pOperator->resultInfo.capacity);
 
-  code = initGroupOptrInfo(&pInfo->pGroupColVals, &pInfo->groupKeyLen, &pInfo->keyBuf, pInfo->pGroupCols);
+  code = initGroupOptrInfo(&pInfo->pGroupColVals, &pInfo->groupKeyLen, NULL, pInfo->pGroupCols);
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
   }
 
+  pInfo->maxGroups = MAX_INTERVAL_TIME_WINDOW;
+  pInfo->pRuns = taosArrayInit(pOperator->resultInfo.capacity, sizeof(SGroupRun));
+  if (pInfo->pRuns == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _error;
+  }
+
   int32_t    num = 0;
   SExprInfo* pExprInfo = createExprInfo(pAggNode->pAggFuncs, pAggNode->pGroupKeys, &num);
-  code = initAggSup(&pOperator->exprSupp, &pInfo->aggSup, pExprInfo, num, pInfo->groupKeyLen, pTaskInfo->id.str,
-                    pTaskInfo->streamInfo.pState, &pTaskInfo->storageAPI.functionStore);
+  // the result rows are located by the group hash table, instead of the result row hash table of the agg supporter
+  code = initAggSupWithoutRowHash(&pOperator->exprSupp, &pInfo->aggSup, pExprInfo, num, pInfo->groupKeyLen,
+                                  pTaskInfo->id.str, pTaskInfo->streamInfo.pState,
+                                  &pTaskInfo->storageAPI.functionStore);
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
   }
@@ -1015,19 +1275,6 @@ _error:
   return NULL;
 }
 
-int32_t setGroupResultOutputBuf(SOperatorInfo* pOperator, SOptrBasicInfo* binfo, int32_t numOfCols, char* pData,
-                                int32_t bytes, uint64_t groupId, SDiskbasedBuf* pBuf, SAggSupporter* pAggSup) {
-  SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
-  SResultRowInfo* pResultRowInfo = &binfo->resultRowInfo;
-  SqlFunctionCtx* pCtx = pOperator->exprSupp.pCtx;
-
-  SResultRow* pResultRow =
-      doSetResultOutBufByKey(pBuf, pResultRowInfo, (char*)pData, bytes, true, groupId, pTaskInfo, false, pAggSup, false);
-
-  setResultRowInitCtx(pResultRow, pCtx, numOfCols, pOperator->exprSupp.rowEntryInfoOffset);
-  return TSDB_CODE_SUCCESS;
-}
-
 uint64_t calGroupIdByData(SPartitionBySupporter* pParSup, SExprSupp* pExprSup, SSDataBlock* pBlock, int32_t rowId) {
   if (pExprSup->pExprInfo != NULL) {
     int32_t code =
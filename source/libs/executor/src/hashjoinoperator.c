@@ -162,6 +162,7 @@ static int32_t initHJoinTableInfo(SHJoinOperatorInfo* pJoin, SHashJoinPhysiNode*
   SNodeList* pKeyList = NULL;
   SHJoinTableInfo* pTable = &pJoin->tbs[idx];
   pTable->downStream = pDownstream[idx];
+  pTable->downStreamIdx = idx;
   pTable->blkId = pDownstream[idx]->resultDataBlockId;
   if (0 == idx) {
     pKeyList = pJoinNode->pOnLeft;
@@ -218,6 +219,21 @@ static void setHJoinBuildAndProbeTable(SHJoinOperatorInfo* pInfo, SHashJoinPhysi
   pInfo->pProbe->downStreamIdx = probeIdx;
 }
 
+static void swapHJoinBuildAndProbeTable(SHJoinOperatorInfo* pInfo) {
+  SHJoinTableInfo* pTable = pInfo->pBuild;
+  pInfo->pBuild = pInfo->pProbe;
+  pInfo->pProbe = pTable;
+
+  for (int32_t i = 0; i < pInfo->pResColNum; ++i) {
+    pInfo->pResColMap[i] = !pInfo->pResColMap[i];
+  }
+}
+
+static FORCE_INLINE bool needDetectHJoinBuildTable(SHJoinOperatorInfo* pInfo) {
+  return JOIN_TYPE_INNER == pInfo->joinType && pInfo->tbs[0].inputStat.inputRowNum <= 0 &&
+         pInfo->tbs[1].inputStat.inputRowNum <= 0;
+}
+
 static int32_t buildHJoinResColMap(SHJoinOperatorInfo* pInfo, SHashJoinPhysiNode* pJoinNode) {
   pInfo->pResColNum = pJoinNode->pTargets->length;
   pInfo->pResColMap = taosMemoryCalloc(pJoinNode->pTargets->length, sizeof(int8_t));
@@ -268,6 +284,8 @@ static void freeHJoinTableInfo(SHJoinTableInfo* pTable) {
   taosMemoryFreeClear(pTable->keyBuf);
   taosMemoryFreeClear(pTable->valCols);
   taosArrayDestroy(pTable->valVarCols);
+  taosArrayDestroyP(pTable->pCachedBlks, (FDelete)blockDataDestroy);
+  pTable->pCachedBlks = NULL;
 }
 
 static void freeHJoinBufPage(void* param) {
@@ -691,13 +709,103 @@ static int32_t addBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo* pJoin
   return code;
 }
 
+static SSDataBlock* getNextHJoinTableBlock(struct SOperatorInfo* pOperator, SHJoinTableInfo* pTable) {
+  int32_t cachedNum = taosArrayGetSize(pTable->pCachedBlks);
+  if (pTable->cachedBlkIdx > 0 && pTable->cachedBlkIdx <= cachedNum) {
+    SSDataBlock** ppPrev = taosArrayGet(pTable->pCachedBlks, pTable->cachedBlkIdx - 1);
+    *ppPrev = blockDataDestroy(*ppPrev);
+  }
+  if (pTable->cachedBlkIdx < cachedNum) {
+    return *(SSDataBlock**)taosArrayGet(pTable->pCachedBlks, pTable->cachedBlkIdx++);
+  }
+  if (pTable->cachedBlkIdx == cachedNum && cachedNum > 0) {
+    pTable->cachedBlkIdx++;
+  }
+
+  if (pTable->inputDone) {
+    return NULL;
+  }
+
+  SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, pTable->downStreamIdx);
+  if (NULL == pBlock) {
+    pTable->inputDone = true;
+  }
+
+  return pBlock;
+}
+
+/*
+ * Without row estimates from the planner an inner join cannot tell which side is the smaller one, so both
+ * downstreams are pulled in turns, always from the side with fewer rows so far, until one side is exhausted.
+ * That side becomes the build table, and the blocks already pulled are replayed from the cache afterwards.
+ * If one side has cached detectMaxCacheSize bytes before that, both sides are large, the build table chosen by the
+ * planner is kept instead of caching the whole probe table.
+ */
+static int32_t detectHJoinBuildTable(struct SOperatorInfo* pOperator) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  int32_t             idx = 0;
+
+  for (int32_t i = 0; i < tListLen(pJoin->tbs); ++i) {
+    pJoin->tbs[i].pCachedBlks = taosArrayInit(8, POINTER_BYTES);
+    if (NULL == pJoin->tbs[i].pCachedBlks) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  while (true) {
+    SHJoinTableInfo* pTable = &pJoin->tbs[idx];
+    SSDataBlock*     pBlock = getNextBlockFromDownstream(pOperator, pTable->downStreamIdx);
+    if (NULL == pBlock) {
+      pTable->inputDone = true;
+      break;
+    }
+
+    SSDataBlock* pCopy = createOneDataBlock(pBlock, true);
+    if (NULL == pCopy) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    if (NULL == taosArrayPush(pTable->pCachedBlks, &pCopy)) {
+      blockDataDestroy(pCopy);
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    pTable->inputStat.inputRowNum += pBlock->info.rows;
+    pTable->cachedSize += blockDataGetSize(pCopy);
+    if (pTable->cachedSize >= pJoin->detectMaxCacheSize) {
+      qDebug("hash join build table detection stopped, downstream idx:%d, cached size:%" PRId64 ", rows:%" PRId64
+             ",%" PRId64,
+             idx, pTable->cachedSize, pJoin->tbs[0].inputStat.inputRowNum, pJoin->tbs[1].inputStat.inputRowNum);
+      return TSDB_CODE_SUCCESS;
+    }
+
+    idx = (pJoin->tbs[0].inputStat.inputRowNum <= pJoin->tbs[1].inputStat.inputRowNum) ? 0 : 1;
+  }
+
+  qDebug("hash join build table detected, downstream idx:%d, rows:%" PRId64 ", cached blocks:%d,%d", idx,
+         pJoin->tbs[idx].inputStat.inputRowNum, (int32_t)taosArrayGetSize(pJoin->tbs[0].pCachedBlks),
+         (int32_t)taosArrayGetSize(pJoin->tbs[1].pCachedBlks));
+
+  if (pJoin->tbs[0].inputStat.inputRowNum > pJoin->tbs[1].inputStat.inputRowNum) {
+    swapHJoinBuildAndProbeTable(pJoin);
+  }
+
+  tSimpleHashCleanup(pJoin->pKeyHash);
+  size_t hashCap = pJoin->pBuild->inputStat.inputRowNum > 0 ? (pJoin->pBuild->inputStat.inputRowNum * 1.5) : 1024;
+  pJoin->pKeyHash = tSimpleHashInit(hashCap, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+  if (NULL == pJoin->pKeyHash) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t buildHJoinKeyHash(struct SOperatorInfo* pOperator) {
   SHJoinOperatorInfo* pJoin = pOperator->info;
   SSDataBlock* pBlock = NULL;
   int32_t code = TSDB_CODE_SUCCESS;
   
   while (true) {
-    pBlock = getNextBlockFromDownstream(pOperator, pJoin->pBuild->downStreamIdx);
+    pBlock = getNextHJoinTableBlock(pOperator, pJoin->pBuild);
     if (NULL == pBlock) {
       break;
     }
@@ -763,7 +871,15 @@ static SSDataBlock* doHashJoin(struct SOperatorInfo* pOperator) {
   
   if (!pJoin->keyHashBuilt) {
     pJoin->keyHashBuilt = true;
-    
+
+    if (pJoin->buildTableDetect) {
+      code = detectHJoinBuildTable(pOperator);
+      if (code) {
+        pTaskInfo->code = code;
+        T_LONG_JMP(pTaskInfo->env, code);
+      }
+    }
+
     code = buildHJoinKeyHash(pOperator);
     if (code) {
       pTaskInfo->code = code;
@@ -790,7 +906,7 @@ static SSDataBlock* doHashJoin(struct SOperatorInfo* pOperator) {
   }
 
   while (true) {
-    SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+    SSDataBlock* pBlock = getNextHJoinTableBlock(pOperator, pJoin->pProbe);
     if (NULL == pBlock) {
       setHJoinDone(pOperator);
       break;
@@ -848,6 +964,8 @@ SOperatorInfo* createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t n
   initHJoinTableInfo(pInfo, pJoinNode, pDownstream, 1, &pJoinNode->inputStat[1]);
 
   setHJoinBuildAndProbeTable(pInfo, pJoinNode);
+  pInfo->buildTableDetect = needDetectHJoinBuildTable(pInfo);
+  pInfo->detectMaxCacheSize = HASH_JOIN_DETECT_MAX_CACHE_SIZE;
   code = buildHJoinResColMap(pInfo, pJoinNode);
   if (code) {
     goto _error;
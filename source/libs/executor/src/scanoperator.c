@@ -220,14 +220,46 @@ static int32_t doDynamicPruneDataBlock(SOperatorInfo* pOperator, SDataBlockInfo*
   return code;
 }
 
-static bool doFilterByBlockSMA(SFilterInfo* pFilterInfo, SColumnDataAgg** pColsAgg, int32_t numOfCols,
-                               int32_t numOfRows) {
+static int32_t doClassifyByBlockSMA(SFilterInfo* pFilterInfo, SColumnDataAgg** pColsAgg, int32_t numOfCols,
+                                    int32_t numOfRows) {
   if (pColsAgg == NULL || pFilterInfo == NULL) {
+    return FILTER_RESULT_PARTIAL_QUALIFIED;
+  }
+
+  return filterRangeClassify(pFilterInfo, pColsAgg, numOfCols, numOfRows);
+}
+
+// check if the best value of the order column in the data block is behind the bound of the top-N rows, i.e., the max
+// value for descending order or the min value for ascending order. Null values are behind all others if not null first.
+static bool isBlockBehindTopNBound(const STopNBound* pBound, SColumnDataAgg** pColsAgg, int32_t numOfCols,
+                                   int32_t numOfRows) {
+  SColumnDataAgg* pAgg = NULL;
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    if (pColsAgg[i] != NULL && pColsAgg[i]->colId == pBound->colId) {
+      pAgg = pColsAgg[i];
+      break;
+    }
+  }
+
+  if (pAgg == NULL || (pAgg->numOfNull > 0 && pBound->nullFirst)) {
+    return false;
+  }
+
+  if (pAgg->numOfNull >= numOfRows) {
     return true;
   }
 
-  bool keep = filterRangeExecute(pFilterInfo, pColsAgg, numOfCols, numOfRows);
-  return keep;
+  bool    desc = (pBound->order == TSDB_ORDER_DESC);
+  int64_t v = desc ? pAgg->max : pAgg->min;
+  if (IS_FLOAT_TYPE(pBound->type)) {
+    double d = *(double*)&v;
+    return desc ? (d < pBound->d) : (d > pBound->d);
+  } else if (IS_UNSIGNED_NUMERIC_TYPE(pBound->type)) {
+    uint64_t u = (uint64_t)v;
+    return desc ? (u < pBound->u) : (u > pBound->u);
+  } else {
+    return desc ? (v < pBound->i) : (v > pBound->i);
+  }
 }
 
 static bool doLoadBlockSMA(STableScanBase* pTableScanInfo, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo) {
@@ -293,6 +325,141 @@ bool applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo
   return false;
 }
 
+#define LATE_MATERIALIZE_PROBE_BLOCKS 32
+
+static EDealRes collectFilterColIds(SNode* pNode, void* pContext) {
+  if (QUERY_NODE_COLUMN == nodeType(pNode)) {
+    SColumnNode* pCol = (SColumnNode*)pNode;
+    if (pCol->colType == COLUMN_TYPE_COLUMN && pCol->colId != PRIMARYKEY_TIMESTAMP_COL_ID) {
+      SArray* pList = pContext;
+      if (taosArraySearch(pList, &pCol->colId, compareInt16Val, TD_EQ) == NULL) {
+        taosArrayPush(pList, &pCol->colId);
+        taosArraySort(pList, compareInt16Val);
+      }
+    }
+  }
+  return DEAL_RES_CONTINUE;
+}
+
+// the filter columns are loaded ahead of the other columns only if the filter refers to part of the scan columns
+static void initLateMaterializeInfo(STableScanBase* pBase, SNode* pConditions) {
+  SLateMaterializeInfo* pInfo = &pBase->lateMaterialize;
+  if (pConditions == NULL) {
+    return;
+  }
+
+  pInfo->pFilterColIds = taosArrayInit(4, sizeof(int16_t));
+  if (pInfo->pFilterColIds == NULL) {
+    return;
+  }
+
+  nodesWalkExpr(pConditions, collectFilterColIds, pInfo->pFilterColIds);
+
+  int32_t numOfFilterCols = taosArrayGetSize(pInfo->pFilterColIds);
+  if (numOfFilterCols == 0 || numOfFilterCols >= pBase->cond.numOfCols - 1) {
+    pInfo->pFilterColIds = taosArrayDestroy(pInfo->pFilterColIds);
+  }
+}
+
+// keep loading the filter columns first only if enough blocks are filtered out by them.
+static void updateLateMaterializeInfo(SLateMaterializeInfo* pInfo, bool skipped, const char* id) {
+  pInfo->numOfBlocks += 1;
+  pInfo->numOfSkipped += skipped ? 1 : 0;
+
+  if (pInfo->numOfBlocks >= LATE_MATERIALIZE_PROBE_BLOCKS && pInfo->numOfSkipped * 8 < pInfo->numOfBlocks) {
+    pInfo->disabled = true;
+    qDebug("%s late materialization disabled, blocks:%" PRId64 ", skipped:%" PRId64, id, pInfo->numOfBlocks,
+           pInfo->numOfSkipped);
+  }
+}
+
+/**
+ * Load the filter columns of the data block and apply the filter first. The rest columns are loaded only if there are
+ * rows left after filtering, otherwise the data block is released directly.
+ */
+static int32_t loadDataBlockByFilterCols(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo,
+                                         SSDataBlock* pBlock, uint32_t* status) {
+  SExecTaskInfo*          pTaskInfo = pOperator->pTaskInfo;
+  SStorageAPI*            pAPI = &pTaskInfo->storageAPI;
+  SFileBlockLoadRecorder* pCost = &pTableScanInfo->readRecorder;
+  SLateMaterializeInfo*   pInfo = &pTableScanInfo->lateMaterialize;
+  SFilterInfo*            pFilterInfo = pOperator->exprSupp.pFilterInfo;
+  SColumnInfoData*        p = NULL;
+  int32_t                 code = TSDB_CODE_SUCCESS;
+
+  SSDataBlock* pRes = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, pInfo->pFilterColIds);
+  if (pRes == NULL) {
+    return terrno;
+  }
+
+  ASSERT(pRes == pBlock);
+  doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
+
+  // restore the previous value
+  pCost->totalRows -= pBlock->info.rows;
+
+  int64_t st = taosGetTimestampUs();
+  int32_t filterStatus = FILTER_RESULT_NONE_QUALIFIED;
+  if (pBlock->info.rows > 0) {
+    SFilterColumnParam param1 = {.numOfCols = taosArrayGetSize(pBlock->pDataBlock), .pDataBlock = pBlock->pDataBlock};
+    code = filterSetDataFromSlotId(pFilterInfo, &param1);
+    if (code == TSDB_CODE_SUCCESS) {
+      code = filterExecute(pFilterInfo, pBlock, &p, NULL, param1.numOfCols, &filterStatus);
+    }
+
+    if (code != TSDB_CODE_SUCCESS) {
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      goto _end;
+    }
+  }
+
+  if (filterStatus == FILTER_RESULT_NONE_QUALIFIED) {
+    pTableScanInfo->readRecorder.filterTime += (taosGetTimestampUs() - st) / 1000.0;
+    updateLateMaterializeInfo(pInfo, true, GET_TASKID(pTaskInfo));
+
+    qDebug("%s data block filter out by filter columns, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+           GET_TASKID(pTaskInfo), pBlock->info.window.skey, pBlock->info.window.ekey, pBlock->info.rows);
+    pCost->filterOutBlocks += 1;
+    blockDataEmpty(pBlock);
+    *status = FUNC_DATA_REQUIRED_FILTEROUT;
+
+    pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+    goto _end;
+  }
+
+  updateLateMaterializeInfo(pInfo, false, GET_TASKID(pTaskInfo));
+
+  // load the rest columns of the same rows, and keep the qualified rows only
+  pRes = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, NULL);
+  if (pRes == NULL) {
+    code = terrno;
+    goto _end;
+  }
+
+  extractQualifiedTupleByFilterResult(pBlock, p, filterStatus);
+
+  size_t size = taosArrayGetSize(pTableScanInfo->matchInfo.pList);
+  for (int32_t i = 0; i < size; ++i) {
+    SColMatchItem* pItem = taosArrayGet(pTableScanInfo->matchInfo.pList, i);
+    if (pItem->colId == PRIMARYKEY_TIMESTAMP_COL_ID) {
+      SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, pItem->dstSlotId);
+      if (pColData->info.type == TSDB_DATA_TYPE_TIMESTAMP) {
+        blockDataUpdateTsWindow(pBlock, pItem->dstSlotId);
+        break;
+      }
+    }
+  }
+
+  double el = (taosGetTimestampUs() - st) / 1000.0;
+  pTableScanInfo->readRecorder.filterTime += el;
+  qDebug("%s data block filter applied by filter columns, elapsed time:%.2f ms", GET_TASKID(pTaskInfo), el);
+
+_end:
+  colDataDestroy(p);
+  taosMemoryFree(p);
+  return code;
+}
+
 static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo, SSDataBlock* pBlock,
                              uint32_t* status) {
   SExecTaskInfo*          pTaskInfo = pOperator->pTaskInfo;
@@ -304,34 +471,84 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->totalRows += pBlock->info.rows;
 
   bool loadSMA = false;
+  bool allQualified = false;
   *status = pTableScanInfo->dataBlockLoadFlag;
-  if (pOperator->exprSupp.pFilterInfo != NULL ||
-      overlapWithTimeWindow(&pTableScanInfo->pdInfo.interval, &pBlock->info, pTableScanInfo->cond.order)) {
+  if (overlapWithTimeWindow(&pTableScanInfo->pdInfo.interval, &pBlock->info, pTableScanInfo->cond.order)) {
     (*status) = FUNC_DATA_REQUIRED_DATA_LOAD;
   }
 
   SDataBlockInfo* pBlockInfo = &pBlock->info;
   taosMemoryFreeClear(pBlock->pBlockAgg);
 
+  // classify the data block according to sma info: the block is skipped if no rows qualify, and is treated as
+  // if there is no filter if all rows qualify. Otherwise, the data block has to be loaded and filtered row by row.
+  if (pOperator->exprSupp.pFilterInfo != NULL) {
+    int32_t filterStatus = FILTER_RESULT_PARTIAL_QUALIFIED;
+    loadSMA = doLoadBlockSMA(pTableScanInfo, pBlock, pTaskInfo);
+    if (loadSMA) {
+      size_t size = taosArrayGetSize(pBlock->pDataBlock);
+      filterStatus = doClassifyByBlockSMA(pOperator->exprSupp.pFilterInfo, pBlock->pBlockAgg, size, pBlockInfo->rows);
+    }
+
+    if (filterStatus == FILTER_RESULT_NONE_QUALIFIED) {
+      qDebug("%s data block filter out by block SMA, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+             GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+      pCost->filterOutBlocks += 1;
+      (*status) = FUNC_DATA_REQUIRED_FILTEROUT;
+
+      taosMemoryFreeClear(pBlock->pBlockAgg);
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      return TSDB_CODE_SUCCESS;
+    } else if (filterStatus == FILTER_RESULT_PARTIAL_QUALIFIED) {
+      (*status) = FUNC_DATA_REQUIRED_DATA_LOAD;
+    } else {
+      allQualified = true;
+      qDebug("%s all rows qualified by block SMA, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+             GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+    }
+  }
+
+  // the data block can not provide any row of the top-N rows, no need to load it
+  STopNBound* pBound = pTableScanInfo->pTopNBound;
+  if (*status == FUNC_DATA_REQUIRED_DATA_LOAD && pBound != NULL && pBound->valid) {
+    if (!loadSMA && pOperator->exprSupp.pFilterInfo == NULL) {
+      loadSMA = doLoadBlockSMA(pTableScanInfo, pBlock, pTaskInfo);
+    }
+
+    size_t size = taosArrayGetSize(pBlock->pDataBlock);
+    if (loadSMA && isBlockBehindTopNBound(pBound, pBlock->pBlockAgg, size, pBlockInfo->rows)) {
+      qDebug("%s data block skipped by top-N bound, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+             GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+      pCost->skipBlocks += 1;
+      (*status) = FUNC_DATA_REQUIRED_FILTEROUT;
+
+      taosMemoryFreeClear(pBlock->pBlockAgg);
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
   if (*status == FUNC_DATA_REQUIRED_FILTEROUT) {
     qDebug("%s data block filter out, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64, GET_TASKID(pTaskInfo),
            pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
     pCost->filterOutBlocks += 1;
     pCost->totalRows += pBlock->info.rows;
+    taosMemoryFreeClear(pBlock->pBlockAgg);
     pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
     return TSDB_CODE_SUCCESS;
   } else if (*status == FUNC_DATA_REQUIRED_NOT_LOAD) {
     qDebug("%s data block skipped, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64 ", uid:%" PRIu64,
            GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows,
            pBlockInfo->id.uid);
+    taosMemoryFreeClear(pBlock->pBlockAgg);
     doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
     pCost->skipBlocks += 1;
     pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
     return TSDB_CODE_SUCCESS;
   } else if (*status == FUNC_DATA_REQUIRED_SMA_LOAD) {
     pCost->loadBlockStatis += 1;
-    loadSMA = true;  // mark the operation of load sma;
-    bool success = doLoadBlockSMA(pTableScanInfo, pBlock, pTaskInfo);
+    // the sma info may have been loaded to classify the data block already
+    bool success = loadSMA ? true : doLoadBlockSMA(pTableScanInfo, pBlock, pTaskInfo);
     if (success) {  // failed to load the block sma data, data block statistics does not exist, load data block instead
       qDebug("%s data block SMA loaded, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64, GET_TASKID(pTaskInfo),
              pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
@@ -346,24 +563,6 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
 
   ASSERT(*status == FUNC_DATA_REQUIRED_DATA_LOAD);
 
-  // try to filter data block according to sma info
-  if (pOperator->exprSupp.pFilterInfo != NULL && (!loadSMA)) {
-    bool success = doLoadBlockSMA(pTableScanInfo, pBlock, pTaskInfo);
-    if (success) {
-      size_t size = taosArrayGetSize(pBlock->pDataBlock);
-      bool   keep = doFilterByBlockSMA(pOperator->exprSupp.pFilterInfo, pBlock->pBlockAgg, size, pBlockInfo->rows);
-      if (!keep) {
-        qDebug("%s data block filter out by block SMA, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
-               GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
-        pCost->filterOutBlocks += 1;
-        (*status) = FUNC_DATA_REQUIRED_FILTEROUT;
-
-        pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
-        return TSDB_CODE_SUCCESS;
-      }
-    }
-  }
-
   // free the sma info, since it should not be involved in later computing process.
   taosMemoryFreeClear(pBlock->pBlockAgg);
 
@@ -387,18 +586,28 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->totalCheckedRows += pBlock->info.rows;
   pCost->loadBlocks += 1;
 
-  SSDataBlock* p = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, NULL);
-  if (p == NULL) {
-    return terrno;
-  }
+  SLateMaterializeInfo* pLateInfo = &pTableScanInfo->lateMaterialize;
+  bool                  needFilter = (pOperator->exprSupp.pFilterInfo != NULL && !allQualified);
+  bool                  lateFiltered = (needFilter && pLateInfo->pFilterColIds != NULL && !pLateInfo->disabled);
+  if (lateFiltered) {
+    int32_t code = loadDataBlockByFilterCols(pOperator, pTableScanInfo, pBlock, status);
+    if (code != TSDB_CODE_SUCCESS || *status == FUNC_DATA_REQUIRED_FILTEROUT) {
+      return code;
+    }
+  } else {
+    SSDataBlock* p = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, NULL);
+    if (p == NULL) {
+      return terrno;
+    }
 
-  ASSERT(p == pBlock);
-  doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
+    ASSERT(p == pBlock);
+    doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
 
-  // restore the previous value
-  pCost->totalRows -= pBlock->info.rows;
+    // restore the previous value
+    pCost->totalRows -= pBlock->info.rows;
+  }
 
-  if (pOperator->exprSupp.pFilterInfo != NULL) {
+  if (needFilter && !lateFiltered) {
     int32_t code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
     if (code != TSDB_CODE_SUCCESS) return code;
 
@@ -872,13 +1081,37 @@ static SSDataBlock* startNextGroupScan(SOperatorInfo* pOperator) {
   return NULL;
 }
 
+static SSDataBlock* startNextRangeScan(SOperatorInfo* pOperator) {
+  STableScanInfo* pInfo = pOperator->info;
+  SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
+  SStorageAPI*    pAPI = &pTaskInfo->storageAPI;
+
+  while ((++pInfo->scanRangeIndex) < taosArrayGetSize(pInfo->pScanRanges)) {
+    pInfo->base.cond.twindows = *(STimeWindow*)taosArrayGet(pInfo->pScanRanges, pInfo->scanRangeIndex);
+    pInfo->scanTimes = 0;
+    taosHashClear(pInfo->pIgnoreTables);
+
+    qDebug("%s start to scan range %" PRId64 " - %" PRId64 ", index:%d", GET_TASKID(pTaskInfo),
+           pInfo->base.cond.twindows.skey, pInfo->base.cond.twindows.ekey, pInfo->scanRangeIndex);
+    pAPI->tsdReader.tsdReaderResetStatus(pInfo->base.dataReader, &pInfo->base.cond);
+
+    SSDataBlock* result = doGroupedTableScan(pOperator);
+    if (result != NULL) {
+      return result;
+    }
+  }
+
+  return NULL;
+}
+
 static SSDataBlock* groupSeqTableScan(SOperatorInfo* pOperator) {
   STableScanInfo* pInfo = pOperator->info;
   SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
   SStorageAPI*    pAPI = &pTaskInfo->storageAPI;
 
   if (pInfo->currentGroupId == -1) {
-    if ((++pInfo->currentGroupId) >= tableListGetOutputGroups(pInfo->base.pTableListInfo)) {
+    if ((++pInfo->currentGroupId) >= tableListGetOutputGroups(pInfo->base.pTableListInfo) ||
+        (pInfo->pScanRanges != NULL && taosArrayGetSize(pInfo->pScanRanges) == 0)) {
       setOperatorCompleted(pOperator);
       return NULL;
     }
@@ -899,9 +1132,19 @@ static SSDataBlock* groupSeqTableScan(SOperatorInfo* pOperator) {
     if (pInfo->pResBlock->info.capacity > pOperator->resultInfo.capacity) {
       pOperator->resultInfo.capacity = pInfo->pResBlock->info.capacity;
     }
+
+    // the reader is opened with the whole query range, and then limited to the first range to scan
+    if (pInfo->pScanRanges != NULL) {
+      pInfo->base.cond.twindows = *(STimeWindow*)taosArrayGet(pInfo->pScanRanges, 0);
+      pAPI->tsdReader.tsdReaderResetStatus(pInfo->base.dataReader, &pInfo->base.cond);
+    }
   }
 
   SSDataBlock* result = doGroupedTableScan(pOperator);
+  if (result == NULL && pInfo->pScanRanges != NULL) {
+    result = startNextRangeScan(pOperator);
+  }
+
   if (result != NULL) {
     if (pOperator->dynamicTask) {
       result->info.id.groupId = result->info.id.uid;
@@ -1003,6 +1246,7 @@ static void destroyTableScanBase(STableScanBase* pBase, TsdReader* pAPI) {
     taosArrayDestroy(pBase->matchInfo.pList);
   }
 
+  taosArrayDestroy(pBase->lateMaterialize.pFilterColIds);
   tableListDestroy(pBase->pTableListInfo);
   taosLRUCacheCleanup(pBase->metaCache.pTableMetaEntryCache);
   cleanupExprSupp(&pBase->pseudoSup);
@@ -1012,6 +1256,7 @@ static void destroyTableScanOperatorInfo(void* param) {
   STableScanInfo* pTableScanInfo = (STableScanInfo*)param;
   blockDataDestroy(pTableScanInfo->pResBlock);
   taosHashCleanup(pTableScanInfo->pIgnoreTables);
+  taosArrayDestroy(pTableScanInfo->pScanRanges);
   destroyTableScanBase(&pTableScanInfo->base, &pTableScanInfo->base.readerAPI);
   taosMemoryFreeClear(param);
 }
@@ -1067,6 +1312,8 @@ SOperatorInfo* createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode,
     goto _error;
   }
 
+  initLateMaterializeInfo(&pInfo->base, pTableScanNode->scan.node.pConditions);
+
   pInfo->currentGroupId = -1;
   pInfo->assignBlockUid = pTableScanNode->assignBlockUid;
   pInfo->hasGroupByTag = pTableScanNode->pGroupTags ? true : false;
@@ -1106,6 +1353,35 @@ _error:
   return NULL;
 }
 
+int32_t setTableScanTopNBound(SOperatorInfo* pOperator, STopNBound* pBound) {
+  if (pOperator->operatorType != QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  STableScanInfo* pInfo = pOperator->info;
+  size_t          size = taosArrayGetSize(pInfo->base.matchInfo.pList);
+  for (int32_t i = 0; i < size; ++i) {
+    SColMatchItem* pItem = taosArrayGet(pInfo->base.matchInfo.pList, i);
+    if (pItem->dstSlotId != pBound->slotId) {
+      continue;
+    }
+
+    // only the numeric columns have comparable block SMA
+    int8_t type = pItem->dataType.type;
+    if (pItem->colId == PRIMARYKEY_TIMESTAMP_COL_ID || !(IS_NUMERIC_TYPE(type) || type == TSDB_DATA_TYPE_TIMESTAMP)) {
+      return TSDB_CODE_INVALID_PARA;
+    }
+
+    pBound->colId = pItem->colId;
+    pBound->type = type;
+    pBound->valid = false;
+    pInfo->base.pTopNBound = pBound;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  return TSDB_CODE_INVALID_PARA;
+}
+
 SOperatorInfo* createTableSeqScanOperatorInfo(void* pReadHandle, SExecTaskInfo* pTaskInfo) {
   STableScanInfo* pInfo = taosMemoryCalloc(1, sizeof(STableScanInfo));
   SOperatorInfo*  pOperator = taosMemoryCalloc(1, sizeof(SOperatorInfo));
@@ -1155,6 +1431,13 @@ static void setGroupId(SStreamScanInfo* pInfo, SSDataBlock* pBlock, int32_t grou
   pInfo->groupId = groupCol[rowIndex];
 }
 
+// the ranges are owned by the table scan operator afterwards, and must be set before the first block is retrieved
+void setTableScanTimeRanges(STableScanInfo* pTableScanInfo, SArray* pRanges) {
+  taosArrayDestroy(pTableScanInfo->pScanRanges);
+  pTableScanInfo->pScanRanges = pRanges;
+  pTableScanInfo->scanRangeIndex = 0;
+}
+
 void resetTableScanInfo(STableScanInfo* pTableScanInfo, STimeWindow* pWin, uint64_t ver) {
   pTableScanInfo->base.cond.twindows = *pWin;
   pTableScanInfo->base.cond.startVersion = 0;
@@ -3729,6 +4012,8 @@ SOperatorInfo* createTableMergeScanOperatorInfo(STableScanPhysiNode* pTableScanN
     goto _error;
   }
 
+  initLateMaterializeInfo(&pInfo->base, pTableScanNode->scan.node.pConditions);
+
   initResultSizeInfo(&pOperator->resultInfo, 1024);
   pInfo->pResBlock = createDataBlockFromDescNode(pDescNode);
   blockDataEnsureCapacity(pInfo->pResBlock, pOperator->resultInfo.capacity);
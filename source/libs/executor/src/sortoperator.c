@@ -41,6 +41,8 @@ typedef struct SSortOperatorInfo {
   uint64_t            maxTupleLength;
   int64_t             maxRows;
   SSortOpGroupIdCalc* pGroupIdCalc;
+  bool                pushTopNBound;
+  STopNBound          topNBound;
 } SSortOperatorInfo;
 
 static SSDataBlock* doSort(SOperatorInfo* pOperator);
@@ -51,6 +53,7 @@ static void destroySortOperatorInfo(void* param);
 static int32_t calcSortOperMaxTupleLength(SSortOperatorInfo* pSortOperInfo, SNodeList* pSortKeys);
 
 static void destroySortOpGroupIdCalc(SSortOpGroupIdCalc* pCalc);
+static void initSortTopNBound(SOperatorInfo* pOperator, SOperatorInfo* downstream);
 
 // todo add limit/offset impl
 SOperatorInfo* createSortOperatorInfo(SOperatorInfo* downstream, SSortPhysiNode* pSortNode, SExecTaskInfo* pTaskInfo) {
@@ -138,6 +141,7 @@ SOperatorInfo* createSortOperatorInfo(SOperatorInfo* downstream, SSortPhysiNode*
     goto _error;
   }
 
+  initSortTopNBound(pOperator, downstream);
   return pOperator;
 
 _error:
@@ -285,6 +289,23 @@ void applyScalarFunction(SSDataBlock* pBlock, void* param) {
   }
 }
 
+static void updateSortTopNBound(const void* pVal, void* param) {
+  STopNBound* pBound = param;
+  if (pVal == NULL) {
+    // null values are kept, no data block is behind them unless null first
+    pBound->valid = false;
+  } else if (IS_FLOAT_TYPE(pBound->type)) {
+    GET_TYPED_DATA(pBound->d, double, pBound->type, pVal);
+    pBound->valid = !isnan(pBound->d);
+  } else if (IS_UNSIGNED_NUMERIC_TYPE(pBound->type)) {
+    GET_TYPED_DATA(pBound->u, uint64_t, pBound->type, pVal);
+    pBound->valid = true;
+  } else {
+    GET_TYPED_DATA(pBound->i, int64_t, pBound->type, pVal);
+    pBound->valid = true;
+  }
+}
+
 int32_t doOpenSortOperator(SOperatorInfo* pOperator) {
   SSortOperatorInfo* pInfo = pOperator->info;
   SExecTaskInfo*     pTaskInfo = pOperator->pTaskInfo;
@@ -299,6 +320,9 @@ int32_t doOpenSortOperator(SOperatorInfo* pOperator) {
                                              pInfo->maxRows, pInfo->maxTupleLength, tsPQSortMemThreshold * 1024 * 1024);
 
   tsortSetFetchRawDataFp(pInfo->pSortHandle, loadNextDataBlock, applyScalarFunction, pOperator);
+  if (pInfo->pushTopNBound) {
+    tsortSetPQBoundFn(pInfo->pSortHandle, pInfo->topNBound.slotId, updateSortTopNBound, &pInfo->topNBound);
+  }
 
   SSortSource* ps = taosMemoryCalloc(1, sizeof(SSortSource));
   ps->param = pOperator->pDownstream[0];
@@ -402,6 +426,31 @@ static int32_t calcSortOperMaxTupleLength(SSortOperatorInfo* pSortOperInfo, SNod
   return TSDB_CODE_SUCCESS;
 }
 
+/**
+ * @brief push the bound of the top-N rows down to the table scan, so that the data blocks which can not provide any row
+ * of the top-N rows are skipped by block SMA. Only applicable if the first order column comes from the table scan
+ * directly, and all rows of the only group are sorted with limit.
+ */
+static void initSortTopNBound(SOperatorInfo* pOperator, SOperatorInfo* downstream) {
+  SSortOperatorInfo* pInfo = pOperator->info;
+  if (pInfo->maxRows <= 0 || pInfo->pGroupIdCalc != NULL || pOperator->exprSupp.pFilterInfo != NULL ||
+      downstream->operatorType != QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    return;
+  }
+
+  SBlockOrderInfo* pOrder = taosArrayGet(pInfo->pSortInfo, 0);
+  for (int32_t i = 0; i < pOperator->exprSupp.numOfExprs; ++i) {
+    if (pOperator->exprSupp.pExprInfo[i].base.resSchema.slotId == pOrder->slotId) {
+      return;
+    }
+  }
+
+  pInfo->topNBound.slotId = pOrder->slotId;
+  pInfo->topNBound.order = pOrder->order;
+  pInfo->topNBound.nullFirst = pOrder->nullFirst;
+  pInfo->pushTopNBound = (setTableScanTopNBound(downstream, &pInfo->topNBound) == TSDB_CODE_SUCCESS);
+}
+
 static void destroySortOpGroupIdCalc(SSortOpGroupIdCalc* pCalc) {
   if (pCalc) {
     taosArrayDestroy(pCalc->pSortColsArr);
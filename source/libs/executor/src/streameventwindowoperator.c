@@ -91,12 +91,8 @@ void setEventWindowInfo(SStreamAggSupporter* pAggSup, SSessionKey* pKey, SRowBuf
 }
 
 int32_t getEndCondIndex(bool* pEnd, int32_t start, int32_t rows) {
-  for (int32_t i = start; i < rows; i++) {
-    if (pEnd[i]) {
-      return i;
-    }
-  }
-  return -1;
+  int32_t i = getNextTrueIndex(pEnd, start, rows);
+  return (i < rows) ? i : -1;
 }
 
 void setEventOutputBuf(SStreamAggSupporter* pAggSup, TSKEY* pTs, uint64_t groupId, bool* pStart, bool* pEnd, int32_t index, int32_t rows, SEventWindowInfo* pCurWin, SSessionKey* pNextWinKey) {
@@ -37,7 +37,7 @@
 
 static void doSetVal(SColumnInfoData* pDstColInfoData, int32_t rowIndex, const SGroupKeys* pKey);
 
-static void setNotFillColumn(SFillInfo* pFillInfo, SColumnInfoData* pDstColInfo, int32_t rowIndex, int32_t colIdx) {
+static SGroupKeys* getNotFillColumnKey(SFillInfo* pFillInfo, int32_t colIdx) {
   SRowVal* p = NULL;
   if (pFillInfo->type == TSDB_FILL_NEXT) {
     p = FILL_IS_ASC_FILL(pFillInfo) ? &pFillInfo->next : &pFillInfo->prev;
@@ -45,7 +45,11 @@ static void setNotFillColumn(SFillInfo* pFillInfo, SColumnInfoData* pDstColInfo,
     p = FILL_IS_ASC_FILL(pFillInfo) ? &pFillInfo->prev : &pFillInfo->next;
   }
 
-  SGroupKeys* pKey = taosArrayGet(p->pRowVal, colIdx);
+  return taosArrayGet(p->pRowVal, colIdx);
+}
+
+static void setNotFillColumn(SFillInfo* pFillInfo, SColumnInfoData* pDstColInfo, int32_t rowIndex, int32_t colIdx) {
+  SGroupKeys* pKey = getNotFillColumnKey(pFillInfo, colIdx);
   doSetVal(pDstColInfo, rowIndex, pKey);
 }
 
@@ -223,6 +227,237 @@ static void doFillOneRow(SFillInfo* pFillInfo, SSDataBlock* pBlock, SSDataBlock*
   pFillInfo->numOfCurrent++;
 }
 
+static void colDataClearNNull(SColumnInfoData* pCol, int32_t start, int32_t numOfRows) {
+  for (int32_t i = start; i < start + numOfRows; ++i) {
+    colDataClearNull_f(pCol->nullbitmap, i);
+  }
+}
+
+// copy the value of fixed length column at row start into the following (numOfRows - 1) rows
+static void repeatFixedColumnRow(SColumnInfoData* pDst, int32_t start, int32_t numOfRows) {
+  if (numOfRows <= 1) {
+    return;
+  }
+
+  if (colDataIsNull_f(pDst->nullbitmap, start)) {
+    colDataSetNNULL(pDst, start + 1, numOfRows - 1);
+    return;
+  }
+
+  // double the copied range in each round, so a gap of n rows needs log(n) memcpy calls
+  int32_t bytes = pDst->info.bytes;
+  char*   p = pDst->pData + (int64_t)bytes * start;
+  for (int32_t copied = 1; copied < numOfRows;) {
+    int32_t n = TMIN(copied, numOfRows - copied);
+    memcpy(p + (int64_t)bytes * copied, p, (int64_t)bytes * n);
+    copied += n;
+  }
+
+  colDataClearNNull(pDst, start + 1, numOfRows - 1);
+}
+
+static void fillColumnRun(SColumnInfoData* pDst, int32_t start, int32_t numOfRows, const char* pData, bool isNull) {
+  if (isNull) {
+    colDataSetNNULL(pDst, start, numOfRows);
+  } else if (IS_VAR_DATA_TYPE(pDst->info.type)) {
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      colDataSetVal(pDst, start + i, pData, false);
+    }
+  } else {
+    colDataSetVal(pDst, start, pData, false);
+    repeatFixedColumnRow(pDst, start, numOfRows);
+  }
+}
+
+static bool fillWindowPseudoColumnRun(SFillInfo* pFillInfo, SFillColInfo* pCol, SColumnInfoData* pDst, int32_t start,
+                                      int32_t numOfRows, const TSKEY* pKeys) {
+  if (!pCol->notFillCol || pCol->pExpr->pExpr->nodeType != QUERY_NODE_COLUMN || pCol->pExpr->base.numOfParams != 1) {
+    return false;
+  }
+
+  int32_t colType = pCol->pExpr->base.pParam[0].pCol->colType;
+  if (colType == COLUMN_TYPE_WINDOW_START) {
+    memcpy(pDst->pData + sizeof(TSKEY) * start, pKeys, sizeof(TSKEY) * numOfRows);
+    colDataClearNNull(pDst, start, numOfRows);
+    return true;
+  } else if (colType == COLUMN_TYPE_WINDOW_END) {
+    // TODO: include endpoint
+    SInterval* pInterval = &pFillInfo->interval;
+    TSKEY*     pEnd = (TSKEY*)pDst->pData + start;
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      pEnd[i] = taosTimeAdd(pKeys[i], pInterval->interval, pInterval->intervalUnit, pInterval->precision);
+    }
+    colDataClearNNull(pDst, start, numOfRows);
+    return true;
+  } else if (colType == COLUMN_TYPE_WINDOW_DURATION) {
+    // TODO: include endpoint
+    fillColumnRun(pDst, start, numOfRows, (const char*)&pFillInfo->interval.sliding, false);
+    return true;
+  }
+
+  return false;
+}
+
+#define DO_LINEAR_FILL_RUN(_t, _dst, _keys, _n, _v1, _v2, _k1, _k2)           \
+  do {                                                                        \
+    _t* _p = (_t*)(_dst);                                                     \
+    for (int32_t _i = 0; _i < (_n); ++_i) {                                   \
+      _p[_i] = (_t)DO_INTERPOLATION((_v1), (_v2), (_k1), (_k2), (_keys)[_i]); \
+    }                                                                         \
+  } while (0)
+
+static void fillLinearColumnRun(SColumnInfoData* pDst, int32_t start, int32_t numOfRows, const TSKEY* pKeys,
+                                const SPoint* point1, const SPoint* point2) {
+  int16_t type = pDst->info.type;
+  double  v1 = 0, v2 = 0;
+  GET_TYPED_DATA(v1, double, type, point1->val);
+  GET_TYPED_DATA(v2, double, type, point2->val);
+
+  char* p = pDst->pData + (int64_t)pDst->info.bytes * start;
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      DO_LINEAR_FILL_RUN(int8_t, p, pKeys, numOfRows, v1, v2, point1->key, point2->key);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      DO_LINEAR_FILL_RUN(uint8_t, p, pKeys, numOfRows, v1, v2, point1->key, point2->key);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      DO_LINEAR_FILL_RUN(int16_t, p, pKeys, numOfRows, v1, v2, point1->key, point2->key);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      DO_LINEAR_FILL_RUN(uint16_t, p, pKeys, numOfRows, v1, v2, point1->key, point2->key);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      DO_LINEAR_FILL_RUN(int32_t, p, pKeys, numOfRows, v1, v2, point1->key, point2->key);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      DO_LINEAR_FILL_RUN(uint32_t, p, pKeys, numOfRows, v1, v2, point1->key, point2->key);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      DO_LINEAR_FILL_RUN(int64_t, p, pKeys, numOfRows, v1, v2, point1->key, point2->key);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      DO_LINEAR_FILL_RUN(uint64_t, p, pKeys, numOfRows, v1, v2, point1->key, point2->key);
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      DO_LINEAR_FILL_RUN(float, p, pKeys, numOfRows, v1, v2, point1->key, point2->key);
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      DO_LINEAR_FILL_RUN(double, p, pKeys, numOfRows, v1, v2, point1->key, point2->key);
+      break;
+    default:
+      memset(p, 0, (int64_t)pDst->info.bytes * numOfRows);
+      break;
+  }
+
+  colDataClearNNull(pDst, start, numOfRows);
+}
+
+static int32_t ensureGapKeysCapacity(SFillInfo* pFillInfo, int32_t numOfRows) {
+  if (pFillInfo->gapKeysCap >= numOfRows) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  TSKEY* p = taosMemoryRealloc(pFillInfo->pGapKeys, sizeof(TSKEY) * numOfRows);
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pFillInfo->pGapKeys = p;
+  pFillInfo->gapKeysCap = numOfRows;
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * Generate the filled rows of one gap, at most maxRows rows, one column at a time. The output is identical to calling
+ * doFillOneRow() for each of them, but the per row dispatch on fill type and column kind is hoisted out of the loop.
+ * If outOfBound is false, the gap ends before the input row with timestamp ts.
+ */
+static int32_t doFillGapRows(SFillInfo* pFillInfo, SSDataBlock* pBlock, SSDataBlock* pSrcBlock, int64_t ts,
+                             bool outOfBound, int32_t maxRows) {
+  int32_t    step = GET_FORWARD_DIRECTION_FACTOR(pFillInfo->order);
+  bool       ascFill = FILL_IS_ASC_FILL(pFillInfo);
+  SInterval* pInterval = &pFillInfo->interval;
+
+  if (maxRows <= 0) {
+    return 0;
+  }
+
+  if (ensureGapKeysCapacity(pFillInfo, maxRows) != TSDB_CODE_SUCCESS) {
+    // not able to hold the timestamps of the whole gap, fill it row by row
+    int32_t numOfRows = 0;
+    while (numOfRows < maxRows &&
+           (outOfBound || (pFillInfo->currentKey < ts && ascFill) || (pFillInfo->currentKey > ts && !ascFill))) {
+      doFillOneRow(pFillInfo, pBlock, pSrcBlock, ts, outOfBound);
+      numOfRows += 1;
+    }
+    return numOfRows;
+  }
+
+  TSKEY*  pKeys = pFillInfo->pGapKeys;
+  TSKEY   key = pFillInfo->currentKey;
+  int32_t numOfRows = 0;
+  while (numOfRows < maxRows && (outOfBound || (key < ts && ascFill) || (key > ts && !ascFill))) {
+    pKeys[numOfRows++] = key;
+    key = taosTimeAdd(key, pInterval->sliding * step, pInterval->slidingUnit, pInterval->precision);
+  }
+
+  if (numOfRows == 0) {
+    return 0;
+  }
+
+  int32_t start = pBlock->info.rows;
+  bool    nullRow = (pFillInfo->type == TSDB_FILL_NULL || pFillInfo->type == TSDB_FILL_NULL_F ||
+                  (pFillInfo->type == TSDB_FILL_LINEAR && outOfBound));
+
+  for (int32_t i = 0; i < pFillInfo->numOfCols; ++i) {
+    SFillColInfo*    pCol = &pFillInfo->pFillCol[i];
+    SColumnInfoData* pDst = taosArrayGet(pBlock->pDataBlock, GET_DEST_SLOT_ID(pCol));
+
+    if (fillWindowPseudoColumnRun(pFillInfo, pCol, pDst, start, numOfRows, pKeys)) {
+      continue;
+    }
+
+    if (pCol->notFillCol || pFillInfo->type == TSDB_FILL_PREV || pFillInfo->type == TSDB_FILL_NEXT) {
+      SGroupKeys* pKey = getNotFillColumnKey(pFillInfo, i);
+      fillColumnRun(pDst, start, numOfRows, pKey->pData, pKey->isNull);
+    } else if (nullRow) {
+      colDataSetNNULL(pDst, start, numOfRows);
+    } else if (pFillInfo->type == TSDB_FILL_LINEAR) {
+      // TODO : linear interpolation supports NULL value
+      int16_t     type = pDst->info.type;
+      SGroupKeys* pKey = taosArrayGet(pFillInfo->prev.pRowVal, i);
+      if (IS_VAR_DATA_TYPE(type) || type == TSDB_DATA_TYPE_BOOL || pKey->isNull) {
+        colDataSetNNULL(pDst, start, numOfRows);
+        continue;
+      }
+
+      SGroupKeys*      pKey1 = taosArrayGet(pFillInfo->prev.pRowVal, pFillInfo->tsSlotId);
+      SColumnInfoData* pSrcCol = taosArrayGet(pSrcBlock->pDataBlock, GET_DEST_SLOT_ID(pCol));
+
+      SPoint point1 = {.key = *(int64_t*)pKey1->pData, .val = pKey->pData};
+      SPoint point2 = {.key = ts, .val = colDataGetData(pSrcCol, pFillInfo->index)};
+      fillLinearColumnRun(pDst, start, numOfRows, pKeys, &point1, &point2);
+    } else {  // fill with user specified value
+      SVariant* pVar = &pCol->fillVal;
+      if (IS_VAR_DATA_TYPE(pDst->info.type) || pDst->info.type == TSDB_DATA_TYPE_TIMESTAMP) {
+        for (int32_t j = 0; j < numOfRows; ++j) {
+          doSetUserSpecifiedValue(pDst, pVar, start + j, pKeys[j]);
+        }
+      } else {
+        doSetUserSpecifiedValue(pDst, pVar, start, pKeys[0]);
+        repeatFixedColumnRow(pDst, start, numOfRows);
+      }
+    }
+  }
+
+  pFillInfo->currentKey = key;
+  pBlock->info.rows += numOfRows;
+  pFillInfo->numOfCurrent += numOfRows;
+  return numOfRows;
+}
+
 void doSetVal(SColumnInfoData* pDstCol, int32_t rowIndex, const SGroupKeys* pKey) {
   if (pKey->isNull) {
     colDataSetNULL(pDstCol, rowIndex);
@@ -310,10 +545,7 @@ static int32_t fillResultImpl(SFillInfo* pFillInfo, SSDataBlock* pBlock, int32_t
     if (((pFillInfo->currentKey < ts && ascFill) || (pFillInfo->currentKey > ts && !ascFill)) &&
         pFillInfo->numOfCurrent < outputRows) {
       // fill the gap between two input rows
-      while (((pFillInfo->currentKey < ts && ascFill) || (pFillInfo->currentKey > ts && !ascFill)) &&
-             pFillInfo->numOfCurrent < outputRows) {
-        doFillOneRow(pFillInfo, pBlock, pFillInfo->pSrcBlock, ts, false);
-      }
+      doFillGapRows(pFillInfo, pBlock, pFillInfo->pSrcBlock, ts, false, outputRows - pFillInfo->numOfCurrent);
 
       // output buffer is full, abort
       if (pFillInfo->numOfCurrent == outputRows) {
@@ -415,9 +647,7 @@ static int64_t appendFilledResult(SFillInfo* pFillInfo, SSDataBlock* pBlock, int
    * real result set. Note that we need to keep the direct previous result rows, to generated the filled data.
    */
   pFillInfo->numOfCurrent = 0;
-  while (pFillInfo->numOfCurrent < resultCapacity) {
-    doFillOneRow(pFillInfo, pBlock, pFillInfo->pSrcBlock, pFillInfo->start, true);
-  }
+  doFillGapRows(pFillInfo, pBlock, pFillInfo->pSrcBlock, pFillInfo->start, true, (int32_t)resultCapacity);
 
   pFillInfo->numOfTotal += pFillInfo->numOfCurrent;
 
@@ -520,6 +750,7 @@ void* taosDestroyFillInfo(SFillInfo* pFillInfo) {
   }
 
   taosMemoryFreeClear(pFillInfo->pTags);
+  taosMemoryFreeClear(pFillInfo->pGapKeys);
   taosMemoryFreeClear(pFillInfo->pFillCol);
   taosMemoryFreeClear(pFillInfo);
   return NULL;
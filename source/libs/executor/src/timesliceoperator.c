@@ -154,13 +154,14 @@ static void doKeepLinearInfo(STimeSliceOperatorInfo* pSliceInfo, const SSDataBlo
   }
 }
 
-static FORCE_INLINE int32_t timeSliceEnsureBlockCapacity(STimeSliceOperatorInfo* pSliceInfo, SSDataBlock* pBlock) {
-  if (pBlock->info.rows < pBlock->info.capacity) {
+static FORCE_INLINE int32_t timeSliceEnsureBlockCapacity(STimeSliceOperatorInfo* pSliceInfo, SSDataBlock* pBlock,
+                                                          int32_t numOfRows) {
+  if (pBlock->info.rows + numOfRows <= pBlock->info.capacity) {
     return TSDB_CODE_SUCCESS;
   }
 
   uint32_t winNum = (pSliceInfo->win.ekey - pSliceInfo->win.skey) / pSliceInfo->interval.interval;
-  uint32_t newRowsNum = pBlock->info.rows + TMIN(winNum / 4 + 1, 1048576);
+  uint32_t newRowsNum = pBlock->info.rows + TMAX(numOfRows, TMIN(winNum / 4 + 1, 1048576));
   blockDataEnsureCapacity(pBlock, newRowsNum);
 
   return TSDB_CODE_SUCCESS;
@@ -251,10 +252,60 @@ static bool checkNullRow(SExprSupp* pExprSup, SSDataBlock* pSrcBlock, int32_t in
 }
 
 
+// convert the user specified fill value to the type of the interp result, false if the type is not supported
+static bool getInterpFillValue(const SVariant* pVar, int16_t type, char* pBuf, bool* isNull) {
+  *isNull = (TSDB_DATA_TYPE_NULL == pVar->nType) ? true : false;
+  if (type == TSDB_DATA_TYPE_FLOAT) {
+    float v = 0;
+    if (!IS_VAR_DATA_TYPE(pVar->nType)) {
+      GET_TYPED_DATA(v, float, pVar->nType, &pVar->f);
+    } else {
+      v = taosStr2Float(varDataVal(pVar->pz), NULL);
+    }
+    *(float*)pBuf = v;
+  } else if (type == TSDB_DATA_TYPE_DOUBLE) {
+    double v = 0;
+    if (!IS_VAR_DATA_TYPE(pVar->nType)) {
+      GET_TYPED_DATA(v, double, pVar->nType, &pVar->d);
+    } else {
+      v = taosStr2Double(varDataVal(pVar->pz), NULL);
+    }
+    *(double*)pBuf = v;
+  } else if (IS_SIGNED_NUMERIC_TYPE(type)) {
+    int64_t v = 0;
+    if (!IS_VAR_DATA_TYPE(pVar->nType)) {
+      GET_TYPED_DATA(v, int64_t, pVar->nType, &pVar->i);
+    } else {
+      v = taosStr2Int64(varDataVal(pVar->pz), NULL, 10);
+    }
+    *(int64_t*)pBuf = v;
+  } else if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
+    uint64_t v = 0;
+    if (!IS_VAR_DATA_TYPE(pVar->nType)) {
+      GET_TYPED_DATA(v, uint64_t, pVar->nType, &pVar->u);
+    } else {
+      v = taosStr2UInt64(varDataVal(pVar->pz), NULL, 10);
+    }
+    *(uint64_t*)pBuf = v;
+  } else if (IS_BOOLEAN_TYPE(type)) {
+    bool v = false;
+    if (!IS_VAR_DATA_TYPE(pVar->nType)) {
+      GET_TYPED_DATA(v, bool, pVar->nType, &pVar->i);
+    } else {
+      v = taosStr2Int8(varDataVal(pVar->pz), NULL, 10);
+    }
+    *(bool*)pBuf = v;
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
 static bool genInterpolationResult(STimeSliceOperatorInfo* pSliceInfo, SExprSupp* pExprSup, SSDataBlock* pResBlock,
                                    SSDataBlock* pSrcBlock, int32_t index, bool beforeTs) {
   int32_t rows = pResBlock->info.rows;
-  timeSliceEnsureBlockCapacity(pSliceInfo, pResBlock);
+  timeSliceEnsureBlockCapacity(pSliceInfo, pResBlock, 1);
   // todo set the correct primary timestamp column
 
 
@@ -312,46 +363,9 @@ static bool genInterpolationResult(STimeSliceOperatorInfo* pSliceInfo, SExprSupp
       case TSDB_FILL_SET_VALUE_F: {
         SVariant* pVar = &pSliceInfo->pFillColInfo[fillColIndex].fillVal;
 
-        bool isNull = (TSDB_DATA_TYPE_NULL == pVar->nType) ? true : false;
-        if (pDst->info.type == TSDB_DATA_TYPE_FLOAT) {
-          float v = 0;
-          if (!IS_VAR_DATA_TYPE(pVar->nType)) {
-            GET_TYPED_DATA(v, float, pVar->nType, &pVar->f);
-          } else {
-            v = taosStr2Float(varDataVal(pVar->pz), NULL);
-          }
-          colDataSetVal(pDst, rows, (char*)&v, isNull);
-        } else if (pDst->info.type == TSDB_DATA_TYPE_DOUBLE) {
-          double v = 0;
-          if (!IS_VAR_DATA_TYPE(pVar->nType)) {
-            GET_TYPED_DATA(v, double, pVar->nType, &pVar->d);
-          } else {
-            v = taosStr2Double(varDataVal(pVar->pz), NULL);
-          }
-          colDataSetVal(pDst, rows, (char*)&v, isNull);
-        } else if (IS_SIGNED_NUMERIC_TYPE(pDst->info.type)) {
-          int64_t v = 0;
-          if (!IS_VAR_DATA_TYPE(pVar->nType)) {
-            GET_TYPED_DATA(v, int64_t, pVar->nType, &pVar->i);
-          } else {
-            v = taosStr2Int64(varDataVal(pVar->pz), NULL, 10);
-          }
-          colDataSetVal(pDst, rows, (char*)&v, isNull);
-        } else if (IS_UNSIGNED_NUMERIC_TYPE(pDst->info.type)) {
-          uint64_t v = 0;
-          if (!IS_VAR_DATA_TYPE(pVar->nType)) {
-            GET_TYPED_DATA(v, uint64_t, pVar->nType, &pVar->u);
-          } else {
-            v = taosStr2UInt64(varDataVal(pVar->pz), NULL, 10);
-          }
-          colDataSetVal(pDst, rows, (char*)&v, isNull);
-        } else if (IS_BOOLEAN_TYPE(pDst->info.type)) {
-          bool v = false;
-          if (!IS_VAR_DATA_TYPE(pVar->nType)) {
-            GET_TYPED_DATA(v, bool, pVar->nType, &pVar->i);
-          } else {
-            v = taosStr2Int8(varDataVal(pVar->pz), NULL, 10);
-          }
+        int64_t v = 0;
+        bool    isNull = false;
+        if (getInterpFillValue(pVar, pDst->info.type, (char*)&v, &isNull)) {
           colDataSetVal(pDst, rows, (char*)&v, isNull);
         }
 
@@ -386,11 +400,11 @@ static bool genInterpolationResult(STimeSliceOperatorInfo* pSliceInfo, SExprSupp
           break;
         }
 
-        current.val = taosMemoryCalloc(pLinearInfo->bytes, 1);
+        // linear interpolation only applies to numeric types, the result fits in 8 bytes
+        int64_t out = 0;
+        current.val = &out;
         taosGetLinearInterpolationVal(&current, pLinearInfo->type, &start, &end, pLinearInfo->type);
         colDataSetVal(pDst, rows, (char*)current.val, false);
-
-        taosMemoryFree(current.val);
         break;
       }
       case TSDB_FILL_PREV: {
@@ -436,9 +450,201 @@ static bool genInterpolationResult(STimeSliceOperatorInfo* pSliceInfo, SExprSupp
   return hasInterp;
 }
 
+#define INTERP_RUN_MAX_ROWS 1024
+
+static void setInterpColumnRun(SColumnInfoData* pDst, int32_t start, int32_t numOfRows, const char* pData,
+                               bool isNull) {
+  if (isNull) {
+    colDataSetNNULL(pDst, start, numOfRows);
+    return;
+  }
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    colDataSetVal(pDst, start + i, pData, false);
+  }
+}
+
+/*
+ * The number of the rows of the keys that genInterpolationResult() outputs, and if the interpolation stops at the
+ * first key without output, in which case the current key is not moved beyond it. The fill states are not changed
+ * within the keys, so only the linear fill depends on the key.
+ */
+static int32_t getInterpRunRows(STimeSliceOperatorInfo* pSliceInfo, SExprSupp* pExprSup, const TSKEY* pKeys,
+                                int32_t numOfKeys, bool beforeTs, bool* stop) {
+  *stop = false;
+  if (pSliceInfo->fillType == TSDB_FILL_PREV) {
+    return pSliceInfo->isPrevRowSet ? numOfKeys : 0;
+  } else if (pSliceInfo->fillType == TSDB_FILL_NEXT) {
+    return pSliceInfo->isNextRowSet ? numOfKeys : 0;
+  } else if (pSliceInfo->fillType != TSDB_FILL_LINEAR) {
+    return numOfKeys;
+  }
+
+  bool  hasInterp = true;
+  TSKEY endKey = INT64_MAX;
+  for (int32_t j = 0; j < pExprSup->numOfExprs; ++j) {
+    SExprInfo* pExprInfo = &pExprSup->pExprInfo[j];
+    if (isIrowtsPseudoColumn(pExprInfo) || isIsfilledPseudoColumn(pExprInfo) || !isInterpFunc(pExprInfo)) {
+      continue;
+    }
+
+    SFillLinearInfo* pLinearInfo = taosArrayGet(pSliceInfo->pLinearInfo, pExprInfo->base.pParam[0].pCol->slotId);
+
+    // do not interpolate before ts range, only increase the current key
+    if (beforeTs && !pLinearInfo->isEndSet) {
+      return 0;
+    }
+
+    if (!pLinearInfo->isStartSet || !pLinearInfo->isEndSet) {
+      hasInterp = false;
+    } else if (pLinearInfo->end.key != INT64_MIN) {
+      endKey = TMIN(endKey, pLinearInfo->end.key);
+    }
+  }
+
+  int32_t numOfRows = 0;
+  while (hasInterp && numOfRows < numOfKeys && pKeys[numOfRows] <= endKey) {
+    numOfRows += 1;
+  }
+
+  *stop = (numOfRows < numOfKeys);
+  return numOfRows;
+}
+
+static void genInterpolationRows(STimeSliceOperatorInfo* pSliceInfo, SExprSupp* pExprSup, SSDataBlock* pResBlock,
+                                 SSDataBlock* pSrcBlock, int32_t index, const TSKEY* pKeys, int32_t numOfRows) {
+  int32_t rows = pResBlock->info.rows;
+  int32_t fillColIndex = 0;
+  timeSliceEnsureBlockCapacity(pSliceInfo, pResBlock, numOfRows);
+
+  for (int32_t j = 0; j < pExprSup->numOfExprs; ++j) {
+    SExprInfo*       pExprInfo = &pExprSup->pExprInfo[j];
+    SColumnInfoData* pDst = taosArrayGet(pResBlock->pDataBlock, pExprInfo->base.resSchema.slotId);
+
+    if (isIrowtsPseudoColumn(pExprInfo)) {
+      for (int32_t i = 0; i < numOfRows; ++i) {
+        colDataSetVal(pDst, rows + i, (const char*)&pKeys[i], false);
+      }
+      continue;
+    } else if (isIsfilledPseudoColumn(pExprInfo)) {
+      bool isFilled = true;
+      setInterpColumnRun(pDst, rows, numOfRows, (const char*)&isFilled, false);
+      continue;
+    } else if (!isInterpFunc(pExprInfo)) {
+      if (isGroupKeyFunc(pExprInfo)) {
+        if (pSrcBlock != NULL) {
+          SColumnInfoData* pSrc = taosArrayGet(pSrcBlock->pDataBlock, pExprInfo->base.pParam[0].pCol->slotId);
+          bool             isNull = colDataIsNull_s(pSrc, index);
+          setInterpColumnRun(pDst, rows, numOfRows, isNull ? NULL : colDataGetData(pSrc, index), isNull);
+        } else {
+          // use stored group key
+          SGroupKeys* pkey = pSliceInfo->pPrevGroupKey;
+          setInterpColumnRun(pDst, rows, numOfRows, pkey->pData, pkey->isNull);
+        }
+      }
+      continue;
+    }
+
+    int32_t srcSlot = pExprInfo->base.pParam[0].pCol->slotId;
+    switch (pSliceInfo->fillType) {
+      case TSDB_FILL_NULL:
+      case TSDB_FILL_NULL_F: {
+        colDataSetNNULL(pDst, rows, numOfRows);
+        break;
+      }
+
+      case TSDB_FILL_SET_VALUE:
+      case TSDB_FILL_SET_VALUE_F: {
+        SVariant* pVar = &pSliceInfo->pFillColInfo[fillColIndex].fillVal;
+
+        int64_t v = 0;
+        bool    isNull = false;
+        if (getInterpFillValue(pVar, pDst->info.type, (char*)&v, &isNull)) {
+          setInterpColumnRun(pDst, rows, numOfRows, (const char*)&v, isNull);
+        }
+
+        ++fillColIndex;
+        break;
+      }
+
+      case TSDB_FILL_LINEAR: {
+        SFillLinearInfo* pLinearInfo = taosArrayGet(pSliceInfo->pLinearInfo, srcSlot);
+        if (pLinearInfo->start.key == INT64_MIN || pLinearInfo->end.key == INT64_MIN) {
+          colDataSetNNULL(pDst, rows, numOfRows);
+          break;
+        }
+
+        for (int32_t i = 0; i < numOfRows; ++i) {
+          // linear interpolation only applies to numeric types, the result fits in 8 bytes
+          int64_t out = 0;
+          SPoint  current = {.key = pKeys[i], .val = &out};
+          taosGetLinearInterpolationVal(&current, pLinearInfo->type, &pLinearInfo->start, &pLinearInfo->end,
+                                        pLinearInfo->type);
+          colDataSetVal(pDst, rows + i, (char*)&out, false);
+        }
+        break;
+      }
+
+      case TSDB_FILL_PREV:
+      case TSDB_FILL_NEXT: {
+        SArray*     pRow = (pSliceInfo->fillType == TSDB_FILL_PREV) ? pSliceInfo->pPrevRow : pSliceInfo->pNextRow;
+        SGroupKeys* pkey = taosArrayGet(pRow, srcSlot);
+        setInterpColumnRun(pDst, rows, numOfRows, pkey->pData, pkey->isNull);
+        break;
+      }
+
+      default:
+        break;
+    }
+  }
+
+  pResBlock->info.rows += numOfRows;
+}
+
+/*
+ * Generate the interpolation rows of the keys from the current one until the timestamp ts or the end of the window,
+ * one column at a time. The results are the same as the ones of calling genInterpolationResult() for each key.
+ */
+static void genInterpolationRun(STimeSliceOperatorInfo* pSliceInfo, SExprSupp* pExprSup, SSDataBlock* pResBlock,
+                                SSDataBlock* pSrcBlock, int32_t index, bool beforeTs, int64_t ts) {
+  SInterval* pInterval = &pSliceInfo->interval;
+
+  if (pSliceInfo->fillType == TSDB_FILL_NONE) {
+    while (pSliceInfo->current < ts && pSliceInfo->current <= pSliceInfo->win.ekey) {
+      genInterpolationResult(pSliceInfo, pExprSup, pResBlock, pSrcBlock, index, beforeTs);
+      pSliceInfo->current =
+          taosTimeAdd(pSliceInfo->current, pInterval->interval, pInterval->intervalUnit, pInterval->precision);
+    }
+    return;
+  }
+
+  TSKEY keys[INTERP_RUN_MAX_ROWS];
+  while (pSliceInfo->current < ts && pSliceInfo->current <= pSliceInfo->win.ekey) {
+    int32_t numOfKeys = 0;
+    TSKEY   key = pSliceInfo->current;
+    while (numOfKeys < INTERP_RUN_MAX_ROWS && key < ts && key <= pSliceInfo->win.ekey) {
+      keys[numOfKeys++] = key;
+      key = taosTimeAdd(key, pInterval->interval, pInterval->intervalUnit, pInterval->precision);
+    }
+
+    bool    stop = false;
+    int32_t numOfRows = getInterpRunRows(pSliceInfo, pExprSup, keys, numOfKeys, beforeTs, &stop);
+    if (numOfRows > 0) {
+      genInterpolationRows(pSliceInfo, pExprSup, pResBlock, pSrcBlock, index, keys, numOfRows);
+    }
+
+    if (stop) {
+      pSliceInfo->current = keys[numOfRows];
+      break;
+    }
+
+    pSliceInfo->current = key;
+  }
+}
+
 static void addCurrentRowToResult(STimeSliceOperatorInfo* pSliceInfo, SExprSupp* pExprSup, SSDataBlock* pResBlock,
                                   SSDataBlock* pSrcBlock, int32_t index) {
-  timeSliceEnsureBlockCapacity(pSliceInfo, pResBlock);
+  timeSliceEnsureBlockCapacity(pSliceInfo, pResBlock, 1);
   for (int32_t j = 0; j < pExprSup->numOfExprs; ++j) {
     SExprInfo* pExprInfo = &pExprSup->pExprInfo[j];
 
@@ -733,15 +939,7 @@ static void doTimesliceImpl(SOperatorInfo* pOperator, STimeSliceOperatorInfo* pS
         doKeepNextRows(pSliceInfo, pBlock, i + 1);
         int64_t nextTs = *(int64_t*)colDataGetData(pTsCol, i + 1);
         if (nextTs > pSliceInfo->current) {
-          while (pSliceInfo->current < nextTs && pSliceInfo->current <= pSliceInfo->win.ekey) {
-            if (!genInterpolationResult(pSliceInfo, &pOperator->exprSupp, pResBlock, pBlock, i, false) &&
-                pSliceInfo->fillType == TSDB_FILL_LINEAR) {
-              break;
-            } else {
-              pSliceInfo->current = taosTimeAdd(pSliceInfo->current, pInterval->interval, pInterval->intervalUnit,
-                                                pInterval->precision);
-            }
-          }
+          genInterpolationRun(pSliceInfo, &pOperator->exprSupp, pResBlock, pBlock, i, false, nextTs);
 
           if (checkWindowBoundReached(pSliceInfo)) {
             break;
@@ -761,15 +959,7 @@ static void doTimesliceImpl(SOperatorInfo* pOperator, STimeSliceOperatorInfo* pS
       doKeepNextRows(pSliceInfo, pBlock, i);
       doKeepLinearInfo(pSliceInfo, pBlock, i);
 
-      while (pSliceInfo->current < ts && pSliceInfo->current <= pSliceInfo->win.ekey) {
-        if (!genInterpolationResult(pSliceInfo, &pOperator->exprSupp, pResBlock, pBlock, i, true) &&
-            pSliceInfo->fillType == TSDB_FILL_LINEAR) {
-          break;
-        } else {
-          pSliceInfo->current =
-              taosTimeAdd(pSliceInfo->current, pInterval->interval, pInterval->intervalUnit, pInterval->precision);
-        }
-      }
+      genInterpolationRun(pSliceInfo, &pOperator->exprSupp, pResBlock, pBlock, i, true, ts);
 
       // add current row if timestamp match
       if (ts == pSliceInfo->current && pSliceInfo->current <= pSliceInfo->win.ekey) {
@@ -798,13 +988,9 @@ static void doTimesliceImpl(SOperatorInfo* pOperator, STimeSliceOperatorInfo* pS
 
 static void genInterpAfterDataBlock(STimeSliceOperatorInfo* pSliceInfo, SOperatorInfo* pOperator, int32_t index) {
   SSDataBlock* pResBlock = pSliceInfo->pRes;
-  SInterval*   pInterval = &pSliceInfo->interval;
 
-  while (pSliceInfo->current <= pSliceInfo->win.ekey && pSliceInfo->fillType != TSDB_FILL_NEXT &&
-         pSliceInfo->fillType != TSDB_FILL_LINEAR) {
-    genInterpolationResult(pSliceInfo, &pOperator->exprSupp, pResBlock, NULL, index, false);
-    pSliceInfo->current =
-        taosTimeAdd(pSliceInfo->current, pInterval->interval, pInterval->intervalUnit, pInterval->precision);
+  if (pSliceInfo->fillType != TSDB_FILL_NEXT && pSliceInfo->fillType != TSDB_FILL_LINEAR) {
+    genInterpolationRun(pSliceInfo, &pOperator->exprSupp, pResBlock, NULL, index, false, INT64_MAX);
   }
 }
 
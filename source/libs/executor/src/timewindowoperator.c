@@ -49,6 +49,8 @@ typedef struct SStateWindowOperatorInfo {
   SStateKeys         stateKey;
   int32_t            tsSlotId;  // primary timestamp column slot id
   STimeWindowAggSupp twAggSup;
+  uint8_t*           pChangeFlags;  // per row flag of state value changes in the current block
+  int32_t            changeFlagsCap;
 } SStateWindowOperatorInfo;
 
 typedef enum SResultTsInterpType {
@@ -691,6 +693,88 @@ static bool filterWindowWithLimit(SIntervalAggOperatorInfo* pOperatorInfo, STime
   return false;
 }
 
+// combine the intermediate results of current pane into all the time windows that cover it
+static void doFlushIntervalPane(SOperatorInfo* pOperator) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SIntervalPaneSupp*        pPane = &pInfo->paneSup;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+
+  if (!pPane->open) {
+    return;
+  }
+
+  memcpy(pPane->pCtx, pSup->pCtx, sizeof(SqlFunctionCtx) * pSup->numOfExprs);
+  for (int32_t i = 0; i < pSup->numOfExprs; ++i) {
+    pPane->pCtx[i].resultInfo = getResultEntryInfo(pPane->pRow, i, pSup->rowEntryInfoOffset);
+  }
+
+  // the last time window that starts no later than the pane, and the previous ones until the pane is not covered
+  int64_t     sliding = pInfo->interval.sliding;
+  int64_t     delta = (pPane->win.skey - pPane->anchor) % sliding;
+  STimeWindow win = {.skey = pPane->win.skey - ((delta < 0) ? delta + sliding : delta)};
+  for (; win.skey > pPane->win.skey - pInfo->interval.interval; win.skey -= sliding) {
+    win.ekey = win.skey + pInfo->interval.interval - 1;
+
+    SResultRow* pResult = NULL;
+    int32_t     ret = setTimeWindowOutputBuf(&pInfo->binfo.resultRowInfo, &win, (pPane->scanFlag == MAIN_SCAN), &pResult,
+                                             pPane->groupId, pSup->pCtx, pSup->numOfExprs, pSup->rowEntryInfoOffset,
+                                             &pInfo->aggSup, pTaskInfo);
+    if (ret != TSDB_CODE_SUCCESS || pResult == NULL) {
+      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+    }
+
+    updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &win, 1);
+    compactFunctions(pSup->pCtx, pPane->pCtx, pSup->numOfExprs, pTaskInfo, &pInfo->twAggSup.timeWindowData);
+  }
+
+  pPane->open = false;
+}
+
+// aggregate the rows of data block into panes, each row is aggregated only once no matter how many windows cover it.
+static void doIntervalPaneAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock, int64_t* tsCols, int32_t scanFlag) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SIntervalPaneSupp*        pPane = &pInfo->paneSup;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+  uint64_t                  groupId = pBlock->info.id.groupId;
+
+  if (!pPane->anchored) {
+    pPane->anchor = taosTimeTruncate(tsCols[0], &pInfo->interval);
+    pPane->anchored = true;
+  }
+
+  int32_t startPos = 0;
+  while (startPos < pBlock->info.rows) {
+    int64_t delta = (tsCols[startPos] - pPane->anchor) % pPane->size;
+    int64_t skey = tsCols[startPos] - ((delta < 0) ? delta + pPane->size : delta);
+
+    // the data blocks of different tables may arrive out of order, a pane is flushed once for each continuous part
+    if (pPane->open && (pPane->win.skey != skey || pPane->groupId != groupId || pPane->scanFlag != scanFlag)) {
+      doFlushIntervalPane(pOperator);
+    }
+
+    if (!pPane->open) {
+      memset(pPane->pRow, 0, pInfo->aggSup.resultRowSize);
+      pPane->win.skey = skey;
+      pPane->win.ekey = skey + pPane->size - 1;
+      pPane->groupId = groupId;
+      pPane->scanFlag = scanFlag;
+      pPane->open = true;
+    }
+
+    // the ctx refers to the time windows once the previous pane is flushed
+    setResultRowInitCtx(pPane->pRow, pSup->pCtx, pSup->numOfExprs, pSup->rowEntryInfoOffset);
+
+    int32_t forwardRows = getNumOfRowsInTimeWindow(&pBlock->info, tsCols, startPos, pPane->win.ekey,
+                                                   binarySearchForKey, NULL, TSDB_ORDER_ASC);
+    updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &pPane->win, 1);
+    applyAggFunctionOnPartialTuples(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, startPos, forwardRows,
+                                    pBlock->info.rows, pSup->numOfExprs);
+    startPos += forwardRows;
+  }
+}
+
 static bool hashIntervalAgg(SOperatorInfo* pOperatorInfo, SResultRowInfo* pResultRowInfo, SSDataBlock* pBlock,
                             int32_t scanFlag) {
   SIntervalAggOperatorInfo* pInfo = (SIntervalAggOperatorInfo*)pOperatorInfo->info;
@@ -706,6 +790,10 @@ static bool hashIntervalAgg(SOperatorInfo* pOperatorInfo, SResultRowInfo* pResul
   TSKEY       ts = getStartTsKey(&pBlock->info.window, tsCols);
   SResultRow* pResult = NULL;
 
+  if (pInfo->paneSup.open && pInfo->paneSup.groupId != tableGroupId) {
+    doFlushIntervalPane(pOperatorInfo);
+  }
+
   if (tableGroupId != pInfo->curGroupId) {
     pInfo->handledGroupNum += 1;
     if (pInfo->slimited && pInfo->handledGroupNum > pInfo->slimit) {
@@ -717,6 +805,12 @@ static bool hashIntervalAgg(SOperatorInfo* pOperatorInfo, SResultRowInfo* pResul
     }
   }
 
+  // the data block without primary timestamp column loaded is still aggregated window by window
+  if (pInfo->paneSup.enabled && tsCols != NULL) {
+    doIntervalPaneAgg(pOperatorInfo, pBlock, tsCols, scanFlag);
+    return false;
+  }
+
   STimeWindow win =
       getActiveTimeWindow(pInfo->aggSup.pResultBuf, pResultRowInfo, ts, &pInfo->interval, pInfo->binfo.inputTsOrder);
   if (filterWindowWithLimit(pInfo, &win, tableGroupId)) return false;
@@ -844,6 +938,260 @@ int64_t* extractTsCol(SSDataBlock* pBlock, const SIntervalAggOperatorInfo* pInfo
   return tsCols;
 }
 
+static void freeWinResCacheItem(void* param) { taosMemoryFree(((SWinResCacheItem*)param)->pData); }
+
+static bool isWinResCacheFunc(const SqlFunctionCtx* pCtx) {
+  // the intermediate result of the function should be a flat buffer, without any reference to other buffers
+  if (pCtx->subsidiaries.num > 0 || pCtx->pExpr->pExpr->nodeType != QUERY_NODE_FUNCTION) {
+    return false;
+  }
+
+  switch (pCtx->pExpr->pExpr->_function.functionType) {
+    case FUNCTION_TYPE_COUNT:
+    case FUNCTION_TYPE_SUM:
+    case FUNCTION_TYPE_AVG:
+    case FUNCTION_TYPE_SPREAD:
+    case FUNCTION_TYPE_STDDEV:
+    case FUNCTION_TYPE_FIRST:
+    case FUNCTION_TYPE_LAST:
+    case FUNCTION_TYPE_HYPERLOGLOG:
+    case FUNCTION_TYPE_WSTART:
+    case FUNCTION_TYPE_WEND:
+    case FUNCTION_TYPE_WDURATION:
+      return true;
+    case FUNCTION_TYPE_MIN:
+    case FUNCTION_TYPE_MAX:
+      return !IS_VAR_DATA_TYPE(pCtx->resDataInfo.type);
+    default:
+      return false;
+  }
+}
+
+static int32_t genWinResCacheDigest(SIntervalPhysiNode* pPhyNode, const STableListInfo* pTableListInfo,
+                                    uint8_t* digest) {
+  STableScanPhysiNode* pScanNode = (STableScanPhysiNode*)nodesListGetNode(pPhyNode->window.node.pChildren, 0);
+
+  // the query time range is not a part of the digest, so queries on overlapped ranges share the same cache entry
+  STimeWindow scanRange = pScanNode->scanRange;
+  pScanNode->scanRange = (STimeWindow){0};
+
+  char*   payload = NULL;
+  int32_t len = 0;
+  int32_t code = nodesNodeToMsg((SNode*)pPhyNode, &payload, &len);
+  pScanNode->scanRange = scanRange;
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  int32_t  numOfTables = (int32_t)tableListGetSize(pTableListInfo);
+  int64_t* pUidList = taosMemoryMalloc(numOfTables * sizeof(int64_t));
+  if (pUidList == NULL) {
+    taosMemoryFree(payload);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    pUidList[i] = tableListGetInfo(pTableListInfo, i)->uid;
+  }
+  taosSort(pUidList, numOfTables, sizeof(int64_t), compareInt64Val);
+
+  T_MD5_CTX context = {0};
+  tMD5Init(&context);
+  tMD5Update(&context, (uint8_t*)payload, (uint32_t)len);
+  tMD5Update(&context, (uint8_t*)pUidList, (uint32_t)(numOfTables * sizeof(int64_t)));
+  tMD5Final(&context);
+  memcpy(digest, context.digest, tListLen(context.digest));
+
+  taosMemoryFree(pUidList);
+  taosMemoryFree(payload);
+  return TSDB_CODE_SUCCESS;
+}
+
+// The partial results of the windows that are entirely covered by the query time range are cached by vnode, if the
+// interval directly aggregates the rows of one group from a table scan in ascending order.
+static void initIntervalWinResCache(SOperatorInfo* pOperator, SIntervalPhysiNode* pPhyNode) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SOperatorInfo*            downstream = pOperator->pDownstream[0];
+  SWinResCacheSupp*         pCacheSup = &pInfo->winResSup;
+  SInterval*                pInterval = &pInfo->interval;
+
+  if (tsWinResCacheSize <= 0 || pOperator->pTaskInfo->execModel != OPTR_EXEC_MODEL_BATCH ||
+      downstream->operatorType != QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    return;
+  }
+
+  if (pInfo->timeWindowInterpo || pInfo->limited || pInfo->slimited || pInfo->binfo.inputTsOrder != TSDB_ORDER_ASC ||
+      pInterval->interval != pInterval->sliding || pInterval->intervalUnit != pInterval->slidingUnit ||
+      IS_CALENDAR_TIME_DURATION(pInterval->intervalUnit)) {
+    return;
+  }
+
+  STableScanInfo*      pScanInfo = downstream->info;
+  STableScanPhysiNode* pScanNode = (STableScanPhysiNode*)nodesListGetNode(pPhyNode->window.node.pChildren, 0);
+  SQueryTableDataCond* pCond = &pScanInfo->base.cond;
+  if (pScanNode->pGroupTags != NULL || pScanNode->scan.pScanPseudoCols != NULL ||
+      pScanInfo->scanMode == TABLE_SCAN__TABLE_ORDER || pScanInfo->scanInfo.numOfAsc != 1 ||
+      pScanInfo->scanInfo.numOfDesc != 0 || pScanInfo->sample.sampleRatio != 1 ||
+      pScanInfo->base.limitInfo.limit.limit != -1 || pScanInfo->base.limitInfo.slimit.limit != -1 ||
+      pCond->order != TSDB_ORDER_ASC || pCond->startVersion != -1 || pCond->endVersion != -1 ||
+      pCond->twindows.skey == INT64_MIN || tableListGetOutputGroups(pScanInfo->base.pTableListInfo) != 1 ||
+      tableListGetSuid(pScanInfo->base.pTableListInfo) == 0) {
+    return;
+  }
+
+  for (int32_t i = 0; i < pOperator->exprSupp.numOfExprs; ++i) {
+    if (!isWinResCacheFunc(&pOperator->exprSupp.pCtx[i])) {
+      return;
+    }
+  }
+
+  STimeWindow first = getAlignQueryTimeWindow(pInterval, pCond->twindows.skey);
+  STimeWindow last = getAlignQueryTimeWindow(pInterval, pCond->twindows.ekey);
+  pCacheSup->range.skey = (first.skey == pCond->twindows.skey) ? first.skey : first.ekey + 1;
+  pCacheSup->range.ekey = (last.ekey == pCond->twindows.ekey) ? last.ekey : last.skey - 1;
+  if (pCacheSup->range.skey > pCacheSup->range.ekey) {
+    return;
+  }
+
+  if (genWinResCacheDigest(pPhyNode, pScanInfo->base.pTableListInfo, pCacheSup->digest) != TSDB_CODE_SUCCESS) {
+    return;
+  }
+
+  pCacheSup->suid = tableListGetSuid(pScanInfo->base.pTableListInfo);
+  pCacheSup->seq = -1;
+  pCacheSup->enabled = true;
+}
+
+// restore the cached windows into the result buffer, and let the table scan skip the time range of them
+static int32_t restoreIntervalWinRes(SOperatorInfo* pOperator) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+  SWinResCacheSupp*         pCacheSup = &pInfo->winResSup;
+  STableScanInfo*           pScanInfo = pOperator->pDownstream[0]->info;
+  STimeWindow*              pQueryWin = &pScanInfo->base.cond.twindows;
+  SArray*                   pItems = NULL;
+  STimeWindow               range = {0};
+
+  // The write sequence number has to be taken before the reader fixes its version range. A write advances the applied
+  // version of the vnode before its rows are inserted and the cache is invalidated, so the writes counted in the
+  // sequence number are visible to a reader opened afterwards, and the others are applied to the entry put back.
+  if (pScanInfo->base.dataReader != NULL) {
+    qDebug("%s table reader already opened, window result cache disabled", GET_TASKID(pTaskInfo));
+    pCacheSup->enabled = false;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = pTaskInfo->storageAPI.metaFn.getCachedWinRes(pScanInfo->base.readHandle.vnode, pCacheSup->suid,
+                                                              pCacheSup->digest, tListLen(pCacheSup->digest), &range,
+                                                              &pItems, &pCacheSup->seq);
+  if (code != TSDB_CODE_SUCCESS || pItems == NULL) {
+    return code;
+  }
+
+  range.skey = TMAX(range.skey, pCacheSup->range.skey);
+  range.ekey = TMIN(range.ekey, pCacheSup->range.ekey);
+
+  int32_t len = pInfo->aggSup.resultRowSize - sizeof(SResultRow);
+  for (int32_t i = 0; i < taosArrayGetSize(pItems); ++i) {
+    if (((SWinResCacheItem*)taosArrayGet(pItems, i))->len != len) {
+      range.skey = INT64_MAX;
+      break;
+    }
+  }
+
+  if (range.skey > range.ekey) {
+    taosArrayDestroyEx(pItems, freeWinResCacheItem);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t numOfWins = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pItems); ++i) {
+    SWinResCacheItem* pItem = taosArrayGet(pItems, i);
+    if (pItem->win.skey < range.skey || pItem->win.ekey > range.ekey) {
+      continue;
+    }
+
+    SResultRow* pResult = NULL;
+    code = setTimeWindowOutputBuf(&pInfo->binfo.resultRowInfo, &pItem->win, true, &pResult, 0, pSup->pCtx,
+                                  pSup->numOfExprs, pSup->rowEntryInfoOffset, &pInfo->aggSup, pTaskInfo);
+    if (code != TSDB_CODE_SUCCESS || pResult == NULL) {
+      taosArrayDestroyEx(pItems, freeWinResCacheItem);
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    memcpy(pResult->pEntryInfo, pItem->pData, len);
+    numOfWins += 1;
+  }
+  taosArrayDestroyEx(pItems, freeWinResCacheItem);
+
+  // scan the new data first, since the reader can not be reset anymore once the range is out of the keep of vnode
+  SArray* pRanges = taosArrayInit(2, sizeof(STimeWindow));
+  if (pRanges == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  if (range.ekey < pQueryWin->ekey) {
+    taosArrayPush(pRanges, &(STimeWindow){.skey = range.ekey + 1, .ekey = pQueryWin->ekey});
+  }
+  if (range.skey > pQueryWin->skey) {
+    taosArrayPush(pRanges, &(STimeWindow){.skey = pQueryWin->skey, .ekey = range.skey - 1});
+  }
+  setTableScanTimeRanges(pScanInfo, pRanges);
+
+  qDebug("%s restore %d cached windows in range %" PRId64 " - %" PRId64, GET_TASKID(pTaskInfo), numOfWins, range.skey,
+         range.ekey);
+  return TSDB_CODE_SUCCESS;
+}
+
+static void saveIntervalWinRes(SOperatorInfo* pOperator) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+  SWinResCacheSupp*         pCacheSup = &pInfo->winResSup;
+  STableScanInfo*           pScanInfo = pOperator->pDownstream[0]->info;
+  SDiskbasedBuf*            pBuf = pInfo->aggSup.pResultBuf;
+  int32_t                   len = pInfo->aggSup.resultRowSize - sizeof(SResultRow);
+
+  if (pCacheSup->seq < 0) {
+    return;
+  }
+
+  int32_t numOfRows = taosArrayGetSize(pInfo->groupResInfo.pRows);
+  SArray* pItems = taosArrayInit(numOfRows, sizeof(SWinResCacheItem));
+  if (pItems == NULL) {
+    return;
+  }
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    SResKeyPos* pPos = taosArrayGetP(pInfo->groupResInfo.pRows, i);
+    SFilePage*  pPage = getBufPage(pBuf, pPos->pos.pageId);
+    if (pPage == NULL) {
+      taosArrayDestroyEx(pItems, freeWinResCacheItem);
+      return;
+    }
+
+    SResultRow* pRow = (SResultRow*)((char*)pPage + pPos->pos.offset);
+    if (pRow->win.skey >= pCacheSup->range.skey && pRow->win.ekey <= pCacheSup->range.ekey) {
+      SWinResCacheItem item = {.win = pRow->win, .len = len, .pData = taosMemoryMalloc(len)};
+      if (item.pData == NULL) {
+        releaseBufPage(pBuf, pPage);
+        taosArrayDestroyEx(pItems, freeWinResCacheItem);
+        return;
+      }
+
+      memcpy(item.pData, pRow->pEntryInfo, len);
+      taosArrayPush(pItems, &item);
+    }
+    releaseBufPage(pBuf, pPage);
+  }
+
+  // ordered by the window start key, which is the first field of the item
+  taosArraySort(pItems, compareInt64Val);
+  pTaskInfo->storageAPI.metaFn.putCachedWinRes(pScanInfo->base.readHandle.vnode, pCacheSup->suid, pCacheSup->digest,
+                                               tListLen(pCacheSup->digest), &pInfo->interval, &pCacheSup->range,
+                                               pItems, pCacheSup->seq);
+}
+
 static int32_t doOpenIntervalAgg(SOperatorInfo* pOperator) {
   if (OPTR_IS_OPENED(pOperator)) {
     return TSDB_CODE_SUCCESS;
@@ -858,6 +1206,13 @@ static int32_t doOpenIntervalAgg(SOperatorInfo* pOperator) {
   int32_t scanFlag = MAIN_SCAN;
   int64_t st = taosGetTimestampUs();
 
+  if (pInfo->winResSup.enabled) {
+    int32_t code = restoreIntervalWinRes(pOperator);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+  }
+
   while (1) {
     SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, 0);
     if (pBlock == NULL) {
@@ -876,95 +1231,184 @@ static int32_t doOpenIntervalAgg(SOperatorInfo* pOperator) {
     if (hashIntervalAgg(pOperator, &pInfo->binfo.resultRowInfo, pBlock, scanFlag)) break;
   }
 
+  doFlushIntervalPane(pOperator);
   initGroupedResultInfo(&pInfo->groupResInfo, pInfo->aggSup.pResultRowHashTable, pInfo->binfo.outputTsOrder);
+  if (pInfo->winResSup.enabled && !isTaskKilled(pTaskInfo)) {
+    saveIntervalWinRes(pOperator);
+  }
   OPTR_SET_OPENED(pOperator);
 
   pOperator->cost.openCost = (taosGetTimestampUs() - st) / 1000.0;
   return TSDB_CODE_SUCCESS;
 }
 
-static void doStateWindowAggImpl(SOperatorInfo* pOperator, SStateWindowOperatorInfo* pInfo, SSDataBlock* pBlock) {
-  SExecTaskInfo* pTaskInfo = pOperator->pTaskInfo;
-  SExprSupp*     pSup = &pOperator->exprSupp;
+static void doKeepStateKey(SStateWindowOperatorInfo* pInfo, const char* val, int32_t bytes) {
+  if (IS_VAR_DATA_TYPE(pInfo->stateKey.type)) {
+    varDataCopy(pInfo->stateKey.pData, val);
+  } else {
+    memcpy(pInfo->stateKey.pData, val, bytes);
+  }
+}
 
-  SColumnInfoData* pStateColInfoData = taosArrayGet(pBlock->pDataBlock, pInfo->stateCol.slotId);
-  int64_t          gid = pBlock->info.id.groupId;
+static void doStateWindowAggRows(SOperatorInfo* pOperator, SStateWindowOperatorInfo* pInfo, SSDataBlock* pBlock,
+                                 STimeWindow* pWin) {
+  SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
+  SExprSupp*      pSup = &pOperator->exprSupp;
+  SWindowRowsSup* pRowSup = &pInfo->winSup;
+  SResultRow*     pResult = NULL;
 
-  bool    masterScan = true;
-  int32_t numOfOutput = pOperator->exprSupp.numOfExprs;
-  int32_t bytes = pStateColInfoData->info.bytes;
+  int32_t ret = setTimeWindowOutputBuf(&pInfo->binfo.resultRowInfo, pWin, true, &pResult, pBlock->info.id.groupId,
+                                       pSup->pCtx, pSup->numOfExprs, pSup->rowEntryInfoOffset, &pInfo->aggSup, pTaskInfo);
+  if (ret != TSDB_CODE_SUCCESS) {  // null data, too many state code
+    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
+  }
 
-  SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, pInfo->tsSlotId);
-  TSKEY*           tsList = (TSKEY*)pColInfoData->pData;
+  updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, pWin, 0);
+  applyAggFunctionOnPartialTuples(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, pRowSup->startRowIndex,
+                                  pRowSup->numOfRows, pBlock->info.rows, pSup->numOfExprs);
+}
 
+// a new state window started at row j, close the current one
+static void doCloseStateWindow(SOperatorInfo* pOperator, SStateWindowOperatorInfo* pInfo, SSDataBlock* pBlock,
+                               const TSKEY* tsList, int32_t j) {
   SWindowRowsSup* pRowSup = &pInfo->winSup;
-  pRowSup->numOfRows = 0;
-  pRowSup->startRowIndex = 0;
 
-  struct SColumnDataAgg* pAgg = NULL;
-  for (int32_t j = 0; j < pBlock->info.rows; ++j) {
-    pAgg = (pBlock->pBlockAgg != NULL) ? pBlock->pBlockAgg[pInfo->stateCol.slotId] : NULL;
-    if (colDataIsNull(pStateColInfoData, pBlock->info.rows, j, pAgg)) {
-      continue;
-    }
+  // keep the time window for the closed time window.
+  STimeWindow window = pRowSup->win;
+  pRowSup->win.ekey = pRowSup->win.skey;
+  doStateWindowAggRows(pOperator, pInfo, pBlock, &window);
 
-    char* val = colDataGetData(pStateColInfoData, j);
+  // here we start a new session window
+  doKeepNewWindowStartInfo(pRowSup, tsList, j, pBlock->info.id.groupId);
+}
 
-    if (gid != pRowSup->groupId || !pInfo->hasKey) {
-      // todo extract method
-      if (IS_VAR_DATA_TYPE(pInfo->stateKey.type)) {
-        varDataCopy(pInfo->stateKey.pData, val);
-      } else {
-        memcpy(pInfo->stateKey.pData, val, bytes);
+#define MARK_STATE_CHANGES(_t, _v, _rows, _flags) \
+  do {                                            \
+    const _t* _d = (const _t*)(_v);               \
+    for (int32_t _i = 1; _i < (_rows); ++_i) {    \
+      (_flags)[_i] = (_d[_i] != _d[_i - 1]);      \
+    }                                             \
+  } while (0)
+
+// set pFlags[i] to 1 if the state value of row i differs from row i - 1. The column must not contain null values.
+// Values are compared by their bytes, the same as compareVal.
+static void markStateChanges(const SColumnInfoData* pCol, int32_t numOfRows, uint8_t* pFlags) {
+  if (IS_VAR_DATA_TYPE(pCol->info.type)) {
+    for (int32_t i = 1; i < numOfRows; ++i) {
+      const char* v = colDataGetVarData(pCol, i);
+      const char* prev = colDataGetVarData(pCol, i - 1);
+      pFlags[i] = (varDataLen(v) != varDataLen(prev)) || memcmp(varDataVal(v), varDataVal(prev), varDataLen(v)) != 0;
+    }
+    return;
+  }
+
+  switch (pCol->info.bytes) {
+    case sizeof(uint8_t):
+      MARK_STATE_CHANGES(uint8_t, pCol->pData, numOfRows, pFlags);
+      break;
+    case sizeof(uint16_t):
+      MARK_STATE_CHANGES(uint16_t, pCol->pData, numOfRows, pFlags);
+      break;
+    case sizeof(uint32_t):
+      MARK_STATE_CHANGES(uint32_t, pCol->pData, numOfRows, pFlags);
+      break;
+    case sizeof(uint64_t):
+      MARK_STATE_CHANGES(uint64_t, pCol->pData, numOfRows, pFlags);
+      break;
+    default: {
+      int32_t bytes = pCol->info.bytes;
+      for (int32_t i = 1; i < numOfRows; ++i) {
+        pFlags[i] = memcmp(pCol->pData + i * bytes, pCol->pData + (i - 1) * bytes, bytes) != 0;
       }
+      break;
+    }
+  }
+}
 
-      pInfo->hasKey = true;
+// the state column has no null value in this block: find all the state changes of the block at once, and then
+// aggregate the runs of equal state values as a whole.
+static void doStateWindowAggBatch(SOperatorInfo* pOperator, SStateWindowOperatorInfo* pInfo, SSDataBlock* pBlock,
+                                  SColumnInfoData* pStateColInfoData, const TSKEY* tsList) {
+  SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
+  SWindowRowsSup* pRowSup = &pInfo->winSup;
+  int64_t         gid = pBlock->info.id.groupId;
+  int32_t         rows = pBlock->info.rows;
+  int32_t         bytes = pStateColInfoData->info.bytes;
 
+  if (pInfo->changeFlagsCap < rows) {
+    uint8_t* p = taosMemoryRealloc(pInfo->pChangeFlags, rows);
+    if (p == NULL) {
+      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+    }
+    pInfo->pChangeFlags = p;
+    pInfo->changeFlagsCap = rows;
+  }
+
+  uint8_t* pFlags = pInfo->pChangeFlags;
+  markStateChanges(pStateColInfoData, rows, pFlags);
+
+  for (int32_t j = 0; j < rows;) {
+    // rows [j, end) share the same state value
+    uint8_t* pNext = (j + 1 < rows) ? memchr(pFlags + j + 1, 1, rows - j - 1) : NULL;
+    int32_t  end = (pNext != NULL) ? (int32_t)(pNext - pFlags) : rows;
+    char*    val = colDataGetData(pStateColInfoData, j);
+
+    if (gid != pRowSup->groupId || !pInfo->hasKey) {
+      doKeepStateKey(pInfo, val, bytes);
+      pInfo->hasKey = true;
       doKeepNewWindowStartInfo(pRowSup, tsList, j, gid);
-      doKeepTuple(pRowSup, tsList[j], gid);
-    } else if (compareVal(val, &pInfo->stateKey)) {
-      doKeepTuple(pRowSup, tsList[j], gid);
-    } else {  // a new state window started
-      SResultRow* pResult = NULL;
+    } else if (j > 0 || !compareVal(val, &pInfo->stateKey)) {
+      doCloseStateWindow(pOperator, pInfo, pBlock, tsList, j);
+      doKeepStateKey(pInfo, val, bytes);
+    }
 
-      // keep the time window for the closed time window.
-      STimeWindow window = pRowSup->win;
+    pRowSup->numOfRows += end - j - 1;
+    doKeepTuple(pRowSup, tsList[end - 1], gid);
+    j = end;
+  }
+}
 
-      pRowSup->win.ekey = pRowSup->win.skey;
-      int32_t ret = setTimeWindowOutputBuf(&pInfo->binfo.resultRowInfo, &window, masterScan, &pResult, gid, pSup->pCtx,
-                                           numOfOutput, pSup->rowEntryInfoOffset, &pInfo->aggSup, pTaskInfo);
-      if (ret != TSDB_CODE_SUCCESS) {  // null data, too many state code
-        T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
+static void doStateWindowAggImpl(SOperatorInfo* pOperator, SStateWindowOperatorInfo* pInfo, SSDataBlock* pBlock) {
+  SColumnInfoData* pStateColInfoData = taosArrayGet(pBlock->pDataBlock, pInfo->stateCol.slotId);
+  int64_t          gid = pBlock->info.id.groupId;
+  int32_t          bytes = pStateColInfoData->info.bytes;
+
+  SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, pInfo->tsSlotId);
+  TSKEY*           tsList = (TSKEY*)pColInfoData->pData;
+
+  SWindowRowsSup* pRowSup = &pInfo->winSup;
+  pRowSup->numOfRows = 0;
+  pRowSup->startRowIndex = 0;
+
+  struct SColumnDataAgg* pAgg = (pBlock->pBlockAgg != NULL) ? pBlock->pBlockAgg[pInfo->stateCol.slotId] : NULL;
+  if (!pStateColInfoData->hasNull || (pAgg != NULL && pAgg->numOfNull == 0)) {
+    doStateWindowAggBatch(pOperator, pInfo, pBlock, pStateColInfoData, tsList);
+  } else {
+    for (int32_t j = 0; j < pBlock->info.rows; ++j) {
+      if (colDataIsNull(pStateColInfoData, pBlock->info.rows, j, pAgg)) {
+        continue;
       }
 
-      updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &window, 0);
-      applyAggFunctionOnPartialTuples(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, pRowSup->startRowIndex,
-                                      pRowSup->numOfRows, pBlock->info.rows, numOfOutput);
+      char* val = colDataGetData(pStateColInfoData, j);
 
-      // here we start a new session window
-      doKeepNewWindowStartInfo(pRowSup, tsList, j, gid);
-      doKeepTuple(pRowSup, tsList[j], gid);
+      if (gid != pRowSup->groupId || !pInfo->hasKey) {
+        doKeepStateKey(pInfo, val, bytes);
+        pInfo->hasKey = true;
 
-      // todo extract method
-      if (IS_VAR_DATA_TYPE(pInfo->stateKey.type)) {
-        varDataCopy(pInfo->stateKey.pData, val);
-      } else {
-        memcpy(pInfo->stateKey.pData, val, bytes);
+        doKeepNewWindowStartInfo(pRowSup, tsList, j, gid);
+        doKeepTuple(pRowSup, tsList[j], gid);
+      } else if (compareVal(val, &pInfo->stateKey)) {
+        doKeepTuple(pRowSup, tsList[j], gid);
+      } else {  // a new state window started
+        doCloseStateWindow(pOperator, pInfo, pBlock, tsList, j);
+        doKeepTuple(pRowSup, tsList[j], gid);
+        doKeepStateKey(pInfo, val, bytes);
       }
     }
   }
 
-  SResultRow* pResult = NULL;
   pRowSup->win.ekey = tsList[pBlock->info.rows - 1];
-  int32_t ret = setTimeWindowOutputBuf(&pInfo->binfo.resultRowInfo, &pRowSup->win, masterScan, &pResult, gid,
-                                       pSup->pCtx, numOfOutput, pSup->rowEntryInfoOffset, &pInfo->aggSup, pTaskInfo);
-  if (ret != TSDB_CODE_SUCCESS) {  // null data, too many state code
-    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
-  }
-
-  updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &pRowSup->win, 0);
-  applyAggFunctionOnPartialTuples(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, pRowSup->startRowIndex,
-                                  pRowSup->numOfRows, pBlock->info.rows, numOfOutput);
+  doStateWindowAggRows(pOperator, pInfo, pBlock, &pRowSup->win);
 }
 
 static int32_t openStateWindowAggOptr(SOperatorInfo* pOperator) {
@@ -1079,6 +1523,141 @@ static SSDataBlock* doBuildIntervalResult(SOperatorInfo* pOperator) {
   return (rows == 0) ? NULL : pBlock;
 }
 
+static int64_t floorDivInt64(int64_t a, int64_t b) {
+  int64_t q = a / b;
+  return (a % b < 0) ? q - 1 : q;
+}
+
+// the sequence number of a time window may be negative if it starts before the anchor
+static SResultRow* getOrderedIntervalRow(SIntervalOrderedSupp* pOrdered, int64_t seq) {
+  int64_t index = seq % pOrdered->capacity;
+  return pOrdered->pRows[(index < 0) ? index + pOrdered->capacity : index];
+}
+
+// finalize the oldest open time windows that end before ts, and emit them into the result block
+static void doCloseOrderedIntervalWindows(SOperatorInfo* pOperator, TSKEY ts) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SIntervalOrderedSupp*     pOrdered = &pInfo->orderedSup;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+  SSDataBlock*              pRes = pInfo->binfo.pRes;
+
+  while (pOrdered->numOfOpen > 0) {
+    SResultRow* pRow = getOrderedIntervalRow(pOrdered, pOrdered->startWin);
+    if (pRow->win.ekey >= ts) {
+      break;
+    }
+
+    int32_t code = finalizeResultRow(pRow, &pOperator->exprSupp, pRes, pTaskInfo);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+
+    pRes->info.id.groupId = pOrdered->groupId;
+    pOrdered->startWin += 1;
+    pOrdered->numOfOpen -= 1;
+  }
+}
+
+static void doOrderedIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SIntervalOrderedSupp*     pOrdered = &pInfo->orderedSup;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+  SInterval*                pInterval = &pInfo->interval;
+  int64_t*                  tsCols = extractTsCol(pBlock, pInfo);
+
+  if (pOrdered->numOfOpen > 0 && pOrdered->groupId != pBlock->info.id.groupId) {
+    doCloseOrderedIntervalWindows(pOperator, INT64_MAX);
+  }
+  pOrdered->groupId = pBlock->info.id.groupId;
+
+  if (!pOrdered->anchored) {
+    pOrdered->anchor = taosTimeTruncate(getStartTsKey(&pBlock->info.window, tsCols), pInterval);
+    pOrdered->anchored = true;
+  }
+
+  int32_t startPos = 0;
+  while (startPos < pBlock->info.rows) {
+    TSKEY ts = (tsCols != NULL) ? tsCols[startPos] : pBlock->info.window.skey;
+    doCloseOrderedIntervalWindows(pOperator, ts);
+
+    // all the time windows from the oldest open one to the last one starting no later than ts cover ts
+    int64_t lastWin = floorDivInt64(ts - pOrdered->anchor, pInterval->sliding);
+    if (pOrdered->numOfOpen == 0) {
+      pOrdered->startWin = floorDivInt64(ts - pInterval->interval - pOrdered->anchor, pInterval->sliding) + 1;
+    }
+
+    while (pOrdered->startWin + pOrdered->numOfOpen <= lastWin) {
+      int64_t     seq = pOrdered->startWin + pOrdered->numOfOpen;
+      SResultRow* pRow = getOrderedIntervalRow(pOrdered, seq);
+      resetResultRow(pRow, pInfo->aggSup.resultRowSize - sizeof(SResultRow));
+      pRow->win.skey = pOrdered->anchor + seq * pInterval->sliding;
+      pRow->win.ekey = pRow->win.skey + pInterval->interval - 1;
+      pOrdered->numOfOpen += 1;
+    }
+
+    // rows are applied to the same time windows until the oldest one is closed or a new one is opened
+    int32_t forwardRows = pBlock->info.rows;
+    if (tsCols != NULL) {
+      SResultRow* pFirst = getOrderedIntervalRow(pOrdered, pOrdered->startWin);
+      TSKEY       ekey = TMIN(pFirst->win.ekey, pOrdered->anchor + (lastWin + 1) * pInterval->sliding - 1);
+      forwardRows = getNumOfRowsInTimeWindow(&pBlock->info, tsCols, startPos, ekey, binarySearchForKey, NULL,
+                                             TSDB_ORDER_ASC);
+    }
+
+    for (int64_t seq = pOrdered->startWin; seq <= lastWin; ++seq) {
+      SResultRow* pRow = getOrderedIntervalRow(pOrdered, seq);
+      setResultRowInitCtx(pRow, pSup->pCtx, pSup->numOfExprs, pSup->rowEntryInfoOffset);
+      updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &pRow->win, 1);
+      applyAggFunctionOnPartialTuples(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, startPos, forwardRows,
+                                      pBlock->info.rows, pSup->numOfExprs);
+    }
+
+    startPos += forwardRows;
+  }
+}
+
+static SSDataBlock* doOrderedIntervalAgg(SOperatorInfo* pOperator) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+  SSDataBlock*              pRes = pInfo->binfo.pRes;
+
+  if (pOperator->status == OP_EXEC_DONE) {
+    return NULL;
+  }
+
+  blockDataCleanup(pRes);
+
+  while (1) {
+    SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, 0);
+    if (pBlock == NULL) {
+      doCloseOrderedIntervalWindows(pOperator, INT64_MAX);
+      doFilter(pRes, pSup->pFilterInfo, NULL);
+      setOperatorCompleted(pOperator);
+      break;
+    }
+
+    pRes->info.scanFlag = pBlock->info.scanFlag;
+    if (pInfo->scalarSupp.pExprInfo != NULL) {
+      SExprSupp* pExprSup = &pInfo->scalarSupp;
+      projectApplyFunctions(pExprSup->pExprInfo, pBlock, pBlock, pExprSup->pCtx, pExprSup->numOfExprs, NULL);
+    }
+
+    setInputDataBlock(pSup, pBlock, pInfo->binfo.inputTsOrder, pBlock->info.scanFlag, true);
+    doOrderedIntervalAggImpl(pOperator, pBlock);
+
+    if (pRes->info.rows >= pOperator->resultInfo.threshold) {
+      doFilter(pRes, pSup->pFilterInfo, NULL);
+      if (pRes->info.rows > 0) {
+        break;
+      }
+    }
+  }
+
+  pOperator->resultInfo.totalRows += pRes->info.rows;
+  return (pRes->info.rows == 0) ? NULL : pRes;
+}
+
 static void setInverFunction(SqlFunctionCtx* pCtx, int32_t num, EStreamType type) {
   for (int i = 0; i < num; i++) {
     if (type == STREAM_INVERT) {
@@ -1119,6 +1698,7 @@ static void destroyStateWindowOperatorInfo(void* param) {
   SStateWindowOperatorInfo* pInfo = (SStateWindowOperatorInfo*)param;
   cleanupBasicInfo(&pInfo->binfo);
   taosMemoryFreeClear(pInfo->stateKey.pData);
+  taosMemoryFreeClear(pInfo->pChangeFlags);
   cleanupExprSupp(&pInfo->scalarSup);
   colDataDestroy(&pInfo->twAggSup.timeWindowData);
   cleanupAggSup(&pInfo->aggSup);
@@ -1148,9 +1728,126 @@ void destroyIntervalOperatorInfo(void* param) {
   cleanupGroupResInfo(&pInfo->groupResInfo);
   colDataDestroy(&pInfo->twAggSup.timeWindowData);
   destroyBoundedQueue(pInfo->pBQ);
+  taosMemoryFreeClear(pInfo->paneSup.pRow);
+  taosMemoryFreeClear(pInfo->paneSup.pCtx);
+  if (pInfo->orderedSup.pRows != NULL) {
+    for (int32_t i = 0; i < pInfo->orderedSup.capacity; ++i) {
+      taosMemoryFree(pInfo->orderedSup.pRows[i]);
+    }
+    taosMemoryFreeClear(pInfo->orderedSup.pRows);
+  }
   taosMemoryFreeClear(param);
 }
 
+static int64_t getGreatestCommonDivisor(int64_t a, int64_t b) {
+  while (b != 0) {
+    int64_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+// pane based aggregation requires that the intermediate results of all functions can be combined, and the windows are
+// of fixed length.
+static bool isIntervalPaneApplicable(SIntervalAggOperatorInfo* pInfo, SqlFunctionCtx* pCtx, int32_t numOfOutput) {
+  SInterval* pInterval = &pInfo->interval;
+  if (pInterval->sliding <= 0 || pInterval->sliding >= pInterval->interval ||
+      IS_CALENDAR_TIME_DURATION(pInterval->intervalUnit) || IS_CALENDAR_TIME_DURATION(pInterval->slidingUnit)) {
+    return false;
+  }
+
+  if (pInfo->timeWindowInterpo || pInfo->limited || pInfo->winResSup.enabled ||
+      pInfo->binfo.inputTsOrder != TSDB_ORDER_ASC) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < numOfOutput; ++i) {
+    int32_t functionId = pCtx[i].functionId;
+    if (functionId != -1 && fmIsWindowPseudoColumnFunc(functionId)) {
+      continue;
+    }
+
+    if (functionId == -1 || pCtx[i].isPseudoFunc || pCtx[i].fpSet.combine == NULL || pCtx[i].subsidiaries.num > 0 ||
+        fmIsMultiRowsFunc(functionId) || fmIsUserDefinedFunc(functionId) || fmIsRepeatScanFunc(functionId)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// the ordered mode requires that the rows of only one table arrive in ascending timestamp order by a single scan, and
+// the time windows are of fixed length.
+static bool isIntervalOrderedApplicable(SIntervalAggOperatorInfo* pInfo, SOperatorInfo* downstream) {
+  SInterval* pInterval = &pInfo->interval;
+  if (pInterval->sliding <= 0 || IS_CALENDAR_TIME_DURATION(pInterval->intervalUnit) ||
+      IS_CALENDAR_TIME_DURATION(pInterval->slidingUnit)) {
+    return false;
+  }
+
+  if (pInfo->paneSup.enabled || pInfo->timeWindowInterpo || pInfo->limited || pInfo->slimited ||
+      pInfo->winResSup.enabled) {
+    return false;
+  }
+
+  if (pInfo->binfo.inputTsOrder != TSDB_ORDER_ASC || pInfo->binfo.outputTsOrder != TSDB_ORDER_ASC ||
+      downstream->operatorType != QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    return false;
+  }
+
+  STableScanInfo* pScanInfo = downstream->info;
+  return tableListGetSize(pScanInfo->base.pTableListInfo) == 1 && pScanInfo->scanInfo.numOfAsc == 1 &&
+         pScanInfo->scanInfo.numOfDesc == 0 && pScanInfo->base.cond.order == TSDB_ORDER_ASC;
+}
+
+static int32_t initIntervalOrderedSupp(SOperatorInfo* pOperator, SOperatorInfo* downstream) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SIntervalOrderedSupp*     pOrdered = &pInfo->orderedSup;
+  if (!isIntervalOrderedApplicable(pInfo, downstream)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // at most ceil(interval / sliding) time windows are open at the same time
+  pOrdered->capacity = (pInfo->interval.interval + pInfo->interval.sliding - 1) / pInfo->interval.sliding;
+  pOrdered->pRows = taosMemoryCalloc(pOrdered->capacity, POINTER_BYTES);
+  if (pOrdered->pRows == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < pOrdered->capacity; ++i) {
+    pOrdered->pRows[i] = taosMemoryCalloc(1, pInfo->aggSup.resultRowSize);
+    if (pOrdered->pRows[i] == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  pOrdered->enabled = true;
+  pOperator->blocking = false;
+  pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, doOrderedIntervalAgg, NULL, destroyIntervalOperatorInfo,
+                                         optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t initIntervalPaneSupp(SIntervalAggOperatorInfo* pInfo, SExprSupp* pSup) {
+  SIntervalPaneSupp* pPane = &pInfo->paneSup;
+  if (!isIntervalPaneApplicable(pInfo, pSup->pCtx, pSup->numOfExprs)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pPane->pRow = taosMemoryCalloc(1, pInfo->aggSup.resultRowSize);
+  pPane->pCtx = taosMemoryCalloc(pSup->numOfExprs, sizeof(SqlFunctionCtx));
+  if (pPane->pRow == NULL || pPane->pCtx == NULL) {
+    taosMemoryFreeClear(pPane->pRow);
+    taosMemoryFreeClear(pPane->pCtx);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pPane->size = getGreatestCommonDivisor(pInfo->interval.interval, pInfo->interval.sliding);
+  pPane->enabled = true;
+  return TSDB_CODE_SUCCESS;
+}
+
 static bool timeWindowinterpNeeded(SqlFunctionCtx* pCtx, int32_t numOfCols, SIntervalAggOperatorInfo* pInfo) {
   // the primary timestamp column
   bool needed = false;
@@ -1297,6 +1994,17 @@ SOperatorInfo* createIntervalOperatorInfo(SOperatorInfo* downstream, SIntervalPh
     goto _error;
   }
 
+  initIntervalWinResCache(pOperator, pPhyNode);
+  code = initIntervalPaneSupp(pInfo, pSup);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _error;
+  }
+
+  code = initIntervalOrderedSupp(pOperator, downstream);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _error;
+  }
+
   return pOperator;
 
 _error:
@@ -51,6 +51,10 @@ struct SSortHandle {
   BoundedQueue*    pBoundedQueue;
   uint32_t         tmpRowIdx;
 
+  int32_t             pqBoundSlotId;
+  _sort_pq_bound_fn_t pqBoundFp;
+  void*               pqBoundParam;
+
   int64_t          mergeLimit;
   int64_t          currMergeLimitTs;          
 
@@ -1363,6 +1367,12 @@ void tsortSetForceUsePQSort(SSortHandle* pHandle) {
   pHandle->forceUsePQSort = true;
 }
 
+void tsortSetPQBoundFn(SSortHandle* pHandle, int32_t slotId, _sort_pq_bound_fn_t fp, void* param) {
+  pHandle->pqBoundSlotId = slotId;
+  pHandle->pqBoundFp = fp;
+  pHandle->pqBoundParam = param;
+}
+
 static bool tsortIsPQSortApplicable(SSortHandle* pHandle) {
   if (pHandle->type != SORT_SINGLESOURCE_SORT) return false;
   if (tsortIsForceUsePQSort(pHandle)) return true;
@@ -1459,6 +1469,12 @@ static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
         if (pPushedNode->data == NULL) return TSDB_CODE_OUT_OF_MEMORY;
       }
     }
+
+    // the top of a full queue is the last row kept, rows behind it will never be kept anymore
+    if (pHandle->pqBoundFp != NULL && taosBQSize(pHandle->pBoundedQueue) == taosBQMaxSize(pHandle->pBoundedQueue) + 1) {
+      PriorityQueueNode* pTop = taosBQTop(pHandle->pBoundedQueue);
+      pHandle->pqBoundFp(tupleDescGetField(pTop->data, pHandle->pqBoundSlotId, colNum), pHandle->pqBoundParam);
+    }
   }
   return TSDB_CODE_SUCCESS;
 }
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include "builtinsimpl.h"
+#include "functionMgt.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+// the intermediate result of min/max is kept in the buffer of the result row entry
+struct SMinMaxCtx {
+  char           buf[sizeof(SResultRowEntryInfo) + sizeof(SMinmaxResInfo)];
+  SqlFunctionCtx ctx;
+
+  SMinMaxCtx() {
+    memset(buf, 0, sizeof(buf));
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.resultInfo = (SResultRowEntryInfo*)buf;
+  }
+
+  SMinmaxResInfo* res() { return (SMinmaxResInfo*)GET_ROWCELL_INTERBUF(ctx.resultInfo); }
+
+  // the bytes of the value beyond the width of the type are left dirty on purpose, they must not be compared
+  template <typename T>
+  void set(int16_t type, T val) {
+    SMinmaxResInfo* pRes = res();
+    pRes->v = (int64_t)0x5A5A5A5A5A5A5A5AULL;
+    memcpy(&pRes->v, &val, sizeof(T));
+    pRes->type = type;
+    pRes->assign = true;
+    ctx.resultInfo->numOfRes = 1;
+  }
+
+  template <typename T>
+  T get() {
+    T val;
+    memcpy(&val, &res()->v, sizeof(T));
+    return val;
+  }
+};
+
+template <typename T>
+void checkMinMaxCombine(int16_t type, T small, T large) {
+  // combine the larger value into the smaller one, and vice versa
+  for (int32_t i = 0; i < 2; ++i) {
+    T dst = (i == 0) ? small : large;
+    T src = (i == 0) ? large : small;
+
+    SMinMaxCtx d, s;
+    d.set(type, dst);
+    s.set(type, src);
+    ASSERT_EQ(minCombine(&d.ctx, &s.ctx), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(d.get<T>(), small) << "min of type " << type << ", case " << i;
+    EXPECT_EQ(d.res()->type, type);
+
+    d.set(type, dst);
+    ASSERT_EQ(maxCombine(&d.ctx, &s.ctx), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(d.get<T>(), large) << "max of type " << type << ", case " << i;
+  }
+}
+}  // namespace
+
+TEST(aggCombineTest, minMaxCombine_signed) {
+  checkMinMaxCombine<int8_t>(TSDB_DATA_TYPE_TINYINT, -100, 3);
+  checkMinMaxCombine<int8_t>(TSDB_DATA_TYPE_BOOL, 0, 1);
+  checkMinMaxCombine<int16_t>(TSDB_DATA_TYPE_SMALLINT, -30000, 2);
+  checkMinMaxCombine<int32_t>(TSDB_DATA_TYPE_INT, -2000000000, 5);
+  checkMinMaxCombine<int64_t>(TSDB_DATA_TYPE_BIGINT, INT64_MIN, INT64_MAX);
+  checkMinMaxCombine<int64_t>(TSDB_DATA_TYPE_TIMESTAMP, 1700000000000, 1700000000001);
+  checkMinMaxCombine<int64_t>(TSDB_DATA_TYPE_TIMESTAMP, -1, 256);
+}
+
+TEST(aggCombineTest, minMaxCombine_unsigned) {
+  // the values with the highest bit set are negative if they are compared as signed integers
+  checkMinMaxCombine<uint8_t>(TSDB_DATA_TYPE_UTINYINT, 100, 200);
+  checkMinMaxCombine<uint16_t>(TSDB_DATA_TYPE_USMALLINT, 1, 40000);
+  checkMinMaxCombine<uint32_t>(TSDB_DATA_TYPE_UINT, 1, 3000000000U);
+  checkMinMaxCombine<uint64_t>(TSDB_DATA_TYPE_UBIGINT, 1, 0x8000000000000001ULL);
+}
+
+TEST(aggCombineTest, minMaxCombine_float) {
+  // the bits of negative floating point values are in reverse order if they are compared as integers
+  checkMinMaxCombine<float>(TSDB_DATA_TYPE_FLOAT, -2.5f, -1.5f);
+  checkMinMaxCombine<float>(TSDB_DATA_TYPE_FLOAT, -1.5f, 2.5f);
+  checkMinMaxCombine<float>(TSDB_DATA_TYPE_FLOAT, 0.25f, 1e30f);
+  checkMinMaxCombine<double>(TSDB_DATA_TYPE_DOUBLE, -2.0, -1.0);
+  checkMinMaxCombine<double>(TSDB_DATA_TYPE_DOUBLE, -1e300, 1e-300);
+}
+
+TEST(aggCombineTest, minMaxCombine_unassigned) {
+  // no value in the source, the destination is kept
+  SMinMaxCtx d, s;
+  d.set<uint8_t>(TSDB_DATA_TYPE_UTINYINT, 200);
+  s.res()->type = TSDB_DATA_TYPE_UTINYINT;
+  ASSERT_EQ(maxCombine(&d.ctx, &s.ctx), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(d.get<uint8_t>(), 200);
+  EXPECT_TRUE(d.res()->assign);
+
+  // no value in the destination, the source is taken together with its type
+  SMinMaxCtx d1, s1;
+  d1.res()->type = TSDB_DATA_TYPE_NULL;
+  s1.set<float>(TSDB_DATA_TYPE_FLOAT, -3.5f);
+  ASSERT_EQ(minCombine(&d1.ctx, &s1.ctx), TSDB_CODE_SUCCESS);
+  EXPECT_TRUE(d1.res()->assign);
+  EXPECT_EQ(d1.res()->type, TSDB_DATA_TYPE_FLOAT);
+  EXPECT_EQ(d1.get<float>(), -3.5f);
+  EXPECT_EQ(d1.ctx.resultInfo->numOfRes, 1);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "executorInt.h"
+#include "operator.h"
+#include "plannodes.h"
+#include "querytask.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+#include "tref.h"
+
+namespace {
+// the fetch rsp of all sources are returned by the local fetch of the test, each rsp has one block of
+// (source index, seq of the rsp of the source, row index)
+const int32_t rowsPerRsp = 10;
+
+struct SExchangeTestSource {
+  int32_t numOfRsp = 0;       // the rsp with rows of the source
+  bool    emptyLast = false;  // the source is completed by an empty rsp, or by the last rsp with rows
+  int32_t fetched = 0;        // the fetch requests received
+};
+
+struct SExchangeTestFetch {
+  std::vector<SExchangeTestSource> sources;
+  std::vector<int32_t>             arrivals;  // the source index of the rsp with rows, in the order of arrival
+  SExchangeInfo*                   pExchangeInfo = NULL;
+  size_t                           maxDeferred = 0;
+  int32_t                          fetchOverLimit = 0;  // the fetch sent while the pending rsp exceed the limit
+};
+
+void* createFetchRsp(int32_t index, int32_t seq, bool completed) {
+  if (seq < 0) {
+    SRetrieveTableRsp* pRsp = (SRetrieveTableRsp*)taosMemoryCalloc(1, sizeof(SRetrieveTableRsp));
+    pRsp->completed = 1;
+    return pRsp;
+  }
+
+  SSDataBlock* pBlock = createDataBlock();
+  for (int16_t i = 0; i < 3; ++i) {
+    SColumnInfoData col = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), i + 1);
+    blockDataAppendColInfo(pBlock, &col);
+  }
+  blockDataEnsureCapacity(pBlock, rowsPerRsp);
+  for (int32_t i = 0; i < rowsPerRsp; ++i) {
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0), i, (const char*)&index, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1), i, (const char*)&seq, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2), i, (const char*)&i, false);
+  }
+  pBlock->info.rows = rowsPerRsp;
+
+  int32_t            len = blockGetEncodeSize(pBlock);
+  SRetrieveTableRsp* pRsp = (SRetrieveTableRsp*)taosMemoryCalloc(1, sizeof(SRetrieveTableRsp) + len);
+  len = blockEncode(pBlock, pRsp->data, taosArrayGetSize(pBlock->pDataBlock));
+  blockDataDestroy(pBlock);
+
+  // the same byte order as the rsp built by the query worker
+  pRsp->completed = completed;
+  pRsp->compLen = htonl(len);
+  pRsp->numOfRows = htobe64(rowsPerRsp);
+  pRsp->numOfCols = htonl(3);
+  pRsp->numOfBlocks = htonl(1);
+  return pRsp;
+}
+
+// the task id of the source is its index, the rsp arrives at once
+int32_t localFetch(void* handle, uint64_t sId, uint64_t qId, uint64_t tId, int64_t rId, int32_t eId, void** pRsp,
+                   SArray* explainRes) {
+  SExchangeTestFetch*  pFetch = static_cast<SExchangeTestFetch*>(handle);
+  SExchangeTestSource* pSource = &pFetch->sources[tId];
+  SExchangeInfo*       pExchangeInfo = pFetch->pExchangeInfo;
+
+  // all sources are fetched once when the operator is opened, the later fetch is held back by the pending rsp
+  if (pSource->fetched > 0 && pExchangeInfo->pendingRspBytes > pExchangeInfo->maxPendingRspBytes) {
+    pFetch->fetchOverLimit += 1;
+  }
+  pFetch->maxDeferred = std::max(pFetch->maxDeferred, taosArrayGetSize(pExchangeInfo->pDeferredSources));
+
+  int32_t seq = pSource->fetched++;
+  if (seq >= pSource->numOfRsp) {
+    *pRsp = createFetchRsp((int32_t)tId, -1, true);
+  } else {
+    *pRsp = createFetchRsp((int32_t)tId, seq, !pSource->emptyLast && seq == pSource->numOfRsp - 1);
+    pFetch->arrivals.push_back((int32_t)tId);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+SNode* createSlotDescNode(int16_t slotId) {
+  SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+  pSlot->slotId = slotId;
+  pSlot->dataType.type = TSDB_DATA_TYPE_INT;
+  pSlot->dataType.bytes = sizeof(int32_t);
+  pSlot->output = true;
+  return (SNode*)pSlot;
+}
+
+SExchangePhysiNode* createExchangeNode(int32_t numOfSources) {
+  SExchangePhysiNode* pExNode = (SExchangePhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_EXCHANGE);
+  for (int32_t i = 0; i < numOfSources; ++i) {
+    SDownstreamSourceNode* pSource = (SDownstreamSourceNode*)nodesMakeNode(QUERY_NODE_DOWNSTREAM_SOURCE);
+    pSource->addr.nodeId = i + 2;
+    pSource->taskId = i;
+    pSource->localExec = true;
+    nodesListMakeAppend(&pExNode->pSrcEndPoints, (SNode*)pSource);
+  }
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  for (int16_t i = 0; i < 3; ++i) {
+    nodesListMakeAppend(&pDesc->pSlots, createSlotDescNode(i));
+  }
+  pExNode->node.pOutputDataBlockDesc = pDesc;
+  return pExNode;
+}
+
+// the error code is returned if the operator jumps out
+SSDataBlock* getNextResult(SOperatorInfo* pOperator, int32_t* pCode) {
+  int32_t code = setjmp(pOperator->pTaskInfo->env);
+  if (code != TSDB_CODE_SUCCESS) {
+    *pCode = code;
+    return NULL;
+  }
+
+  *pCode = TSDB_CODE_SUCCESS;
+  return pOperator->fpSet.getNextFn(pOperator);
+}
+}  // namespace
+
+class ExchangeOperatorTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    if (exchangeObjRefPool < 0) {
+      exchangeObjRefPool = taosOpenRef(1024, doDestroyExchangeOperatorInfo);
+    }
+  }
+
+  void TearDown() override {
+    destroyOperator(pOperator);
+    nodesDestroyNode((SNode*)pExNode);
+    if (pTaskInfo != NULL) {
+      taosArrayDestroy(pTaskInfo->stopInfo.pStopInfo);
+      taosMemoryFree(pTaskInfo->id.str);
+      taosMemoryFree(pTaskInfo);
+    }
+    pOperator = NULL;
+    pExNode = NULL;
+    pTaskInfo = NULL;
+  }
+
+  // the source i has i % 5 rsp with rows, the odd ones are completed by an extra empty rsp
+  SExchangeInfo* createOperator(int32_t numOfSources) {
+    for (int32_t i = 0; i < numOfSources; ++i) {
+      SExchangeTestSource source;
+      source.numOfRsp = i % 5;
+      source.emptyLast = (i % 2 == 1) || source.numOfRsp == 0;
+      fetch.sources.push_back(source);
+    }
+
+    pTaskInfo = (SExecTaskInfo*)taosMemoryCalloc(1, sizeof(SExecTaskInfo));
+    pTaskInfo->id.str = taosStrdup("exchangeOperatorTest");
+    pTaskInfo->stopInfo.pStopInfo = taosArrayInit(1, sizeof(SExchangeOpStopInfo));
+    pTaskInfo->localFetch.handle = &fetch;
+    pTaskInfo->localFetch.localExec = true;
+    pTaskInfo->localFetch.fp = localFetch;
+
+    pExNode = createExchangeNode(numOfSources);
+    pOperator = createExchangeOperatorInfo(NULL, pExNode, pTaskInfo);
+    EXPECT_NE(pOperator, nullptr) << tstrerror(pTaskInfo->code);
+    if (pOperator == NULL) {
+      return NULL;
+    }
+
+    fetch.pExchangeInfo = (SExchangeInfo*)pOperator->info;
+    return fetch.pExchangeInfo;
+  }
+
+  // the source index of the result blocks in the returned order
+  void collectResults(std::vector<int32_t>* pSources) {
+    std::vector<int32_t> nextSeq(fetch.sources.size(), 0);
+    while (1) {
+      int32_t      code = 0;
+      SSDataBlock* pRes = getNextResult(pOperator, &code);
+      ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+      if (pRes == NULL) {
+        break;
+      }
+
+      ASSERT_EQ(pRes->info.rows, rowsPerRsp);
+      int32_t index = *(int32_t*)colDataGetData((SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 0), 0);
+      int32_t seq = *(int32_t*)colDataGetData((SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 1), 0);
+      ASSERT_LT(index, (int32_t)fetch.sources.size());
+
+      // the rsp of a source are returned in the order of the fetch
+      EXPECT_EQ(seq, nextSeq[index]) << "source " << index;
+      nextSeq[index] = seq + 1;
+      for (int32_t i = 0; i < pRes->info.rows; ++i) {
+        EXPECT_EQ(*(int32_t*)colDataGetData((SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 2), i), i);
+      }
+      pSources->push_back(index);
+    }
+  }
+
+  void checkCompleted(const std::vector<int32_t>& sources) {
+    // all rsp of all sources are returned in the order of arrival
+    EXPECT_EQ(sources, fetch.arrivals);
+    int32_t total = 0;
+    for (int32_t i = 0; i < fetch.sources.size(); ++i) {
+      const SExchangeTestSource& source = fetch.sources[i];
+      total += source.numOfRsp;
+      EXPECT_EQ(source.fetched, source.numOfRsp + (source.emptyLast ? 1 : 0)) << "source " << i;
+    }
+    EXPECT_EQ(sources.size(), total);
+
+    SExchangeInfo* pExchangeInfo = fetch.pExchangeInfo;
+    EXPECT_EQ(pExchangeInfo->pendingRspBytes, 0);
+    EXPECT_EQ(taosArrayGetSize(pExchangeInfo->pDeferredSources), 0);
+  }
+
+  SExecTaskInfo*      pTaskInfo = NULL;
+  SExchangePhysiNode* pExNode = NULL;
+  SOperatorInfo*      pOperator = NULL;
+  SExchangeTestFetch  fetch;
+};
+
+TEST_F(ExchangeOperatorTest, noDeferredFetch) {
+  SExchangeInfo* pExchangeInfo = createOperator(100);
+  ASSERT_NE(pExchangeInfo, nullptr);
+  EXPECT_EQ(pExchangeInfo->maxPendingRspBytes, tsExchangeMaxPendingRspSize * 1048576L);
+
+  std::vector<int32_t> sources;
+  collectResults(&sources);
+  checkCompleted(sources);
+  EXPECT_EQ(fetch.maxDeferred, 0);
+
+  // the first rsp of all sources arrive before any of them is consumed
+  std::vector<int32_t> firstRound;
+  for (int32_t i = 0; i < fetch.sources.size(); ++i) {
+    if (fetch.sources[i].numOfRsp > 0) {
+      firstRound.push_back(i);
+    }
+  }
+  ASSERT_GE(sources.size(), firstRound.size());
+  EXPECT_EQ(std::vector<int32_t>(sources.begin(), sources.begin() + firstRound.size()), firstRound);
+}
+
+TEST_F(ExchangeOperatorTest, deferredFetch) {
+  SExchangeInfo* pExchangeInfo = createOperator(100);
+  ASSERT_NE(pExchangeInfo, nullptr);
+
+  // a few rsp are allowed to be pending
+  SRetrieveTableRsp* pRsp = (SRetrieveTableRsp*)createFetchRsp(0, 0, false);
+  pExchangeInfo->maxPendingRspBytes = (sizeof(SRetrieveTableRsp) + htonl(pRsp->compLen)) * 3;
+  taosMemoryFree(pRsp);
+
+  std::vector<int32_t> sources;
+  collectResults(&sources);
+  checkCompleted(sources);
+
+  // no fetch is sent while the pending rsp exceed the limit, and the held back ones are sent later
+  EXPECT_EQ(fetch.fetchOverLimit, 0);
+  EXPECT_GT(fetch.maxDeferred, 0);
+}
+
+TEST_F(ExchangeOperatorTest, singlePendingRsp) {
+  SExchangeInfo* pExchangeInfo = createOperator(16);
+  ASSERT_NE(pExchangeInfo, nullptr);
+
+  // no more fetch is sent until all rsp are consumed
+  pExchangeInfo->maxPendingRspBytes = 0;
+
+  std::vector<int32_t> sources;
+  collectResults(&sources);
+  checkCompleted(sources);
+  EXPECT_EQ(fetch.fetchOverLimit, 0);
+  EXPECT_GT(fetch.maxDeferred, 0);
+}
+
+#pragma GCC diagnostic pop
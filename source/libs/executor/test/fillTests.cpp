@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#define ALLOW_FORBID_FUNC
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "executorInt.h"
+#include "stub.h"
+#include "tdatablock.h"
+#include "tfill.h"
+
+namespace {
+const int32_t numOfCols = 4;
+const int32_t outputCapacity = 4096;
+const int32_t colTypes[numOfCols] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_VARCHAR,
+                                     TSDB_DATA_TYPE_DOUBLE};
+const int32_t colBytes[numOfCols] = {8, 4, 12, 8};
+
+// the input rows, the gaps between them are of different lengths, and some of them are longer than the output capacity
+const int32_t numOfInputRows = 6;
+const int64_t ascTs[numOfInputRows] = {0, 200, 210, 220, 500, 560};
+const int64_t descTs[numOfInputRows] = {1000, 700, 690, 680, 300, 250};
+
+SSDataBlock* createFillBlock(int32_t rows) {
+  SSDataBlock* pBlock = createDataBlock();
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData colInfo = createColumnInfoData(colTypes[i], colBytes[i], i + 1);
+    blockDataAppendColInfo(pBlock, &colInfo);
+  }
+  blockDataEnsureCapacity(pBlock, rows);
+  return pBlock;
+}
+
+// the expressions are owned by the test, the fill info only frees the fill values of the columns
+struct SFillTestCols {
+  SExprInfo   exprs[numOfCols];
+  tExprNode   nodes[numOfCols];
+  SFunctParam params[numOfCols];
+  SColumn     cols[numOfCols];
+};
+
+SFillColInfo* createFillTestCols(SFillTestCols* pTestCols) {
+  memset(pTestCols, 0, sizeof(SFillTestCols));
+  SFillColInfo* pCols = (SFillColInfo*)taosMemoryCalloc(numOfCols, sizeof(SFillColInfo));
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SExprInfo* pExpr = &pTestCols->exprs[i];
+    pExpr->base.resSchema.slotId = i;
+    pExpr->base.resSchema.type = colTypes[i];
+    pExpr->base.resSchema.bytes = colBytes[i];
+    pExpr->pExpr = &pTestCols->nodes[i];
+    pExpr->pExpr->nodeType = QUERY_NODE_COLUMN;
+    pExpr->base.numOfParams = 1;
+    pExpr->base.pParam = &pTestCols->params[i];
+    pExpr->base.pParam[0].pCol = &pTestCols->cols[i];
+    pExpr->base.pParam[0].pCol->colType = COLUMN_TYPE_COLUMN;
+
+    pCols[i].pExpr = pExpr;
+    pCols[i].notFillCol = (i == 0);
+    pCols[i].fillVal.nType = TSDB_DATA_TYPE_BIGINT;
+    pCols[i].fillVal.i = 7;
+  }
+
+  pCols[2].fillVal.nType = TSDB_DATA_TYPE_VARCHAR;
+  pCols[2].fillVal.pz = (char*)taosMemoryCalloc(1, colBytes[2]);
+  varDataSetLen(pCols[2].fillVal.pz, 3);
+  memcpy(varDataVal(pCols[2].fillVal.pz), "abc", 3);
+  return pCols;
+}
+
+SSDataBlock* createInputBlock(int32_t order) {
+  SSDataBlock* pBlock = createFillBlock(numOfInputRows);
+  const int64_t* ts = (order == TSDB_ORDER_ASC) ? ascTs : descTs;
+  for (int32_t i = 0; i < numOfInputRows; ++i) {
+    int32_t v = i * 13 - 20;
+    double  d = i * 2.5 - 3;
+    char    str[12] = {0};
+    varDataSetLen(str, 2);
+    varDataVal(str)[0] = 'a' + i;
+    varDataVal(str)[1] = 'z';
+
+    // the int and varchar columns have null values at different rows
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0), i, (const char*)&ts[i], false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1), i, (const char*)&v, i == 2);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2), i, str, i == 1 || i == 4);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 3), i, (const char*)&d, false);
+  }
+  pBlock->info.rows = numOfInputRows;
+  return pBlock;
+}
+
+// the buffer that can not be enlarged, taosMemoryRealloc() is realloc() if USE_TD_MEMORY is not set
+void* pBlockedBuf = NULL;
+
+void* fillTestRealloc(void* ptr, int64_t size) {
+  if (ptr != NULL && ptr == pBlockedBuf) {
+    return NULL;
+  }
+  return realloc(ptr, size);
+}
+
+// fill the range with an interval of 10ms, and collect the results of all the calls into one block. The gaps are
+// filled by doFillOneRow() row by row if the buffer of the gap timestamps fails to be enlarged.
+SSDataBlock* doFillTest(int32_t fillType, int32_t order, int32_t capacity, bool fillByRow) {
+  SInterval interval = {0};
+  interval.interval = 10;
+  interval.sliding = 10;
+  interval.intervalUnit = 'a';
+  interval.slidingUnit = 'a';
+  interval.precision = TSDB_TIME_PRECISION_MILLI;
+
+  SFillTestCols testCols;
+  SFillColInfo* pCols = createFillTestCols(&testCols);
+  int64_t       skey = (order == TSDB_ORDER_ASC) ? 0 : 1000;
+  SFillInfo*    pFillInfo =
+      taosCreateFillInfo(skey, numOfCols - 1, 1, capacity, &interval, fillType, pCols, 0, order, "fillTest");
+  Stub stub;
+  if (fillByRow) {
+    pFillInfo->pGapKeys = (TSKEY*)taosMemoryMalloc(sizeof(TSKEY));
+    pFillInfo->gapKeysCap = 0;
+    pBlockedBuf = pFillInfo->pGapKeys;
+    stub.set(taosMemoryRealloc, fillTestRealloc);
+  }
+
+  SSDataBlock* pInput = createInputBlock(order);
+  SSDataBlock* pOutput = createFillBlock(outputCapacity);
+  taosFillSetInputDataBlock(pFillInfo, pInput);
+  taosFillSetStartInfo(pFillInfo, numOfInputRows, (order == TSDB_ORDER_ASC) ? 900 : 100);
+
+  while (taosFillHasMoreResults(pFillInfo)) {
+    int32_t rows = pOutput->info.rows;
+    int64_t numOfRes = taosFillResultDataBlock(pFillInfo, pOutput, capacity);
+    EXPECT_GT(numOfRes, 0);
+    EXPECT_LE(numOfRes, capacity);
+    EXPECT_EQ(pOutput->info.rows, rows + numOfRes);
+    if (numOfRes <= 0) {
+      break;
+    }
+  }
+
+  // the buffer of the gap timestamps is never enlarged if the gaps are filled row by row
+  EXPECT_EQ(pFillInfo->gapKeysCap == 0, fillByRow);
+
+  taosDestroyFillInfo(pFillInfo);
+  blockDataDestroy(pInput);
+  pBlockedBuf = NULL;
+  return pOutput;
+}
+
+void checkSameBlock(const SSDataBlock* pExpected, const SSDataBlock* pBlock, const char* msg) {
+  ASSERT_EQ(pBlock->info.rows, pExpected->info.rows) << msg;
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pExpectedCol = (SColumnInfoData*)taosArrayGet(pExpected->pDataBlock, i);
+    SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, i);
+    for (int32_t row = 0; row < pExpected->info.rows; ++row) {
+      bool isNull = colDataIsNull_s(pExpectedCol, row);
+      ASSERT_EQ(colDataIsNull_s(pCol, row), isNull) << msg << ", column " << i << ", row " << row;
+      if (isNull) {
+        continue;
+      }
+
+      char*   pExpectedData = colDataGetData(pExpectedCol, row);
+      char*   pData = colDataGetData(pCol, row);
+      int32_t len = IS_VAR_DATA_TYPE(pExpectedCol->info.type) ? varDataTLen(pExpectedData) : pExpectedCol->info.bytes;
+      ASSERT_EQ(memcmp(pData, pExpectedData, len), 0) << msg << ", column " << i << ", row " << row;
+    }
+  }
+}
+}  // namespace
+
+// the gaps filled at once are the same as the ones filled by doFillOneRow() row by row
+TEST(fillTest, fillGapRowsSameAsRowByRow) {
+  int32_t fillTypes[] = {TSDB_FILL_NULL, TSDB_FILL_NULL_F, TSDB_FILL_PREV, TSDB_FILL_NEXT, TSDB_FILL_LINEAR,
+                         TSDB_FILL_SET_VALUE, TSDB_FILL_SET_VALUE_F};
+  int32_t orders[] = {TSDB_ORDER_ASC, TSDB_ORDER_DESC};
+  // the gaps are split by the output capacity at different rows
+  int32_t capacities[] = {1, 7, 37, outputCapacity};
+
+  for (int32_t type : fillTypes) {
+    for (int32_t order : orders) {
+      for (int32_t capacity : capacities) {
+        char msg[128] = {0};
+        snprintf(msg, sizeof(msg), "fill type %d, order %d, capacity %d", type, order, capacity);
+
+        SSDataBlock* pExpected = doFillTest(type, order, capacity, true);
+        SSDataBlock* pBlock = doFillTest(type, order, capacity, false);
+        // the range from the start key to the end key is covered by the filled and input rows
+        EXPECT_EQ(pExpected->info.rows, 91) << msg;
+        checkSameBlock(pExpected, pBlock, msg);
+        blockDataDestroy(pExpected);
+        blockDataDestroy(pBlock);
+      }
+    }
+  }
+}
+
+#pragma GCC diagnostic pop
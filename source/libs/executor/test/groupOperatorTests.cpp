@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "executorInt.h"
+#include "functionMgt.h"
+#include "operator.h"
+#include "plannodes.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+// the input block is (ts, key, v), the output block is (count(v), key) grouped by key
+const int16_t inputBlockId = 0;
+const int16_t outputBlockId = 1;
+
+typedef std::pair<uint64_t, int64_t> SGroupTestKey;  // groupId of the input block, the group key
+
+struct SGroupTestRow {
+  uint64_t groupId;  // groupId of the output block
+  int64_t  key;
+  int64_t  count;
+};
+
+// the input blocks are handed out by the downstream operator one by one, and destroyed with it
+struct SGroupTestInput {
+  std::vector<SSDataBlock*> blocks;
+  size_t                    next = 0;
+};
+
+SSDataBlock* getNextInputBlock(SOperatorInfo* pOperator) {
+  SGroupTestInput* pInput = static_cast<SGroupTestInput*>(pOperator->info);
+  return (pInput->next < pInput->blocks.size()) ? pInput->blocks[pInput->next++] : NULL;
+}
+
+void destroyInput(void* param) {
+  SGroupTestInput* pInput = static_cast<SGroupTestInput*>(param);
+  for (SSDataBlock* pBlock : pInput->blocks) {
+    blockDataDestroy(pBlock);
+  }
+  delete pInput;
+}
+
+// the consecutive rows of the same key are aggregated as one run, v is null at every 7th row
+SSDataBlock* createInputBlock(uint64_t groupId, const std::vector<int64_t>& keys) {
+  SSDataBlock*    pBlock = createDataBlock();
+  SColumnInfoData ts = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), 1);
+  SColumnInfoData key = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 2);
+  SColumnInfoData v = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 3);
+  blockDataAppendColInfo(pBlock, &ts);
+  blockDataAppendColInfo(pBlock, &key);
+  blockDataAppendColInfo(pBlock, &v);
+  blockDataEnsureCapacity(pBlock, keys.size());
+
+  for (int32_t i = 0; i < keys.size(); ++i) {
+    int64_t t = 1700000000000 + i;
+    int32_t val = i;
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0), i, (const char*)&t, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1), i, (const char*)&keys[i], false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2), i, (const char*)&val, i % 7 == 0);
+  }
+  pBlock->info.rows = keys.size();
+  pBlock->info.id.groupId = groupId;
+  return pBlock;
+}
+
+SOperatorInfo* createInputOperator(SGroupTestInput* pInput) {
+  SOperatorInfo* pOperator = (SOperatorInfo*)taosMemoryCalloc(1, sizeof(SOperatorInfo));
+  pOperator->name = "groupTestInputOperator";
+  pOperator->info = pInput;
+  pOperator->fpSet.getNextFn = getNextInputBlock;
+  pOperator->fpSet.closeFn = destroyInput;
+  return pOperator;
+}
+
+// count(v) of each key under each groupId of the input blocks
+std::map<SGroupTestKey, int64_t> countGroups(const SGroupTestInput* pInput) {
+  std::map<SGroupTestKey, int64_t> res;
+  for (SSDataBlock* pBlock : pInput->blocks) {
+    SColumnInfoData* pKeyCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    SColumnInfoData* pValCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2);
+    for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+      int64_t key = *(int64_t*)colDataGetData(pKeyCol, i);
+      res[SGroupTestKey(pBlock->info.id.groupId, key)] += colDataIsNull_s(pValCol, i) ? 0 : 1;
+    }
+  }
+  return res;
+}
+
+SNode* createColumnNode(int16_t slotId, uint8_t type, int32_t bytes) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = bytes;
+  pCol->dataBlockId = inputBlockId;
+  pCol->slotId = slotId;
+  pCol->colId = slotId + 1;
+  pCol->colType = COLUMN_TYPE_COLUMN;
+  snprintf(pCol->colName, sizeof(pCol->colName), "c%d", slotId);
+  return (SNode*)pCol;
+}
+
+SNode* createTargetNode(int16_t slotId, SNode* pExpr) {
+  STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+  pTarget->dataBlockId = outputBlockId;
+  pTarget->slotId = slotId;
+  pTarget->pExpr = pExpr;
+  return (SNode*)pTarget;
+}
+
+SNode* createSlotDescNode(int16_t slotId, uint8_t type, int32_t bytes) {
+  SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+  pSlot->slotId = slotId;
+  pSlot->dataType.type = type;
+  pSlot->dataType.bytes = bytes;
+  pSlot->output = true;
+  return (SNode*)pSlot;
+}
+
+// select count(v), key from t group by key
+SAggPhysiNode* createGroupAggNode(bool mergeDataBlock) {
+  SFunctionNode* pFunc = (SFunctionNode*)nodesMakeNode(QUERY_NODE_FUNCTION);
+  tstrncpy(pFunc->functionName, "count", sizeof(pFunc->functionName));
+  nodesListMakeAppend(&pFunc->pParameterList, createColumnNode(2, TSDB_DATA_TYPE_INT, sizeof(int32_t)));
+  char msg[128] = {0};
+  EXPECT_EQ(fmGetFuncInfo(pFunc, msg, sizeof(msg)), TSDB_CODE_SUCCESS) << msg;
+
+  SAggPhysiNode* pAggNode = (SAggPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_AGG);
+  nodesListMakeAppend(&pAggNode->pAggFuncs, createTargetNode(0, (SNode*)pFunc));
+  nodesListMakeAppend(&pAggNode->pGroupKeys,
+                      createTargetNode(1, createColumnNode(1, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t))));
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = outputBlockId;
+  nodesListMakeAppend(&pDesc->pSlots, createSlotDescNode(0, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t)));
+  nodesListMakeAppend(&pDesc->pSlots, createSlotDescNode(1, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t)));
+  pAggNode->node.pOutputDataBlockDesc = pDesc;
+  pAggNode->mergeDataBlock = mergeDataBlock;
+  return pAggNode;
+}
+
+// the error code is returned if the operator jumps out
+SSDataBlock* getNextResult(SOperatorInfo* pOperator, int32_t* pCode) {
+  int32_t code = setjmp(pOperator->pTaskInfo->env);
+  if (code != TSDB_CODE_SUCCESS) {
+    *pCode = code;
+    return NULL;
+  }
+
+  *pCode = TSDB_CODE_SUCCESS;
+  return pOperator->fpSet.getNextFn(pOperator);
+}
+
+void appendResultRows(const SSDataBlock* pRes, std::vector<SGroupTestRow>* pRows) {
+  SColumnInfoData* pCountCol = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 0);
+  SColumnInfoData* pKeyCol = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 1);
+  for (int32_t i = 0; i < pRes->info.rows; ++i) {
+    SGroupTestRow row = {pRes->info.id.groupId, *(int64_t*)colDataGetData(pKeyCol, i),
+                         *(int64_t*)colDataGetData(pCountCol, i)};
+    pRows->push_back(row);
+  }
+}
+
+// the runs of two rows of the same key, the keys of the later blocks are the same as the ones of the former blocks
+std::vector<int64_t> createRunKeys(int32_t start, int32_t numOfRows, int32_t numOfKeys) {
+  std::vector<int64_t> keys;
+  for (int32_t i = start; i < start + numOfRows; ++i) {
+    keys.push_back((i / 2) * 7 % numOfKeys);
+  }
+  return keys;
+}
+}  // namespace
+
+class GroupOperatorTest : public ::testing::Test {
+ protected:
+  // the result rows are kept in the disk based buffer under the temp dir
+  static void SetUpTestSuite() {
+    strcpy(tsTempDir, TD_TMP_DIR_PATH);
+    osUpdate();
+  }
+
+  void TearDown() override {
+    destroyOperator(pOperator);
+    nodesDestroyNode((SNode*)pAggNode);
+    if (pTaskInfo != NULL) {
+      taosMemoryFree(pTaskInfo->id.str);
+      taosMemoryFree(pTaskInfo);
+    }
+    pOperator = NULL;
+    pAggNode = NULL;
+    pTaskInfo = NULL;
+  }
+
+  SGroupbyOperatorInfo* createOperator(SGroupTestInput* pInput, bool mergeDataBlock, EOPTR_EXEC_MODEL model) {
+    expected = countGroups(pInput);
+    pTaskInfo = (SExecTaskInfo*)taosMemoryCalloc(1, sizeof(SExecTaskInfo));
+    pTaskInfo->id.str = taosStrdup("groupOperatorTest");
+    pTaskInfo->execModel = model;
+
+    pAggNode = createGroupAggNode(mergeDataBlock);
+    pOperator = createGroupOperatorInfo(createInputOperator(pInput), pAggNode, pTaskInfo);
+    EXPECT_NE(pOperator, nullptr) << tstrerror(pTaskInfo->code);
+    if (pOperator == NULL) {
+      return NULL;
+    }
+
+    // the result rows are only located by the group hash table
+    SGroupbyOperatorInfo* pInfo = (SGroupbyOperatorInfo*)pOperator->info;
+    EXPECT_EQ(pInfo->aggSup.pResultRowHashTable, nullptr);
+    return pInfo;
+  }
+
+  // all results are collected, the number of the result blocks is returned
+  int32_t collectResults(std::vector<SGroupTestRow>* pRows) {
+    int32_t numOfBlocks = 0;
+    while (1) {
+      int32_t      code = 0;
+      SSDataBlock* pRes = getNextResult(pOperator, &code);
+      EXPECT_EQ(code, TSDB_CODE_SUCCESS);
+      if (pRes == NULL) {
+        break;
+      }
+      appendResultRows(pRes, pRows);
+      numOfBlocks += 1;
+    }
+    return numOfBlocks;
+  }
+
+  // each group of the input blocks is returned once, with its own count
+  void checkResults(const std::vector<SGroupTestRow>& rows) {
+    std::vector<std::pair<int64_t, int64_t>> res;
+    for (const SGroupTestRow& row : rows) {
+      res.push_back(std::make_pair(row.key, row.count));
+    }
+
+    std::vector<std::pair<int64_t, int64_t>> exp;
+    for (const auto& it : expected) {
+      exp.push_back(std::make_pair(it.first.second, it.second));
+    }
+
+    std::sort(res.begin(), res.end());
+    std::sort(exp.begin(), exp.end());
+    EXPECT_EQ(res, exp);
+  }
+
+  SExecTaskInfo*                   pTaskInfo = NULL;
+  SAggPhysiNode*                   pAggNode = NULL;
+  SOperatorInfo*                   pOperator = NULL;
+  std::map<SGroupTestKey, int64_t> expected;
+};
+
+TEST_F(GroupOperatorTest, resizeAcrossBlocks) {
+  const int32_t numOfKeys = 1999;
+
+  SGroupTestInput* pInput = new SGroupTestInput;
+  for (int32_t i = 0; i < 5; ++i) {
+    pInput->blocks.push_back(createInputBlock(0, createRunKeys(i * 1000, 1000, numOfKeys)));
+  }
+  SGroupbyOperatorInfo* pInfo = createOperator(pInput, true, OPTR_EXEC_MODEL_BATCH);
+  ASSERT_NE(pInfo, nullptr);
+  ASSERT_EQ(expected.size(), numOfKeys);
+
+  // the results are returned in several blocks, and the slots of the table are kept until the last one
+  pOperator->resultInfo.threshold = 100;
+  std::vector<SGroupTestRow> rows;
+  int32_t                    code = 0;
+  SSDataBlock*               pRes = getNextResult(pOperator, &code);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  ASSERT_NE(pRes, nullptr);
+  EXPECT_EQ(pRes->info.rows, 100);
+  appendResultRows(pRes, &rows);
+
+  // the table grows from 1024 slots until the load factor is not above 0.75
+  EXPECT_EQ(pInfo->groupHash.size, numOfKeys);
+  EXPECT_EQ(pInfo->groupHash.capacity, 4096);
+
+  EXPECT_EQ(collectResults(&rows), (numOfKeys + 99) / 100 - 1);
+  checkResults(rows);
+}
+
+TEST_F(GroupOperatorTest, sameKeyUnderDifferentGroupIds) {
+  // the keys of the blocks of the two input groups are the same, the counts of them are different
+  SGroupTestInput* pInput = new SGroupTestInput;
+  for (int32_t i = 0; i < 4; ++i) {
+    pInput->blocks.push_back(createInputBlock(i % 2 + 1, createRunKeys(0, (i % 2 + 1) * 300, 50)));
+  }
+  ASSERT_NE(createOperator(pInput, false, OPTR_EXEC_MODEL_BATCH), nullptr);
+  ASSERT_EQ(expected.size(), 100);
+
+  std::vector<SGroupTestRow> rows;
+  collectResults(&rows);
+  checkResults(rows);
+
+  // the same key of different input groups is returned in different output groups
+  std::map<int64_t, std::set<uint64_t>> groupIds;
+  for (const SGroupTestRow& row : rows) {
+    EXPECT_NE(row.groupId, 0);
+    groupIds[row.key].insert(row.groupId);
+  }
+  ASSERT_EQ(groupIds.size(), 50);
+  for (const auto& it : groupIds) {
+    EXPECT_EQ(it.second.size(), 2) << "key " << it.first;
+  }
+}
+
+TEST_F(GroupOperatorTest, perGroupOutputResumesAtIter) {
+  const int32_t numOfKeys = 1999;
+
+  SGroupTestInput* pInput = new SGroupTestInput;
+  for (int32_t i = 0; i < 3; ++i) {
+    pInput->blocks.push_back(createInputBlock(0, createRunKeys(i * 1500, 1500, numOfKeys)));
+  }
+  ASSERT_NE(createOperator(pInput, false, OPTR_EXEC_MODEL_BATCH), nullptr);
+
+  // each result block stops at the next group, which is the first one of the next block
+  std::vector<SGroupTestRow> rows;
+  EXPECT_EQ(collectResults(&rows), numOfKeys);
+  checkResults(rows);
+
+  std::set<uint64_t> groupIds;
+  for (const SGroupTestRow& row : rows) {
+    EXPECT_TRUE(groupIds.insert(row.groupId).second) << "key " << row.key;
+  }
+}
+
+TEST_F(GroupOperatorTest, tooManyGroups) {
+  const int32_t maxGroups = 100;
+
+  // no more groups than the limit
+  SGroupTestInput* pInput = new SGroupTestInput;
+  pInput->blocks.push_back(createInputBlock(0, createRunKeys(0, maxGroups * 2, maxGroups)));
+  SGroupbyOperatorInfo* pInfo = createOperator(pInput, true, OPTR_EXEC_MODEL_BATCH);
+  ASSERT_NE(pInfo, nullptr);
+  pInfo->maxGroups = maxGroups;
+
+  std::vector<SGroupTestRow> rows;
+  collectResults(&rows);
+  checkResults(rows);
+  TearDown();
+
+  // one more group than the limit
+  pInput = new SGroupTestInput;
+  pInput->blocks.push_back(createInputBlock(0, createRunKeys(0, (maxGroups + 1) * 2, maxGroups + 1)));
+  pInfo = createOperator(pInput, true, OPTR_EXEC_MODEL_BATCH);
+  ASSERT_NE(pInfo, nullptr);
+  pInfo->maxGroups = maxGroups;
+
+  int32_t code = 0;
+  EXPECT_EQ(getNextResult(pOperator, &code), nullptr);
+  EXPECT_EQ(code, TSDB_CODE_QRY_TOO_MANY_TIMEWINDOW);
+  TearDown();
+
+  // the stream model is not limited
+  pInput = new SGroupTestInput;
+  pInput->blocks.push_back(createInputBlock(0, createRunKeys(0, (maxGroups + 1) * 2, maxGroups + 1)));
+  pInfo = createOperator(pInput, true, OPTR_EXEC_MODEL_STREAM);
+  ASSERT_NE(pInfo, nullptr);
+  pInfo->maxGroups = maxGroups;
+  ASSERT_EQ(expected.size(), maxGroups + 1);
+
+  rows.clear();
+  collectResults(&rows);
+  checkResults(rows);
+}
+
+#pragma GCC diagnostic pop
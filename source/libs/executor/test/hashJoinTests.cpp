@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "executorInt.h"
+#include "hashjoin.h"
+#include "operator.h"
+#include "plannodes.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+// the input blocks of both sides are (key, v), the output block is (left.key, left.v, right.v)
+const int16_t leftBlockId = 0;
+const int16_t rightBlockId = 1;
+const int16_t outputBlockId = 2;
+
+typedef std::tuple<int64_t, int32_t, int32_t> SJoinTestRow;
+
+// the input blocks are handed out by the downstream operator one by one, and destroyed with it
+struct SJoinTestInput {
+  std::vector<SSDataBlock*> blocks;
+  size_t                    next = 0;
+};
+
+SSDataBlock* getNextInputBlock(SOperatorInfo* pOperator) {
+  SJoinTestInput* pInput = static_cast<SJoinTestInput*>(pOperator->info);
+  return (pInput->next < pInput->blocks.size()) ? pInput->blocks[pInput->next++] : NULL;
+}
+
+void destroyInput(void* param) {
+  SJoinTestInput* pInput = static_cast<SJoinTestInput*>(param);
+  for (SSDataBlock* pBlock : pInput->blocks) {
+    blockDataDestroy(pBlock);
+  }
+  delete pInput;
+}
+
+// the key of the row i is i % numOfKeys, v is i + base
+SSDataBlock* createInputBlock(int32_t start, int32_t numOfRows, int32_t numOfKeys, int32_t base) {
+  SSDataBlock*    pBlock = createDataBlock();
+  SColumnInfoData key = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 1);
+  SColumnInfoData v = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 2);
+  blockDataAppendColInfo(pBlock, &key);
+  blockDataAppendColInfo(pBlock, &v);
+  blockDataEnsureCapacity(pBlock, numOfRows);
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int64_t k = (start + i) % numOfKeys;
+    int32_t val = start + i + base;
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0), i, (const char*)&k, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1), i, (const char*)&val, false);
+  }
+  pBlock->info.rows = numOfRows;
+  return pBlock;
+}
+
+SJoinTestInput* createInput(int32_t numOfBlocks, int32_t rowsOfBlock, int32_t numOfKeys, int32_t base) {
+  SJoinTestInput* pInput = new SJoinTestInput;
+  for (int32_t i = 0; i < numOfBlocks; ++i) {
+    pInput->blocks.push_back(createInputBlock(i * rowsOfBlock, rowsOfBlock, numOfKeys, base));
+  }
+  return pInput;
+}
+
+SOperatorInfo* createInputOperator(SJoinTestInput* pInput, int16_t blockId) {
+  SOperatorInfo* pOperator = (SOperatorInfo*)taosMemoryCalloc(1, sizeof(SOperatorInfo));
+  pOperator->name = "joinTestInputOperator";
+  pOperator->info = pInput;
+  pOperator->resultDataBlockId = blockId;
+  pOperator->fpSet.getNextFn = getNextInputBlock;
+  pOperator->fpSet.closeFn = destroyInput;
+  return pOperator;
+}
+
+// the nested loop join of the two inputs
+std::vector<SJoinTestRow> joinInputs(const SJoinTestInput* pLeft, const SJoinTestInput* pRight) {
+  std::vector<SJoinTestRow> res;
+  for (SSDataBlock* pLeftBlock : pLeft->blocks) {
+    for (int32_t i = 0; i < pLeftBlock->info.rows; ++i) {
+      int64_t lk = *(int64_t*)colDataGetData((SColumnInfoData*)taosArrayGet(pLeftBlock->pDataBlock, 0), i);
+      int32_t lv = *(int32_t*)colDataGetData((SColumnInfoData*)taosArrayGet(pLeftBlock->pDataBlock, 1), i);
+      for (SSDataBlock* pRightBlock : pRight->blocks) {
+        for (int32_t j = 0; j < pRightBlock->info.rows; ++j) {
+          int64_t rk = *(int64_t*)colDataGetData((SColumnInfoData*)taosArrayGet(pRightBlock->pDataBlock, 0), j);
+          int32_t rv = *(int32_t*)colDataGetData((SColumnInfoData*)taosArrayGet(pRightBlock->pDataBlock, 1), j);
+          if (lk == rk) {
+            res.push_back(SJoinTestRow(lk, lv, rv));
+          }
+        }
+      }
+    }
+  }
+  return res;
+}
+
+SNode* createColumnNode(int16_t blockId, int16_t slotId, uint8_t type, int32_t bytes) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = bytes;
+  pCol->dataBlockId = blockId;
+  pCol->slotId = slotId;
+  pCol->colId = slotId + 1;
+  pCol->colType = COLUMN_TYPE_COLUMN;
+  snprintf(pCol->colName, sizeof(pCol->colName), "c%d", slotId);
+  return (SNode*)pCol;
+}
+
+SNode* createTargetNode(int16_t slotId, SNode* pExpr) {
+  STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+  pTarget->dataBlockId = outputBlockId;
+  pTarget->slotId = slotId;
+  pTarget->pExpr = pExpr;
+  return (SNode*)pTarget;
+}
+
+SNode* createSlotDescNode(int16_t slotId, uint8_t type, int32_t bytes) {
+  SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+  pSlot->slotId = slotId;
+  pSlot->dataType.type = type;
+  pSlot->dataType.bytes = bytes;
+  pSlot->output = true;
+  return (SNode*)pSlot;
+}
+
+// select l.key, l.v, r.v from l join r on l.key = r.key, with the row estimates of both sides
+SHashJoinPhysiNode* createHashJoinNode(int64_t leftRows, int64_t rightRows) {
+  SHashJoinPhysiNode* pJoinNode = (SHashJoinPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_JOIN);
+  pJoinNode->joinType = JOIN_TYPE_INNER;
+  nodesListMakeAppend(&pJoinNode->pOnLeft, createColumnNode(leftBlockId, 0, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t)));
+  nodesListMakeAppend(&pJoinNode->pOnRight, createColumnNode(rightBlockId, 0, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t)));
+  nodesListMakeAppend(&pJoinNode->pTargets,
+                      createTargetNode(0, createColumnNode(leftBlockId, 0, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t))));
+  nodesListMakeAppend(&pJoinNode->pTargets,
+                      createTargetNode(1, createColumnNode(leftBlockId, 1, TSDB_DATA_TYPE_INT, sizeof(int32_t))));
+  nodesListMakeAppend(&pJoinNode->pTargets,
+                      createTargetNode(2, createColumnNode(rightBlockId, 1, TSDB_DATA_TYPE_INT, sizeof(int32_t))));
+  pJoinNode->inputStat[0].inputRowNum = leftRows;
+  pJoinNode->inputStat[1].inputRowNum = rightRows;
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = outputBlockId;
+  nodesListMakeAppend(&pDesc->pSlots, createSlotDescNode(0, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t)));
+  nodesListMakeAppend(&pDesc->pSlots, createSlotDescNode(1, TSDB_DATA_TYPE_INT, sizeof(int32_t)));
+  nodesListMakeAppend(&pDesc->pSlots, createSlotDescNode(2, TSDB_DATA_TYPE_INT, sizeof(int32_t)));
+  pJoinNode->node.pOutputDataBlockDesc = pDesc;
+  return pJoinNode;
+}
+
+// the error code is returned if the operator jumps out
+SSDataBlock* getNextResult(SOperatorInfo* pOperator, int32_t* pCode) {
+  int32_t code = setjmp(pOperator->pTaskInfo->env);
+  if (code != TSDB_CODE_SUCCESS) {
+    *pCode = code;
+    return NULL;
+  }
+
+  *pCode = TSDB_CODE_SUCCESS;
+  return pOperator->fpSet.getNextFn(pOperator);
+}
+}  // namespace
+
+class HashJoinTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    destroyOperator(pOperator);
+    nodesDestroyNode((SNode*)pJoinNode);
+    if (pTaskInfo != NULL) {
+      taosMemoryFree(pTaskInfo->id.str);
+      taosMemoryFree(pTaskInfo);
+    }
+    pOperator = NULL;
+    pJoinNode = NULL;
+    pTaskInfo = NULL;
+  }
+
+  SHJoinOperatorInfo* createOperator(SJoinTestInput* pLeft, SJoinTestInput* pRight, int64_t leftRows,
+                                     int64_t rightRows) {
+    expected = joinInputs(pLeft, pRight);
+    pTaskInfo = (SExecTaskInfo*)taosMemoryCalloc(1, sizeof(SExecTaskInfo));
+    pTaskInfo->id.str = taosStrdup("hashJoinTest");
+    pTaskInfo->execModel = OPTR_EXEC_MODEL_BATCH;
+
+    pJoinNode = createHashJoinNode(leftRows, rightRows);
+    SOperatorInfo* pDownstream[2] = {createInputOperator(pLeft, leftBlockId),
+                                     createInputOperator(pRight, rightBlockId)};
+    pOperator = createHashJoinOperatorInfo(pDownstream, 2, pJoinNode, pTaskInfo);
+    EXPECT_NE(pOperator, nullptr) << tstrerror(pTaskInfo->code);
+    return (pOperator != NULL) ? (SHJoinOperatorInfo*)pOperator->info : NULL;
+  }
+
+  // all result rows are the ones of the nested loop join
+  void checkResults() {
+    std::vector<SJoinTestRow> rows;
+    while (1) {
+      int32_t      code = 0;
+      SSDataBlock* pRes = getNextResult(pOperator, &code);
+      ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+      if (pRes == NULL) {
+        break;
+      }
+      for (int32_t i = 0; i < pRes->info.rows; ++i) {
+        rows.push_back(SJoinTestRow(*(int64_t*)colDataGetData((SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 0), i),
+                                    *(int32_t*)colDataGetData((SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 1), i),
+                                    *(int32_t*)colDataGetData((SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 2), i)));
+      }
+    }
+
+    ASSERT_FALSE(expected.empty());
+    std::sort(rows.begin(), rows.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(rows, expected);
+  }
+
+  SExecTaskInfo*            pTaskInfo = NULL;
+  SHashJoinPhysiNode*       pJoinNode = NULL;
+  SOperatorInfo*            pOperator = NULL;
+  std::vector<SJoinTestRow> expected;
+};
+
+TEST_F(HashJoinTest, buildTableFromPlanner) {
+  // the side with fewer estimated rows is the build table, no block is cached
+  SHJoinOperatorInfo* pJoin = createOperator(createInput(4, 1000, 70, 0), createInput(1, 300, 50, 100000), 4000, 300);
+  ASSERT_NE(pJoin, nullptr);
+  EXPECT_FALSE(pJoin->buildTableDetect);
+  EXPECT_EQ(pJoin->pBuild, &pJoin->tbs[1]);
+  checkResults();
+  EXPECT_EQ(pJoin->tbs[0].pCachedBlks, nullptr);
+  TearDown();
+
+  pJoin = createOperator(createInput(1, 300, 50, 0), createInput(4, 1000, 70, 100000), 300, 4000);
+  ASSERT_NE(pJoin, nullptr);
+  EXPECT_FALSE(pJoin->buildTableDetect);
+  EXPECT_EQ(pJoin->pBuild, &pJoin->tbs[0]);
+  checkResults();
+}
+
+TEST_F(HashJoinTest, detectSmallerBuildTable) {
+  // without estimates the side exhausted first is the build table, the blocks of both sides are replayed
+  SHJoinOperatorInfo* pJoin = createOperator(createInput(4, 1000, 70, 0), createInput(2, 300, 50, 100000), 0, 0);
+  ASSERT_NE(pJoin, nullptr);
+  EXPECT_TRUE(pJoin->buildTableDetect);
+  checkResults();
+  EXPECT_EQ(pJoin->pBuild, &pJoin->tbs[1]);
+  EXPECT_EQ(pJoin->execInfo.buildBlkRows, 600);
+  EXPECT_EQ(pJoin->execInfo.probeBlkRows, 4000);
+  TearDown();
+
+  pJoin = createOperator(createInput(2, 300, 50, 0), createInput(4, 1000, 70, 100000), 0, 0);
+  ASSERT_NE(pJoin, nullptr);
+  EXPECT_TRUE(pJoin->buildTableDetect);
+  checkResults();
+  EXPECT_EQ(pJoin->pBuild, &pJoin->tbs[0]);
+  EXPECT_EQ(pJoin->execInfo.buildBlkRows, 600);
+  EXPECT_EQ(pJoin->execInfo.probeBlkRows, 4000);
+}
+
+TEST_F(HashJoinTest, detectStopsAtCacheLimit) {
+  // both sides are above the limit, the build table of the planner is kept and the rest is not cached
+  SHJoinOperatorInfo* pJoin = createOperator(createInput(4, 1000, 70, 0), createInput(2, 300, 50, 100000), 0, 0);
+  ASSERT_NE(pJoin, nullptr);
+  EXPECT_TRUE(pJoin->buildTableDetect);
+  pJoin->detectMaxCacheSize = 1;
+  checkResults();
+  EXPECT_EQ(pJoin->pBuild, &pJoin->tbs[0]);
+  EXPECT_EQ(pJoin->execInfo.buildBlkRows, 4000);
+  EXPECT_EQ(pJoin->execInfo.probeBlkRows, 600);
+  EXPECT_EQ(taosArrayGetSize(pJoin->tbs[0].pCachedBlks), 1);
+  EXPECT_EQ(taosArrayGetSize(pJoin->tbs[1].pCachedBlks), 0);
+}
+
+#pragma GCC diagnostic pop
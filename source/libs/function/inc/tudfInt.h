@@ -19,6 +19,8 @@
 extern "C" {
 #endif
 
+#define UDF_SHM_NAME_LEN 64
+
 enum {
   UDF_TASK_SETUP = 0,
   UDF_TASK_CALL = 1,
@@ -35,7 +37,9 @@ enum {
 };
 
 typedef struct SUdfSetupRequest {
-  char udfName[TSDB_FUNC_NAME_LEN + 1];
+  char    udfName[TSDB_FUNC_NAME_LEN + 1];
+  char    shmName[UDF_SHM_NAME_LEN];  // empty if the client has no shared memory for this session
+  int32_t shmSize;
 } SUdfSetupRequest;
 
 typedef struct SUdfSetupResponse {
@@ -43,11 +47,13 @@ typedef struct SUdfSetupResponse {
   int8_t  outputType;
   int32_t bytes;
   int32_t bufSize;
+  int32_t shmSize;  // size of the shared memory udfd has mapped, 0 if none
 } SUdfSetupResponse;
 
 typedef struct SUdfCallRequest {
   int64_t udfHandle;
   int8_t  callType;
+  int32_t shmLen;  // > 0 if the call body is in the session shared memory instead of the pipe message
 
   SSDataBlock  block;
   SUdfInterBuf interBuf;
@@ -57,6 +63,7 @@ typedef struct SUdfCallRequest {
 
 typedef struct SUdfCallResponse {
   int8_t       callType;
+  int32_t      shmLen;  // > 0 if the result is in the session shared memory instead of the pipe message
   SSDataBlock  resultData;
   SUdfInterBuf resultBuf;
 } SUdfCallResponse;
@@ -102,14 +109,23 @@ void   *decodeUdfRequest(const void *buf, SUdfRequest *request);
 int32_t encodeUdfResponse(void **buf, const SUdfResponse *response);
 void   *decodeUdfResponse(const void *buf, SUdfResponse *response);
 
+int32_t encodeUdfCallRequestBody(void **buf, const SUdfCallRequest *call);
+void   *decodeUdfCallRequestBodyInPlace(const void *buf, SUdfCallRequest *call, SUdfDataBlock *udfBlock);
+int32_t encodeUdfCallResponseBody(void **buf, const SUdfCallResponse *callRsp);
+void   *decodeUdfCallResponseBody(const void *buf, SUdfCallResponse *callRsp);
+
 void freeUdfColumnData(SUdfColumnData *data, SUdfColumnMeta *meta);
 void freeUdfColumn(SUdfColumn *col);
 void freeUdfDataDataBlock(SUdfDataBlock *block);
+void freeUdfDataBlockInPlace(SUdfDataBlock *block);
 
 int32_t convertDataBlockToUdfDataBlock(SSDataBlock *block, SUdfDataBlock *udfBlock);
 int32_t convertUdfColumnToDataBlock(SUdfColumn *udfCol, SSDataBlock *block);
 
 int32_t getUdfdPipeName(char *pipeName, int32_t size);
+
+int32_t udfShmMap(const char *name, int32_t size, bool create, void **ppShm);
+void    udfShmUnmap(void *pShm, int32_t size);
 #ifdef __cplusplus
 }
 #endif
@@ -929,57 +929,52 @@ int32_t minMaxCombine(SqlFunctionCtx* pDestCtx, SqlFunctionCtx* pSourceCtx, int3
   SMinmaxResInfo*      pSBuf = GET_ROWCELL_INTERBUF(pSResInfo);
   int16_t              type = pDBuf->type == TSDB_DATA_TYPE_NULL ? pSBuf->type : pDBuf->type;
 
+  bool replace = false;
   switch (type) {
     case TSDB_DATA_TYPE_DOUBLE:
+      replace = COMPARE_MINMAX_DATA(double);
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      replace = COMPARE_MINMAX_DATA(float);
+      break;
     case TSDB_DATA_TYPE_UBIGINT:
+      replace = COMPARE_MINMAX_DATA(uint64_t);
+      break;
+    case TSDB_DATA_TYPE_TIMESTAMP:
     case TSDB_DATA_TYPE_BIGINT:
-      if (pSBuf->assign && (COMPARE_MINMAX_DATA(int64_t) || !pDBuf->assign)) {
-        pDBuf->v = pSBuf->v;
-        replaceTupleData(&pDBuf->tuplePos, &pSBuf->tuplePos);
-        pDBuf->assign = true;
-      }
+      replace = COMPARE_MINMAX_DATA(int64_t);
       break;
     case TSDB_DATA_TYPE_UINT:
+      replace = COMPARE_MINMAX_DATA(uint32_t);
+      break;
     case TSDB_DATA_TYPE_INT:
-      if (pSBuf->assign && (COMPARE_MINMAX_DATA(int32_t) || !pDBuf->assign)) {
-        pDBuf->v = pSBuf->v;
-        replaceTupleData(&pDBuf->tuplePos, &pSBuf->tuplePos);
-        pDBuf->assign = true;
-      }
+      replace = COMPARE_MINMAX_DATA(int32_t);
       break;
     case TSDB_DATA_TYPE_USMALLINT:
+      replace = COMPARE_MINMAX_DATA(uint16_t);
+      break;
     case TSDB_DATA_TYPE_SMALLINT:
-      if (pSBuf->assign && (COMPARE_MINMAX_DATA(int16_t) || !pDBuf->assign)) {
-        pDBuf->v = pSBuf->v;
-        replaceTupleData(&pDBuf->tuplePos, &pSBuf->tuplePos);
-        pDBuf->assign = true;
-      }
+      replace = COMPARE_MINMAX_DATA(int16_t);
       break;
-    case TSDB_DATA_TYPE_BOOL:
     case TSDB_DATA_TYPE_UTINYINT:
-    case TSDB_DATA_TYPE_TINYINT:
-      if (pSBuf->assign && (COMPARE_MINMAX_DATA(int8_t) || !pDBuf->assign)) {
-        pDBuf->v = pSBuf->v;
-        replaceTupleData(&pDBuf->tuplePos, &pSBuf->tuplePos);
-        pDBuf->assign = true;
-      }
+      replace = COMPARE_MINMAX_DATA(uint8_t);
       break;
-    case TSDB_DATA_TYPE_FLOAT: {
-      if (pSBuf->assign && (COMPARE_MINMAX_DATA(double) || !pDBuf->assign)) {
-        pDBuf->v = pSBuf->v;
-        replaceTupleData(&pDBuf->tuplePos, &pSBuf->tuplePos);
-        pDBuf->assign = true;
-      }
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      replace = COMPARE_MINMAX_DATA(int8_t);
       break;
-    }
     default:
-      if (pSBuf->assign && (strcmp((char*)&pDBuf->v, (char*)&pSBuf->v) || !pDBuf->assign)) {
-        pDBuf->v = pSBuf->v;
-        replaceTupleData(&pDBuf->tuplePos, &pSBuf->tuplePos);
-        pDBuf->assign = true;
-      }
+      replace = strcmp((char*)&pDBuf->v, (char*)&pSBuf->v);
       break;
   }
+
+  // the value of each type is kept in its own width, see doMinMaxHelper
+  if (pSBuf->assign && (replace || !pDBuf->assign)) {
+    pDBuf->v = pSBuf->v;
+    pDBuf->type = type;
+    replaceTupleData(&pDBuf->tuplePos, &pSBuf->tuplePos);
+    pDBuf->assign = true;
+  }
   pDResInfo->numOfRes = TMAX(pDResInfo->numOfRes, pSResInfo->numOfRes);
   pDResInfo->isNullRes &= pSResInfo->isNullRes;
   return TSDB_CODE_SUCCESS;
@@ -393,6 +393,11 @@ typedef struct SUdfcUvSession {
   int32_t bytes;
   int32_t bufSize;
 
+  // shared memory with udfd, the call body and result go through it instead of the pipe
+  void   *shm;
+  int32_t shmSize;
+  int8_t  shmInUse;
+
   char udfName[TSDB_FUNC_NAME_LEN + 1];
 } SUdfcUvSession;
 
@@ -505,14 +510,29 @@ int32_t getUdfdPipeName(char *pipeName, int32_t size) {
   return 0;
 }
 
+int32_t udfShmMap(const char *name, int32_t size, bool create, void **ppShm) {
+  *ppShm = taosShmMap(name, size, create);
+  if (*ppShm == NULL) {
+    fnError("failed to map udf shared memory %s, size:%d, since %s", name, size, terrstr());
+    return terrno;
+  }
+  return 0;
+}
+
+void udfShmUnmap(void *pShm, int32_t size) { taosShmUnmap(pShm, size); }
+
 int32_t encodeUdfSetupRequest(void **buf, const SUdfSetupRequest *setup) {
   int32_t len = 0;
   len += taosEncodeBinary(buf, setup->udfName, TSDB_FUNC_NAME_LEN);
+  len += taosEncodeString(buf, setup->shmName);
+  len += taosEncodeFixedI32(buf, setup->shmSize);
   return len;
 }
 
 void *decodeUdfSetupRequest(const void *buf, SUdfSetupRequest *request) {
   buf = taosDecodeBinaryTo(buf, request->udfName, TSDB_FUNC_NAME_LEN);
+  buf = taosDecodeStringTo(buf, request->shmName);
+  buf = taosDecodeFixedI32(buf, &request->shmSize);
   return (void *)buf;
 }
 
@@ -531,10 +551,63 @@ void *decodeUdfInterBuf(const void *buf, SUdfInterBuf *state) {
   return (void *)buf;
 }
 
-int32_t encodeUdfCallRequest(void **buf, const SUdfCallRequest *call) {
+static void *decodeUdfInterBufInPlace(const void *buf, SUdfInterBuf *state) {
+  buf = taosDecodeFixedI8(buf, &state->numOfResult);
+  buf = taosDecodeFixedI32(buf, &state->bufLen);
+  state->buf = (char *)buf;
+  return POINTER_SHIFT(buf, state->bufLen);
+}
+
+// decode a block encoded by tEncodeDataBlock, the column buffers of udfBlock point into buf
+static void *decodeDataBlockToUdfDataBlockInPlace(const void *buf, SUdfDataBlock *udfBlock) {
+  uint64_t uid = 0;
+  int16_t  numOfCols = 0;
+  int16_t  hasVarCol = 0;
+  int64_t  rows = 0;
+  int32_t  sz = 0;
+  buf = taosDecodeFixedU64(buf, &uid);
+  buf = taosDecodeFixedI16(buf, &numOfCols);
+  buf = taosDecodeFixedI16(buf, &hasVarCol);
+  buf = taosDecodeFixedI64(buf, &rows);
+  buf = taosDecodeFixedI32(buf, &sz);
+
+  udfBlock->numOfRows = rows;
+  udfBlock->numOfCols = sz;
+  udfBlock->udfCols = taosMemoryCalloc(sz, sizeof(SUdfColumn *));
+  for (int32_t i = 0; i < sz; ++i) {
+    udfBlock->udfCols[i] = taosMemoryCalloc(1, sizeof(SUdfColumn));
+    SUdfColumn *udfCol = udfBlock->udfCols[i];
+    int16_t     colId = 0;
+    int8_t      type = 0;
+    int32_t     len = 0;
+    buf = taosDecodeFixedI16(buf, &colId);
+    buf = taosDecodeFixedI8(buf, &type);
+    udfCol->colMeta.type = type;
+    buf = taosDecodeFixedI32(buf, &udfCol->colMeta.bytes);
+    buf = taosDecodeFixedBool(buf, &udfCol->hasNull);
+    udfCol->colData.numOfRows = rows;
+    if (IS_VAR_DATA_TYPE(udfCol->colMeta.type)) {
+      udfCol->colData.varLenCol.varOffsetsLen = sizeof(int32_t) * rows;
+      udfCol->colData.varLenCol.varOffsets = (int32_t *)buf;
+      buf = POINTER_SHIFT(buf, udfCol->colData.varLenCol.varOffsetsLen);
+      buf = taosDecodeFixedI32(buf, &len);
+      udfCol->colData.varLenCol.payloadLen = len;
+      udfCol->colData.varLenCol.payload = (char *)buf;
+    } else {
+      udfCol->colData.fixLenCol.nullBitmapLen = BitmapLen(rows);
+      udfCol->colData.fixLenCol.nullBitmap = (char *)buf;
+      buf = POINTER_SHIFT(buf, udfCol->colData.fixLenCol.nullBitmapLen);
+      buf = taosDecodeFixedI32(buf, &len);
+      udfCol->colData.fixLenCol.dataLen = len;
+      udfCol->colData.fixLenCol.data = (char *)buf;
+    }
+    buf = POINTER_SHIFT(buf, len);
+  }
+  return (void *)buf;
+}
+
+int32_t encodeUdfCallRequestBody(void **buf, const SUdfCallRequest *call) {
   int32_t len = 0;
-  len += taosEncodeFixedI64(buf, call->udfHandle);
-  len += taosEncodeFixedI8(buf, call->callType);
   if (call->callType == TSDB_UDF_CALL_SCALA_PROC) {
     len += tEncodeDataBlock(buf, &call->block);
   } else if (call->callType == TSDB_UDF_CALL_AGG_INIT) {
@@ -551,9 +624,7 @@ int32_t encodeUdfCallRequest(void **buf, const SUdfCallRequest *call) {
   return len;
 }
 
-void *decodeUdfCallRequest(const void *buf, SUdfCallRequest *call) {
-  buf = taosDecodeFixedI64(buf, &call->udfHandle);
-  buf = taosDecodeFixedI8(buf, &call->callType);
+static void *decodeUdfCallRequestBody(const void *buf, SUdfCallRequest *call) {
   switch (call->callType) {
     case TSDB_UDF_CALL_SCALA_PROC:
       buf = tDecodeDataBlock(buf, &call->block);
@@ -576,6 +647,52 @@ void *decodeUdfCallRequest(const void *buf, SUdfCallRequest *call) {
   return (void *)buf;
 }
 
+// decode the call body from the session shared memory without copying. the input block is returned in udfBlock,
+// its columns and the inter buffers of the call point into buf.
+void *decodeUdfCallRequestBodyInPlace(const void *buf, SUdfCallRequest *call, SUdfDataBlock *udfBlock) {
+  switch (call->callType) {
+    case TSDB_UDF_CALL_SCALA_PROC:
+      buf = decodeDataBlockToUdfDataBlockInPlace(buf, udfBlock);
+      break;
+    case TSDB_UDF_CALL_AGG_INIT:
+      buf = taosDecodeFixedI8(buf, &call->initFirst);
+      break;
+    case TSDB_UDF_CALL_AGG_PROC:
+      buf = decodeDataBlockToUdfDataBlockInPlace(buf, udfBlock);
+      buf = decodeUdfInterBufInPlace(buf, &call->interBuf);
+      break;
+    case TSDB_UDF_CALL_AGG_MERGE:
+      buf = decodeUdfInterBufInPlace(buf, &call->interBuf);
+      buf = decodeUdfInterBufInPlace(buf, &call->interBuf2);
+      break;
+    case TSDB_UDF_CALL_AGG_FIN:
+      buf = decodeUdfInterBufInPlace(buf, &call->interBuf);
+      break;
+  }
+  return (void *)buf;
+}
+
+int32_t encodeUdfCallRequest(void **buf, const SUdfCallRequest *call) {
+  int32_t len = 0;
+  len += taosEncodeFixedI64(buf, call->udfHandle);
+  len += taosEncodeFixedI8(buf, call->callType);
+  len += taosEncodeFixedI32(buf, call->shmLen);
+  if (call->shmLen == 0) {
+    len += encodeUdfCallRequestBody(buf, call);
+  }
+  return len;
+}
+
+void *decodeUdfCallRequest(const void *buf, SUdfCallRequest *call) {
+  buf = taosDecodeFixedI64(buf, &call->udfHandle);
+  buf = taosDecodeFixedI8(buf, &call->callType);
+  buf = taosDecodeFixedI32(buf, &call->shmLen);
+  if (call->shmLen == 0) {
+    buf = decodeUdfCallRequestBody(buf, call);
+  }
+  return (void *)buf;
+}
+
 int32_t encodeUdfTeardownRequest(void **buf, const SUdfTeardownRequest *teardown) {
   int32_t len = 0;
   len += taosEncodeFixedI64(buf, teardown->udfHandle);
@@ -630,6 +747,7 @@ int32_t encodeUdfSetupResponse(void **buf, const SUdfSetupResponse *setupRsp) {
   len += taosEncodeFixedI8(buf, setupRsp->outputType);
   len += taosEncodeFixedI32(buf, setupRsp->bytes);
   len += taosEncodeFixedI32(buf, setupRsp->bufSize);
+  len += taosEncodeFixedI32(buf, setupRsp->shmSize);
   return len;
 }
 
@@ -638,12 +756,12 @@ void *decodeUdfSetupResponse(const void *buf, SUdfSetupResponse *setupRsp) {
   buf = taosDecodeFixedI8(buf, &setupRsp->outputType);
   buf = taosDecodeFixedI32(buf, &setupRsp->bytes);
   buf = taosDecodeFixedI32(buf, &setupRsp->bufSize);
+  buf = taosDecodeFixedI32(buf, &setupRsp->shmSize);
   return (void *)buf;
 }
 
-int32_t encodeUdfCallResponse(void **buf, const SUdfCallResponse *callRsp) {
+int32_t encodeUdfCallResponseBody(void **buf, const SUdfCallResponse *callRsp) {
   int32_t len = 0;
-  len += taosEncodeFixedI8(buf, callRsp->callType);
   switch (callRsp->callType) {
     case TSDB_UDF_CALL_SCALA_PROC:
       len += tEncodeDataBlock(buf, &callRsp->resultData);
@@ -664,8 +782,7 @@ int32_t encodeUdfCallResponse(void **buf, const SUdfCallResponse *callRsp) {
   return len;
 }
 
-void *decodeUdfCallResponse(const void *buf, SUdfCallResponse *callRsp) {
-  buf = taosDecodeFixedI8(buf, &callRsp->callType);
+void *decodeUdfCallResponseBody(const void *buf, SUdfCallResponse *callRsp) {
   switch (callRsp->callType) {
     case TSDB_UDF_CALL_SCALA_PROC:
       buf = tDecodeDataBlock(buf, &callRsp->resultData);
@@ -686,6 +803,25 @@ void *decodeUdfCallResponse(const void *buf, SUdfCallResponse *callRsp) {
   return (void *)buf;
 }
 
+int32_t encodeUdfCallResponse(void **buf, const SUdfCallResponse *callRsp) {
+  int32_t len = 0;
+  len += taosEncodeFixedI8(buf, callRsp->callType);
+  len += taosEncodeFixedI32(buf, callRsp->shmLen);
+  if (callRsp->shmLen == 0) {
+    len += encodeUdfCallResponseBody(buf, callRsp);
+  }
+  return len;
+}
+
+void *decodeUdfCallResponse(const void *buf, SUdfCallResponse *callRsp) {
+  buf = taosDecodeFixedI8(buf, &callRsp->callType);
+  buf = taosDecodeFixedI32(buf, &callRsp->shmLen);
+  if (callRsp->shmLen == 0) {
+    buf = decodeUdfCallResponseBody(buf, callRsp);
+  }
+  return (void *)buf;
+}
+
 int32_t encodeUdfTeardownResponse(void **buf, const SUdfTeardownResponse *teardownRsp) { return 0; }
 
 void *decodeUdfTeardownResponse(const void *buf, SUdfTeardownResponse *teardownResponse) { return (void *)buf; }
@@ -779,6 +915,15 @@ void freeUdfDataDataBlock(SUdfDataBlock *block) {
   block->udfCols = NULL;
 }
 
+void freeUdfDataBlockInPlace(SUdfDataBlock *block) {
+  for (int32_t i = 0; i < block->numOfCols; ++i) {
+    taosMemoryFree(block->udfCols[i]);
+    block->udfCols[i] = NULL;
+  }
+  taosMemoryFree(block->udfCols);
+  block->udfCols = NULL;
+}
+
 void freeUdfInterBuf(SUdfInterBuf *buf) {
   taosMemoryFree(buf->buf);
   buf->buf = NULL;
@@ -1785,6 +1930,22 @@ int32_t udfcRunUdfUvTask(SClientUdfTask *task, int8_t uvTaskType) {
   return task->errCode;
 }
 
+static void udfcCreateSessionShm(SUdfcUvSession *session, SUdfSetupRequest *req) {
+  static int64_t shmSeq = 0;
+  if (tsUdfShmSize <= 0) {
+    return;
+  }
+
+  int32_t size = tsUdfShmSize * 1024 * 1024;
+  snprintf(req->shmName, sizeof(req->shmName), "/taosudf.%d.%" PRId64, taosGetPId(), atomic_add_fetch_64(&shmSeq, 1));
+  if (udfShmMap(req->shmName, size, true, &session->shm) != 0) {
+    req->shmName[0] = 0;
+    return;
+  }
+  session->shmSize = size;
+  req->shmSize = size;
+}
+
 int32_t doSetupUdf(char udfName[], UdfcFuncHandle *funcHandle) {
   SClientUdfTask *task = taosMemoryCalloc(1, sizeof(SClientUdfTask));
   task->errCode = 0;
@@ -1803,6 +1964,7 @@ int32_t doSetupUdf(char udfName[], UdfcFuncHandle *funcHandle) {
     return TSDB_CODE_UDF_PIPE_CONNECT_ERR;
   }
 
+  udfcCreateSessionShm(task->session, req);
   udfcRunUdfUvTask(task, UV_TASK_REQ_RSP);
 
   SUdfSetupResponse *rsp = &task->_setup.rsp;
@@ -1810,6 +1972,15 @@ int32_t doSetupUdf(char udfName[], UdfcFuncHandle *funcHandle) {
   task->session->outputType = rsp->outputType;
   task->session->bytes = rsp->bytes;
   task->session->bufSize = rsp->bufSize;
+  if (req->shmSize > 0) {
+    // udfd has mapped the shared memory or given up, the name is not needed any more either way
+    taosShmUnlink(req->shmName);
+    if (task->errCode != 0 || rsp->shmSize != req->shmSize) {
+      udfShmUnmap(task->session->shm, task->session->shmSize);
+      task->session->shm = NULL;
+      task->session->shmSize = 0;
+    }
+  }
   strncpy(task->session->udfName, udfName, TSDB_FUNC_NAME_LEN);
   if (task->errCode != 0) {
     fnError("failed to setup udf. udfname: %s, err: %d", udfName, task->errCode)
@@ -1864,8 +2035,27 @@ int32_t callUdf(UdfcFuncHandle handle, int8_t callType, SSDataBlock *input, SUdf
     }
   }
 
+  // the shared memory holds one call at a time, concurrent calls of the session go through the pipe
+  bool useShm = false;
+  if (session->shm != NULL && atomic_val_compare_exchange_8(&session->shmInUse, 0, 1) == 0) {
+    if (encodeUdfCallRequestBody(NULL, req) <= session->shmSize) {
+      void *buf = session->shm;
+      req->shmLen = encodeUdfCallRequestBody(&buf, req);
+      useShm = true;
+    } else {
+      atomic_store_8(&session->shmInUse, 0);
+    }
+  }
+
   udfcRunUdfUvTask(task, UV_TASK_REQ_RSP);
 
+  if (task->errCode == 0 && task->_call.rsp.shmLen > 0) {
+    decodeUdfCallResponseBody(session->shm, &task->_call.rsp);
+  }
+  if (useShm) {
+    atomic_store_8(&session->shmInUse, 0);
+  }
+
   if (task->errCode != 0) {
     fnError("call udf failure. err: %d", task->errCode);
   } else {
@@ -1951,6 +2141,7 @@ int32_t doTeardownUdf(UdfcFuncHandle handle) {
 
   if (session->udfUvPipe == NULL) {
     fnError("tear down udf. pipe to udfd does not exist. udf name: %s", session->udfName);
+    udfShmUnmap(session->shm, session->shmSize);
     taosMemoryFree(session);
     return TSDB_CODE_UDF_PIPE_NOT_EXIST;
   }
@@ -1977,6 +2168,7 @@ int32_t doTeardownUdf(UdfcFuncHandle handle) {
     conn->session = NULL;
   }
   uv_mutex_unlock(&gUdfcProxy.udfcUvMutex);
+  udfShmUnmap(session->shm, session->shmSize);
   taosMemoryFree(session);
   taosMemoryFree(task);
 
@@ -283,6 +283,10 @@ typedef struct SUdf {
 
 typedef struct SUdfcFuncHandle {
   SUdf *udf;
+
+  // shared memory of the client session, mapped at setup
+  void   *shm;
+  int32_t shmSize;
 } SUdfcFuncHandle;
 
 typedef enum EUdfdRpcReqRspType {
@@ -643,8 +647,11 @@ void udfdProcessSetupRequest(SUvUdfWork *uvUdf, SUdfRequest *request) {
     }
     uv_mutex_unlock(&udf->lock);
   }
-  SUdfcFuncHandle *handle = taosMemoryMalloc(sizeof(SUdfcFuncHandle));
+  SUdfcFuncHandle *handle = taosMemoryCalloc(1, sizeof(SUdfcFuncHandle));
   handle->udf = udf;
+  if (code == 0 && setup->shmSize > 0 && udfShmMap(setup->shmName, setup->shmSize, false, &handle->shm) == 0) {
+    handle->shmSize = setup->shmSize;
+  }
 
   SUdfResponse rsp;
   rsp.seqNum = request->seqNum;
@@ -654,6 +661,7 @@ void udfdProcessSetupRequest(SUvUdfWork *uvUdf, SUdfRequest *request) {
   rsp.setupRsp.outputType = udf->outputType;
   rsp.setupRsp.bytes = udf->outputLen;
   rsp.setupRsp.bufSize = udf->bufSize;
+  rsp.setupRsp.shmSize = handle->shmSize;
 
   int32_t len = encodeUdfResponse(NULL, &rsp);
   rsp.msgLen = len;
@@ -677,7 +685,19 @@ void udfdProcessCallRequest(SUvUdfWork *uvUdf, SUdfRequest *request) {
   SUdfResponse     *rsp = &response;
   SUdfCallResponse *subRsp = &rsp->callRsp;
 
-  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t       code = TSDB_CODE_SUCCESS;
+  SUdfDataBlock input = {0};
+  bool          inPlace = (call->shmLen > 0);
+  if (inPlace) {
+    if (handle->shm == NULL || call->shmLen > handle->shmSize) {
+      fnError("udfd call request in shared memory. invalid length %d, shared memory size %d", call->shmLen,
+              handle->shmSize);
+      code = TSDB_CODE_INVALID_MSG;
+      goto _send;
+    }
+    decodeUdfCallRequestBodyInPlace(handle->shm, call, &input);
+  }
+
   switch (call->callType) {
     case TSDB_UDF_CALL_SCALA_PROC: {
       SUdfColumn output = {0};
@@ -685,12 +705,16 @@ void udfdProcessCallRequest(SUvUdfWork *uvUdf, SUdfRequest *request) {
       output.colMeta.type = udf->outputType;
       output.colMeta.precision = 0;
       output.colMeta.scale = 0;
-      udfColEnsureCapacity(&output, call->block.info.rows);
+      udfColEnsureCapacity(&output, inPlace ? input.numOfRows : call->block.info.rows);
 
-      SUdfDataBlock input = {0};
-      convertDataBlockToUdfDataBlock(&call->block, &input);
-      code = udf->scriptPlugin->udfScalarProcFunc(&input, &output, udf->scriptUdfCtx);
-      freeUdfDataDataBlock(&input);
+      if (inPlace) {
+        code = udf->scriptPlugin->udfScalarProcFunc(&input, &output, udf->scriptUdfCtx);
+        freeUdfDataBlockInPlace(&input);
+      } else {
+        convertDataBlockToUdfDataBlock(&call->block, &input);
+        code = udf->scriptPlugin->udfScalarProcFunc(&input, &output, udf->scriptUdfCtx);
+        freeUdfDataDataBlock(&input);
+      }
       convertUdfColumnToDataBlock(&output, &response.callRsp.resultData);
       freeUdfColumn(&output);
       break;
@@ -702,12 +726,17 @@ void udfdProcessCallRequest(SUvUdfWork *uvUdf, SUdfRequest *request) {
       break;
     }
     case TSDB_UDF_CALL_AGG_PROC: {
-      SUdfDataBlock input = {0};
-      convertDataBlockToUdfDataBlock(&call->block, &input);
+      if (!inPlace) {
+        convertDataBlockToUdfDataBlock(&call->block, &input);
+      }
       SUdfInterBuf outBuf = {.buf = taosMemoryMalloc(udf->bufSize), .bufLen = udf->bufSize, .numOfResult = 0};
       code = udf->scriptPlugin->udfAggProcFunc(&input, &call->interBuf, &outBuf, udf->scriptUdfCtx);
-      freeUdfInterBuf(&call->interBuf);
-      freeUdfDataDataBlock(&input);
+      if (inPlace) {
+        freeUdfDataBlockInPlace(&input);
+      } else {
+        freeUdfInterBuf(&call->interBuf);
+        freeUdfDataDataBlock(&input);
+      }
       subRsp->resultBuf = outBuf;
 
       break;
@@ -715,8 +744,10 @@ void udfdProcessCallRequest(SUvUdfWork *uvUdf, SUdfRequest *request) {
     case TSDB_UDF_CALL_AGG_MERGE: {
       SUdfInterBuf outBuf = {.buf = taosMemoryMalloc(udf->bufSize), .bufLen = udf->bufSize, .numOfResult = 0};
       code = udf->scriptPlugin->udfAggMergeFunc(&call->interBuf, &call->interBuf2, &outBuf, udf->scriptUdfCtx);
-      freeUdfInterBuf(&call->interBuf);
-      freeUdfInterBuf(&call->interBuf2);
+      if (!inPlace) {
+        freeUdfInterBuf(&call->interBuf);
+        freeUdfInterBuf(&call->interBuf2);
+      }
       subRsp->resultBuf = outBuf;
 
       break;
@@ -724,7 +755,9 @@ void udfdProcessCallRequest(SUvUdfWork *uvUdf, SUdfRequest *request) {
     case TSDB_UDF_CALL_AGG_FIN: {
       SUdfInterBuf outBuf = {.buf = taosMemoryMalloc(udf->bufSize), .bufLen = udf->bufSize, .numOfResult = 0};
       code = udf->scriptPlugin->udfAggFinishFunc(&call->interBuf, &outBuf, udf->scriptUdfCtx);
-      freeUdfInterBuf(&call->interBuf);
+      if (!inPlace) {
+        freeUdfInterBuf(&call->interBuf);
+      }
       subRsp->resultBuf = outBuf;
       break;
     }
@@ -732,11 +765,18 @@ void udfdProcessCallRequest(SUvUdfWork *uvUdf, SUdfRequest *request) {
       break;
   }
 
+_send:
   rsp->seqNum = request->seqNum;
   rsp->type = request->type;
   rsp->code = (code != 0) ? TSDB_CODE_UDF_FUNC_EXEC_FAILURE : 0;
   subRsp->callType = call->callType;
 
+  // the input in the shared memory has been consumed, so the result can be put back in its place
+  if (inPlace && code == 0 && encodeUdfCallResponseBody(NULL, subRsp) <= handle->shmSize) {
+    void *shmBuf = handle->shm;
+    subRsp->shmLen = encodeUdfCallResponseBody(&shmBuf, subRsp);
+  }
+
   int32_t len = encodeUdfResponse(NULL, rsp);
   rsp->msgLen = len;
   void *bufBegin = taosMemoryMalloc(len);
@@ -798,6 +838,7 @@ void udfdProcessTeardownRequest(SUvUdfWork *uvUdf, SUdfRequest *request) {
     fnDebug("udfd destroy function returns %d", code);
     taosMemoryFree(udf);
   }
+  udfShmUnmap(handle->shm, handle->shmSize);
   taosMemoryFree(handle);
 
   SUdfResponse  response = {0};
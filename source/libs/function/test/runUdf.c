@@ -9,9 +9,19 @@
 #include "tglobal.h"
 #include "tudf.h"
 
+static int32_t numOfRows = 1024;
+static int32_t numOfLoops = 1;
+static int32_t shmSize = -1;
+
 static int32_t parseArgs(int32_t argc, char *argv[]) {
   for (int32_t i = 1; i < argc; ++i) {
-    if (strcmp(argv[i], "-c") == 0) {
+    if (strcmp(argv[i], "-r") == 0 && i < argc - 1) {
+      numOfRows = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-l") == 0 && i < argc - 1) {
+      numOfLoops = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-s") == 0 && i < argc - 1) {
+      shmSize = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0) {
       if (i < argc - 1) {
         if (strlen(argv[++i]) >= PATH_MAX) {
           printf("config file path overflow");
@@ -34,6 +44,7 @@ static int32_t initLog() {
   return taosCreateLog(logName, 1, configDir, NULL, NULL, NULL, NULL, 0);
 }
 
+// rows/s through udf1. run with "-s 0" to send the data through the udfd pipe instead of the shared memory
 int scalarFuncTest() {
   UdfcFuncHandle handle;
 
@@ -41,40 +52,49 @@ int scalarFuncTest() {
     fnError("setup udf failure");
     return -1;
   }
-  int64_t beg = taosGetTimestampUs();
-  for (int k = 0; k < 1; ++k) {
-    SSDataBlock  block = {0};
-    SSDataBlock *pBlock = &block;
-    for (int32_t i = 0; i < 1; ++i) {
-      SColumnInfoData colInfo = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 1);
-      blockDataAppendColInfo(pBlock, &colInfo);
-    }
 
-    blockDataEnsureCapacity(pBlock, 1024);
-    pBlock->info.rows = 1024;
+  SSDataBlock  block = {0};
+  SSDataBlock *pBlock = &block;
+  for (int32_t i = 0; i < 1; ++i) {
+    SColumnInfoData colInfo = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 1);
+    blockDataAppendColInfo(pBlock, &colInfo);
+  }
 
-    SColumnInfoData *pCol = taosArrayGet(pBlock->pDataBlock, 0);
-    for (int32_t j = 0; j < pBlock->info.rows; ++j) {
-      colDataSetInt32(pCol, j, &j);
-    }
+  blockDataEnsureCapacity(pBlock, numOfRows);
+  pBlock->info.rows = numOfRows;
 
+  SColumnInfoData *pCol = taosArrayGet(pBlock->pDataBlock, 0);
+  for (int32_t j = 0; j < pBlock->info.rows; ++j) {
+    colDataSetInt32(pCol, j, &j);
+  }
+
+  int64_t beg = taosGetTimestampUs();
+  for (int k = 0; k < numOfLoops; ++k) {
     SScalarParam input = {0};
     input.numOfRows = pBlock->info.rows;
     input.columnData = taosArrayGet(pBlock->pDataBlock, 0);
 
     SScalarParam output = {0};
-    doCallUdfScalarFunc(handle, &input, 1, &output);
-    taosArrayDestroy(pBlock->pDataBlock);
+    if (doCallUdfScalarFunc(handle, &input, 1, &output) != 0) {
+      fnError("call udf failure");
+      break;
+    }
 
     SColumnInfoData *col = output.columnData;
-    for (int32_t i = 0; i < output.numOfRows; ++i) {
-      if (i % 100 == 0) fprintf(stderr, "%d\t%d\n", i, *(int32_t *)(col->pData + i * sizeof(int32_t)));
+    if (k == 0) {
+      for (int32_t i = 0; i < output.numOfRows; ++i) {
+        if (i % 100 == 0) fprintf(stderr, "%d\t%d\n", i, *(int32_t *)(col->pData + i * sizeof(int32_t)));
+      }
     }
     colDataDestroy(output.columnData);
     taosMemoryFree(output.columnData);
   }
   int64_t end = taosGetTimestampUs();
-  fprintf(stderr, "time: %f\n", (end - beg) / 1000.0);
+  blockDataFreeRes(pBlock);
+
+  double elapsed = (end - beg) / 1000000.0;
+  fprintf(stderr, "rows: %d, loops: %d, shm: %dMB, time: %fs, rows/s: %.0f\n", numOfRows, numOfLoops, tsUdfShmSize,
+          elapsed, elapsed > 0 ? (double)numOfRows * numOfLoops / elapsed : 0);
   doTeardownUdf(handle);
 
   return 0;
@@ -131,6 +151,9 @@ int main(int argc, char *argv[]) {
     fnError("failed to start since read config error");
     return -1;
   }
+  if (shmSize >= 0) {
+    tsUdfShmSize = shmSize;
+  }
 
   udfcOpen();
   uv_sleep(1000);
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#define ALLOW_FORBID_FUNC
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "tdatablock.h"
+#include "tudf.h"
+#include "tudfInt.h"
+
+namespace {
+const int32_t numOfRows = 37;
+
+// a block of fixed and var length columns, each of them has null values at rows of its own
+SSDataBlock *createTestBlock() {
+  SSDataBlock *pBlock = createDataBlock();
+  int16_t      types[] = {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_DOUBLE, TSDB_DATA_TYPE_VARCHAR,
+                          TSDB_DATA_TYPE_BOOL, TSDB_DATA_TYPE_VARCHAR};
+  int32_t      numOfCols = sizeof(types) / sizeof(types[0]);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    int32_t         bytes = IS_VAR_DATA_TYPE(types[i]) ? 32 + VARSTR_HEADER_SIZE : tDataTypes[types[i]].bytes;
+    SColumnInfoData colInfo = createColumnInfoData(types[i], bytes, i + 1);
+    blockDataAppendColInfo(pBlock, &colInfo);
+  }
+  blockDataEnsureCapacity(pBlock, numOfRows);
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData *pCol = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, i);
+    for (int32_t row = 0; row < numOfRows; ++row) {
+      // the last column has no null value
+      if (i < numOfCols - 1 && (row + i) % 5 == 0) {
+        colDataSetNULL(pCol, row);
+        continue;
+      }
+      int64_t val = row * 31 - 500;
+      double  dval = val + 0.25;
+      char    str[32 + VARSTR_HEADER_SIZE] = {0};
+      switch (types[i]) {
+        case TSDB_DATA_TYPE_INT: {
+          int32_t v = val;
+          colDataSetVal(pCol, row, (const char *)&v, false);
+        } break;
+        case TSDB_DATA_TYPE_BIGINT:
+          colDataSetVal(pCol, row, (const char *)&val, false);
+          break;
+        case TSDB_DATA_TYPE_DOUBLE:
+          colDataSetVal(pCol, row, (const char *)&dval, false);
+          break;
+        case TSDB_DATA_TYPE_BOOL: {
+          int8_t v = row % 2;
+          colDataSetVal(pCol, row, (const char *)&v, false);
+        } break;
+        default: {
+          // the strings are of different lengths, some of them are empty
+          int32_t len = snprintf(varDataVal(str), 32, "%.*s", row % 7 * 4, "abcdefghijklmnopqrstuvwxyz0123456789");
+          varDataSetLen(str, len);
+          colDataSetVal(pCol, row, str, false);
+        } break;
+      }
+    }
+  }
+  pBlock->info.rows = numOfRows;
+  pBlock->info.hasVarCol = true;
+  return pBlock;
+}
+
+void checkUdfBlockEqual(const SUdfDataBlock *expected, const SUdfDataBlock *block) {
+  ASSERT_EQ(block->numOfRows, expected->numOfRows);
+  ASSERT_EQ(block->numOfCols, expected->numOfCols);
+  for (int32_t i = 0; i < expected->numOfCols; ++i) {
+    const SUdfColumn *pExpected = expected->udfCols[i];
+    const SUdfColumn *pCol = block->udfCols[i];
+    EXPECT_EQ(pCol->colMeta.type, pExpected->colMeta.type) << "column " << i;
+    EXPECT_EQ(pCol->colMeta.bytes, pExpected->colMeta.bytes) << "column " << i;
+    EXPECT_EQ(pCol->hasNull, pExpected->hasNull) << "column " << i;
+    ASSERT_EQ(pCol->colData.numOfRows, pExpected->colData.numOfRows) << "column " << i;
+
+    if (IS_VAR_DATA_TYPE(pExpected->colMeta.type)) {
+      const auto *pVar = &pCol->colData.varLenCol;
+      const auto *pExpectedVar = &pExpected->colData.varLenCol;
+      ASSERT_EQ(pVar->varOffsetsLen, pExpectedVar->varOffsetsLen) << "column " << i;
+      EXPECT_EQ(memcmp(pVar->varOffsets, pExpectedVar->varOffsets, pVar->varOffsetsLen), 0) << "column " << i;
+      ASSERT_EQ(pVar->payloadLen, pExpectedVar->payloadLen) << "column " << i;
+      EXPECT_EQ(memcmp(pVar->payload, pExpectedVar->payload, pVar->payloadLen), 0) << "column " << i;
+    } else {
+      const auto *pFix = &pCol->colData.fixLenCol;
+      const auto *pExpectedFix = &pExpected->colData.fixLenCol;
+      ASSERT_EQ(pFix->nullBitmapLen, pExpectedFix->nullBitmapLen) << "column " << i;
+      EXPECT_EQ(memcmp(pFix->nullBitmap, pExpectedFix->nullBitmap, pFix->nullBitmapLen), 0) << "column " << i;
+      ASSERT_EQ(pFix->dataLen, pExpectedFix->dataLen) << "column " << i;
+    }
+
+    // the values are compared row by row, the bytes of null values are not defined
+    for (int32_t row = 0; row < pExpected->colData.numOfRows; ++row) {
+      bool isNull = udfColDataIsNull(pExpected, row);
+      ASSERT_EQ(udfColDataIsNull(pCol, row), isNull) << "column " << i << ", row " << row;
+      if (isNull) {
+        continue;
+      }
+      char *pData = udfColDataGetData(pCol, row);
+      char *pExpectedData = udfColDataGetData(pExpected, row);
+      if (IS_VAR_DATA_TYPE(pExpected->colMeta.type)) {
+        ASSERT_EQ(varDataTLen(pData), varDataTLen(pExpectedData)) << "column " << i << ", row " << row;
+        EXPECT_EQ(memcmp(pData, pExpectedData, varDataTLen(pData)), 0) << "column " << i << ", row " << row;
+      } else {
+        EXPECT_EQ(memcmp(pData, pExpectedData, pExpected->colMeta.bytes), 0) << "column " << i << ", row " << row;
+      }
+    }
+  }
+}
+
+// decode the call from the pipe message, and convert its block as udfd does without the shared memory
+void decodeCallFromPipe(const SUdfCallRequest *call, SUdfRequest *pRequest, SUdfDataBlock *pUdfBlock) {
+  SUdfRequest request = {0};
+  request.type = UDF_TASK_CALL;
+  request.call = *call;
+  request.call.shmLen = 0;
+  int32_t len = encodeUdfRequest(NULL, &request);
+  request.msgLen = len;
+  void *bufBegin = taosMemoryCalloc(1, len);
+  void *buf = bufBegin;
+  encodeUdfRequest(&buf, &request);
+
+  memset(pRequest, 0, sizeof(SUdfRequest));
+  decodeUdfRequest(bufBegin, pRequest);
+  convertDataBlockToUdfDataBlock(&pRequest->call.block, pUdfBlock);
+  taosMemoryFree(bufBegin);
+}
+
+void checkCallInPlace(int8_t callType) {
+  SSDataBlock    *pBlock = createTestBlock();
+  char            interBuf[] = "the intermediate result of the aggregation";
+  SUdfCallRequest call = {0};
+  call.callType = callType;
+  call.block = *pBlock;
+  call.interBuf.buf = interBuf;
+  call.interBuf.bufLen = sizeof(interBuf);
+  call.interBuf.numOfResult = 1;
+
+  SUdfRequest   request = {0};
+  SUdfDataBlock expected = {0};
+  decodeCallFromPipe(&call, &request, &expected);
+
+  // the body is encoded into the shared memory, and decoded without copying the columns
+  int32_t len = encodeUdfCallRequestBody(NULL, &call);
+  void   *shm = taosMemoryCalloc(1, len);
+  void   *buf = shm;
+  ASSERT_EQ(encodeUdfCallRequestBody(&buf, &call), len);
+
+  SUdfCallRequest callInPlace = {0};
+  callInPlace.callType = callType;
+  SUdfDataBlock block = {0};
+  void         *end = decodeUdfCallRequestBodyInPlace(shm, &callInPlace, &block);
+  EXPECT_EQ(POINTER_DISTANCE(end, shm), len);
+  checkUdfBlockEqual(&expected, &block);
+
+  if (callType == TSDB_UDF_CALL_AGG_PROC) {
+    EXPECT_EQ(callInPlace.interBuf.bufLen, request.call.interBuf.bufLen);
+    EXPECT_EQ(callInPlace.interBuf.numOfResult, request.call.interBuf.numOfResult);
+    EXPECT_EQ(memcmp(callInPlace.interBuf.buf, request.call.interBuf.buf, callInPlace.interBuf.bufLen), 0);
+    freeUdfInterBuf(&request.call.interBuf);
+  }
+
+  freeUdfDataBlockInPlace(&block);
+  taosMemoryFree(shm);
+  freeUdfDataDataBlock(&expected);
+  blockDataFreeRes(&request.call.block);
+  blockDataDestroy(pBlock);
+}
+}  // namespace
+
+TEST(udfShmTest, decodeBlockInPlace_scalar) { checkCallInPlace(TSDB_UDF_CALL_SCALA_PROC); }
+
+TEST(udfShmTest, decodeBlockInPlace_agg) { checkCallInPlace(TSDB_UDF_CALL_AGG_PROC); }
+
+TEST(udfShmTest, shmMapExclusive) {
+  char name[64] = {0};
+  snprintf(name, sizeof(name), "/taosudftest.%d", taosGetPId());
+  taosShmUnlink(name);
+
+  void *pShm = NULL;
+  ASSERT_EQ(udfShmMap(name, 4096, true, &pShm), 0);
+  memset(pShm, 0x5A, 4096);
+
+#ifdef LINUX
+  // only the owner can access the object
+  char path[128] = {0};
+  snprintf(path, sizeof(path), "/dev/shm%s", name);
+  struct stat st;
+  ASSERT_EQ(stat(path, &st), 0);
+  EXPECT_EQ(st.st_mode & 0777, 0600);
+#endif
+
+  // an existing object is not taken over by the creator
+  void *pOther = NULL;
+  EXPECT_NE(udfShmMap(name, 4096, true, &pOther), 0);
+
+  // the other side maps the same pages, but not more than the size of the object
+  void *pPeer = NULL;
+  ASSERT_EQ(udfShmMap(name, 4096, false, &pPeer), 0);
+  EXPECT_EQ(((char *)pPeer)[4095], 0x5A);
+  EXPECT_NE(udfShmMap(name, 8192, false, &pOther), 0);
+
+  EXPECT_EQ(taosShmUnlink(name), 0);
+  EXPECT_NE(udfShmMap(name, 4096, false, &pOther), 0);
+  udfShmUnmap(pPeer, 4096);
+  udfShmUnmap(pShm, 4096);
+}
+
+#pragma GCC diagnostic pop
@@ -109,6 +109,51 @@ void idxTRsltDestroy(SIdxTRslt *tr);
 
 void idxTRsltMergeTo(SIdxTRslt *tr, SArray *out);
 
+/*
+ * compressed uid set, uids are grouped by the high 48 bits into containers, each container keeps the low 16 bits
+ * either in a sorted uint16 array or in a 65536-bit bitset once it holds more than IDX_BM_ARRAY_MAX_SIZE values.
+ * child tables created in batch get adjacent uids, so most of them share a few containers.
+ */
+#define IDX_BM_ARRAY_MAX_SIZE 4096
+#define IDX_BM_BITSET_WORDS   1024
+
+typedef struct {
+  uint64_t  key;     // uid >> 16
+  int32_t   num;     // number of values in container
+  int32_t   cap;     // capacity of pArr
+  bool      sorted;  // pArr is sorted and unique
+  uint16_t *pArr;
+  uint64_t *pBits;   // bitset with IDX_BM_BITSET_WORDS words, NULL for array container
+} SIdxBmContainer;
+
+typedef struct {
+  SArray *pConts;  // SArray<SIdxBmContainer>, sorted by key
+  int32_t lastIdx;
+} SIdxBitmap;
+
+SIdxBitmap *idxBitmapCreate();
+
+void idxBitmapDestroy(SIdxBitmap *bm);
+
+int32_t idxBitmapAdd(SIdxBitmap *bm, uint64_t uid);
+
+/* add unsorted uids, duplicate ones are allowed */
+int32_t idxBitmapAddArray(SIdxBitmap *bm, const SArray *uids);
+
+/* dst = dst & src */
+int32_t idxBitmapAnd(SIdxBitmap *dst, SIdxBitmap *src);
+
+/* dst = dst | src */
+int32_t idxBitmapOr(SIdxBitmap *dst, SIdxBitmap *src);
+
+/* dst = dst & ~src */
+int32_t idxBitmapAndNot(SIdxBitmap *dst, SIdxBitmap *src);
+
+int64_t idxBitmapCardinality(SIdxBitmap *bm);
+
+/* append all uids to out in ascending order */
+int32_t idxBitmapToArray(SIdxBitmap *bm, SArray *out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -247,9 +247,9 @@ int indexSearch(SIndex* index, SIndexMultiTermQuery* multiQuerys, SArray* result
     idxTermSearch(index, qterm, &trslt);
     taosArrayPush(iRslts, (void*)&trslt);
   }
-  idxMergeFinalResults(iRslts, opera, result);
+  int32_t code = idxMergeFinalResults(iRslts, opera, result);
   idxInterRsltDestroy(iRslts);
-  return 0;
+  return code;
 }
 
 int indexDelete(SIndex* index, SIndexMultiTermQuery* query) { return 1; }
@@ -458,23 +458,38 @@ static void idxInterRsltDestroy(SArray* results) {
 }
 
 static int idxMergeFinalResults(SArray* in, EIndexOperatorType oType, SArray* out) {
-  // refactor, merge interResults into fResults by oType
-  for (int i = 0; i < taosArrayGetSize(in); i--) {
-    SArray* t = taosArrayGetP(in, i);
-    taosArraySort(t, uidCompare);
-    taosArrayRemoveDuplicate(t, uidCompare, NULL);
-  }
-
-  if (oType == MUST) {
-    iIntersection(in, out);
-  } else if (oType == SHOULD) {
-    iUnion(in, out);
-  } else if (oType == NOT) {
+  if (oType != MUST && oType != SHOULD) {
     // just one column index, enhance later
     // taosArrayAddAll(fResults, interResults);
     // not use currently
+    return 0;
   }
-  return 0;
+
+  // merge interResults into fResults by oType, the uid lists are neither sorted nor unique
+  int32_t     code = 0;
+  SIdxBitmap* bm = NULL;
+  for (int i = 0; i < taosArrayGetSize(in) && code == 0; i++) {
+    SIdxBitmap* t = idxBitmapCreate();
+    if (t == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      break;
+    }
+    code = idxBitmapAddArray(t, taosArrayGetP(in, i));
+    if (code == 0 && bm != NULL) {
+      code = (oType == MUST) ? idxBitmapAnd(bm, t) : idxBitmapOr(bm, t);
+      idxBitmapDestroy(t);
+    } else if (code == 0) {
+      bm = t;
+    } else {
+      idxBitmapDestroy(t);
+    }
+  }
+
+  if (code == 0 && bm != NULL) {
+    code = idxBitmapToArray(bm, out);
+  }
+  idxBitmapDestroy(bm);
+  return code;
 }
 
 static void idxMayMergeTempToFinalRslt(SArray* result, TFileValue* tfv, SIdxTRslt* tr) {
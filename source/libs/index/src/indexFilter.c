@@ -17,6 +17,7 @@
 #include "index.h"
 #include "indexComm.h"
 #include "indexInt.h"
+#include "indexUtil.h"
 #include "nodes.h"
 #include "querynodes.h"
 #include "scalar.h"
@@ -867,17 +868,27 @@ static int32_t sifExecLogic(SLogicConditionNode *node, SIFCtx *ctx, SIFParam *ou
   SIF_ERR_RET(sifInitParamList(&params, node->pParameterList, ctx));
 
   if (ctx->noExec == false) {
+    // the result is coarse, both AND and OR keep the union of all params and leave the rest to the exact filter
+    SIdxBitmap *bm = idxBitmapCreate();
+    if (bm == NULL) {
+      SIF_ERR_JRET(TSDB_CODE_OUT_OF_MEMORY);
+    }
     for (int32_t m = 0; m < node->pParameterList->length; m++) {
-      if (node->condType == LOGIC_COND_TYPE_AND) {
-        taosArrayAddAll(output->result, params[m].result);
-      } else if (node->condType == LOGIC_COND_TYPE_OR) {
-        taosArrayAddAll(output->result, params[m].result);
+      if (node->condType == LOGIC_COND_TYPE_AND || node->condType == LOGIC_COND_TYPE_OR) {
+        code = idxBitmapAddArray(bm, params[m].result);
       } else if (node->condType == LOGIC_COND_TYPE_NOT) {
         // taosArrayAddAll(output->result, params[m].result);
       }
-      taosArraySort(output->result, idxUidCompare);
-      taosArrayRemoveDuplicate(output->result, idxUidCompare, NULL);
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+    }
+    if (code == TSDB_CODE_SUCCESS) {
+      taosArrayClear(output->result);
+      code = idxBitmapToArray(bm, output->result);
     }
+    idxBitmapDestroy(bm);
+    SIF_ERR_JRET(code);
   } else {
     for (int32_t m = 0; m < node->pParameterList->length; m++) {
       output->status = sifMergeCond(node->condType, output->status, params[m].status);
@@ -183,7 +183,7 @@ void idxTRsltDestroy(SIdxTRslt *tr) {
   taosArrayDestroy(tr->del);
   taosMemoryFree(tr);
 }
-void idxTRsltMergeTo(SIdxTRslt *tr, SArray *result) {
+static void idxTRsltMergeToByArray(SIdxTRslt *tr, SArray *result) {
   taosArraySort(tr->total, uidCompare);
   taosArraySort(tr->add, uidCompare);
   taosArraySort(tr->del, uidCompare);
@@ -200,3 +200,499 @@ void idxTRsltMergeTo(SIdxTRslt *tr, SArray *result) {
   }
   iExcept(result, tr->del);
 }
+
+// the result is only replaced after the bitmap merge succeeds, so the fallback array merge starts from it untouched
+void idxTRsltMergeTo(SIdxTRslt *tr, SArray *result) {
+  SIdxBitmap *bm = idxBitmapCreate();
+  SIdxBitmap *del = idxBitmapCreate();
+  SArray     *merged = taosArrayInit(4, sizeof(uint64_t));
+
+  int32_t code = (bm == NULL || del == NULL || merged == NULL) ? TSDB_CODE_OUT_OF_MEMORY : 0;
+  if (code == 0) code = idxBitmapAddArray(bm, result);
+  if (code == 0) code = idxBitmapAddArray(bm, tr->total);
+  if (code == 0) code = idxBitmapAddArray(bm, tr->add);
+  if (code == 0) code = idxBitmapAddArray(del, tr->del);
+  if (code == 0) code = idxBitmapAndNot(bm, del);
+  if (code == 0) code = idxBitmapToArray(bm, merged);
+  if (code == 0) taosArraySwap(result, merged);
+
+  idxBitmapDestroy(bm);
+  idxBitmapDestroy(del);
+  taosArrayDestroy(merged);
+  if (code != 0) {
+    indexWarn("failed to merge index result by bitmap, reason:%s, fallback to array merge", tstrerror(code));
+    idxTRsltMergeToByArray(tr, result);
+  }
+}
+
+static FORCE_INLINE int32_t bmPopcount(uint64_t w) {
+  w = w - ((w >> 1) & 0x5555555555555555ULL);
+  w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+  w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int32_t)((w * 0x0101010101010101ULL) >> 56);
+}
+
+static int32_t bmLowCompare(const void *a, const void *b) {
+  return (int32_t)(*(uint16_t *)a) - (int32_t)(*(uint16_t *)b);
+}
+
+static void bmContDestroy(SIdxBmContainer *c) {
+  taosMemoryFreeClear(c->pArr);
+  taosMemoryFreeClear(c->pBits);
+}
+
+static int32_t bmContCountBits(const uint64_t *pBits) {
+  int32_t num = 0;
+  for (int32_t i = 0; i < IDX_BM_BITSET_WORDS; i++) {
+    num += bmPopcount(pBits[i]);
+  }
+  return num;
+}
+
+static int32_t bmContToBitset(SIdxBmContainer *c) {
+  if (c->pBits != NULL) {
+    return 0;
+  }
+  c->pBits = taosMemoryCalloc(IDX_BM_BITSET_WORDS, sizeof(uint64_t));
+  if (c->pBits == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  for (int32_t i = 0; i < c->num; i++) {
+    c->pBits[c->pArr[i] >> 6] |= (1ULL << (c->pArr[i] & 0x3F));
+  }
+  c->num = bmContCountBits(c->pBits);
+  c->cap = 0;
+  c->sorted = true;
+  taosMemoryFreeClear(c->pArr);
+  return 0;
+}
+
+// turn a sparse bitset back into an array container
+static int32_t bmContShrink(SIdxBmContainer *c) {
+  if (c->pBits == NULL || c->num > IDX_BM_ARRAY_MAX_SIZE) {
+    return 0;
+  }
+  c->cap = TMAX(c->num, 4);
+  c->pArr = taosMemoryMalloc(c->cap * sizeof(uint16_t));
+  if (c->pArr == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  int32_t n = 0;
+  for (int32_t i = 0; i < IDX_BM_BITSET_WORDS; i++) {
+    uint64_t w = c->pBits[i];
+    while (w != 0) {
+      c->pArr[n++] = (uint16_t)((i << 6) + BUILDIN_CTZL(w));
+      w &= (w - 1);
+    }
+  }
+  c->sorted = true;
+  taosMemoryFreeClear(c->pBits);
+  return 0;
+}
+
+static void bmContSort(SIdxBmContainer *c) {
+  if (c->pBits != NULL || c->sorted) {
+    return;
+  }
+  taosSort(c->pArr, c->num, sizeof(uint16_t), bmLowCompare);
+  int32_t n = 0;
+  for (int32_t i = 0; i < c->num; i++) {
+    if (n == 0 || c->pArr[n - 1] != c->pArr[i]) {
+      c->pArr[n++] = c->pArr[i];
+    }
+  }
+  c->num = n;
+  c->sorted = true;
+}
+
+static int32_t bmContAdd(SIdxBmContainer *c, uint16_t low) {
+  if (c->pBits != NULL) {
+    uint64_t mask = 1ULL << (low & 0x3F);
+    if ((c->pBits[low >> 6] & mask) == 0) {
+      c->pBits[low >> 6] |= mask;
+      c->num += 1;
+    }
+    return 0;
+  }
+
+  if (c->num > 0) {
+    if (c->pArr[c->num - 1] == low) {
+      return 0;
+    } else if (c->pArr[c->num - 1] > low) {
+      c->sorted = false;
+    }
+  }
+
+  if (c->num >= c->cap) {
+    if (c->cap >= IDX_BM_ARRAY_MAX_SIZE) {
+      int32_t code = bmContToBitset(c);
+      if (code != 0) {
+        return code;
+      }
+      return bmContAdd(c, low);
+    }
+
+    int32_t   cap = TMIN(TMAX(c->cap * 2, 4), IDX_BM_ARRAY_MAX_SIZE);
+    uint16_t *p = taosMemoryRealloc(c->pArr, cap * sizeof(uint16_t));
+    if (p == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    c->pArr = p;
+    c->cap = cap;
+  }
+  c->pArr[c->num++] = low;
+  return 0;
+}
+
+static bool bmContHas(const SIdxBmContainer *c, uint16_t low) {
+  if (c->pBits != NULL) {
+    return (c->pBits[low >> 6] & (1ULL << (low & 0x3F))) != 0;
+  }
+  int32_t s = 0, e = c->num - 1;
+  while (s <= e) {
+    int32_t m = s + (e - s) / 2;
+    if (c->pArr[m] == low) {
+      return true;
+    } else if (c->pArr[m] < low) {
+      s = m + 1;
+    } else {
+      e = m - 1;
+    }
+  }
+  return false;
+}
+
+static int32_t bmContCopyBits(const SIdxBmContainer *c, SIdxBmContainer *out) {
+  out->pBits = taosMemoryCalloc(IDX_BM_BITSET_WORDS, sizeof(uint64_t));
+  if (out->pBits == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  if (c->pBits != NULL) {
+    memcpy(out->pBits, c->pBits, IDX_BM_BITSET_WORDS * sizeof(uint64_t));
+  } else {
+    for (int32_t i = 0; i < c->num; i++) {
+      out->pBits[c->pArr[i] >> 6] |= (1ULL << (c->pArr[i] & 0x3F));
+    }
+  }
+  out->sorted = true;
+  return 0;
+}
+
+static int32_t bmContAnd(const SIdxBmContainer *a, const SIdxBmContainer *b, SIdxBmContainer *out) {
+  out->key = a->key;
+  if (a->pBits != NULL && b->pBits != NULL) {
+    int32_t code = bmContCopyBits(a, out);
+    if (code != 0) {
+      return code;
+    }
+    for (int32_t i = 0; i < IDX_BM_BITSET_WORDS; i++) {
+      out->pBits[i] &= b->pBits[i];
+    }
+    out->num = bmContCountBits(out->pBits);
+    return bmContShrink(out);
+  }
+
+  // probe the array side against the other one, the output keeps the order of the array
+  const SIdxBmContainer *pArrCont = (a->pBits == NULL) ? a : b;
+  const SIdxBmContainer *pOther = (pArrCont == a) ? b : a;
+  if (pOther->pBits == NULL && pOther->num < pArrCont->num) {
+    TSWAP(pArrCont, pOther);
+  }
+
+  out->cap = TMAX(pArrCont->num, 4);
+  out->pArr = taosMemoryMalloc(out->cap * sizeof(uint16_t));
+  if (out->pArr == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  for (int32_t i = 0; i < pArrCont->num; i++) {
+    if (bmContHas(pOther, pArrCont->pArr[i])) {
+      out->pArr[out->num++] = pArrCont->pArr[i];
+    }
+  }
+  out->sorted = true;
+  return 0;
+}
+
+static int32_t bmContOr(const SIdxBmContainer *a, const SIdxBmContainer *b, SIdxBmContainer *out) {
+  out->key = a->key;
+  if (a->pBits == NULL && b->pBits == NULL && a->num + b->num <= IDX_BM_ARRAY_MAX_SIZE) {
+    out->cap = TMAX(a->num + b->num, 4);
+    out->pArr = taosMemoryMalloc(out->cap * sizeof(uint16_t));
+    if (out->pArr == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    int32_t i = 0, j = 0;
+    while (i < a->num || j < b->num) {
+      uint16_t v;
+      if (j >= b->num || (i < a->num && a->pArr[i] < b->pArr[j])) {
+        v = a->pArr[i++];
+      } else if (i >= a->num || b->pArr[j] < a->pArr[i]) {
+        v = b->pArr[j++];
+      } else {
+        v = a->pArr[i++];
+        j++;
+      }
+      out->pArr[out->num++] = v;
+    }
+    out->sorted = true;
+    return 0;
+  }
+
+  int32_t code = bmContCopyBits(a, out);
+  if (code != 0) {
+    return code;
+  }
+  if (b->pBits != NULL) {
+    for (int32_t i = 0; i < IDX_BM_BITSET_WORDS; i++) {
+      out->pBits[i] |= b->pBits[i];
+    }
+  } else {
+    for (int32_t i = 0; i < b->num; i++) {
+      out->pBits[b->pArr[i] >> 6] |= (1ULL << (b->pArr[i] & 0x3F));
+    }
+  }
+  out->num = bmContCountBits(out->pBits);
+  return bmContShrink(out);
+}
+
+static int32_t bmContAndNot(const SIdxBmContainer *a, const SIdxBmContainer *b, SIdxBmContainer *out) {
+  out->key = a->key;
+  if (a->pBits == NULL) {
+    out->cap = TMAX(a->num, 4);
+    out->pArr = taosMemoryMalloc(out->cap * sizeof(uint16_t));
+    if (out->pArr == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    for (int32_t i = 0; i < a->num; i++) {
+      if (!bmContHas(b, a->pArr[i])) {
+        out->pArr[out->num++] = a->pArr[i];
+      }
+    }
+    out->sorted = true;
+    return 0;
+  }
+
+  int32_t code = bmContCopyBits(a, out);
+  if (code != 0) {
+    return code;
+  }
+  if (b->pBits != NULL) {
+    for (int32_t i = 0; i < IDX_BM_BITSET_WORDS; i++) {
+      out->pBits[i] &= ~b->pBits[i];
+    }
+  } else {
+    for (int32_t i = 0; i < b->num; i++) {
+      out->pBits[b->pArr[i] >> 6] &= ~(1ULL << (b->pArr[i] & 0x3F));
+    }
+  }
+  out->num = bmContCountBits(out->pBits);
+  return bmContShrink(out);
+}
+
+static int32_t bmContClone(const SIdxBmContainer *c, SIdxBmContainer *out) {
+  *out = *c;
+  out->pArr = NULL;
+  out->pBits = NULL;
+  if (c->pBits != NULL) {
+    return bmContCopyBits(c, out);
+  }
+  out->cap = TMAX(c->num, 4);
+  out->pArr = taosMemoryMalloc(out->cap * sizeof(uint16_t));
+  if (out->pArr == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  memcpy(out->pArr, c->pArr, c->num * sizeof(uint16_t));
+  return 0;
+}
+
+static void bmDestroyConts(SArray *pConts) {
+  for (int32_t i = 0; i < taosArrayGetSize(pConts); i++) {
+    bmContDestroy(taosArrayGet(pConts, i));
+  }
+  taosArrayDestroy(pConts);
+}
+
+static void bmNormalize(SIdxBitmap *bm) {
+  for (int32_t i = 0; i < taosArrayGetSize(bm->pConts); i++) {
+    bmContSort(taosArrayGet(bm->pConts, i));
+  }
+}
+
+static SIdxBmContainer *bmGetCont(SIdxBitmap *bm, uint64_t key) {
+  int32_t n = (int32_t)taosArrayGetSize(bm->pConts);
+  if (bm->lastIdx < n) {
+    SIdxBmContainer *c = taosArrayGet(bm->pConts, bm->lastIdx);
+    if (c->key == key) {
+      return c;
+    }
+  }
+
+  int32_t s = 0, e = n - 1;
+  if (n > 0 && ((SIdxBmContainer *)taosArrayGet(bm->pConts, n - 1))->key < key) {
+    s = n;  // appended in ascending order, the common case
+  }
+  while (s <= e) {
+    int32_t          m = s + (e - s) / 2;
+    SIdxBmContainer *c = taosArrayGet(bm->pConts, m);
+    if (c->key == key) {
+      bm->lastIdx = m;
+      return c;
+    } else if (c->key < key) {
+      s = m + 1;
+    } else {
+      e = m - 1;
+    }
+  }
+
+  SIdxBmContainer nc = {.key = key, .sorted = true};
+  if (taosArrayInsert(bm->pConts, s, &nc) == NULL) {
+    return NULL;
+  }
+  bm->lastIdx = s;
+  return taosArrayGet(bm->pConts, s);
+}
+
+SIdxBitmap *idxBitmapCreate() {
+  SIdxBitmap *bm = taosMemoryCalloc(1, sizeof(SIdxBitmap));
+  if (bm == NULL) {
+    return NULL;
+  }
+  bm->pConts = taosArrayInit(4, sizeof(SIdxBmContainer));
+  if (bm->pConts == NULL) {
+    taosMemoryFree(bm);
+    return NULL;
+  }
+  return bm;
+}
+
+void idxBitmapDestroy(SIdxBitmap *bm) {
+  if (bm == NULL) {
+    return;
+  }
+  bmDestroyConts(bm->pConts);
+  taosMemoryFree(bm);
+}
+
+int32_t idxBitmapAdd(SIdxBitmap *bm, uint64_t uid) {
+  SIdxBmContainer *c = bmGetCont(bm, uid >> 16);
+  if (c == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  return bmContAdd(c, (uint16_t)(uid & 0xFFFF));
+}
+
+int32_t idxBitmapAddArray(SIdxBitmap *bm, const SArray *uids) {
+  for (int32_t i = 0; i < taosArrayGetSize(uids); i++) {
+    int32_t code = idxBitmapAdd(bm, *(uint64_t *)taosArrayGet(uids, i));
+    if (code != 0) {
+      return code;
+    }
+  }
+  return 0;
+}
+
+typedef int32_t (*bm_cont_fn_t)(const SIdxBmContainer *a, const SIdxBmContainer *b, SIdxBmContainer *out);
+
+/*
+ * merge the containers of dst and src with the same key by fn, containers that only exist in dst are kept when
+ * keepDst is true, and the ones only in src are copied when keepSrc is true
+ */
+static int32_t bmMerge(SIdxBitmap *dst, SIdxBitmap *src, bm_cont_fn_t fn, bool keepDst, bool keepSrc) {
+  bmNormalize(dst);
+  bmNormalize(src);
+
+  int32_t dn = (int32_t)taosArrayGetSize(dst->pConts);
+  int32_t sn = (int32_t)taosArrayGetSize(src->pConts);
+  SArray *pConts = taosArrayInit(TMAX(dn, 4), sizeof(SIdxBmContainer));
+  if (pConts == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t code = 0;
+  int32_t i = 0, j = 0;
+  while (i < dn || j < sn) {
+    SIdxBmContainer *d = (i < dn) ? taosArrayGet(dst->pConts, i) : NULL;
+    SIdxBmContainer *s = (j < sn) ? taosArrayGet(src->pConts, j) : NULL;
+    SIdxBmContainer  out = {0};
+
+    if (s == NULL || (d != NULL && d->key < s->key)) {
+      if (keepDst) {
+        out = *d;
+        memset(d, 0, sizeof(SIdxBmContainer));
+      }
+      i++;
+    } else if (d == NULL || s->key < d->key) {
+      if (keepSrc) {
+        code = bmContClone(s, &out);
+      }
+      j++;
+    } else {
+      code = fn(d, s, &out);
+      i++;
+      j++;
+    }
+
+    if (code != 0) {
+      bmContDestroy(&out);
+      break;
+    }
+    if (out.num > 0) {
+      taosArrayPush(pConts, &out);
+    } else {
+      bmContDestroy(&out);
+    }
+  }
+
+  if (code != 0) {
+    bmDestroyConts(pConts);
+    return code;
+  }
+
+  bmDestroyConts(dst->pConts);
+  dst->pConts = pConts;
+  dst->lastIdx = 0;
+  return 0;
+}
+
+int32_t idxBitmapAnd(SIdxBitmap *dst, SIdxBitmap *src) { return bmMerge(dst, src, bmContAnd, false, false); }
+
+int32_t idxBitmapOr(SIdxBitmap *dst, SIdxBitmap *src) { return bmMerge(dst, src, bmContOr, true, true); }
+
+int32_t idxBitmapAndNot(SIdxBitmap *dst, SIdxBitmap *src) { return bmMerge(dst, src, bmContAndNot, true, false); }
+
+int64_t idxBitmapCardinality(SIdxBitmap *bm) {
+  bmNormalize(bm);
+  int64_t num = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(bm->pConts); i++) {
+    num += ((SIdxBmContainer *)taosArrayGet(bm->pConts, i))->num;
+  }
+  return num;
+}
+
+int32_t idxBitmapToArray(SIdxBitmap *bm, SArray *out) {
+  if (taosArrayEnsureCap(out, taosArrayGetSize(out) + idxBitmapCardinality(bm)) != 0) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(bm->pConts); i++) {
+    SIdxBmContainer *c = taosArrayGet(bm->pConts, i);
+    uint64_t         high = c->key << 16;
+    if (c->pBits == NULL) {
+      for (int32_t k = 0; k < c->num; k++) {
+        uint64_t uid = high | c->pArr[k];
+        taosArrayPush(out, &uid);
+      }
+      continue;
+    }
+
+    for (int32_t k = 0; k < IDX_BM_BITSET_WORDS; k++) {
+      uint64_t w = c->pBits[k];
+      while (w != 0) {
+        uint64_t uid = high | (uint64_t)((k << 6) + BUILDIN_CTZL(w));
+        taosArrayPush(out, &uid);
+        w &= (w - 1);
+      }
+    }
+  }
+  return 0;
+}
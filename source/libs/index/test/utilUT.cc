@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <iostream>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -365,3 +366,127 @@ TEST_F(UtilEnv, testDictComm) {
     EXPECT_EQ(COMMON_INPUTS[v], i);
   }
 }
+
+static SArray *genBitmapUids(std::vector<uint64_t> &vals) {
+  SArray *arr = taosArrayInit(vals.size(), sizeof(uint64_t));
+  for (size_t i = 0; i < vals.size(); i++) {
+    taosArrayPush(arr, &vals[i]);
+  }
+  return arr;
+}
+static void checkBitmapResult(SIdxBitmap *bm, std::set<uint64_t> &expect) {
+  SArray *out = taosArrayInit(8, sizeof(uint64_t));
+  idxBitmapToArray(bm, out);
+  EXPECT_EQ(taosArrayGetSize(out), expect.size());
+  EXPECT_EQ(idxBitmapCardinality(bm), (int64_t)expect.size());
+
+  int i = 0;
+  for (auto v : expect) {
+    EXPECT_EQ(*(uint64_t *)taosArrayGet(out, i), v);
+    i++;
+  }
+  taosArrayDestroy(out);
+}
+TEST_F(UtilEnv, bitmapMerge) {
+  // uids created in batch share the high bits, mix dense and sparse containers
+  std::vector<uint64_t> v1, v2;
+  std::set<uint64_t>    s1, s2;
+  uint64_t              base = (0x123ULL << 52) | (0x2ULL << 48);
+  for (int i = 0; i < 200000; i++) {
+    uint64_t u = base | (taosRand() % 300000);
+    v1.push_back(u);
+    s1.insert(u);
+  }
+  for (int i = 0; i < 3000; i++) {
+    uint64_t u = base | (taosRand() % 300000);
+    v2.push_back(u);
+    s2.insert(u);
+    u = (0x7ULL << 52) | (uint64_t)taosRand();
+    v2.push_back(u);
+    s2.insert(u);
+  }
+  SArray *a1 = genBitmapUids(v1);
+  SArray *a2 = genBitmapUids(v2);
+
+  std::set<uint64_t> expect;
+  SIdxBitmap        *b1 = idxBitmapCreate();
+  SIdxBitmap        *b2 = idxBitmapCreate();
+  idxBitmapAddArray(b1, a1);
+  idxBitmapAddArray(b2, a2);
+  checkBitmapResult(b1, s1);
+  checkBitmapResult(b2, s2);
+
+  std::set_intersection(s1.begin(), s1.end(), s2.begin(), s2.end(), std::inserter(expect, expect.begin()));
+  EXPECT_EQ(idxBitmapAnd(b1, b2), 0);
+  checkBitmapResult(b1, expect);
+
+  expect.clear();
+  idxBitmapDestroy(b1);
+  b1 = idxBitmapCreate();
+  idxBitmapAddArray(b1, a1);
+  std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(), std::inserter(expect, expect.begin()));
+  EXPECT_EQ(idxBitmapOr(b1, b2), 0);
+  checkBitmapResult(b1, expect);
+
+  expect.clear();
+  idxBitmapDestroy(b1);
+  b1 = idxBitmapCreate();
+  idxBitmapAddArray(b1, a1);
+  std::set_difference(s1.begin(), s1.end(), s2.begin(), s2.end(), std::inserter(expect, expect.begin()));
+  EXPECT_EQ(idxBitmapAndNot(b1, b2), 0);
+  checkBitmapResult(b1, expect);
+
+  idxBitmapDestroy(b1);
+  idxBitmapDestroy(b2);
+  taosArrayDestroy(a1);
+  taosArrayDestroy(a2);
+}
+TEST_F(UtilEnv, TempResultMergeDel) {
+  SIdxTRslt *relt = idxTRsltCreate();
+  SArray    *f = taosArrayInit(0, sizeof(uint64_t));
+
+  uint64_t vals[] = {9, 3, 3, 7, 1};
+  for (int i = 0; i < 5; i++) {
+    taosArrayPush(relt->total, &vals[i]);
+  }
+  uint64_t val = 5;
+  taosArrayPush(relt->add, &val);
+  val = 7;
+  taosArrayPush(relt->del, &val);
+  idxTRsltMergeTo(relt, f);
+
+  uint64_t expect[] = {1, 3, 5, 9};
+  EXPECT_EQ(taosArrayGetSize(f), 4);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(*(uint64_t *)taosArrayGet(f, i), expect[i]);
+  }
+  taosArrayDestroy(f);
+  idxTRsltDestroy(relt);
+}
+TEST_F(UtilEnv, TempResultMergeToNonEmpty) {
+  SIdxTRslt *relt = idxTRsltCreate();
+  SArray    *f = taosArrayInit(0, sizeof(uint64_t));
+
+  // the uids already in the result are kept, unless they are deleted
+  uint64_t olds[] = {2, 4, 8};
+  for (int i = 0; i < 3; i++) {
+    taosArrayPush(f, &olds[i]);
+  }
+  uint64_t vals[] = {9, 3, 1};
+  for (int i = 0; i < 3; i++) {
+    taosArrayPush(relt->total, &vals[i]);
+  }
+  uint64_t val = 5;
+  taosArrayPush(relt->add, &val);
+  val = 4;
+  taosArrayPush(relt->del, &val);
+  idxTRsltMergeTo(relt, f);
+
+  uint64_t expect[] = {1, 2, 3, 5, 8, 9};
+  EXPECT_EQ(taosArrayGetSize(f), 6);
+  for (int i = 0; i < 6; i++) {
+    EXPECT_EQ(*(uint64_t *)taosArrayGet(f, i), expect[i]);
+  }
+  taosArrayDestroy(f);
+  idxTRsltDestroy(relt);
+}
@@ -610,7 +610,48 @@ static int32_t stbSplCreateMergeKeysByPrimaryKey(SNode* pPrimaryKey, EOrder orde
   return nodesListMakeStrictAppend(pMergeKeys, (SNode*)pMergeKey);
 }
 
+static bool stbSplNeedSeqRecvData(SLogicNode* pNode) {
+  if (NULL == pNode) {
+    return false;
+  }
+
+  if (NULL != pNode->pLimit || NULL != pNode->pSlimit) {
+    return true;
+  }
+  return stbSplNeedSeqRecvData(pNode->pParent);
+}
+
+// Each vnode has already merged the partial states of all its child tables into one row per window, so the merge
+// stage can combine the rows by window start in a hash table instead of sort-merging all vgroup streams first. Only
+// tumbling windows qualify, since the partial row of a sliding window must not be spread to its neighbours, and a
+// limit above the window still prefers the sorted merge because it can stop early.
+static bool stbSplIsHashMergeInterval(SWindowLogicNode* pWindow) {
+  return pWindow->interval == pWindow->sliding && pWindow->intervalUnit == pWindow->slidingUnit &&
+         !stbSplNeedSeqRecvData((SLogicNode*)pWindow);
+}
+
+static int32_t stbSplSplitIntervalForBatchByHash(SSplitContext* pCxt, SStableSplitInfo* pInfo) {
+  SLogicNode* pPartWindow = NULL;
+  int32_t     code = stbSplCreatePartWindowNode((SWindowLogicNode*)pInfo->pSplitNode, &pPartWindow);
+  if (TSDB_CODE_SUCCESS == code) {
+    ((SWindowLogicNode*)pPartWindow)->windowAlgo = INTERVAL_ALGO_HASH;
+    ((SWindowLogicNode*)pInfo->pSplitNode)->windowAlgo = INTERVAL_ALGO_HASH;
+    code = stbSplCreateExchangeNode(pCxt, pInfo->pSplitNode, pPartWindow);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = nodesListMakeStrictAppend(&pInfo->pSubplan->pChildren,
+                                     (SNode*)splCreateScanSubplan(pCxt, pPartWindow, SPLIT_FLAG_STABLE_SPLIT));
+  }
+  pInfo->pSubplan->subplanType = SUBPLAN_TYPE_MERGE;
+  ++(pCxt->groupId);
+  return code;
+}
+
 static int32_t stbSplSplitIntervalForBatch(SSplitContext* pCxt, SStableSplitInfo* pInfo) {
+  if (stbSplIsHashMergeInterval((SWindowLogicNode*)pInfo->pSplitNode)) {
+    return stbSplSplitIntervalForBatchByHash(pCxt, pInfo);
+  }
+
   SLogicNode* pPartWindow = NULL;
   int32_t     code = stbSplCreatePartWindowNode((SWindowLogicNode*)pInfo->pSplitNode, &pPartWindow);
   if (TSDB_CODE_SUCCESS == code) {
@@ -780,17 +821,6 @@ static int32_t stbSplSplitWindowForCrossTable(SSplitContext* pCxt, SStableSplitI
   return TSDB_CODE_PLAN_INTERNAL_ERROR;
 }
 
-static bool stbSplNeedSeqRecvData(SLogicNode* pNode) {
-  if (NULL == pNode) {
-    return false;
-  }
-
-  if (NULL != pNode->pLimit || NULL != pNode->pSlimit) {
-    return true;
-  }
-  return stbSplNeedSeqRecvData(pNode->pParent);
-}
-
 static int32_t stbSplSplitWindowForPartTable(SSplitContext* pCxt, SStableSplitInfo* pInfo) {
   if (pCxt->pPlanCxt->streamQuery) {
     SPLIT_FLAG_SET_MASK(pInfo->pSubplan->splitFlag, SPLIT_FLAG_STABLE_SPLIT);
@@ -77,4 +77,10 @@ TEST_F(PlanIntervalTest, stable) {
   run("SELECT _WSTART, COUNT(*) FROM st1 PARTITION BY TBNAME INTERVAL(10s)");
 
   run("SELECT TBNAME, COUNT(*) FROM st1 PARTITION BY TBNAME INTERVAL(10s)");
+
+  run("SELECT _WSTART, AVG(c1) FROM st1 INTERVAL(10s) SLIDING(5s)");
+
+  run("SELECT _WSTART, AVG(c1) FROM st1 INTERVAL(10s) LIMIT 10");
+
+  run("SELECT _WSTART, AVG(c1) FROM st1 PARTITION BY tag1 INTERVAL(10s)");
 }
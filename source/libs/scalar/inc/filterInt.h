@@ -231,6 +231,7 @@ typedef struct SFltTreeStat {
 typedef struct SFltScalarCtx {
   SNode *node;
   SArray* fltSclRange;
+  bool    fullRange;  // the column ranges are equivalent to the whole condition, not only implied by it
 } SFltScalarCtx;
 
 typedef struct SFltBuildGroupCtx {
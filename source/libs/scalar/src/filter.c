@@ -3902,6 +3902,67 @@ bool filterRangeExecute(SFilterInfo *info, SColumnDataAgg **pDataStatis, int32_t
   return ret;
 }
 
+static bool fltSclRangeCoverBlockSma(SFltSclColumnRange *colRange, SColumnDataAgg *pAgg, int32_t numOfRows) {
+  // null values never satisfy a comparison
+  if (pAgg->numOfNull > 0) {
+    return false;
+  }
+
+  SArray *points = taosArrayInit(2, sizeof(SFltSclPoint));
+  SArray *merged = taosArrayInit(4, sizeof(SFltSclPoint));
+  fltSclBuildRangeFromBlockSma(colRange, pAgg, numOfRows, points);
+  fltSclIntersect(points, colRange->points, merged);
+
+  // the block range is covered only if the intersection is the block range itself
+  bool cover = false;
+  if (taosArrayGetSize(points) == 2 && taosArrayGetSize(merged) == 2) {
+    SFltSclPoint *pMin = taosArrayGet(points, 0);
+    SFltSclPoint *pMax = taosArrayGet(points, 1);
+    SFltSclPoint *pStart = taosArrayGet(merged, 0);
+    SFltSclPoint *pEnd = taosArrayGet(merged, 1);
+    cover = !pStart->excl && !pEnd->excl && fltSclCompareDatum(&pStart->val, &pMin->val) == 0 &&
+            fltSclCompareDatum(&pEnd->val, &pMax->val) == 0;
+  }
+
+  taosArrayDestroy(merged);
+  taosArrayDestroy(points);
+  return cover;
+}
+
+int32_t filterRangeClassify(SFilterInfo *info, SColumnDataAgg **pDataStatis, int32_t numOfCols, int32_t numOfRows) {
+  if (!filterRangeExecute(info, pDataStatis, numOfCols, numOfRows)) {
+    return FILTER_RESULT_NONE_QUALIFIED;
+  }
+
+  if (!info->sclCtx.fullRange) {
+    return FILTER_RESULT_PARTIAL_QUALIFIED;
+  }
+
+  SArray *colRanges = info->sclCtx.fltSclRange;
+  int32_t numOfRanges = taosArrayGetSize(colRanges);
+  if (numOfRanges == 0) {
+    return FILTER_RESULT_PARTIAL_QUALIFIED;
+  }
+
+  for (int32_t i = 0; i < numOfRanges; ++i) {
+    SFltSclColumnRange *colRange = taosArrayGet(colRanges, i);
+    SColumnDataAgg     *pAgg = NULL;
+    for (int32_t j = 0; j < numOfCols; ++j) {
+      if (pDataStatis[j] != NULL && pDataStatis[j]->colId == colRange->colNode->colId) {
+        pAgg = pDataStatis[j];
+        break;
+      }
+    }
+
+    if (pAgg == NULL || !fltSclRangeCoverBlockSma(colRange, pAgg, numOfRows)) {
+      return FILTER_RESULT_PARTIAL_QUALIFIED;
+    }
+  }
+
+  qDebug("filter range classify, all rows of block qualified by block sma, rows %d", numOfRows);
+  return FILTER_RESULT_ALL_QUALIFIED;
+}
+
 int32_t filterGetTimeRangeImpl(SFilterInfo *info, STimeWindow *win, bool *isStrict) {
   SFilterRange     ra = {0};
   SFilterRangeCtx *prev = filterInitRangeCtx(TSDB_DATA_TYPE_TIMESTAMP, FLT_OPTION_TIMESTAMP);
@@ -4571,6 +4632,75 @@ static int32_t fltSclCollectOperatorsFromLogicCond(SNode *pNode, SArray *sclOpLi
   return TSDB_CODE_SUCCESS;
 }
 
+// the row filter out of scalar mode casts the constant to the column type, which is exact only if the type holds it
+static bool fltSclIsValueInColumnType(uint8_t colType, SValueNode *pVal) {
+  uint8_t valType = pVal->node.resType.type;
+  if (!IS_INTEGER_TYPE(colType) || !IS_INTEGER_TYPE(valType)) {
+    return true;
+  }
+
+  if (IS_UNSIGNED_NUMERIC_TYPE(valType) && pVal->datum.u > INT64_MAX) {
+    return colType == TSDB_DATA_TYPE_UBIGINT;
+  }
+
+  int64_t v = IS_UNSIGNED_NUMERIC_TYPE(valType) ? (int64_t)pVal->datum.u : pVal->datum.i;
+  switch (colType) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return IS_VALID_TINYINT(v);
+    case TSDB_DATA_TYPE_SMALLINT:
+      return IS_VALID_SMALLINT(v);
+    case TSDB_DATA_TYPE_INT:
+      return IS_VALID_INT(v);
+    case TSDB_DATA_TYPE_UTINYINT:
+      return IS_VALID_UTINYINT(v);
+    case TSDB_DATA_TYPE_USMALLINT:
+      return IS_VALID_USMALLINT(v);
+    case TSDB_DATA_TYPE_UINT:
+      return IS_VALID_UINT(v);
+    case TSDB_DATA_TYPE_UBIGINT:
+      return v >= 0;
+    default:
+      return true;
+  }
+}
+
+static bool fltSclIsFullRangeNode(SNode *pNode) {
+  if (!fltSclIsCollectableNode(pNode)) {
+    return false;
+  }
+
+  SOperatorNode *pOper = (SOperatorNode *)pNode;
+  uint8_t        colType = ((SColumnNode *)pOper->pLeft)->node.resType.type;
+  uint8_t        valType = ((SValueNode *)pOper->pRight)->node.resType.type;
+
+  // float values are compared in single precision by the row filter, so the double range may disagree at the edge
+  if (colType == TSDB_DATA_TYPE_FLOAT || valType == TSDB_DATA_TYPE_FLOAT) {
+    return false;
+  }
+  return (IS_NUMERIC_TYPE(colType) || colType == TSDB_DATA_TYPE_TIMESTAMP) &&
+         (IS_NUMERIC_TYPE(valType) || valType == TSDB_DATA_TYPE_TIMESTAMP) &&
+         fltSclIsValueInColumnType(colType, (SValueNode *)pOper->pRight);
+}
+
+static bool fltSclIsFullRange(SNode *pNode) {
+  if (nodeType(pNode) == QUERY_NODE_OPERATOR) {
+    return fltSclIsFullRangeNode(pNode);
+  }
+
+  if (nodeType(pNode) != QUERY_NODE_LOGIC_CONDITION ||
+      ((SLogicConditionNode *)pNode)->condType != LOGIC_COND_TYPE_AND) {
+    return false;
+  }
+
+  SNode *pExpr = NULL;
+  FOREACH(pExpr, ((SLogicConditionNode *)pNode)->pParameterList) {
+    if (!fltSclIsFullRangeNode(pExpr)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 static int32_t fltSclCollectOperators(SNode *pNode, SArray *sclOpList) {
   if (nodeType(pNode) == QUERY_NODE_OPERATOR) {
     fltSclCollectOperatorFromNode(pNode, sclOpList);
@@ -4586,6 +4716,7 @@ int32_t fltOptimizeNodes(SFilterInfo *pInfo, SNode **pNode, SFltTreeStat *pStat)
   SArray *colRangeList = taosArrayInit(16, sizeof(SFltSclColumnRange));
   fltSclProcessCNF(sclOpList, colRangeList);
   pInfo->sclCtx.fltSclRange = colRangeList;
+  pInfo->sclCtx.fullRange = fltSclIsFullRange(*pNode);
 
   for (int32_t i = 0; i < taosArrayGetSize(sclOpList); ++i) {
     SFltSclOperator *sclOp = taosArrayGet(sclOpList, i);
@@ -4674,6 +4805,8 @@ int32_t filterInitFromNode(SNode *pNode, SFilterInfo **pInfo, uint32_t options)
   fltDebug("scalar mode: %d", info->scalarMode);
 
   if (!info->scalarMode) {
+    // only the column ranges are kept, for filterRangeClassify to find the blocks whose rows all qualify
+    FLT_ERR_JRET(fltOptimizeNodes(info, &pNode, &stat));
     FLT_ERR_JRET(fltInitFromNode(pNode, info, options));
   } else {
     info->sclCtx.node = pNode;
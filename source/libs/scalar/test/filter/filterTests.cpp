@@ -345,6 +345,169 @@ TEST(timerangeTest, greater_and_lower_not_strict) {
   nodesDestroyNode(logicNode1);
 }
 
+TEST(rangeClassifyTest, int_column_greater_and_lower_equal) {
+  SNode  *pLeft1 = NULL, *pRight1 = NULL, *pLeft2 = NULL, *pRight2 = NULL, *opNode1 = NULL, *opNode2 = NULL;
+  SNode  *logicNode = NULL;
+  int32_t lowv = 0, highv = 100;
+
+  bool scalarMode = tsFilterScalarMode;
+  tsFilterScalarMode = true;
+
+  flttMakeColumnNode(&pLeft1, NULL, TSDB_DATA_TYPE_INT, sizeof(int32_t), 0, NULL);
+  flttMakeValueNode(&pRight1, TSDB_DATA_TYPE_INT, &lowv);
+  ((SValueNode *)pRight1)->datum.i = lowv;
+  ((SValueNode *)pRight1)->translate = true;
+  flttMakeOpNode(&opNode1, OP_TYPE_GREATER_THAN, TSDB_DATA_TYPE_BOOL, pLeft1, pRight1);
+  flttMakeColumnNode(&pLeft2, NULL, TSDB_DATA_TYPE_INT, sizeof(int32_t), 0, NULL);
+  flttMakeValueNode(&pRight2, TSDB_DATA_TYPE_INT, &highv);
+  ((SValueNode *)pRight2)->datum.i = highv;
+  ((SValueNode *)pRight2)->translate = true;
+  flttMakeOpNode(&opNode2, OP_TYPE_LOWER_EQUAL, TSDB_DATA_TYPE_BOOL, pLeft2, pRight2);
+
+  SNodeList *list = nodesMakeList();
+  nodesListAppend(list, opNode1);
+  nodesListAppend(list, opNode2);
+  flttMakeLogicNodeFromList(&logicNode, LOGIC_COND_TYPE_AND, list);
+
+  SFilterInfo *filter = NULL;
+  int32_t      code = filterInitFromNode(logicNode, &filter, 0);
+  ASSERT_EQ(code, 0);
+
+  int32_t         rowNum = 10;
+  SColumnDataAgg  stat = {0};
+  SColumnDataAgg *pStat = &stat;
+  stat.colId = ((SColumnNode *)pLeft1)->colId;
+
+  stat.min = 1;
+  stat.max = 100;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, rowNum), FILTER_RESULT_ALL_QUALIFIED);
+
+  stat.min = 0;
+  stat.max = 50;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, rowNum), FILTER_RESULT_PARTIAL_QUALIFIED);
+
+  stat.min = 50;
+  stat.max = 101;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, rowNum), FILTER_RESULT_PARTIAL_QUALIFIED);
+
+  stat.min = -10;
+  stat.max = 0;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, rowNum), FILTER_RESULT_NONE_QUALIFIED);
+
+  // null values never qualify
+  stat.min = 1;
+  stat.max = 100;
+  stat.numOfNull = 1;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, rowNum), FILTER_RESULT_PARTIAL_QUALIFIED);
+
+  // no sma info of the filter column
+  stat.numOfNull = 0;
+  stat.colId = ((SColumnNode *)pLeft1)->colId + 1;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, rowNum), FILTER_RESULT_PARTIAL_QUALIFIED);
+
+  filterFreeInfo(filter);
+  nodesDestroyNode(logicNode);
+  tsFilterScalarMode = scalarMode;
+}
+
+TEST(rangeClassifyTest, int_column_greater_or_equal) {
+  SNode  *pLeft1 = NULL, *pRight1 = NULL, *pLeft2 = NULL, *pRight2 = NULL, *opNode1 = NULL, *opNode2 = NULL;
+  SNode  *logicNode = NULL;
+  int32_t lowv = 0, eqv = -5;
+
+  bool scalarMode = tsFilterScalarMode;
+  tsFilterScalarMode = true;
+
+  flttMakeColumnNode(&pLeft1, NULL, TSDB_DATA_TYPE_INT, sizeof(int32_t), 0, NULL);
+  flttMakeValueNode(&pRight1, TSDB_DATA_TYPE_INT, &lowv);
+  ((SValueNode *)pRight1)->datum.i = lowv;
+  ((SValueNode *)pRight1)->translate = true;
+  flttMakeOpNode(&opNode1, OP_TYPE_GREATER_THAN, TSDB_DATA_TYPE_BOOL, pLeft1, pRight1);
+  flttMakeColumnNode(&pLeft2, NULL, TSDB_DATA_TYPE_INT, sizeof(int32_t), 0, NULL);
+  flttMakeValueNode(&pRight2, TSDB_DATA_TYPE_INT, &eqv);
+  ((SValueNode *)pRight2)->datum.i = eqv;
+  ((SValueNode *)pRight2)->translate = true;
+  flttMakeOpNode(&opNode2, OP_TYPE_EQUAL, TSDB_DATA_TYPE_BOOL, pLeft2, pRight2);
+
+  SNodeList *list = nodesMakeList();
+  nodesListAppend(list, opNode1);
+  nodesListAppend(list, opNode2);
+  flttMakeLogicNodeFromList(&logicNode, LOGIC_COND_TYPE_OR, list);
+
+  SFilterInfo *filter = NULL;
+  int32_t      code = filterInitFromNode(logicNode, &filter, 0);
+  ASSERT_EQ(code, 0);
+
+  // the column range is not collected from OR conditions, so no block can be proved fully qualified
+  SColumnDataAgg  stat = {0};
+  SColumnDataAgg *pStat = &stat;
+  stat.colId = ((SColumnNode *)pLeft1)->colId;
+  stat.min = 1;
+  stat.max = 100;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, 10), FILTER_RESULT_PARTIAL_QUALIFIED);
+
+  filterFreeInfo(filter);
+  nodesDestroyNode(logicNode);
+  tsFilterScalarMode = scalarMode;
+}
+
+TEST(rangeClassifyTest, int_column_without_scalar_mode) {
+  SNode  *pLeft1 = NULL, *pRight1 = NULL, *pLeft2 = NULL, *pRight2 = NULL, *opNode1 = NULL, *opNode2 = NULL;
+  SNode  *logicNode = NULL;
+  int32_t lowv = 0, highv = 100;
+
+  bool scalarMode = tsFilterScalarMode;
+  tsFilterScalarMode = false;
+
+  flttMakeColumnNode(&pLeft1, NULL, TSDB_DATA_TYPE_INT, sizeof(int32_t), 0, NULL);
+  flttMakeValueNode(&pRight1, TSDB_DATA_TYPE_INT, &lowv);
+  ((SValueNode *)pRight1)->datum.i = lowv;
+  ((SValueNode *)pRight1)->translate = true;
+  flttMakeOpNode(&opNode1, OP_TYPE_GREATER_THAN, TSDB_DATA_TYPE_BOOL, pLeft1, pRight1);
+  flttMakeColumnNode(&pLeft2, NULL, TSDB_DATA_TYPE_INT, sizeof(int32_t), 0, NULL);
+  flttMakeValueNode(&pRight2, TSDB_DATA_TYPE_INT, &highv);
+  ((SValueNode *)pRight2)->datum.i = highv;
+  ((SValueNode *)pRight2)->translate = true;
+  flttMakeOpNode(&opNode2, OP_TYPE_LOWER_EQUAL, TSDB_DATA_TYPE_BOOL, pLeft2, pRight2);
+
+  SNodeList *list = nodesMakeList();
+  nodesListAppend(list, opNode1);
+  nodesListAppend(list, opNode2);
+  flttMakeLogicNodeFromList(&logicNode, LOGIC_COND_TYPE_AND, list);
+
+  SFilterInfo *filter = NULL;
+  int32_t      code = filterInitFromNode(logicNode, &filter, 0);
+  ASSERT_EQ(code, 0);
+  ASSERT_FALSE(filter->scalarMode);
+
+  // the rows are filtered by the filter units, and the blocks are classified by the column ranges all the same
+  int32_t         rowNum = 10;
+  SColumnDataAgg  stat = {0};
+  SColumnDataAgg *pStat = &stat;
+  stat.colId = ((SColumnNode *)pLeft1)->colId;
+
+  stat.min = 1;
+  stat.max = 100;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, rowNum), FILTER_RESULT_ALL_QUALIFIED);
+
+  stat.min = 0;
+  stat.max = 50;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, rowNum), FILTER_RESULT_PARTIAL_QUALIFIED);
+
+  stat.min = -10;
+  stat.max = 0;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, rowNum), FILTER_RESULT_NONE_QUALIFIED);
+
+  stat.min = 1;
+  stat.max = 100;
+  stat.numOfNull = 1;
+  ASSERT_EQ(filterRangeClassify(filter, &pStat, 1, rowNum), FILTER_RESULT_PARTIAL_QUALIFIED);
+
+  filterFreeInfo(filter);
+  nodesDestroyNode(logicNode);
+  tsFilterScalarMode = scalarMode;
+}
+
 #if 0
 TEST(columnTest, smallint_column_greater_double_value) {
   SNode       *pLeft = NULL, *pRight = NULL, *opNode = NULL;
@@ -24,6 +24,10 @@
 #include "tcompare.h"
 #include "ttimer.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef struct SCfComparator {
   rocksdb_comparator_t** comp;
   int32_t                numOfComp;
@@ -78,11 +82,19 @@ typedef struct {
   int32_t        chkpCap;
   TdThreadRwlock chkpDirLock;
   int64_t        dataWritten;
+  int64_t        sessionWritten;  // the session windows written into the sess cf, by all the states of the task
 
   void* pMeta;
 
 } STaskDbWrapper;
 
+// a checkpoint uploaded to the remote storage, and the shared sst files it references
+typedef struct {
+  int64_t chkpId;
+  char*   pManifest;
+  SArray* pSst;
+} SRemoteChkp;
+
 typedef struct SDbChkp {
   int8_t  init;
   char*   pCurrent;
@@ -103,6 +115,9 @@ typedef struct SDbChkp {
   SArray* pDel;
   int8_t  update;
 
+  SArray* pRemote;        // SRemoteChkp, in ascending order of checkpoint id
+  int8_t  remoteLoaded;   // the checkpoints uploaded before restart are loaded into pRemote
+
   TdThreadRwlock rwLock;
 } SDbChkp;
 typedef struct {
@@ -191,6 +206,7 @@ int32_t streamStateSessionAddIfNotExist_rocksdb(SStreamState* pState, SSessionKe
                                                 int32_t* pVLen);
 
 int32_t streamStateSessionClear_rocksdb(SStreamState* pState);
+int64_t streamStateAddSessionWritten_rocksdb(SStreamState* pState, int64_t num);
 
 int32_t streamStateStateAddIfNotExist_rocksdb(SStreamState* pState, SSessionKey* key, char* pKeyData,
                                               int32_t keyDataLen, state_key_cmpr_fn fn, void** pVal, int32_t* pVLen);
@@ -253,11 +269,23 @@ int32_t taskDbBuildSnap(void* arg, SArray* pSnap);
 
 int32_t taskDbDoCheckpoint(void* arg, int64_t chkpId);
 
+typedef int (*__chkp_download_fn_t)(char* id, char* fname, char* dstName);
+
 SBkdMgt* bkdMgtCreate(char* path);
 int32_t  bkdMgtAddChkp(SBkdMgt* bm, char* task, char* path);
-int32_t  bkdMgtGetDelta(SBkdMgt* bm, char* taskId, int64_t chkpId, SArray* list, char* name);
+int32_t  bkdMgtGetDelta(SBkdMgt* bm, char* taskId, int64_t chkpId, char* name);
 int32_t  bkdMgtDumpTo(SBkdMgt* bm, char* taskId, char* dname);
+int32_t  bkdMgtLoadRemote(SBkdMgt* bm, char* taskId, char* remoteId, char* dname, __chkp_download_fn_t fp);
+int32_t  bkdMgtGetObsolete(SBkdMgt* bm, char* taskId, SArray* pRetained, SArray* pChkpIds, SArray* list);
+void     bkdMgtDelObsolete(SBkdMgt* bm, char* taskId, SArray* pChkpIds);
+void     bkdMgtResetChkp(SBkdMgt* bm, char* taskId, int64_t chkpId);
 void     bkdMgtDestroy(SBkdMgt* bm);
 
-int32_t taskDbGenChkpUploadData(void* arg, void* bkdMgt, int64_t chkpId, int8_t type, char** path, SArray* list);
+int32_t taskDbGenChkpUploadData(void* arg, void* bkdMgt, int64_t chkpId, int8_t type, char** path, char* remoteId);
+int32_t taskDbGetObsoleteChkp(void* arg, void* bkdMgt, SArray* pChkpIds, SArray* list);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
\ No newline at end of file
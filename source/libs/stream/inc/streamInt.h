@@ -128,6 +128,9 @@ int32_t streamTaskFillHistoryFinished(SStreamTask* pTask);
 void              streamClearChkptReadyMsg(SStreamTask* pTask);
 int32_t           streamTaskGetDataFromInputQ(SStreamTask* pTask, SStreamQueueItem** pInput, int32_t* numOfBlocks,
                                               int32_t* blockSize);
+void              streamTaskInitBatchInfo(STaskBatchInfo* pBatch);
+void              streamTaskRecordBatchExec(SStreamTask* pTask, int32_t numOfBlocks, int64_t startTs, int64_t el);
+void              streamTaskGetBatchSummary(SStreamTask* pTask, STaskStatusEntry* pEntry);
 int32_t           streamQueueItemGetSize(const SStreamQueueItem* pItem);
 void              streamQueueItemIncSize(const SStreamQueueItem* pItem, int32_t size);
 const char*       streamQueueItemGetTypeStr(int32_t type);
@@ -169,6 +172,7 @@ int         uploadCheckpoint(char* id, char* path);
 int         downloadCheckpoint(char* id, char* path);
 int         deleteCheckpoint(char* id);
 int         deleteCheckpointFile(char* id, char* name);
+int         deleteCheckpointFiles(char* id, SArray* names);
 int         downloadCheckpointByName(char* id, char* fname, char* dstName);
 
 int32_t streamTaskOnNormalTaskReady(SStreamTask* pTask);
@@ -240,10 +240,14 @@ int32_t rebuildDirFromCheckpoint(const char* path, int64_t chkpId, char** dst) {
   return 0;
 }
 int32_t remoteChkp_readMetaData(char* path, SArray* list) {
-  char* metaPath = taosMemoryCalloc(1, strlen(path));
+  char* metaPath = taosMemoryCalloc(1, strlen(path) + 32);
   sprintf(metaPath, "%s%s%s", path, TD_DIRSEP, "META");
 
-  TdFilePtr pFile = taosOpenFile(path, TD_FILE_READ);
+  TdFilePtr pFile = taosOpenFile(metaPath, TD_FILE_READ);
+  if (pFile == NULL) {
+    taosMemoryFree(metaPath);
+    return -1;
+  }
 
   char buf[128] = {0};
   if (taosReadFile(pFile, buf, sizeof(buf)) <= 0) {
@@ -322,25 +326,14 @@ int32_t remoteChkp_validAndCvtMeta(char* path, SArray* list, int64_t chkpId) {
   return complete == 1 ? 0 : -1;
 }
 
-int32_t rebuildFromRemoteChkp_rsync(char* key, char* chkpPath, int64_t chkpId, char* defaultPath) {
-  // impl later
-  int32_t code = 0;
+// the remote dir of a task holds the shared sst files and the CURRENT/MANIFEST files of each retained checkpoint with
+// the checkpoint id as suffix, which are renamed back according to the META file of the latest checkpoint.
+int32_t rebuildFromRemoteChkpImpl(char* key, char* chkpPath, int64_t chkpId, char* defaultPath) {
   if (taosIsDir(chkpPath)) {
     taosRemoveDir(chkpPath);
   }
-  if (taosIsDir(defaultPath)) {
-    taosRemoveDir(defaultPath);
-  }
+  taosMulMkDir(chkpPath);
 
-  code = downloadCheckpoint(key, chkpPath);
-  if (code != 0) {
-    return code;
-  }
-  code = copyFiles(chkpPath, defaultPath);
-
-  return code;
-}
-int32_t rebuildFromRemoteChkp_s3(char* key, char* chkpPath, int64_t chkpId, char* defaultPath) {
   int32_t code = downloadCheckpoint(key, chkpPath);
   if (code != 0) {
     return code;
@@ -376,10 +369,8 @@ int32_t rebuildFromRemoteChkp_s3(char* key, char* chkpPath, int64_t chkpId, char
 }
 int32_t rebuildFromRemoteChkp(char* key, char* chkpPath, int64_t chkpId, char* defaultPath) {
   UPLOAD_TYPE type = getUploadType();
-  if (type == UPLOAD_S3) {
-    return rebuildFromRemoteChkp_s3(key, chkpPath, chkpId, defaultPath);
-  } else if (type == UPLOAD_RSYNC) {
-    return rebuildFromRemoteChkp_rsync(key, chkpPath, chkpId, defaultPath);
+  if (type == UPLOAD_S3 || type == UPLOAD_RSYNC) {
+    return rebuildFromRemoteChkpImpl(key, chkpPath, chkpId, defaultPath);
   }
   return -1;
 }
@@ -1889,32 +1880,17 @@ void taskDbDestroy(void* pDb, bool flush) {
 
 void taskDbDestroy2(void* pDb) { taskDbDestroy(pDb, true); }
 
-int32_t taskDbGenChkpUploadData__rsync(STaskDbWrapper* pDb, int64_t chkpId, char** path) {
-  int64_t st = taosGetTimestampMs();
-  int32_t code = -1;
-  int64_t refId = pDb->refId;
+// only the sst files added since the previous uploaded checkpoint are copied into the upload dir
+int32_t taskDbGenChkpUploadData(void* arg, void* mgt, int64_t chkpId, int8_t type, char** path, char* remoteId) {
+  STaskDbWrapper* pDb = arg;
+  SBkdMgt*        p = (SBkdMgt*)mgt;
+  UPLOAD_TYPE     utype = type;
+  int32_t         code = 0;
 
-  if (taosAcquireRef(taskDbWrapperId, refId) == NULL) {
+  if (utype != UPLOAD_RSYNC && utype != UPLOAD_S3) {
     return -1;
   }
 
-  char* buf = taosMemoryCalloc(1, strlen(pDb->path) + 128);
-  sprintf(buf, "%s%s%s%s%s%" PRId64 "", pDb->path, TD_DIRSEP, "checkpoints", TD_DIRSEP, "checkpoint", chkpId);
-  if (taosIsDir(buf)) {
-    code = 0;
-    *path = buf;
-  } else {
-    taosMemoryFree(buf);
-  }
-
-  taosReleaseRef(taskDbWrapperId, refId);
-  return code;
-}
-
-int32_t taskDbGenChkpUploadData__s3(STaskDbWrapper* pDb, void* bkdChkpMgt, int64_t chkpId, char** path, SArray* list) {
-  int32_t  code = 0;
-  SBkdMgt* p = (SBkdMgt*)bkdChkpMgt;
-
   char* temp = taosMemoryCalloc(1, strlen(pDb->path) + 32);
   sprintf(temp, "%s%s%s%" PRId64 "", pDb->path, TD_DIRSEP, "tmp", chkpId);
 
@@ -1924,22 +1900,27 @@ int32_t taskDbGenChkpUploadData__s3(STaskDbWrapper* pDb, void* bkdChkpMgt, int64
   } else {
     taosMkDir(temp);
   }
-  code = bkdMgtGetDelta(p, pDb->idstr, chkpId, list, temp);
-
   *path = temp;
 
-  return code;
+  code = bkdMgtGetDelta(p, pDb->idstr, chkpId, temp);
+  if (code != 0) {
+    return code;
+  }
+
+  return bkdMgtLoadRemote(p, pDb->idstr, remoteId, temp, downloadCheckpointByName);
 }
-int32_t taskDbGenChkpUploadData(void* arg, void* mgt, int64_t chkpId, int8_t type, char** path, SArray* list) {
+
+// the uploaded checkpoints that are not retained locally any more, and the files to be deleted from the remote storage
+int32_t taskDbGetObsoleteChkp(void* arg, void* mgt, SArray* pChkpIds, SArray* list) {
   STaskDbWrapper* pDb = arg;
-  UPLOAD_TYPE     utype = type;
 
-  if (utype == UPLOAD_RSYNC) {
-    return taskDbGenChkpUploadData__rsync(pDb, chkpId, path);
-  } else if (utype == UPLOAD_S3) {
-    return taskDbGenChkpUploadData__s3(pDb, mgt, chkpId, path, list);
-  }
-  return -1;
+  taosThreadRwlockRdlock(&pDb->chkpDirLock);
+  SArray* pRetained = taosArrayDup(pDb->chkpSaved, NULL);
+  taosThreadRwlockUnlock(&pDb->chkpDirLock);
+
+  int32_t code = bkdMgtGetObsolete((SBkdMgt*)mgt, pDb->idstr, pRetained, pChkpIds, list);
+  taosArrayDestroy(pRetained);
+  return code;
 }
 
 int32_t taskDbOpenCfByKey(STaskDbWrapper* pDb, const char* key) {
@@ -3186,6 +3167,13 @@ int32_t streamStateSessionGetKeyByRange_rocksdb(SStreamState* pState, const SSes
   return -1;
 }
 
+// the task db is shared by the stream task and its fill history task, so the session windows written by one state are
+// counted for all the others
+int64_t streamStateAddSessionWritten_rocksdb(SStreamState* pState, int64_t num) {
+  STaskDbWrapper* wrapper = pState->pTdbState->pOwner->pBackend;
+  return atomic_add_fetch_64(&wrapper->sessionWritten, num);
+}
+
 int32_t streamStateSessionAddIfNotExist_rocksdb(SStreamState* pState, SSessionKey* key, TSKEY gap, void** pVal,
                                                 int32_t* pVLen) {
   stDebug("streamStateSessionAddIfNotExist_rocksdb");
@@ -3250,6 +3238,7 @@ int32_t streamStateSessionClear_rocksdb(SStreamState* pState) {
     if (code == 0 && size > 0) {
       memset(buf, 0, size);
       // refactor later
+      streamStateAddSessionWritten_rocksdb(pState, 1);
       streamStateSessionPut_rocksdb(pState, &delKey, buf, size);
     } else {
       taosMemoryFreeClear(buf);
@@ -3772,6 +3761,7 @@ SDbChkp* dbChkpCreate(char* path, int64_t initChkpId) {
 
   p->pAdd = taosArrayInit(64, sizeof(void*));
   p->pDel = taosArrayInit(64, sizeof(void*));
+  p->pRemote = taosArrayInit(8, sizeof(SRemoteChkp));
   p->update = 0;
   taosThreadRwlockInit(&p->rwLock, NULL);
 
@@ -3781,9 +3771,16 @@ SDbChkp* dbChkpCreate(char* path, int64_t initChkpId) {
   return p;
 }
 
+static void destroyRemoteChkp(void* param) {
+  SRemoteChkp* pRemote = param;
+  taosMemoryFree(pRemote->pManifest);
+  taosArrayDestroyP(pRemote->pSst, taosMemoryFree);
+}
+
 void dbChkpDestroy(SDbChkp* pChkp) {
   taosMemoryFree(pChkp->buf);
   taosMemoryFree(pChkp->path);
+  taosArrayDestroyEx(pChkp->pRemote, destroyRemoteChkp);
 
   taosArrayDestroyP(pChkp->pSST, taosMemoryFree);
   taosArrayDestroyP(pChkp->pAdd, taosMemoryFree);
@@ -3801,7 +3798,56 @@ int32_t dbChkpInit(SDbChkp* p) {
   if (p == NULL) return 0;
   return 0;
 }
-int32_t dbChkpDumpTo(SDbChkp* p, char* dname, SArray* list) {
+// write the file list of current checkpoint, which references the shared sst files, into file CHKP_$chkpId
+static int32_t dbChkpDumpFileList(SDbChkp* p, char* dname, SRemoteChkp* pRemote) {
+  int32_t len = strlen(dname) + 64;
+  char*   fname = taosMemoryCalloc(1, len);
+  snprintf(fname, len, "%s%s%s%" PRId64 "", dname, TD_DIRSEP, "CHKP_", p->curChkpId);
+
+  TdFilePtr pFile = taosOpenFile(fname, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+  if (pFile == NULL) {
+    stError("chkp failed to create file list: %s", fname);
+    taosMemoryFree(fname);
+    return -1;
+  }
+
+  int32_t code = 0;
+  char    buf[256] = {0};
+  int32_t n = snprintf(buf, sizeof(buf), "%s_%" PRId64 "\n%s_%" PRId64 "\n", p->pCurrent, p->curChkpId,
+                       p->pManifest, p->curChkpId);
+  if (taosWriteFile(pFile, buf, n) != n) {
+    code = -1;
+  }
+
+  for (int i = 0; code == 0 && i < taosArrayGetSize(pRemote->pSst); i++) {
+    char* name = taosArrayGetP(pRemote->pSst, i);
+    n = snprintf(buf, sizeof(buf), "%s\n", name);
+    if (taosWriteFile(pFile, buf, n) != n) {
+      code = -1;
+    }
+  }
+
+  // the other checkpoints in the remote storage, all of them are found from the latest one after restart
+  for (int i = 0; code == 0 && i < taosArrayGetSize(p->pRemote); i++) {
+    SRemoteChkp* pOther = taosArrayGet(p->pRemote, i);
+    if (pOther->chkpId == pRemote->chkpId) continue;
+
+    n = snprintf(buf, sizeof(buf), "%s%" PRId64 "\n", "CHKP_", pOther->chkpId);
+    if (taosWriteFile(pFile, buf, n) != n) {
+      code = -1;
+    }
+  }
+
+  if (code != 0) {
+    stError("chkp failed to write file list: %s", fname);
+  }
+
+  taosCloseFile(&pFile);
+  taosMemoryFree(fname);
+  return code;
+}
+
+int32_t dbChkpDumpTo(SDbChkp* p, char* dname) {
   taosThreadRwlockRdlock(&p->rwLock);
   int32_t code = -1;
   int32_t len = p->len + 128;
@@ -3834,12 +3880,8 @@ int32_t dbChkpDumpTo(SDbChkp* p, char* dname, SArray* list) {
       goto _ERROR;
     }
   }
-  // del file in $name
-  for (int i = 0; i < taosArrayGetSize(p->pDel); i++) {
-    char* filename = taosArrayGetP(p->pDel, i);
-    char* p = taosStrdup(filename);
-    taosArrayPush(list, &p);
-  }
+  // sst files removed since the previous checkpoint are still referenced by the retained remote checkpoints, and are
+  // deleted when no retained checkpoint references them any more, see dbChkpDelObsolete
 
   // copy current file to dst dir
   memset(srcBuf, 0, len);
@@ -3880,6 +3922,32 @@ int32_t dbChkpDumpTo(SDbChkp* p, char* dname, SArray* list) {
   }
   taosCloseFile(&pFile);
 
+  SRemoteChkp remote = {.chkpId = p->curChkpId, .pManifest = taosStrdup(p->pManifest)};
+  remote.pSst = taosArrayInit(taosHashGetSize(p->pSstTbl[p->idx]), sizeof(void*));
+
+  void* pIter = taosHashIterate(p->pSstTbl[p->idx], NULL);
+  while (pIter) {
+    size_t klen = 0;
+    char*  name = taosHashGetKey(pIter, &klen);
+    char*  fname = taosMemoryCalloc(1, klen + 1);
+    memcpy(fname, name, klen);
+    taosArrayPush(remote.pSst, &fname);
+    pIter = taosHashIterate(p->pSstTbl[p->idx], pIter);
+  }
+
+  if (dbChkpDumpFileList(p, dname, &remote) != 0) {
+    destroyRemoteChkp(&remote);
+    goto _ERROR;
+  }
+
+  // the same checkpoint may be uploaded again
+  SRemoteChkp* pLast = taosArrayGetLast(p->pRemote);
+  if (pLast != NULL && pLast->chkpId == remote.chkpId) {
+    destroyRemoteChkp(pLast);
+    taosArrayPop(p->pRemote);
+  }
+  taosArrayPush(p->pRemote, &remote);
+
   // clear delta data buf
   taosArrayClearP(p->pAdd, taosMemoryFree);
   taosArrayClearP(p->pDel, taosMemoryFree);
@@ -3917,7 +3985,7 @@ void bkdMgtDestroy(SBkdMgt* bm) {
 
   taosMemoryFree(bm);
 }
-int32_t bkdMgtGetDelta(SBkdMgt* bm, char* taskId, int64_t chkpId, SArray* list, char* dname) {
+int32_t bkdMgtGetDelta(SBkdMgt* bm, char* taskId, int64_t chkpId, char* dname) {
   int32_t code = 0;
 
   taosThreadRwlockWrlock(&bm->rwLock);
@@ -3933,13 +4001,13 @@ int32_t bkdMgtGetDelta(SBkdMgt* bm, char* taskId, int64_t chkpId, SArray* list,
 
     pChkp = p;
 
-    code = dbChkpDumpTo(pChkp, dname, list);
+    code = dbChkpDumpTo(pChkp, dname);
     taosThreadRwlockUnlock(&bm->rwLock);
     return code;
   }
 
   code = dbChkpGetDelta(pChkp, chkpId, NULL);
-  code = dbChkpDumpTo(pChkp, dname, list);
+  code = dbChkpDumpTo(pChkp, dname);
 
   taosThreadRwlockUnlock(&bm->rwLock);
   return code;
@@ -3969,9 +4037,322 @@ int32_t bkdMgtDumpTo(SBkdMgt* bm, char* taskId, char* dname) {
   int32_t code = 0;
   taosThreadRwlockRdlock(&bm->rwLock);
 
-  SDbChkp* p = taosHashGet(bm->pDbChkpTbl, taskId, strlen(taskId));
-  code = dbChkpDumpTo(p, dname, NULL);
+  SDbChkp** pp = taosHashGet(bm->pDbChkpTbl, taskId, strlen(taskId));
+  code = (pp != NULL) ? dbChkpDumpTo(*pp, dname) : -1;
+
+  taosThreadRwlockUnlock(&bm->rwLock);
+  return code;
+}
+
+static int32_t compareRemoteChkp(const void* pLeft, const void* pRight) {
+  int64_t left = ((SRemoteChkp*)pLeft)->chkpId;
+  int64_t right = ((SRemoteChkp*)pRight)->chkpId;
+  if (left == right) {
+    return 0;
+  }
+  return left < right ? -1 : 1;
+}
+
+static SRemoteChkp* dbChkpGetRemote(SDbChkp* p, int64_t chkpId) {
+  for (int i = 0; i < taosArrayGetSize(p->pRemote); i++) {
+    SRemoteChkp* pRemote = taosArrayGet(p->pRemote, i);
+    if (pRemote->chkpId == chkpId) {
+      return pRemote;
+    }
+  }
+  return NULL;
+}
+
+// parse the file list CHKP_$chkpId written by dbChkpDumpFileList, the other checkpoints it references are put into pRefs
+static int32_t dbChkpParseFileList(char* fname, SRemoteChkp* pRemote, SArray* pRefs) {
+  int64_t size = 0;
+  if (taosStatFile(fname, &size, NULL, NULL) != 0 || size <= 0) {
+    return -1;
+  }
+
+  TdFilePtr pFile = taosOpenFile(fname, TD_FILE_READ);
+  if (pFile == NULL) {
+    return -1;
+  }
+
+  char* content = taosMemoryCalloc(1, size + 1);
+  if (taosReadFile(pFile, content, size) != size) {
+    taosCloseFile(&pFile);
+    taosMemoryFree(content);
+    return -1;
+  }
+  taosCloseFile(&pFile);
+
+  char* line = content;
+  while (line != NULL && *line != 0) {
+    char* end = strchr(line, '\n');
+    if (end != NULL) {
+      *end = 0;
+    }
+
+    int32_t len = strlen(line);
+    if (strncmp(line, "CHKP_", 5) == 0) {
+      int64_t chkpId = taosStr2int64(line + 5);
+      taosArrayPush(pRefs, &chkpId);
+    } else if (strncmp(line, "MANIFEST-", 9) == 0) {
+      // MANIFEST-xxx_$chkpId
+      char* pos = strrchr(line, '_');
+      if (pos != NULL && pRemote->pManifest == NULL) {
+        pRemote->pManifest = taosMemoryCalloc(1, pos - line + 1);
+        memcpy(pRemote->pManifest, line, pos - line);
+      }
+    } else if (len > 4 && strcmp(line + len - 4, ".sst") == 0) {
+      char* name = taosStrdup(line);
+      taosArrayPush(pRemote->pSst, &name);
+    }
+
+    line = (end != NULL) ? end + 1 : NULL;
+  }
+
+  taosMemoryFree(content);
+  return pRemote->pManifest != NULL ? 0 : -1;
+}
+
+/*
+ * the checkpoints uploaded before restart are found from the latest one recorded in the remote META file, whose file
+ * list references all the others in the remote storage at the time it was uploaded. The ones referenced but deleted
+ * already are skipped.
+ */
+static int32_t dbChkpLoadRemote(SDbChkp* p, char* remoteId, char* dname, __chkp_download_fn_t fp) {
+  int32_t code = 0;
+  int32_t len = strlen(p->path) + 64;
+  char*   tmp = taosMemoryCalloc(1, len);
+  char*   fname = taosMemoryCalloc(1, len);
+  SArray* pMeta = taosArrayInit(2, POINTER_BYTES);
+  SArray* pIds = taosArrayInit(8, sizeof(int64_t));
+  SArray* pLoaded = taosArrayInit(8, sizeof(SRemoteChkp));
+
+  sprintf(tmp, "%s%s%s", p->path, TD_DIRSEP, "remote");
+  if (taosIsDir(tmp)) {
+    taosRemoveDir(tmp);
+  }
+  taosMulMkDir(tmp);
+
+  // no checkpoint has been uploaded yet
+  sprintf(fname, "%s%s%s", tmp, TD_DIRSEP, "META");
+  if (fp(remoteId, "META", fname) != 0 || remoteChkp_readMetaData(tmp, pMeta) != 0 || taosArrayGetSize(pMeta) == 0) {
+    goto _EXIT;
+  }
+
+  // CURRENT_$chkpId
+  char* pos = strrchr(taosArrayGetP(pMeta, 0), '_');
+  if (pos == NULL) {
+    goto _EXIT;
+  }
+  int64_t latest = taosStr2int64(pos + 1);
+  taosArrayPush(pIds, &latest);
+
+  for (int i = 0; i < taosArrayGetSize(pIds); i++) {
+    int64_t chkpId = *(int64_t*)taosArrayGet(pIds, i);
+
+    bool visited = false;
+    for (int j = 0; !visited && j < i; j++) {
+      visited = (*(int64_t*)taosArrayGet(pIds, j) == chkpId);
+    }
+    if (visited) continue;
+
+    char name[64] = {0};
+    snprintf(name, sizeof(name), "%s%" PRId64 "", "CHKP_", chkpId);
+    sprintf(fname, "%s%s%s", tmp, TD_DIRSEP, name);
+
+    SRemoteChkp remote = {.chkpId = chkpId, .pSst = taosArrayInit(64, POINTER_BYTES)};
+    if (fp(remoteId, name, fname) != 0 || dbChkpParseFileList(fname, &remote, pIds) != 0) {
+      stDebug("chkp remote checkpoint:%" PRId64 " not found, path:%s", chkpId, p->path);
+      destroyRemoteChkp(&remote);
+      continue;
+    }
+
+    // the checkpoint is uploaded again after restart
+    if (dbChkpGetRemote(p, chkpId) != NULL) {
+      destroyRemoteChkp(&remote);
+      continue;
+    }
+
+    stDebug("chkp remote checkpoint:%" PRId64 " loaded, sst:%d, path:%s", chkpId,
+            (int32_t)taosArrayGetSize(remote.pSst), p->path);
+    taosArrayPush(pLoaded, &remote);
+  }
+
+  if (taosArrayGetSize(pLoaded) > 0) {
+    taosArrayAddAll(pLoaded, p->pRemote);
+    taosArraySort(pLoaded, compareRemoteChkp);
+    taosArrayDestroy(p->pRemote);
+    p->pRemote = pLoaded;
+    pLoaded = NULL;
+
+    // the file list of the checkpoint to be uploaded references the loaded ones too
+    SRemoteChkp* pCur = dbChkpGetRemote(p, p->curChkpId);
+    if (pCur != NULL) {
+      code = dbChkpDumpFileList(p, dname, pCur);
+    }
+  }
+
+_EXIT:
+  taosRemoveDir(tmp);
+  taosMemoryFree(tmp);
+  taosMemoryFree(fname);
+  taosArrayDestroyP(pMeta, taosMemoryFree);
+  taosArrayDestroy(pIds);
+  taosArrayDestroyEx(pLoaded, destroyRemoteChkp);
+  return code;
+}
+
+int32_t bkdMgtLoadRemote(SBkdMgt* bm, char* taskId, char* remoteId, char* dname, __chkp_download_fn_t fp) {
+  int32_t code = 0;
+  taosThreadRwlockRdlock(&bm->rwLock);
+
+  SDbChkp** pp = taosHashGet(bm->pDbChkpTbl, taskId, strlen(taskId));
+  if (pp != NULL) {
+    SDbChkp* p = *pp;
+    taosThreadRwlockWrlock(&p->rwLock);
+    if (!p->remoteLoaded) {
+      code = dbChkpLoadRemote(p, remoteId, dname, fp);
+      p->remoteLoaded = 1;
+    }
+    taosThreadRwlockUnlock(&p->rwLock);
+  }
+
+  taosThreadRwlockUnlock(&bm->rwLock);
+  return code;
+}
+
+/*
+ *  remote: |--cp1--|--cp2--|--cp3--|--cp4--|
+ *  retained locally: |--cp3--|--cp4--|
+ *  cp1 and cp2 are obsolete, they are removed from the remote storage together with the sst files that neither cp3 nor
+ *  cp4 references, and then dropped by dbChkpDelObsolete
+ */
+static int32_t dbChkpGetObsolete(SDbChkp* p, SArray* pRetained, SArray* pChkpIds, SArray* list) {
+  taosThreadRwlockRdlock(&p->rwLock);
+
+  int32_t   size = taosArrayGetSize(p->pRemote);
+  SArray*   pDrop = taosArrayInit(size, POINTER_BYTES);
+  SHashObj* pInUse = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  int8_t    dummy = 0;
+
+  for (int i = 0; i < size; i++) {
+    SRemoteChkp* pRemote = taosArrayGet(p->pRemote, i);
+
+    // the latest uploaded checkpoint is always kept
+    bool retained = (i == size - 1);
+    for (int j = 0; !retained && j < taosArrayGetSize(pRetained); j++) {
+      retained = (*(int64_t*)taosArrayGet(pRetained, j) == pRemote->chkpId);
+    }
+
+    if (!retained) {
+      taosArrayPush(pDrop, &pRemote);
+      continue;
+    }
+
+    for (int j = 0; j < taosArrayGetSize(pRemote->pSst); j++) {
+      char* name = taosArrayGetP(pRemote->pSst, j);
+      taosHashPut(pInUse, name, strlen(name), &dummy, sizeof(dummy));
+    }
+  }
+
+  for (int i = 0; i < taosArrayGetSize(pDrop); i++) {
+    SRemoteChkp* pRemote = taosArrayGetP(pDrop, i);
+    char         buf[256] = {0};
+    char*        fname = NULL;
+
+    for (int j = 0; j < taosArrayGetSize(pRemote->pSst); j++) {
+      char* name = taosArrayGetP(pRemote->pSst, j);
+      if (taosHashGet(pInUse, name, strlen(name)) == NULL) {
+        // mark it, in case that it is referenced by another obsolete checkpoint
+        taosHashPut(pInUse, name, strlen(name), &dummy, sizeof(dummy));
+        fname = taosStrdup(name);
+        taosArrayPush(list, &fname);
+      }
+    }
+
+    snprintf(buf, sizeof(buf), "%s_%" PRId64 "", "CURRENT", pRemote->chkpId);
+    fname = taosStrdup(buf);
+    taosArrayPush(list, &fname);
+
+    snprintf(buf, sizeof(buf), "%s_%" PRId64 "", pRemote->pManifest, pRemote->chkpId);
+    fname = taosStrdup(buf);
+    taosArrayPush(list, &fname);
+
+    // the file list is the last one, so the checkpoint can still be found if the files are deleted partly
+    snprintf(buf, sizeof(buf), "%s%" PRId64 "", "CHKP_", pRemote->chkpId);
+    fname = taosStrdup(buf);
+    taosArrayPush(list, &fname);
+
+    taosArrayPush(pChkpIds, &pRemote->chkpId);
+    stDebug("chkp remote checkpoint:%" PRId64 " is obsolete, path:%s", pRemote->chkpId, p->path);
+  }
+
+  taosArrayDestroy(pDrop);
+  taosHashCleanup(pInUse);
+
+  taosThreadRwlockUnlock(&p->rwLock);
+  return 0;
+}
+
+// the files of obsolete checkpoints are deleted from the remote storage
+static void dbChkpDelObsolete(SDbChkp* p, SArray* pChkpIds) {
+  taosThreadRwlockWrlock(&p->rwLock);
+
+  for (int i = taosArrayGetSize(p->pRemote) - 1; i >= 0; i--) {
+    SRemoteChkp* pRemote = taosArrayGet(p->pRemote, i);
+    for (int j = 0; j < taosArrayGetSize(pChkpIds); j++) {
+      if (*(int64_t*)taosArrayGet(pChkpIds, j) == pRemote->chkpId) {
+        destroyRemoteChkp(pRemote);
+        taosArrayRemove(p->pRemote, i);
+        break;
+      }
+    }
+  }
+
+  taosThreadRwlockUnlock(&p->rwLock);
+}
+
+int32_t bkdMgtGetObsolete(SBkdMgt* bm, char* taskId, SArray* pRetained, SArray* pChkpIds, SArray* list) {
+  int32_t code = 0;
+  taosThreadRwlockRdlock(&bm->rwLock);
+
+  SDbChkp** pp = taosHashGet(bm->pDbChkpTbl, taskId, strlen(taskId));
+  if (pp != NULL) {
+    code = dbChkpGetObsolete(*pp, pRetained, pChkpIds, list);
+  }
 
   taosThreadRwlockUnlock(&bm->rwLock);
   return code;
+}
+
+void bkdMgtDelObsolete(SBkdMgt* bm, char* taskId, SArray* pChkpIds) {
+  taosThreadRwlockRdlock(&bm->rwLock);
+
+  SDbChkp** pp = taosHashGet(bm->pDbChkpTbl, taskId, strlen(taskId));
+  if (pp != NULL) {
+    dbChkpDelObsolete(*pp, pChkpIds);
+  }
+
+  taosThreadRwlockUnlock(&bm->rwLock);
+}
+
+// the upload of checkpoint failed, so upload all files of the next checkpoint
+void bkdMgtResetChkp(SBkdMgt* bm, char* taskId, int64_t chkpId) {
+  taosThreadRwlockRdlock(&bm->rwLock);
+
+  SDbChkp** pp = taosHashGet(bm->pDbChkpTbl, taskId, strlen(taskId));
+  if (pp != NULL) {
+    SDbChkp* p = *pp;
+    taosThreadRwlockWrlock(&p->rwLock);
+    p->init = 0;
+
+    SRemoteChkp* pLast = taosArrayGetLast(p->pRemote);
+    if (pLast != NULL && pLast->chkpId == chkpId) {
+      destroyRemoteChkp(pLast);
+      taosArrayPop(p->pRemote);
+    }
+    taosThreadRwlockUnlock(&p->rwLock);
+  }
+
+  taosThreadRwlockUnlock(&bm->rwLock);
 }
\ No newline at end of file
@@ -346,72 +346,51 @@ void streamTaskSetFailedId(SStreamTask* pTask) {
   pTask->chkInfo.checkpointId = pTask->chkInfo.checkpointingId;
 }
 
-int32_t getChkpMeta(char* id, char* path, SArray* list) {
-  char* file = taosMemoryCalloc(1, strlen(path) + 32);
-  sprintf(file, "%s%s%s", path, TD_DIRSEP, "META_TMP");
-  int32_t code = downloadCheckpointByName(id, "META", file);
-  if (code != 0) {
-    stDebug("chkp failed to download meta file:%s", file);
-    taosMemoryFree(file);
-    return code;
-  }
-  TdFilePtr pFile = taosOpenFile(file, TD_FILE_READ);
-  char      buf[128] = {0};
-  if (taosReadFile(pFile, buf, sizeof(buf)) <= 0) {
-    stError("chkp failed to read meta file:%s", file);
-    code = -1;
-  } else {
-    int32_t len = strlen(buf);
-    for (int i = 0; i < len; i++) {
-      if (buf[i] == '\n') {
-        char* item = taosMemoryCalloc(1, i + 1);
-        memcpy(item, buf, i);
-        taosArrayPush(list, &item);
-
-        item = taosMemoryCalloc(1, len - i);
-        memcpy(item, buf + i + 1, len - i - 1);
-        taosArrayPush(list, &item);
-      }
+// the obsolete checkpoints are removed from the remote storage only after the new checkpoint, which may reference their
+// sst files, is uploaded. They are kept in the bookkeeping if the deletion fails, and deleted again next time.
+static void doDelObsoleteChkp(SAsyncUploadArg* arg) {
+  STaskDbWrapper* pDb = arg->pTask->pBackend;
+  void*           pMgt = arg->pTask->pMeta->bkdChkptMgt;
+  SArray*         pChkpIds = taosArrayInit(4, sizeof(int64_t));
+  SArray*         toDelFiles = taosArrayInit(4, POINTER_BYTES);
+
+  int32_t code = taskDbGetObsoleteChkp(pDb, pMgt, pChkpIds, toDelFiles);
+  if (code == 0 && taosArrayGetSize(pChkpIds) > 0) {
+    stDebug("s-task:%s try to del %d obsolete checkpoints, %d files", arg->pTask->id.idStr,
+            (int32_t)taosArrayGetSize(pChkpIds), (int32_t)taosArrayGetSize(toDelFiles));
+    code = deleteCheckpointFiles(arg->taskId, toDelFiles);
+    if (code == 0) {
+      bkdMgtDelObsolete(pMgt, pDb->idstr, pChkpIds);
+    } else {
+      stError("s-task:%s failed to del obsolete checkpoints, retry next time", arg->pTask->id.idStr);
     }
   }
-  taosCloseFile(&pFile);
-  taosRemoveFile(file);
-  taosMemoryFree(file);
-  return code;
+
+  taosArrayDestroy(pChkpIds);
+  taosArrayDestroyP(toDelFiles, taosMemoryFree);
 }
+
 int32_t doUploadChkp(void* param) {
   SAsyncUploadArg* arg = param;
   char*            path = NULL;
   int32_t          code = 0;
-  SArray*          toDelFiles = taosArrayInit(4, sizeof(void*));
 
   if ((code = taskDbGenChkpUploadData(arg->pTask->pBackend, arg->pTask->pMeta->bkdChkptMgt, arg->chkpId,
-                                      (int8_t)(arg->type), &path, toDelFiles)) != 0) {
+                                      (int8_t)(arg->type), &path, arg->taskId)) != 0) {
     stError("s-task:%s failed to gen upload checkpoint:%" PRId64 "", arg->pTask->id.idStr, arg->chkpId);
   }
-  if (arg->type == UPLOAD_S3) {
-    if (code == 0 && (code = getChkpMeta(arg->taskId, path, toDelFiles)) != 0) {
-      stError("s-task:%s failed to get  checkpoint:%" PRId64 " meta", arg->pTask->id.idStr, arg->chkpId);
-    }
-  }
 
   if (code == 0 && (code = uploadCheckpoint(arg->taskId, path)) != 0) {
     stError("s-task:%s failed to upload checkpoint:%" PRId64, arg->pTask->id.idStr, arg->chkpId);
   }
 
   if (code == 0) {
-    for (int i = 0; i < taosArrayGetSize(toDelFiles); i++) {
-      char* p = taosArrayGetP(toDelFiles, i);
-      code = deleteCheckpointFile(arg->taskId, p);
-      stDebug("s-task:%s try to del file: %s", arg->pTask->id.idStr, p);
-      if (code != 0) {
-        break;
-      }
-    }
+    doDelObsoleteChkp(arg);
+  } else {
+    STaskDbWrapper* pDb = arg->pTask->pBackend;
+    bkdMgtResetChkp(arg->pTask->pMeta->bkdChkptMgt, pDb->idstr, arg->chkpId);
   }
 
-  taosArrayDestroyP(toDelFiles, taosMemoryFree);
-
   taosRemoveDir(path);
   taosMemoryFree(path);
 
@@ -532,7 +511,7 @@ static int uploadCheckpointToS3(char* id, char* path) {
 
 static int downloadCheckpointByNameS3(char* id, char* fname, char* dstName) {
   int   code = 0;
-  char* buf = taosMemoryCalloc(1, strlen(id) + strlen(dstName) + 4);
+  char* buf = taosMemoryCalloc(1, strlen(id) + strlen(fname) + 4);
   sprintf(buf, "%s/%s", id, fname);
   if (s3GetObjectToFile(buf, dstName) != 0) {
     code = -1;
@@ -571,7 +550,7 @@ int downloadCheckpointByName(char* id, char* fname, char* dstName) {
     return -1;
   }
   if (strlen(tsSnodeAddress) != 0) {
-    return 0;
+    return downloadRsyncFile(id, fname, dstName);
   } else if (tsS3StreamEnabled) {
     return downloadCheckpointByNameS3(id, fname, dstName);
   }
@@ -611,3 +590,29 @@ int deleteCheckpointFile(char* id, char* name) {
   s3DeleteObjects((const char**)&tmp, 1);
   return 0;
 }
+
+int deleteCheckpointFiles(char* id, SArray* names) {
+  int32_t num = taosArrayGetSize(names);
+  if (id == NULL || strlen(id) == 0 || num == 0) {
+    return 0;
+  }
+  if (strlen(tsSnodeAddress) != 0) {
+    return deleteRsyncFiles(id, names);
+  } else if (tsS3StreamEnabled) {
+    char** objects = taosMemoryCalloc(num, POINTER_BYTES);
+    if (objects == NULL) {
+      return -1;
+    }
+    for (int i = 0; i < num; i++) {
+      char* name = taosArrayGetP(names, i);
+      objects[i] = taosMemoryCalloc(1, strlen(id) + strlen(name) + 2);
+      sprintf(objects[i], "%s/%s", id, name);
+    }
+    s3DeleteObjects((const char**)objects, num);
+    for (int i = 0; i < num; i++) {
+      taosMemoryFree(objects[i]);
+    }
+    taosMemoryFree(objects);
+  }
+  return 0;
+}
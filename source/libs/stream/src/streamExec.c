@@ -587,12 +587,15 @@ int32_t doStreamExecTask(SStreamTask* pTask) {
       if (type == STREAM_INPUT__DATA_BLOCK) {
         pTask->execInfo.sink.dataSize += blockSize;
         stDebug("s-task:%s sink task start to sink %d blocks, size:%.2fKiB", id, numOfBlocks, SIZE_IN_KiB(blockSize));
+
+        int64_t st = taosGetTimestampUs();
         doOutputResultBlockImpl(pTask, (SStreamDataBlock*)pInput);
+        streamTaskRecordBatchExec(pTask, numOfBlocks, st, taosGetTimestampUs() - st);
         continue;
       }
     }
 
-    int64_t st = taosGetTimestampMs();
+    int64_t st = taosGetTimestampUs();
 
     const SStreamQueueItem* pItem = pInput;
     stDebug("s-task:%s start to process batch of blocks, num:%d, type:%d", id, numOfBlocks, pItem->type);
@@ -604,7 +607,12 @@ int32_t doStreamExecTask(SStreamTask* pTask) {
     int32_t totalBlocks = 0;
     streamTaskExecImpl(pTask, pInput, &resSize, &totalBlocks);
 
-    double el = (taosGetTimestampMs() - st) / 1000.0;
+    int64_t elUs = taosGetTimestampUs() - st;
+    if (type != STREAM_INPUT__CHECKPOINT) {
+      streamTaskRecordBatchExec(pTask, numOfBlocks, st, elUs);
+    }
+
+    double el = elUs / 1000000.0;
     stDebug("s-task:%s batch of input blocks exec end, elapsed time:%.2fs, result size:%.2fMiB, numOfBlocks:%d", id, el,
            SIZE_IN_MiB(resSize), totalBlocks);
 
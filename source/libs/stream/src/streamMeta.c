@@ -960,6 +960,16 @@ int32_t tEncodeStreamHbMsg(SEncoder* pEncoder, const SStreamHbMsg* pReq) {
     if (tEncodeI32(pEncoder, *pVgId) < 0) return -1;
   }
 
+  // batch statistics, appended after the update node list to keep compatible with the old hb msg
+  for (int32_t i = 0; i < pReq->numOfTasks; ++i) {
+    STaskStatusEntry* ps = taosArrayGet(pReq->pTaskStatus, i);
+    if (tEncodeI32(pEncoder, ps->maxBatchBlocks) < 0) return -1;
+    for (int32_t j = 0; j < STREAM_EXEC_HISTO_MAX; ++j) {
+      if (tEncodeDouble(pEncoder, ps->execStat[j].avg) < 0) return -1;
+      if (tEncodeDouble(pEncoder, ps->execStat[j].p99) < 0) return -1;
+    }
+  }
+
   tEndEncode(pEncoder);
   return pEncoder->pos;
 }
@@ -1004,6 +1014,17 @@ int32_t tDecodeStreamHbMsg(SDecoder* pDecoder, SStreamHbMsg* pReq) {
     taosArrayPush(pReq->pUpdateNodes, &vgId);
   }
 
+  if (!tDecodeIsEnd(pDecoder)) {
+    for (int32_t i = 0; i < pReq->numOfTasks; ++i) {
+      STaskStatusEntry* ps = taosArrayGet(pReq->pTaskStatus, i);
+      if (tDecodeI32(pDecoder, &ps->maxBatchBlocks) < 0) return -1;
+      for (int32_t j = 0; j < STREAM_EXEC_HISTO_MAX; ++j) {
+        if (tDecodeDouble(pDecoder, &ps->execStat[j].avg) < 0) return -1;
+        if (tDecodeDouble(pDecoder, &ps->execStat[j].p99) < 0) return -1;
+      }
+    }
+  }
+
   tEndDecode(pDecoder);
   return 0;
 }
@@ -1156,6 +1177,8 @@ void metaHbToMnode(void* param, void* tmrId) {
       walReaderValidVersionRange((*pTask)->exec.pWalReader, &entry.verStart, &entry.verEnd);
     }
 
+    streamTaskGetBatchSummary(*pTask, &entry);
+
     addUpdateNodeIntoHbMsg(*pTask, &hbMsg);
     taosArrayPush(hbMsg.pTaskStatus, &entry);
     if (!hasMnodeEpset) {
@@ -15,7 +15,9 @@
 
 #include "streamInt.h"
 
-#define MAX_STREAM_EXEC_BATCH_NUM                 32
+#define MAX_STREAM_EXEC_BATCH_NUM                 256
+#define INIT_STREAM_EXEC_BATCH_NUM                32
+#define STREAM_EXEC_COST_SMOOTH_FACTOR            0.2
 #define MAX_SMOOTH_BURST_RATIO                    5     // 5 sec
 #define WAIT_FOR_DURATION                         40
 #define OUTPUT_QUEUE_FULL_WAIT_DURATION           500   // 500 ms
@@ -32,6 +34,7 @@ typedef struct SQueueReader {
 static bool streamTaskExtractAvailableToken(STokenBucket* pBucket, const char* id);
 static void streamTaskPutbackToken(STokenBucket* pBucket);
 static void streamTaskConsumeQuota(STokenBucket* pBucket, int32_t bytes);
+static int32_t streamTaskGetBatchWaitDuration(SStreamTask* pTask, int32_t numOfBlocks);
 
 static void streamQueueCleanup(SStreamQueue* pQueue) {
   void* qItem = NULL;
@@ -152,6 +155,11 @@ int32_t streamTaskGetDataFromInputQ(SStreamTask* pTask, SStreamQueueItem** pInpu
   int32_t     MAX_RETRY_TIMES = 5;
   const char* id = pTask->id.idStr;
   int32_t     taskLevel = pTask->info.taskLevel;
+  int32_t     maxBlocks = pTask->execInfo.batch.maxBlocks;
+
+  if (maxBlocks <= 0) {
+    maxBlocks = INIT_STREAM_EXEC_BATCH_NUM;
+  }
 
   *pInput = NULL;
   *numOfBlocks = 0;
@@ -173,8 +181,11 @@ int32_t streamTaskGetDataFromInputQ(SStreamTask* pTask, SStreamQueueItem** pInpu
     SStreamQueueItem* qItem = streamQueueNextItem(pTask->inputq.queue);
     if (qItem == NULL) {
       if ((taskLevel == TASK_LEVEL__SOURCE  || taskLevel == TASK_LEVEL__SINK) && (++retryTimes) < MAX_RETRY_TIMES) {
-        taosMsleep(WAIT_FOR_DURATION);
-        continue;
+        int32_t waitDuration = streamTaskGetBatchWaitDuration(pTask, *numOfBlocks);
+        if (waitDuration > 0) {
+          taosMsleep(waitDuration);
+          continue;
+        }
       }
 
       // restore the token to bucket
@@ -219,6 +230,7 @@ int32_t streamTaskGetDataFromInputQ(SStreamTask* pTask, SStreamQueueItem** pInpu
       if (*pInput == NULL) {
         ASSERT((*numOfBlocks) == 0);
         *pInput = qItem;
+        pTask->execInfo.batch.firstTs = taosQitemGetTimestamp(qItem);
       } else {
         // merge current block failed, let's handle the already merged blocks.
         void* newRet = streamQueueMergeQueueItem(*pInput, qItem);
@@ -243,8 +255,8 @@ int32_t streamTaskGetDataFromInputQ(SStreamTask* pTask, SStreamQueueItem** pInpu
       *numOfBlocks += 1;
       streamQueueProcessSuccess(pTask->inputq.queue);
 
-      if (*numOfBlocks >= MAX_STREAM_EXEC_BATCH_NUM) {
-        stDebug("s-task:%s batch size limit:%d reached, start to process blocks", id, MAX_STREAM_EXEC_BATCH_NUM);
+      if (*numOfBlocks >= maxBlocks) {
+        stDebug("s-task:%s batch size limit:%d reached, start to process blocks", id, maxBlocks);
 
         *blockSize = streamQueueItemGetSize(*pInput);
         if (taskLevel == TASK_LEVEL__SINK) {
@@ -257,6 +269,122 @@ int32_t streamTaskGetDataFromInputQ(SStreamTask* pTask, SStreamQueueItem** pInpu
   }
 }
 
+void streamTaskInitBatchInfo(STaskBatchInfo* pBatch) {
+  memset(pBatch, 0, sizeof(STaskBatchInfo));
+  pBatch->maxBlocks = INIT_STREAM_EXEC_BATCH_NUM;
+}
+
+// Waiting for more blocks only pays off if the blocks already extracted can still be executed within the latency
+// target, otherwise start to process them immediately.
+static int32_t streamTaskGetBatchWaitDuration(SStreamTask* pTask, int32_t numOfBlocks) {
+  if (numOfBlocks == 0) {
+    return WAIT_FOR_DURATION;
+  }
+
+  STaskBatchInfo* pBatch = &pTask->execInfo.batch;
+
+  double waitMs = (taosGetTimestampUs() - pBatch->firstTs) / 1000.0;
+  double remain = tsStreamExecLatency - waitMs - numOfBlocks * pBatch->blockCost;
+  if (remain <= 0) {
+    stDebug("s-task:%s no latency budget left, waited:%.2fms, blocks:%d, est cost:%.2fms per block", pTask->id.idStr,
+            waitMs, numOfBlocks, pBatch->blockCost);
+    return 0;
+  }
+
+  return (int32_t)TMIN(remain, WAIT_FOR_DURATION);
+}
+
+static void streamExecHistoAdd(SStreamExecHisto* pHisto, double val) {
+  int32_t slot = 0;
+  for (int64_t v = (int64_t)val; v > 0 && slot < STREAM_EXEC_HISTO_SLOTS - 1; v >>= 1) {
+    slot += 1;
+  }
+
+  pHisto->slots[slot] += 1;
+  pHisto->count += 1;
+  pHisto->sum += val;
+}
+
+void streamTaskRecordBatchExec(SStreamTask* pTask, int32_t numOfBlocks, int64_t startTs, int64_t el) {
+  STaskBatchInfo* pBatch = &pTask->execInfo.batch;
+  if (numOfBlocks <= 0) {
+    return;
+  }
+
+  double execMs = el / 1000.0;
+  double queueMs = TMAX(startTs - pBatch->firstTs, 0) / 1000.0;
+
+  streamExecHistoAdd(&pBatch->histo[STREAM_EXEC_HISTO_BATCH_SIZE], numOfBlocks);
+  streamExecHistoAdd(&pBatch->histo[STREAM_EXEC_HISTO_EXEC_TIME], execMs);
+  streamExecHistoAdd(&pBatch->histo[STREAM_EXEC_HISTO_QUEUE_TIME], queueMs);
+
+  double cost = execMs / numOfBlocks;
+  if (pBatch->blockCost <= 0) {
+    pBatch->blockCost = cost;
+  } else {
+    pBatch->blockCost += (cost - pBatch->blockCost) * STREAM_EXEC_COST_SMOOTH_FACTOR;
+  }
+
+  // the number of blocks that can be executed in one batch within the latency target
+  int32_t limit = MAX_STREAM_EXEC_BATCH_NUM;
+  if (pBatch->blockCost > 0) {
+    limit = (int32_t)TMIN(tsStreamExecLatency / pBatch->blockCost, MAX_STREAM_EXEC_BATCH_NUM);
+  }
+
+  // blocks pile up in inputQ, and the latency target is missed already. Grow the batch to amortize the per-execution
+  // overhead, so the backlog is consumed faster.
+  int32_t numOfItems = streamQueueGetNumOfItems(pTask->inputq.queue);
+  if (numOfItems > limit && queueMs > tsStreamExecLatency) {
+    limit = TMIN(TMAX(limit, 1) * 2, MAX_STREAM_EXEC_BATCH_NUM);
+  }
+
+  // move half of the way to the new limit in each round to avoid oscillation
+  int32_t prev = pBatch->maxBlocks;
+  pBatch->maxBlocks = TMAX((prev + limit + 1) / 2, 1);
+
+  if (prev != pBatch->maxBlocks) {
+    stDebug("s-task:%s batch limit %d->%d, blocks:%d exec:%.2fms queue:%.2fms cost:%.3fms per block, inputQ:%d",
+            pTask->id.idStr, prev, pBatch->maxBlocks, numOfBlocks, execMs, queueMs, pBatch->blockCost, numOfItems);
+  }
+}
+
+static void streamExecHistoSummary(const SStreamExecHisto* pHisto, const SStreamExecHisto* pPrev,
+                                   SStreamExecSummary* pSummary) {
+  int64_t count = pHisto->count - pPrev->count;
+  if (count <= 0) {
+    pSummary->avg = 0;
+    pSummary->p99 = 0;
+    return;
+  }
+
+  pSummary->avg = (pHisto->sum - pPrev->sum) / count;
+
+  // the upper bound of the slot that holds the 99th percentile
+  int64_t threshold = count - count / 100;
+  int64_t acc = 0;
+  for (int32_t i = 0; i < STREAM_EXEC_HISTO_SLOTS; ++i) {
+    acc += pHisto->slots[i] - pPrev->slots[i];
+    if (acc >= threshold) {
+      pSummary->p99 = (double)(1LL << i);
+      return;
+    }
+  }
+
+  pSummary->p99 = (double)(1LL << (STREAM_EXEC_HISTO_SLOTS - 1));
+}
+
+// summarize the batches executed since the last hb, called by the hb timer only
+void streamTaskGetBatchSummary(SStreamTask* pTask, STaskStatusEntry* pEntry) {
+  STaskBatchInfo* pBatch = &pTask->execInfo.batch;
+
+  pEntry->maxBatchBlocks = pBatch->maxBlocks;
+  for (int32_t i = 0; i < STREAM_EXEC_HISTO_MAX; ++i) {
+    SStreamExecHisto snapshot = pBatch->histo[i];
+    streamExecHistoSummary(&snapshot, &pBatch->reported[i], &pEntry->execStat[i]);
+    pBatch->reported[i] = snapshot;
+  }
+}
+
 int32_t streamTaskPutDataIntoInputQ(SStreamTask* pTask, SStreamQueueItem* pItem) {
   int8_t      type = pItem->type;
   STaosQueue* pQueue = pTask->inputq.queue->pQueue;
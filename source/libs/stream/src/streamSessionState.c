@@ -97,6 +97,17 @@ SRowBuffPos* createSessionWinBuff(SStreamFileState* pFileState, SSessionKey* pKe
   return pNewPos;
 }
 
+// same as streamStateSessionAddIfNotExist_rocksdb, but skips the range scan if no session written to disk can be
+// within the gap of pKey.
+static int32_t getSessionWinFromDisk(SStreamFileState* pFileState, void* pFileStore, SSessionKey* pKey, TSKEY gap,
+                                     void** pVal, int32_t* pVLen) {
+  if (!mayHaveSessionOnDisk(pFileState, pKey->groupId, pKey->win.skey - gap, pKey->win.ekey + gap)) {
+    (*pVal) = taosMemoryCalloc(1, *pVLen);
+    return 1;
+  }
+  return streamStateSessionAddIfNotExist_rocksdb(pFileStore, pKey, gap, pVal, pVLen);
+}
+
 int32_t getSessionWinResultBuff(SStreamFileState* pFileState, SSessionKey* pKey, TSKEY gap, void** pVal, int32_t* pVLen) {
   int32_t code = TSDB_CODE_SUCCESS;
   SSHashObj* pSessionBuff = getRowStateBuff(pFileState);
@@ -116,7 +127,7 @@ int32_t getSessionWinResultBuff(SStreamFileState* pFileState, SSessionKey* pKey,
   if (size == 0) {
     void*   pFileStore = getStateFileStore(pFileState);
     void*   p = NULL;
-    int32_t code_file = streamStateSessionAddIfNotExist_rocksdb(pFileStore, pKey, gap, &p, pVLen);
+    int32_t code_file = getSessionWinFromDisk(pFileState, pFileStore, pKey, gap, &p, pVLen);
     if (code_file == TSDB_CODE_SUCCESS) {
       (*pVal) = createSessionWinBuff(pFileState, pKey, p, pVLen);
       code = code_file;
@@ -159,7 +170,7 @@ int32_t getSessionWinResultBuff(SStreamFileState* pFileState, SSessionKey* pKey,
     if (!isDeteled(pFileState, endTs) && isFlushedState(pFileState, endTs, gap)) {
       void*        p = NULL;
       void*        pFileStore = getStateFileStore(pFileState);
-      int32_t      code_file = streamStateSessionAddIfNotExist_rocksdb(pFileStore, pKey, gap, &p, pVLen);
+      int32_t      code_file = getSessionWinFromDisk(pFileState, pFileStore, pKey, gap, &p, pVLen);
       if (code_file == TSDB_CODE_SUCCESS || isFlushedState(pFileState, endTs, 0)) {
         (*pVal) = createSessionWinBuff(pFileState, pKey, p, pVLen);
         code = code_file;
@@ -377,6 +388,10 @@ SStreamStateCur* sessionWinStateSeekKeyCurrentPrev(SStreamFileState* pFileState,
     return pCur;
   }
 
+  if (!mayHaveSessionOnDisk(pFileState, pWinKey->groupId, INT64_MIN, pWinKey->win.skey)) {
+    return NULL;
+  }
+
   void* pFileStore = getStateFileStore(pFileState);
   pCur = streamStateSessionSeekKeyCurrentPrev_rocksdb(pFileStore, pWinKey);
   if (!pCur) {
@@ -421,7 +436,9 @@ SStreamStateCur* sessionWinStateSeekKeyCurrentNext(SStreamFileState* pFileState,
   }
 
   void* pFileStore = getStateFileStore(pFileState);
-  pCur = streamStateSessionSeekKeyCurrentNext_rocksdb(pFileStore, (SSessionKey*)pWinKey);
+  if (mayHaveSessionOnDisk(pFileState, pWinKey->groupId, pWinKey->win.skey, INT64_MAX)) {
+    pCur = streamStateSessionSeekKeyCurrentNext_rocksdb(pFileStore, (SSessionKey*)pWinKey);
+  }
   checkAndTransformCursor(pFileState, pWinKey->groupId, pWinStates, &pCur);
   return pCur;
 }
@@ -436,7 +453,9 @@ SStreamStateCur* sessionWinStateSeekKeyNext(SStreamFileState* pFileState, const
   }
 
   void* pFileStore = getStateFileStore(pFileState);
-  pCur = streamStateSessionSeekKeyNext_rocksdb(pFileStore, pWinKey);
+  if (mayHaveSessionOnDisk(pFileState, pWinKey->groupId, pWinKey->win.skey, INT64_MAX)) {
+    pCur = streamStateSessionSeekKeyNext_rocksdb(pFileStore, pWinKey);
+  }
   checkAndTransformCursor(pFileState, pWinKey->groupId, pWinStates, &pCur);
   return pCur;
 }
@@ -534,6 +553,16 @@ _end:
   return code;
 }
 
+// the neighbour of a state window can be anywhere in its group, so only a group without any window on disk is skipped.
+static int32_t getStateWinFromDisk(SStreamFileState* pFileState, void* pFileStore, SSessionKey* pKey, char* pKeyData,
+                                   int32_t keyDataLen, state_key_cmpr_fn fn, void** pVal, int32_t* pVLen) {
+  if (!mayHaveSessionOnDisk(pFileState, pKey->groupId, INT64_MIN, INT64_MAX)) {
+    (*pVal) = taosMemoryCalloc(1, *pVLen);
+    return 1;
+  }
+  return streamStateStateAddIfNotExist_rocksdb(pFileStore, pKey, pKeyData, keyDataLen, fn, pVal, pVLen);
+}
+
 int32_t getStateWinResultBuff(SStreamFileState* pFileState, SSessionKey* key, char* pKeyData, int32_t keyDataLen,
                              state_key_cmpr_fn fn, void** pVal, int32_t* pVLen) {
   SSessionKey* pWinKey = key;
@@ -556,7 +585,7 @@ int32_t getStateWinResultBuff(SStreamFileState* pFileState, SSessionKey* key, ch
   if (size == 0) {
     void*   pFileStore = getStateFileStore(pFileState);
     void*   p = NULL;
-    int32_t code_file = streamStateStateAddIfNotExist_rocksdb(pFileStore, pWinKey, pKeyData, keyDataLen, fn, &p, pVLen);
+    int32_t code_file = getStateWinFromDisk(pFileState, pFileStore, pWinKey, pKeyData, keyDataLen, fn, &p, pVLen);
     if (code_file == TSDB_CODE_SUCCESS) {
       (*pVal) = createSessionWinBuff(pFileState, pWinKey, p, pVLen);
       code = code_file;
@@ -602,8 +631,7 @@ int32_t getStateWinResultBuff(SStreamFileState* pFileState, SSessionKey* key, ch
     if (!isDeteled(pFileState, endTs)) {
       void*   p = NULL;
       void*   pFileStore = getStateFileStore(pFileState);
-      int32_t code_file =
-          streamStateStateAddIfNotExist_rocksdb(pFileStore, pWinKey, pKeyData, keyDataLen, fn, &p, pVLen);
+      int32_t code_file = getStateWinFromDisk(pFileState, pFileStore, pWinKey, pKeyData, keyDataLen, fn, &p, pVLen);
       if (code_file == TSDB_CODE_SUCCESS || isFlushedState(pFileState, endTs, 0)) {
         (*pVal) = createSessionWinBuff(pFileState, pWinKey, p, pVLen);
         code = code_file;
@@ -471,6 +471,7 @@ SStreamStateCur* streamStateFillGetCur(SStreamState* pState, const SWinKey* key)
 
 SStreamStateCur* streamStateGetAndCheckCur(SStreamState* pState, SWinKey* key) {
 #ifdef USE_ROCKSDB
+  streamFileStateWaitSpill(pState->pFileState);
   return streamStateGetAndCheckCur_rocksdb(pState, key);
 #else
   SStreamStateCur* pCur = streamStateFillGetCur(pState, key);
@@ -542,6 +543,7 @@ int32_t streamStateGetGroupKVByCur(SStreamStateCur* pCur, SWinKey* pKey, const v
 
 SStreamStateCur* streamStateSeekKeyNext(SStreamState* pState, const SWinKey* key) {
 #ifdef USE_ROCKSDB
+  streamFileStateWaitSpill(pState->pFileState);
   return streamStateSeekKeyNext_rocksdb(pState, key);
 #else
   SStreamStateCur* pCur = taosMemoryCalloc(1, sizeof(SStreamStateCur));
@@ -693,6 +695,7 @@ int32_t streamStateSessionPut(SStreamState* pState, const SSessionKey* key, void
       if (!pos->pRowBuff) {
         return code;
       }
+      putSessionDiskRange(pState->pFileState, key);
       code = streamStateSessionPut_rocksdb(pState, key, pos->pRowBuff, vLen);
       streamStateReleaseBuf(pState, pos, true);
       putFreeBuff(pState->pFileState, pos);
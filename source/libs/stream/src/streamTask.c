@@ -435,6 +435,7 @@ int32_t streamTaskInit(SStreamTask* pTask, SStreamMeta* pMeta, SMsgCb* pMsgCb, i
   }
 
   pTask->execInfo.created = taosGetTimestampMs();
+  streamTaskInitBatchInfo(&pTask->execInfo.batch);
   pTask->inputq.status = TASK_INPUT_STATUS__NORMAL;
   pTask->outputq.status = TASK_OUTPUT_STATUS__NORMAL;
   pTask->pMeta = pMeta;
@@ -796,5 +797,7 @@ void streamTaskStatusCopy(STaskStatusEntry* pDst, const STaskStatusEntry* pSrc)
   pDst->sinkDataSize = pSrc->sinkDataSize;
   pDst->activeCheckpointId = pSrc->activeCheckpointId;
   pDst->checkpointFailed = pSrc->checkpointFailed;
+  pDst->maxBatchBlocks = pSrc->maxBatchBlocks;
+  memcpy(pDst->execStat, pSrc->execStat, sizeof(pSrc->execStat));
 }
 
@@ -30,6 +30,10 @@
 #define TASK_KEY                       "streamFileState"
 #define STREAM_STATE_INFO_NAME         "StreamStateCheckPoint"
 
+#define SPILL_STATUS_IDLE    0
+#define SPILL_STATUS_PENDING 1
+#define SPILL_STATUS_DONE    2
+
 struct SStreamFileState {
   SList*   usedBuffs;
   SList*   freeBuffs;
@@ -57,10 +61,38 @@ struct SStreamFileState {
   _state_file_remove_fn stateFileRemoveFn;
   _state_file_get_fn    stateFileGetFn;
   _state_file_clear_fn  stateFileClearFn;
+
+  // the evicted rows are written into the file store by the spill thread, and can be read from pSpillBuff until the
+  // spill is reaped by the task thread.
+  bool             asyncSpill;
+  bool             spillThreadStarted;
+  bool             spillStop;
+  int8_t           spillStatus;
+  SStreamSnapshot* pSpillList;
+  SSHashObj*       pSpillBuff;
+  TdThread         spillThread;
+  TdThreadMutex    spillMutex;
+  TdThreadCond     spillCond;
+
+  // the key range of the session windows written into the file store, per group. if the file store was empty when the
+  // state was opened, a group without a range (or whose range misses the searched window) has nothing on disk, unless
+  // any session window is written into the file store by others, e.g. the fill history task sharing the task db.
+  SSHashObj* pSessionDiskRange;
+  bool       sessionDiskRangeComplete;
+  int64_t    sessionWritten;  // the session windows written into the file store by this state
+
+  int64_t numOfRead;
+  int64_t numOfMemHit;
+  int64_t numOfDiskHit;
 };
 
 typedef SRowBuffPos SRowBuffInfo;
 
+typedef struct SSessionDiskRange {
+  TSKEY minSKey;
+  TSKEY maxEKey;
+} SSessionDiskRange;
+
 int32_t stateHashBuffRemoveFn(void* pBuff, const void* pKey, size_t keyLen) {
   SRowBuffPos** pos = tSimpleHashGet(pBuff, pKey, keyLen);
   if (pos) {
@@ -139,6 +171,8 @@ SStreamFileState* streamFileStateInit(int64_t memSize, uint32_t keySize, uint32_
   if (!pFileState) {
     goto _error;
   }
+  taosThreadMutexInit(&pFileState->spillMutex, NULL);
+  taosThreadCondInit(&pFileState->spillCond, NULL);
   rowSize += selectRowSize;
   pFileState->maxRowCount = TMAX((uint64_t)memSize / rowSize, FLUSH_NUM * 2);
   pFileState->usedBuffs = tdListNew(POINTER_BYTES);
@@ -156,6 +190,8 @@ SStreamFileState* streamFileStateInit(int64_t memSize, uint32_t keySize, uint32_
     pFileState->stateFileGetFn = intervalFileGetFn;
     pFileState->stateFileClearFn = streamStateClear_rocksdb;
     pFileState->cfName = taosStrdup("state");
+    pFileState->pSpillBuff = tSimpleHashInit(cap, hashFn);
+    pFileState->asyncSpill = (pFileState->pSpillBuff != NULL);
   } else {
     pFileState->rowStateBuff = tSimpleHashInit(cap, hashFn);
     pFileState->stateBuffCleanupFn = sessionWinStateCleanup;
@@ -167,6 +203,7 @@ SStreamFileState* streamFileStateInit(int64_t memSize, uint32_t keySize, uint32_
     pFileState->stateFileGetFn = sessionFileGetFn;
     pFileState->stateFileClearFn = streamStateSessionClear_rocksdb;
     pFileState->cfName = taosStrdup("sess");
+    pFileState->pSessionDiskRange = tSimpleHashInit(cap, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT));
   }
 
   if (!pFileState->usedBuffs || !pFileState->freeBuffs || !pFileState->rowStateBuff) {
@@ -240,16 +277,96 @@ void destroyRowBuff(void* ptr) {
   taosMemoryFree(*(void**)ptr);
 }
 
+static int32_t doFlushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, bool flushState);
+
+static void* streamFileStateSpillThreadFp(void* param) {
+  SStreamFileState* pFileState = param;
+  setThreadName("stream-spill");
+
+  taosThreadMutexLock(&pFileState->spillMutex);
+  while (1) {
+    while (!pFileState->spillStop && pFileState->spillStatus != SPILL_STATUS_PENDING) {
+      taosThreadCondWait(&pFileState->spillCond, &pFileState->spillMutex);
+    }
+    if (pFileState->spillStatus != SPILL_STATUS_PENDING) {
+      break;
+    }
+    taosThreadMutexUnlock(&pFileState->spillMutex);
+
+    doFlushSnapshot(pFileState, pFileState->pSpillList, false);
+
+    taosThreadMutexLock(&pFileState->spillMutex);
+    pFileState->spillStatus = SPILL_STATUS_DONE;
+    taosThreadCondBroadcast(&pFileState->spillCond);
+  }
+  taosThreadMutexUnlock(&pFileState->spillMutex);
+  return NULL;
+}
+
+// return the row buffers of the written rows to the free list, and wait for the spill to complete if required
+static void streamFileStateReapSpill(SStreamFileState* pFileState, bool wait) {
+  if (pFileState->pSpillList == NULL) {
+    return;
+  }
+
+  taosThreadMutexLock(&pFileState->spillMutex);
+  if (!wait && pFileState->spillStatus != SPILL_STATUS_DONE) {
+    taosThreadMutexUnlock(&pFileState->spillMutex);
+    return;
+  }
+  while (pFileState->spillStatus != SPILL_STATUS_DONE) {
+    taosThreadCondWait(&pFileState->spillCond, &pFileState->spillMutex);
+  }
+  pFileState->spillStatus = SPILL_STATUS_IDLE;
+  taosThreadMutexUnlock(&pFileState->spillMutex);
+
+  SListIter iter = {0};
+  tdListInitIter(pFileState->pSpillList, &iter, TD_LIST_FORWARD);
+  SListNode* pNode = NULL;
+  while ((pNode = tdListNext(&iter)) != NULL) {
+    SRowBuffPos* pPos = *(SRowBuffPos**)pNode->data;
+    putFreeBuff(pFileState, pPos);
+  }
+
+  tdListFreeP(pFileState->pSpillList, destroyRowBuffPosPtr);
+  pFileState->pSpillList = NULL;
+  tSimpleHashClear(pFileState->pSpillBuff);
+}
+
+static void streamFileStateStopSpill(SStreamFileState* pFileState) {
+  streamFileStateReapSpill(pFileState, true);
+  if (pFileState->spillThreadStarted) {
+    taosThreadMutexLock(&pFileState->spillMutex);
+    pFileState->spillStop = true;
+    taosThreadCondBroadcast(&pFileState->spillCond);
+    taosThreadMutexUnlock(&pFileState->spillMutex);
+    taosThreadJoin(pFileState->spillThread, NULL);
+    pFileState->spillThreadStarted = false;
+  }
+}
+
+void streamFileStateWaitSpill(SStreamFileState* pFileState) {
+  if (pFileState != NULL) {
+    streamFileStateReapSpill(pFileState, true);
+  }
+}
+
 void streamFileStateDestroy(SStreamFileState* pFileState) {
   if (!pFileState) {
     return;
   }
 
+  streamFileStateStopSpill(pFileState);
+
   taosMemoryFree(pFileState->id);
   taosMemoryFree(pFileState->cfName);
+  tSimpleHashCleanup(pFileState->pSpillBuff);
+  tSimpleHashCleanup(pFileState->pSessionDiskRange);
   tdListFreeP(pFileState->usedBuffs, destroyRowBuffAllPosPtr);
   tdListFreeP(pFileState->freeBuffs, destroyRowBuff);
   pFileState->stateBuffCleanupFn(pFileState->rowStateBuff);
+  taosThreadCondDestroy(&pFileState->spillCond);
+  taosThreadMutexDestroy(&pFileState->spillMutex);
   taosMemoryFree(pFileState);
 }
 
@@ -302,6 +419,7 @@ void clearFlushedRowBuff(SStreamFileState* pFileState, SStreamSnapshot* pFlushLi
 }
 
 void streamFileStateClear(SStreamFileState* pFileState) {
+  streamFileStateReapSpill(pFileState, true);
   pFileState->flushMark = INT64_MIN;
   pFileState->maxTs = INT64_MIN;
   tSimpleHashClear(pFileState->rowStateBuff);
@@ -325,6 +443,13 @@ void popUsedBuffs(SStreamFileState* pFileState, SStreamSnapshot* pFlushList, uin
         ASSERT(pPos->needFree == true);
         continue;
       }
+      // clock eviction: the row accessed since the last scan gets a second chance at the tail of the list
+      if (!used && pPos->beReferenced) {
+        pPos->beReferenced = false;
+        tdListPopNode(pFileState->usedBuffs, pNode);
+        tdListAppendNode(pFileState->usedBuffs, pNode);
+        continue;
+      }
       tdListAppend(pFlushList, &pPos);
       pFileState->flushMark = TMAX(pFileState->flushMark, pFileState->getTs(pPos->pKey));
       pFileState->stateBuffRemoveByPosFn(pFileState, pPos);
@@ -356,7 +481,7 @@ int32_t flushRowBuff(SStreamFileState* pFileState) {
     }
   }
 
-  flushSnapshot(pFileState, pFlushList, false);
+  doFlushSnapshot(pFileState, pFlushList, false);
 
   SListIter fIter = {0};
   tdListInitIter(pFlushList, &fIter, TD_LIST_FORWARD);
@@ -372,12 +497,75 @@ int32_t flushRowBuff(SStreamFileState* pFileState) {
 
 int32_t clearRowBuff(SStreamFileState* pFileState) {
   clearExpiredRowBuff(pFileState, pFileState->maxTs - pFileState->deleteMark, false);
+  if (isListEmpty(pFileState->freeBuffs)) {
+    streamFileStateReapSpill(pFileState, true);
+  }
   if (isListEmpty(pFileState->freeBuffs)) {
     return flushRowBuff(pFileState);
   }
   return TSDB_CODE_SUCCESS;
 }
 
+// evict the rows in advance when the free row buffers are about to run out, and write them in the spill thread, so that
+// the task thread does not wait for the file store.
+static void mayStartSpill(SStreamFileState* pFileState) {
+  if (!pFileState->asyncSpill || pFileState->curRowCount < pFileState->maxRowCount) {
+    return;
+  }
+
+  uint64_t num = TMAX((uint64_t)(pFileState->curRowCount * FLUSH_RATIO), FLUSH_NUM);
+  if (listNEles(pFileState->freeBuffs) > num / 4) {
+    return;
+  }
+
+  streamFileStateReapSpill(pFileState, false);
+  if (pFileState->pSpillList != NULL) {
+    return;
+  }
+
+  SStreamSnapshot* pSpillList = tdListNew(POINTER_BYTES);
+  if (pSpillList == NULL) {
+    return;
+  }
+
+  // the rows in use can not be evicted, since the row buffers are held by the operator
+  clearFlushedRowBuff(pFileState, pSpillList, num);
+  if (isListEmpty(pSpillList)) {
+    popUsedBuffs(pFileState, pSpillList, num, false);
+  }
+  if (isListEmpty(pSpillList)) {
+    tdListFree(pSpillList);
+    return;
+  }
+
+  SListIter iter = {0};
+  tdListInitIter(pSpillList, &iter, TD_LIST_FORWARD);
+  SListNode* pNode = NULL;
+  while ((pNode = tdListNext(&iter)) != NULL) {
+    SRowBuffPos* pPos = *(SRowBuffPos**)pNode->data;
+    tSimpleHashPut(pFileState->pSpillBuff, pPos->pKey, pFileState->keyLen, &pPos, POINTER_BYTES);
+  }
+
+  if (!pFileState->spillThreadStarted) {
+    if (taosThreadCreate(&pFileState->spillThread, NULL, streamFileStateSpillThreadFp, pFileState) != 0) {
+      qError("%s failed to create stream state spill thread, flush in task thread", pFileState->id);
+      pFileState->asyncSpill = false;
+      doFlushSnapshot(pFileState, pSpillList, false);
+      pFileState->pSpillList = pSpillList;
+      pFileState->spillStatus = SPILL_STATUS_DONE;
+      streamFileStateReapSpill(pFileState, true);
+      return;
+    }
+    pFileState->spillThreadStarted = true;
+  }
+
+  taosThreadMutexLock(&pFileState->spillMutex);
+  pFileState->pSpillList = pSpillList;
+  pFileState->spillStatus = SPILL_STATUS_PENDING;
+  taosThreadCondSignal(&pFileState->spillCond);
+  taosThreadMutexUnlock(&pFileState->spillMutex);
+}
+
 void* getFreeBuff(SStreamFileState* pFileState) {
   SList*     lists = pFileState->freeBuffs;
   int32_t    buffSize = pFileState->rowSize;
@@ -400,6 +588,10 @@ int32_t streamFileStateClearBuff(SStreamFileState* pFileState, SRowBuffPos* pPos
 }
 
 SRowBuffPos* getNewRowPos(SStreamFileState* pFileState) {
+  // start the spill before the new row is in the used list, it has no key yet and is not in use, so it must not be
+  // evicted before the caller takes it
+  mayStartSpill(pFileState);
+
   SRowBuffPos* pPos = taosMemoryCalloc(1, sizeof(SRowBuffPos));
   pPos->pKey = taosMemoryCalloc(1, pFileState->keyLen);
   void* pBuff = getFreeBuff(pFileState);
@@ -438,26 +630,39 @@ SRowBuffPos* getNewRowPosForWrite(SStreamFileState* pFileState) {
 
 int32_t getRowBuff(SStreamFileState* pFileState, void* pKey, int32_t keyLen, void** pVal, int32_t* pVLen) {
   pFileState->maxTs = TMAX(pFileState->maxTs, pFileState->getTs(pKey));
+  pFileState->numOfRead++;
   SRowBuffPos** pos = tSimpleHashGet(pFileState->rowStateBuff, pKey, keyLen);
   if (pos) {
     *pVLen = pFileState->rowSize;
     *pVal = *pos;
     (*pos)->beUsed = true;
     (*pos)->beFlushed = false;
+    (*pos)->beReferenced = true;
+    pFileState->numOfMemHit++;
     return TSDB_CODE_SUCCESS;
   }
   SRowBuffPos* pNewPos = getNewRowPosForWrite(pFileState);
   ASSERT(pNewPos->pRowBuff);
   memcpy(pNewPos->pKey, pKey, keyLen);
 
+  // the evicted row may be still in the spill buffer, which is read only before the spill is reaped
+  SRowBuffPos** ppSpillPos = NULL;
+  if (pFileState->pSpillList != NULL) {
+    ppSpillPos = tSimpleHashGet(pFileState->pSpillBuff, pKey, keyLen);
+  }
+
   TSKEY ts = pFileState->getTs(pKey);
-  if (!isDeteled(pFileState, ts) && isFlushedState(pFileState, ts, 0)) {
+  if (ppSpillPos != NULL) {
+    memcpy(pNewPos->pRowBuff, (*ppSpillPos)->pRowBuff, pFileState->rowSize);
+    pFileState->numOfMemHit++;
+  } else if (!isDeteled(pFileState, ts) && isFlushedState(pFileState, ts, 0)) {
     int32_t len = 0;
     void*   p = NULL;
     int32_t code = streamStateGet_rocksdb(pFileState->pFileStore, pKey, &p, &len);
     qDebug("===stream===get %" PRId64 " from disc, res %d", ts, code);
     if (code == TSDB_CODE_SUCCESS) {
       memcpy(pNewPos->pRowBuff, p, len);
+      pFileState->numOfDiskHit++;
     }
     taosMemoryFree(p);
   }
@@ -471,6 +676,10 @@ int32_t getRowBuff(SStreamFileState* pFileState, void* pKey, int32_t keyLen, voi
 }
 
 int32_t deleteRowBuff(SStreamFileState* pFileState, const void* pKey, int32_t keyLen) {
+  // the row being written by the spill thread can not be removed from the file store until it is written
+  if (pFileState->pSpillList != NULL && tSimpleHashGet(pFileState->pSpillBuff, pKey, keyLen) != NULL) {
+    streamFileStateReapSpill(pFileState, true);
+  }
   int32_t code_buff = pFileState->stateBuffRemoveFn(pFileState->rowStateBuff, pKey, keyLen);
   int32_t code_file = pFileState->stateFileRemoveFn(pFileState, pKey);
   if (code_buff == TSDB_CODE_SUCCESS || code_file == TSDB_CODE_SUCCESS) {
@@ -492,6 +701,7 @@ int32_t getRowBuffByPos(SStreamFileState* pFileState, SRowBuffPos* pPos, void**
     if (pPos->needFree) {
       recoverSessionRowBuff(pFileState, pPos);
     }
+    pPos->beReferenced = true;
     (*pVal) = pPos->pRowBuff;
     return TSDB_CODE_SUCCESS;
   }
@@ -533,6 +743,17 @@ SStreamSnapshot* getSnapshot(SStreamFileState* pFileState) {
 }
 
 int32_t flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, bool flushState) {
+  // the rows being written by the spill thread must reach the file store before the snapshot
+  streamFileStateReapSpill(pFileState, true);
+  if (flushState && pFileState->numOfRead > 0) {
+    qInfo("%s stream state buff read:%" PRId64 ", mem hit ratio:%.2f%%, disk hit ratio:%.2f%%", pFileState->id,
+          pFileState->numOfRead, pFileState->numOfMemHit * 100.0 / pFileState->numOfRead,
+          pFileState->numOfDiskHit * 100.0 / pFileState->numOfRead);
+  }
+  return doFlushSnapshot(pFileState, pSnapshot, flushState);
+}
+
+static int32_t doFlushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, bool flushState) {
   int32_t   code = TSDB_CODE_SUCCESS;
   SListIter iter = {0};
   tdListInitIter(pSnapshot, &iter, TD_LIST_FORWARD);
@@ -555,9 +776,15 @@ int32_t flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot,
       continue;
     }
     pPos->beFlushed = true;
-    pFileState->flushMark = TMAX(pFileState->flushMark, pFileState->getTs(pPos->pKey));
+    if (pSnapshot != pFileState->pSpillList) {
+      // the flush mark of the spilled rows has been updated when they are evicted
+      pFileState->flushMark = TMAX(pFileState->flushMark, pFileState->getTs(pPos->pKey));
+    }
 
     qDebug("===stream===flushed start:%" PRId64, pFileState->getTs(pPos->pKey));
+    if (pFileState->pSessionDiskRange) {
+      putSessionDiskRange(pFileState, pPos->pKey);
+    }
     if (streamStateGetBatchSize(batch) >= BATCH_LIMIT) {
       streamStatePutBatch_rocksdb(pFileState->pFileStore, batch);
       streamStateClearBatch(batch);
@@ -656,8 +883,13 @@ int32_t recoverSesssion(SStreamFileState* pFileState, int64_t ckId) {
     deleteExpiredCheckPoint(pFileState, mark);
   }
 
+  // the session windows written by the other states of the task db after this count are not in pSessionDiskRange
+  int64_t          numOfWritten = streamStateAddSessionWritten_rocksdb(pFileState->pFileStore, 0);
   SStreamStateCur* pCur = streamStateSessionSeekToLast_rocksdb(pFileState->pFileStore);
   if (pCur == NULL) {
+    // nothing on disk yet, so every session written from now on by this state is tracked by pSessionDiskRange
+    pFileState->sessionWritten = numOfWritten;
+    pFileState->sessionDiskRangeComplete = true;
     return -1;
   }
   int32_t recoverNum = TMIN(MIN_NUM_OF_ROW_BUFF, pFileState->maxRowCount);
@@ -729,9 +961,17 @@ int32_t recoverSnapshot(SStreamFileState* pFileState, int64_t ckId) {
 
 int32_t streamFileStateGeSelectRowSize(SStreamFileState* pFileState) { return pFileState->selectivityRowSize; }
 
+void streamFileStateGetHitRatio(SStreamFileState* pFileState, double* pMemRatio, double* pDiskRatio) {
+  int64_t numOfRead = TMAX(pFileState->numOfRead, 1);
+  *pMemRatio = (double)pFileState->numOfMemHit / numOfRead;
+  *pDiskRatio = (double)pFileState->numOfDiskHit / numOfRead;
+}
+
 void streamFileStateReloadInfo(SStreamFileState* pFileState, TSKEY ts) {
   pFileState->flushMark = TMAX(pFileState->flushMark, ts);
   pFileState->maxTs = TMAX(pFileState->maxTs, ts);
+  // the session windows of the fill history task are transferred by the file store, none of them is in the range
+  pFileState->sessionDiskRangeComplete = false;
 }
 
 void* getRowStateBuff(SStreamFileState* pFileState) { return pFileState->rowStateBuff; }
@@ -744,4 +984,43 @@ bool isDeteled(SStreamFileState* pFileState, TSKEY ts) {
 
 bool isFlushedState(SStreamFileState* pFileState, TSKEY ts, TSKEY gap) { return ts <= (pFileState->flushMark + gap); }
 
+void putSessionDiskRange(SStreamFileState* pFileState, const SSessionKey* pKey) {
+  if (!pFileState->pSessionDiskRange) {
+    return;
+  }
+
+  // counted by this state before the task db, so the windows of this state are never taken as the ones of others
+  atomic_add_fetch_64(&pFileState->sessionWritten, 1);
+  streamStateAddSessionWritten_rocksdb(pFileState->pFileStore, 1);
+
+  SSessionDiskRange* pRange = tSimpleHashGet(pFileState->pSessionDiskRange, &pKey->groupId, sizeof(uint64_t));
+  if (pRange) {
+    pRange->minSKey = TMIN(pRange->minSKey, pKey->win.skey);
+    pRange->maxEKey = TMAX(pRange->maxEKey, pKey->win.ekey);
+    return;
+  }
+
+  SSessionDiskRange range = {.minSKey = pKey->win.skey, .maxEKey = pKey->win.ekey};
+  if (tSimpleHashPut(pFileState->pSessionDiskRange, &pKey->groupId, sizeof(uint64_t), &range, sizeof(range)) != 0) {
+    // the range of this group is lost, fall back to searching the file store for all groups
+    pFileState->sessionDiskRangeComplete = false;
+  }
+}
+
+bool mayHaveSessionOnDisk(SStreamFileState* pFileState, uint64_t groupId, TSKEY skey, TSKEY ekey) {
+  if (!pFileState->sessionDiskRangeComplete || !pFileState->pSessionDiskRange) {
+    return true;
+  }
+
+  int64_t numOfWritten = streamStateAddSessionWritten_rocksdb(pFileState->pFileStore, 0);
+  if (numOfWritten > atomic_load_64(&pFileState->sessionWritten)) {
+    qDebug("%s session windows are written into the file store by others, search it for all groups", pFileState->id);
+    pFileState->sessionDiskRangeComplete = false;
+    return true;
+  }
+
+  SSessionDiskRange* pRange = tSimpleHashGet(pFileState->pSessionDiskRange, &groupId, sizeof(uint64_t));
+  return pRange != NULL && pRange->minSKey <= ekey && pRange->maxEKey >= skey;
+}
+
 int32_t getRowStateRowSize(SStreamFileState* pFileState) { return pFileState->rowSize; }
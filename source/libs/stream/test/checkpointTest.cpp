@@ -66,3 +66,254 @@ TEST(testCase, checkpointDeleteFile_Test) {
   char* id = "2013892036";
   deleteCheckpointFile(id, "offset-ver0");
 }
+
+static void buildChkpDir(const char* path, const char* manifest, const char** sst, int32_t num) {
+  taosMulMkDir(path);
+  const char* names[8] = {"CURRENT", manifest};
+  for (int32_t i = 0; i < num; i++) {
+    names[i + 2] = sst[i];
+  }
+
+  for (int32_t i = 0; i < num + 2; i++) {
+    char fname[PATH_MAX] = {0};
+    snprintf(fname, sizeof(fname), "%s/%s", path, names[i]);
+    TdFilePtr pFile = taosOpenFile(fname, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+    taosWriteFile(pFile, names[i], strlen(names[i]));
+    taosCloseFile(&pFile);
+  }
+}
+
+static bool fileInDir(const char* path, const char* name) {
+  char fname[PATH_MAX] = {0};
+  snprintf(fname, sizeof(fname), "%s/%s", path, name);
+  return taosCheckExistFile(fname);
+}
+
+static bool fileInList(SArray* list, const char* name) {
+  for (int32_t i = 0; i < taosArrayGetSize(list); i++) {
+    if (strcmp((char*)taosArrayGetP(list, i), name) == 0) return true;
+  }
+  return false;
+}
+
+TEST(testCase, checkpointIncrementalUpload_Test) {
+  const char* base = "/tmp/stream_chkp_incr";
+  taosRemoveDir(base);
+
+  const char* sst1[] = {"000001.sst", "000002.sst"};
+  buildChkpDir("/tmp/stream_chkp_incr/task/checkpoints/checkpoint1", "MANIFEST-000005", sst1, 2);
+  const char* sst2[] = {"000002.sst", "000003.sst"};
+  buildChkpDir("/tmp/stream_chkp_incr/task/checkpoints/checkpoint2", "MANIFEST-000007", sst2, 2);
+
+  SBkdMgt* bm = bkdMgtCreate((char*)base);
+
+  // the first checkpoint is uploaded in whole
+  const char* up1 = "/tmp/stream_chkp_incr/up1";
+  taosMulMkDir(up1);
+  ASSERT_EQ(bkdMgtGetDelta(bm, "task", 1, (char*)up1), 0);
+  EXPECT_TRUE(fileInDir(up1, "000001.sst"));
+  EXPECT_TRUE(fileInDir(up1, "000002.sst"));
+  EXPECT_TRUE(fileInDir(up1, "CURRENT_1"));
+  EXPECT_TRUE(fileInDir(up1, "MANIFEST-000005_1"));
+  EXPECT_TRUE(fileInDir(up1, "CHKP_1"));
+  EXPECT_TRUE(fileInDir(up1, "META"));
+
+  // only the newly added sst file of the second checkpoint is uploaded
+  const char* up2 = "/tmp/stream_chkp_incr/up2";
+  taosMulMkDir(up2);
+  ASSERT_EQ(bkdMgtGetDelta(bm, "task", 2, (char*)up2), 0);
+  EXPECT_FALSE(fileInDir(up2, "000001.sst"));
+  EXPECT_FALSE(fileInDir(up2, "000002.sst"));
+  EXPECT_TRUE(fileInDir(up2, "000003.sst"));
+  EXPECT_TRUE(fileInDir(up2, "CURRENT_2"));
+  EXPECT_TRUE(fileInDir(up2, "MANIFEST-000007_2"));
+  EXPECT_TRUE(fileInDir(up2, "CHKP_2"));
+
+  // both checkpoints are retained, nothing to delete
+  SArray* retained = taosArrayInit(2, sizeof(int64_t));
+  int64_t id = 1;
+  taosArrayPush(retained, &id);
+  id = 2;
+  taosArrayPush(retained, &id);
+
+  SArray* list = taosArrayInit(4, POINTER_BYTES);
+  SArray* ids = taosArrayInit(4, sizeof(int64_t));
+  ASSERT_EQ(bkdMgtGetObsolete(bm, "task", retained, ids, list), 0);
+  EXPECT_EQ(taosArrayGetSize(list), 0);
+  EXPECT_EQ(taosArrayGetSize(ids), 0);
+
+  // checkpoint 1 is obsolete, and the sst file shared with checkpoint 2 is kept
+  taosArrayRemove(retained, 0);
+  ASSERT_EQ(bkdMgtGetObsolete(bm, "task", retained, ids, list), 0);
+  EXPECT_EQ(taosArrayGetSize(list), 4);
+  EXPECT_TRUE(fileInList(list, "CURRENT_1"));
+  EXPECT_TRUE(fileInList(list, "MANIFEST-000005_1"));
+  EXPECT_TRUE(fileInList(list, "CHKP_1"));
+  EXPECT_TRUE(fileInList(list, "000001.sst"));
+  ASSERT_EQ(taosArrayGetSize(ids), 1);
+  EXPECT_EQ(*(int64_t*)taosArrayGet(ids, 0), 1);
+
+  // nothing is dropped until the files are deleted from the remote storage
+  taosArrayClearP(list, taosMemoryFree);
+  taosArrayClear(ids);
+  ASSERT_EQ(bkdMgtGetObsolete(bm, "task", retained, ids, list), 0);
+  EXPECT_EQ(taosArrayGetSize(list), 4);
+  bkdMgtDelObsolete(bm, "task", ids);
+
+  taosArrayClearP(list, taosMemoryFree);
+  taosArrayClear(ids);
+  ASSERT_EQ(bkdMgtGetObsolete(bm, "task", retained, ids, list), 0);
+  EXPECT_EQ(taosArrayGetSize(list), 0);
+
+  // the latest uploaded checkpoint is never deleted
+  taosArrayClear(retained);
+  ASSERT_EQ(bkdMgtGetObsolete(bm, "task", retained, ids, list), 0);
+  EXPECT_EQ(taosArrayGetSize(list), 0);
+  EXPECT_EQ(taosArrayGetSize(ids), 0);
+
+  taosArrayDestroyP(list, taosMemoryFree);
+  taosArrayDestroy(ids);
+  taosArrayDestroy(retained);
+  bkdMgtDestroy(bm);
+  taosRemoveDir(base);
+}
+
+// the remote storage of the checkpoints is a local dir in the tests below
+static const char* remoteDir = "/tmp/stream_chkp_remote/remote";
+
+static int downloadFromDir(char* id, char* fname, char* dstName) {
+  char src[PATH_MAX] = {0};
+  snprintf(src, sizeof(src), "%s/%s/%s", remoteDir, id, fname);
+  if (!taosCheckExistFile(src)) return -1;
+
+  taosRemoveFile(dstName);
+  return taosCopyFile(src, dstName) < 0 ? -1 : 0;
+}
+
+static void uploadToDir(const char* id, const char* path) {
+  char dst[PATH_MAX] = {0};
+  snprintf(dst, sizeof(dst), "%s/%s", remoteDir, id);
+  taosMulMkDir(dst);
+
+  TdDirPtr      pDir = taosOpenDir(path);
+  TdDirEntryPtr de = NULL;
+  while ((de = taosReadDir(pDir)) != NULL) {
+    char* name = taosGetDirEntryName(de);
+    if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) continue;
+
+    char src[PATH_MAX] = {0};
+    snprintf(src, sizeof(src), "%s/%s", path, name);
+    snprintf(dst, sizeof(dst), "%s/%s/%s", remoteDir, id, name);
+    taosRemoveFile(dst);
+    taosCopyFile(src, dst);
+  }
+  taosCloseDir(&pDir);
+}
+
+static void deleteFromDir(const char* id, SArray* list) {
+  for (int32_t i = 0; i < taosArrayGetSize(list); i++) {
+    char fname[PATH_MAX] = {0};
+    snprintf(fname, sizeof(fname), "%s/%s/%s", remoteDir, id, (char*)taosArrayGetP(list, i));
+    taosRemoveFile(fname);
+  }
+}
+
+static void uploadChkp(SBkdMgt* bm, int64_t chkpId, const char* up) {
+  taosRemoveDir(up);
+  taosMulMkDir(up);
+  ASSERT_EQ(bkdMgtGetDelta(bm, "task", chkpId, (char*)up), 0);
+  ASSERT_EQ(bkdMgtLoadRemote(bm, "task", "remoteTask", (char*)up, downloadFromDir), 0);
+  uploadToDir("remoteTask", up);
+}
+
+static bool fileContains(const char* path, const char* name, const char* str) {
+  char fname[PATH_MAX] = {0};
+  snprintf(fname, sizeof(fname), "%s/%s", path, name);
+
+  char      buf[1024] = {0};
+  TdFilePtr pFile = taosOpenFile(fname, TD_FILE_READ);
+  if (pFile == NULL) return false;
+  taosReadFile(pFile, buf, sizeof(buf) - 1);
+  taosCloseFile(&pFile);
+  return strstr(buf, str) != NULL;
+}
+
+TEST(testCase, checkpointRemoteRebuild_Test) {
+  const char* base = "/tmp/stream_chkp_remote";
+  taosRemoveDir(base);
+
+  const char* sst1[] = {"000001.sst", "000002.sst"};
+  buildChkpDir("/tmp/stream_chkp_remote/task/checkpoints/checkpoint1", "MANIFEST-000005", sst1, 2);
+  const char* sst2[] = {"000002.sst", "000003.sst"};
+  buildChkpDir("/tmp/stream_chkp_remote/task/checkpoints/checkpoint2", "MANIFEST-000007", sst2, 2);
+
+  // nothing in the remote storage before the first upload
+  SBkdMgt* bm = bkdMgtCreate((char*)base);
+  uploadChkp(bm, 1, "/tmp/stream_chkp_remote/up1");
+  uploadChkp(bm, 2, "/tmp/stream_chkp_remote/up2");
+  EXPECT_TRUE(fileContains("/tmp/stream_chkp_remote/up2", "CHKP_2", "CHKP_1\n"));
+  bkdMgtDestroy(bm);
+
+  // restart, the checkpoints uploaded before are loaded from the remote storage
+  const char* sst3[] = {"000003.sst", "000004.sst"};
+  buildChkpDir("/tmp/stream_chkp_remote/task/checkpoints/checkpoint3", "MANIFEST-000009", sst3, 2);
+
+  bm = bkdMgtCreate((char*)base);
+  const char* up3 = "/tmp/stream_chkp_remote/up3";
+  uploadChkp(bm, 3, up3);
+  EXPECT_TRUE(fileInDir(up3, "000003.sst"));
+  EXPECT_TRUE(fileInDir(up3, "000004.sst"));
+  EXPECT_TRUE(fileContains(up3, "CHKP_3", "CHKP_1\n"));
+  EXPECT_TRUE(fileContains(up3, "CHKP_3", "CHKP_2\n"));
+
+  // only checkpoint 3 is retained, the sst file shared by checkpoint 2 and 3 is kept
+  SArray* retained = taosArrayInit(2, sizeof(int64_t));
+  int64_t id = 3;
+  taosArrayPush(retained, &id);
+
+  SArray* list = taosArrayInit(4, POINTER_BYTES);
+  SArray* ids = taosArrayInit(4, sizeof(int64_t));
+  ASSERT_EQ(bkdMgtGetObsolete(bm, "task", retained, ids, list), 0);
+  EXPECT_EQ(taosArrayGetSize(ids), 2);
+  EXPECT_EQ(taosArrayGetSize(list), 8);
+  EXPECT_TRUE(fileInList(list, "000001.sst"));
+  EXPECT_TRUE(fileInList(list, "000002.sst"));
+  EXPECT_FALSE(fileInList(list, "000003.sst"));
+  EXPECT_TRUE(fileInList(list, "CURRENT_1"));
+  EXPECT_TRUE(fileInList(list, "MANIFEST-000005_1"));
+  EXPECT_TRUE(fileInList(list, "CHKP_1"));
+  EXPECT_TRUE(fileInList(list, "CURRENT_2"));
+  EXPECT_TRUE(fileInList(list, "MANIFEST-000007_2"));
+  EXPECT_TRUE(fileInList(list, "CHKP_2"));
+
+  deleteFromDir("remoteTask", list);
+  bkdMgtDelObsolete(bm, "task", ids);
+  bkdMgtDestroy(bm);
+
+  // restart again, the deleted checkpoints referenced by checkpoint 3 are skipped
+  const char* sst4[] = {"000004.sst", "000005.sst"};
+  buildChkpDir("/tmp/stream_chkp_remote/task/checkpoints/checkpoint4", "MANIFEST-000011", sst4, 2);
+
+  bm = bkdMgtCreate((char*)base);
+  uploadChkp(bm, 4, "/tmp/stream_chkp_remote/up4");
+  EXPECT_TRUE(fileContains("/tmp/stream_chkp_remote/up4", "CHKP_4", "CHKP_3\n"));
+  EXPECT_FALSE(fileContains("/tmp/stream_chkp_remote/up4", "CHKP_4", "CHKP_2\n"));
+
+  taosArrayClearP(list, taosMemoryFree);
+  taosArrayClear(ids);
+  taosArrayClear(retained);
+  id = 4;
+  taosArrayPush(retained, &id);
+  ASSERT_EQ(bkdMgtGetObsolete(bm, "task", retained, ids, list), 0);
+  ASSERT_EQ(taosArrayGetSize(ids), 1);
+  EXPECT_EQ(*(int64_t*)taosArrayGet(ids, 0), 3);
+  EXPECT_EQ(taosArrayGetSize(list), 4);
+  EXPECT_TRUE(fileInList(list, "000003.sst"));
+  EXPECT_FALSE(fileInList(list, "000004.sst"));
+
+  taosArrayDestroyP(list, taosMemoryFree);
+  taosArrayDestroy(ids);
+  taosArrayDestroy(retained);
+  bkdMgtDestroy(bm);
+  taosRemoveDir(base);
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "streamInt.h"
+#include "tglobal.h"
+
+namespace {
+const int64_t startTs = 1700000000000000LL;
+}  // namespace
+
+class StreamBatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    latency = tsStreamExecLatency;
+    tsStreamExecLatency = 100;
+
+    pTask = (SStreamTask*)taosMemoryCalloc(1, sizeof(SStreamTask));
+    pTask->id.idStr = "streamBatchTest";
+    pTask->inputq.queue = streamQueueOpen(1024);
+    ASSERT_NE(pTask->inputq.queue, nullptr);
+    streamTaskInitBatchInfo(&pTask->execInfo.batch);
+  }
+
+  void TearDown() override {
+    void* pItem = NULL;
+    while (taosReadQitem(pTask->inputq.queue->pQueue, &pItem) > 0) {
+      taosFreeQitem(pItem);
+    }
+    streamQueueClose(pTask->inputq.queue, 0);
+    taosMemoryFree(pTask);
+    tsStreamExecLatency = latency;
+  }
+
+  // execute a batch of blocks at the given cost per block, the first block has waited queueMs in inputQ
+  void execBatch(int32_t numOfBlocks, double costMs, double queueMs) {
+    pTask->execInfo.batch.firstTs = startTs;
+    streamTaskRecordBatchExec(pTask, numOfBlocks, startTs + (int64_t)(queueMs * 1000),
+                              (int64_t)(numOfBlocks * costMs * 1000));
+  }
+
+  // the limit no longer changes in the rounds of the same batch
+  int32_t execUntilStable(int32_t numOfBlocks, double costMs, double queueMs) {
+    STaskBatchInfo* pBatch = &pTask->execInfo.batch;
+    for (int32_t i = 0; i < 20; ++i) {
+      int32_t prev = pBatch->maxBlocks;
+      execBatch(numOfBlocks, costMs, queueMs);
+      if (pBatch->maxBlocks == prev) {
+        return pBatch->maxBlocks;
+      }
+    }
+
+    ADD_FAILURE() << "the batch limit does not converge, current:" << pBatch->maxBlocks;
+    return pBatch->maxBlocks;
+  }
+
+  void fillInputQ(int32_t numOfItems) {
+    for (int32_t i = 0; i < numOfItems; ++i) {
+      void* pItem = taosAllocateQitem(sizeof(int64_t), DEF_QITEM, 0);
+      ASSERT_NE(pItem, nullptr);
+      taosWriteQitem(pTask->inputq.queue->pQueue, pItem);
+    }
+    ASSERT_EQ(streamQueueGetNumOfItems(pTask->inputq.queue), numOfItems);
+  }
+
+  SStreamTask* pTask = NULL;
+  int32_t      latency = 0;
+};
+
+TEST_F(StreamBatchTest, limitConvergence) {
+  STaskBatchInfo* pBatch = &pTask->execInfo.batch;
+  EXPECT_EQ(pBatch->maxBlocks, 32);
+
+  // the limit moves half of the way toward latency / cost in each round: 32 -> 41 -> 46 -> 48 -> 49 -> 50
+  execBatch(10, 2, 0);
+  EXPECT_DOUBLE_EQ(pBatch->blockCost, 2);
+  EXPECT_EQ(pBatch->maxBlocks, 41);
+  EXPECT_EQ(execUntilStable(10, 2, 0), 50);
+
+  // the moving average of the cost follows the slower blocks, and the limit shrinks down to one block
+  execBatch(10, 12, 0);
+  EXPECT_DOUBLE_EQ(pBatch->blockCost, 4);
+  EXPECT_EQ(execUntilStable(10, 400, 0), 1);
+
+  // the cheap blocks are merged up to the upper bound
+  streamTaskInitBatchInfo(pBatch);
+  EXPECT_EQ(execUntilStable(10, 0.01, 0), 256);
+}
+
+TEST_F(StreamBatchTest, doublingUnderBacklog) {
+  STaskBatchInfo* pBatch = &pTask->execInfo.batch;
+  EXPECT_EQ(execUntilStable(10, 2, 0), 50);
+
+  // the backlog alone does not grow the batch if the latency target is still met
+  fillInputQ(300);
+  EXPECT_EQ(execUntilStable(10, 2, 50), 50);
+
+  // the target is missed and more blocks than the limit are waiting, the limit is doubled
+  execBatch(10, 2, 150);
+  EXPECT_EQ(pBatch->maxBlocks, 75);
+  EXPECT_EQ(execUntilStable(10, 2, 150), 100);
+
+  // but not above the upper bound
+  EXPECT_EQ(execUntilStable(10, 0.5, 150), 256);
+}
+
+TEST_F(StreamBatchTest, summaryP99) {
+  STaskBatchInfo*  pBatch = &pTask->execInfo.batch;
+  STaskStatusEntry entry;
+  memset(&entry, 0, sizeof(entry));
+
+  // 3 blocks fall into the slot [2, 4), 200 blocks into [128, 256)
+  for (int32_t i = 0; i < 99; ++i) {
+    execBatch(3, 1, 0);
+  }
+  execBatch(200, 0.01, 0);
+
+  streamTaskGetBatchSummary(pTask, &entry);
+  EXPECT_EQ(entry.maxBatchBlocks, pBatch->maxBlocks);
+  SStreamExecSummary* pSize = &entry.execStat[STREAM_EXEC_HISTO_BATCH_SIZE];
+  EXPECT_DOUBLE_EQ(pSize->avg, (99 * 3 + 200) / 100.0);
+  // 99 of 100 batches are in the slot of 3 blocks, its upper bound is the p99
+  EXPECT_DOUBLE_EQ(pSize->p99, 4);
+  // no batch waited in inputQ, all of them are in the first slot
+  EXPECT_DOUBLE_EQ(entry.execStat[STREAM_EXEC_HISTO_QUEUE_TIME].avg, 0);
+  EXPECT_DOUBLE_EQ(entry.execStat[STREAM_EXEC_HISTO_QUEUE_TIME].p99, 1);
+
+  // only the batches since the last summary are counted
+  execBatch(200, 0.01, 0);
+  execBatch(1, 0.01, 0);
+  streamTaskGetBatchSummary(pTask, &entry);
+  EXPECT_DOUBLE_EQ(pSize->avg, 100.5);
+  EXPECT_DOUBLE_EQ(pSize->p99, 256);
+
+  // the values beyond the last slot are counted in it
+  execBatch(1, 1000000, 0);
+  streamTaskGetBatchSummary(pTask, &entry);
+  EXPECT_DOUBLE_EQ(entry.execStat[STREAM_EXEC_HISTO_EXEC_TIME].avg, 1000000);
+  EXPECT_DOUBLE_EQ(entry.execStat[STREAM_EXEC_HISTO_EXEC_TIME].p99, 1 << (STREAM_EXEC_HISTO_SLOTS - 1));
+
+  // nothing is executed since the last summary
+  streamTaskGetBatchSummary(pTask, &entry);
+  for (int32_t i = 0; i < STREAM_EXEC_HISTO_MAX; ++i) {
+    EXPECT_DOUBLE_EQ(entry.execStat[i].avg, 0);
+    EXPECT_DOUBLE_EQ(entry.execStat[i].p99, 0);
+  }
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <taoserror.h>
+#include <set>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "streamInt.h"
+#include "streamState.h"
+#include "tstreamFileState.h"
+
+namespace {
+const char* statePath = "/tmp/streamFileStateTest";
+
+TSKEY getWinKeyTs(void* pKey) { return ((SWinKey*)pKey)->ts; }
+
+TSKEY getSessionKeyTs(void* pKey) { return ((SSessionKey*)pKey)->win.skey; }
+
+SSessionKey createSessionKey(uint64_t groupId, TSKEY skey, TSKEY ekey) {
+  SSessionKey key = {0};
+  key.groupId = groupId;
+  key.win.skey = skey;
+  key.win.ekey = ekey;
+  return key;
+}
+
+// each row is filled with the bytes derived from its index
+void fillRow(void* pRowBuff, int32_t size, int64_t index) {
+  memset(pRowBuff, (char)(index % 251 + 1), size);
+  memcpy(pRowBuff, &index, sizeof(index));
+}
+
+bool checkRow(const void* pRowBuff, int32_t size, int64_t index) {
+  int64_t val = 0;
+  memcpy(&val, pRowBuff, sizeof(val));
+  if (val != index) {
+    return false;
+  }
+  for (int32_t i = sizeof(index); i < size; ++i) {
+    if (((const char*)pRowBuff)[i] != (char)(index % 251 + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+class StreamFileStateTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    taosRemoveDir(statePath);
+    streamMetaInit();
+    pMeta = streamMetaOpen(statePath, NULL, NULL, 1, 0);
+    ASSERT_NE(pMeta, nullptr);
+
+    pTask = (SStreamTask*)taosMemoryCalloc(1, sizeof(SStreamTask));
+    pTask->id.streamId = 1023;
+    pTask->id.taskId = 1111;
+    pTask->pMeta = pMeta;
+    pState = streamStateOpen((char*)statePath, pTask, false, -1, -1);
+    ASSERT_NE(pState, nullptr);
+  }
+
+  void TearDown() override {
+    if (pState != NULL) {
+      streamStateClose(pState, true);
+    }
+    taosMemoryFree(pTask);
+    streamMetaClose(pMeta);
+    taosRemoveDir(statePath);
+  }
+
+  SStreamMeta*  pMeta = NULL;
+  SStreamTask*  pTask = NULL;
+  SStreamState* pState = NULL;
+};
+
+TEST_F(StreamFileStateTest, asyncSpillKeepsRowBuff) {
+  const int32_t rowSize = 256;
+  const int32_t maxRowCount = 64;
+  const int32_t numOfHeld = 16;
+  const int64_t numOfRows = maxRowCount * 8;
+
+  SStreamFileState* pFileState = streamFileStateInit(rowSize * maxRowCount, sizeof(SWinKey), rowSize, 0, getWinKeyTs,
+                                                     pState, INT64_MAX, "fileStateTest", 0, STREAM_STATE_BUFF_HASH);
+  ASSERT_NE(pFileState, nullptr);
+  pState->pFileState = pFileState;
+
+  // the operator holds the latest rows while the buffer is filled past its limit, and the older rows are spilled in
+  // the background
+  std::vector<SRowBuffPos*> held;
+  std::vector<int64_t>      heldIndex;
+  for (int64_t i = 0; i < numOfRows; ++i) {
+    SWinKey      key = {.groupId = 1, .ts = 1000 + i};
+    SRowBuffPos* pPos = NULL;
+    int32_t      len = 0;
+    ASSERT_EQ(getRowBuff(pFileState, &key, sizeof(SWinKey), (void**)&pPos, &len), TSDB_CODE_SUCCESS);
+    ASSERT_NE(pPos->pRowBuff, nullptr);
+    ASSERT_EQ(len, rowSize);
+    fillRow(pPos->pRowBuff, rowSize, i);
+    held.push_back(pPos);
+    heldIndex.push_back(i);
+
+    // every held row keeps its own row buffer, which is neither spilled nor given to another row
+    std::set<void*> buffs;
+    for (int32_t j = 0; j < held.size(); ++j) {
+      ASSERT_NE(held[j]->pRowBuff, nullptr) << "row " << heldIndex[j] << " lost its buffer at row " << i;
+      ASSERT_TRUE(buffs.insert(held[j]->pRowBuff).second) << "row " << heldIndex[j] << " shares its buffer";
+      ASSERT_TRUE(checkRow(held[j]->pRowBuff, rowSize, heldIndex[j])) << "row " << heldIndex[j] << " at row " << i;
+    }
+
+    if (held.size() > numOfHeld) {
+      streamFileStateReleaseBuff(pFileState, held.front(), false);
+      held.erase(held.begin());
+      heldIndex.erase(heldIndex.begin());
+    }
+  }
+
+  for (int32_t j = 0; j < held.size(); ++j) {
+    streamFileStateReleaseBuff(pFileState, held[j], false);
+  }
+
+  // the spilled rows are read back from the spill buffer or the file store
+  for (int64_t i = 0; i < numOfRows; ++i) {
+    SWinKey      key = {.groupId = 1, .ts = 1000 + i};
+    SRowBuffPos* pPos = NULL;
+    int32_t      len = 0;
+    ASSERT_EQ(getRowBuff(pFileState, &key, sizeof(SWinKey), (void**)&pPos, &len), TSDB_CODE_SUCCESS);
+    ASSERT_NE(pPos->pRowBuff, nullptr);
+    ASSERT_TRUE(checkRow(pPos->pRowBuff, rowSize, i)) << "row " << i;
+    streamFileStateReleaseBuff(pFileState, pPos, false);
+  }
+}
+
+// the windows of two groups are written until the oldest ones are flushed to the file store
+static void writeSessionWins(SStreamFileState* pFileState, int32_t rowSize, int64_t numOfWins) {
+  for (int64_t i = 0; i < numOfWins; ++i) {
+    SSessionKey  key = createSessionKey(i % 2 + 1, i * 1000, i * 1000 + 100);
+    SRowBuffPos* pPos = NULL;
+    int32_t      len = rowSize;
+    ASSERT_NE(getSessionWinResultBuff(pFileState, &key, 10, (void**)&pPos, &len), TSDB_CODE_SUCCESS);
+    ASSERT_NE(pPos, nullptr);
+    ASSERT_NE(pPos->pRowBuff, nullptr);
+    fillRow(pPos->pRowBuff, rowSize, i);
+    streamFileStateReleaseBuff(pFileState, pPos, false);
+  }
+}
+
+TEST_F(StreamFileStateTest, flushedSessionIsFound) {
+  const int32_t rowSize = 256;
+  const int32_t maxRowCount = 64;
+  const int64_t numOfWins = maxRowCount * 4;
+
+  // without delete mark, the windows are only removed from memory by the flush
+  SStreamFileState* pFileState = streamFileStateInit(rowSize * maxRowCount, sizeof(SSessionKey), rowSize, 0,
+                                                     getSessionKeyTs, pState, 0, "sessionTest", 0,
+                                                     STREAM_STATE_BUFF_SORT);
+  ASSERT_NE(pFileState, nullptr);
+  pState->pFileState = pFileState;
+
+  // nothing is on disk when the state is created
+  EXPECT_FALSE(mayHaveSessionOnDisk(pFileState, 1, INT64_MIN, INT64_MAX));
+  writeSessionWins(pFileState, rowSize, numOfWins);
+
+  // the first windows are flushed, the ones of a group without any window on disk are skipped
+  EXPECT_TRUE(mayHaveSessionOnDisk(pFileState, 1, INT64_MIN, 0));
+  EXPECT_TRUE(mayHaveSessionOnDisk(pFileState, 2, 1000, 1000));
+  EXPECT_FALSE(mayHaveSessionOnDisk(pFileState, 2, INT64_MIN, 999));
+  EXPECT_FALSE(mayHaveSessionOnDisk(pFileState, 3, INT64_MIN, INT64_MAX));
+
+  // the flushed window is found by a key after its end but within the gap
+  for (int64_t i = 0; i < 4; ++i) {
+    SSessionKey  key = createSessionKey(i % 2 + 1, i * 1000 + 105, i * 1000 + 105);
+    SRowBuffPos* pPos = NULL;
+    int32_t      len = rowSize;
+    ASSERT_EQ(getSessionWinResultBuff(pFileState, &key, 10, (void**)&pPos, &len), TSDB_CODE_SUCCESS) << "window " << i;
+    EXPECT_EQ(key.win.skey, i * 1000);
+    EXPECT_EQ(key.win.ekey, i * 1000 + 100);
+    ASSERT_NE(pPos->pRowBuff, nullptr);
+    EXPECT_TRUE(checkRow(pPos->pRowBuff, rowSize, i)) << "window " << i;
+    streamFileStateReleaseBuff(pFileState, pPos, false);
+  }
+
+  // a window of a group never flushed is created in memory
+  SSessionKey  key = createSessionKey(3, 0, 0);
+  SRowBuffPos* pPos = NULL;
+  int32_t      len = rowSize;
+  EXPECT_NE(getSessionWinResultBuff(pFileState, &key, 10, (void**)&pPos, &len), TSDB_CODE_SUCCESS);
+  ASSERT_NE(pPos, nullptr);
+  streamFileStateReleaseBuff(pFileState, pPos, false);
+}
+
+TEST_F(StreamFileStateTest, restartWithSessionsOnDisk) {
+  const int32_t rowSize = 256;
+  const int32_t maxRowCount = 64;
+
+  SStreamFileState* pFileState = streamFileStateInit(rowSize * maxRowCount, sizeof(SSessionKey), rowSize, 0,
+                                                     getSessionKeyTs, pState, 0, "sessionTest", 0,
+                                                     STREAM_STATE_BUFF_SORT);
+  ASSERT_NE(pFileState, nullptr);
+  pState->pFileState = pFileState;
+  writeSessionWins(pFileState, rowSize, maxRowCount * 4);
+  // the checkpoint writes the windows in memory and the flush mark
+  flushSnapshot(pFileState, getSnapshot(pFileState), true);
+  streamFileStateDestroy(pFileState);
+  pState->pFileState = NULL;
+
+  // the windows written by the previous run are not indexed, so every group may have windows on disk
+  pFileState = streamFileStateInit(rowSize * maxRowCount, sizeof(SSessionKey), rowSize, 0, getSessionKeyTs, pState, 0,
+                                   "sessionTest", 0, STREAM_STATE_BUFF_SORT);
+  ASSERT_NE(pFileState, nullptr);
+  pState->pFileState = pFileState;
+  EXPECT_TRUE(mayHaveSessionOnDisk(pFileState, 1, INT64_MIN, 0));
+  EXPECT_TRUE(mayHaveSessionOnDisk(pFileState, 3, INT64_MIN, INT64_MAX));
+
+  // only the latest windows are recovered into memory, the first one is read from disk
+  SSessionKey  key = createSessionKey(1, 105, 105);
+  SRowBuffPos* pPos = NULL;
+  int32_t      len = rowSize;
+  ASSERT_EQ(getSessionWinResultBuff(pFileState, &key, 10, (void**)&pPos, &len), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(key.win.skey, 0);
+  EXPECT_TRUE(checkRow(pPos->pRowBuff, rowSize, 0));
+  streamFileStateReleaseBuff(pFileState, pPos, false);
+}
+
+TEST_F(StreamFileStateTest, sessionsOfFillHistoryTask) {
+  const int32_t rowSize = 256;
+  const int32_t maxRowCount = 64;
+
+  SStreamFileState* pFileState = streamFileStateInit(rowSize * maxRowCount, sizeof(SSessionKey), rowSize, 0,
+                                                     getSessionKeyTs, pState, 0, "sessionTest", 0,
+                                                     STREAM_STATE_BUFF_SORT);
+  ASSERT_NE(pFileState, nullptr);
+  pState->pFileState = pFileState;
+  EXPECT_FALSE(mayHaveSessionOnDisk(pFileState, 1, INT64_MIN, INT64_MAX));
+
+  // the fill history task opens its state with the id of the stream task, so both of them share the same task db
+  SStreamTask* pHistoryTask = (SStreamTask*)taosMemoryCalloc(1, sizeof(SStreamTask));
+  pHistoryTask->id = pTask->id;
+  pHistoryTask->pMeta = pMeta;
+  SStreamState* pHistoryState = streamStateOpen((char*)statePath, pHistoryTask, false, -1, -1);
+  ASSERT_NE(pHistoryState, nullptr);
+  SStreamFileState* pHistoryFileState = streamFileStateInit(rowSize * maxRowCount, sizeof(SSessionKey), rowSize, 0,
+                                                            getSessionKeyTs, pHistoryState, 0, "historyTest", 0,
+                                                            STREAM_STATE_BUFF_SORT);
+  ASSERT_NE(pHistoryFileState, nullptr);
+  pHistoryState->pFileState = pHistoryFileState;
+
+  // the windows flushed by the fill history task are not in the range of the stream task
+  writeSessionWins(pHistoryFileState, rowSize, maxRowCount * 4);
+  EXPECT_TRUE(mayHaveSessionOnDisk(pHistoryFileState, 1, INT64_MIN, 0));
+  EXPECT_FALSE(mayHaveSessionOnDisk(pHistoryFileState, 3, INT64_MIN, INT64_MAX));
+  EXPECT_TRUE(mayHaveSessionOnDisk(pFileState, 1, INT64_MIN, 0));
+  EXPECT_TRUE(mayHaveSessionOnDisk(pFileState, 3, INT64_MIN, INT64_MAX));
+
+  // the first window of the fill history task is merged into the window of the stream task
+  SSessionKey  key = createSessionKey(1, 105, 105);
+  SRowBuffPos* pPos = NULL;
+  int32_t      len = rowSize;
+  ASSERT_EQ(getSessionWinResultBuff(pFileState, &key, 10, (void**)&pPos, &len), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(key.win.skey, 0);
+  EXPECT_EQ(key.win.ekey, 100);
+  ASSERT_NE(pPos->pRowBuff, nullptr);
+  EXPECT_TRUE(checkRow(pPos->pRowBuff, rowSize, 0));
+  streamFileStateReleaseBuff(pFileState, pPos, false);
+
+  streamStateClose(pHistoryState, false);
+  taosMemoryFree(pHistoryTask);
+}
+
+TEST_F(StreamFileStateTest, reloadInfoAfterFillHistory) {
+  const int32_t rowSize = 256;
+  const int32_t maxRowCount = 64;
+
+  SStreamFileState* pFileState = streamFileStateInit(rowSize * maxRowCount, sizeof(SSessionKey), rowSize, 0,
+                                                     getSessionKeyTs, pState, 0, "sessionTest", 0,
+                                                     STREAM_STATE_BUFF_SORT);
+  ASSERT_NE(pFileState, nullptr);
+  pState->pFileState = pFileState;
+  EXPECT_FALSE(mayHaveSessionOnDisk(pFileState, 1, INT64_MIN, INT64_MAX));
+
+  // the state of the fill history task is transferred to the stream task, all groups are searched in the file store
+  streamFileStateReloadInfo(pFileState, 1000);
+  EXPECT_TRUE(mayHaveSessionOnDisk(pFileState, 1, INT64_MIN, INT64_MAX));
+  EXPECT_TRUE(mayHaveSessionOnDisk(pFileState, 3, INT64_MIN, INT64_MAX));
+}
+
+#pragma GCC diagnostic pop
@@ -1386,3 +1386,74 @@ int32_t taosSetFileHandlesLimit() {
 #endif
   return 0;
 }
+
+void *taosShmMap(const char *name, int64_t size, bool create) {
+#ifdef WINDOWS
+  terrno = TSDB_CODE_OPS_NOT_SUPPORT;
+  return NULL;
+#else
+  if (name == NULL || size <= 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return NULL;
+  }
+
+  // the object is created exclusively and only accessible by the owner, an existing one is never taken over
+  int32_t fd = shm_open(name, O_RDWR | (create ? (O_CREAT | O_EXCL) : 0), S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    return NULL;
+  }
+
+  void       *ptr = NULL;
+  struct stat st;
+  if (create) {
+    if (ftruncate(fd, size) != 0) {
+      terrno = TAOS_SYSTEM_ERROR(errno);
+      goto _exit;
+    }
+  } else if (fstat(fd, &st) != 0 || st.st_size < size) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    goto _exit;
+  }
+
+  ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (ptr == MAP_FAILED) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    ptr = NULL;
+  }
+
+_exit:
+  close(fd);
+  if (ptr == NULL && create) {
+    shm_unlink(name);
+  }
+  return ptr;
+#endif
+}
+
+int32_t taosShmUnmap(void *ptr, int64_t size) {
+#ifdef WINDOWS
+  return 0;
+#else
+  if (ptr == NULL) {
+    return 0;
+  }
+  if (munmap(ptr, size) != 0) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    return -1;
+  }
+  return 0;
+#endif
+}
+
+int32_t taosShmUnlink(const char *name) {
+#ifdef WINDOWS
+  return 0;
+#else
+  if (shm_unlink(name) != 0) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    return -1;
+  }
+  return 0;
+#endif
+}
@@ -64,6 +64,15 @@ static const int32_t TEST_NUMBER = 1;
 
 #define safeInt64Add(a, b)  (((a >= 0) && (b <= INT64_MAX - a)) || ((a < 0) && (b >= INT64_MIN - a)))
 
+// the first byte of compressed integer data denotes the codec
+#define INT_CODEC_SIMPLE8B 0
+#define INT_CODEC_COPY     1
+#define INT_CODEC_CONST    2  // all values are the same
+#define INT_CODEC_FOR      3  // frame of reference, value - min are bit-packed with a fixed width
+#define INT_CODEC_DELTA    4  // value - previous value - min delta are bit-packed with a fixed width
+
+bool tsLegacyCmprFormat = false;
+
 #ifdef TD_TSZ
 bool lossyFloat = false;
 bool lossyDouble = false;
@@ -88,7 +97,8 @@ void tsCompressExit() { tdszExit(); }
 /*
  * Compress Integer (Simple8B).
  */
-int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type) {
+static int32_t tsCompressINTSimple8b(const char *const input, const int32_t nelements, char *const output,
+                                     const char type) {
   // Selector value:              0    1   2   3   4   5   6   7   8  9  10  11
   // 12  13  14  15
   char    bit_per_integer[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 30, 60};
@@ -191,17 +201,301 @@ int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char
       opos += sizeof(buffer);
     } else {
     _copy_and_exit:
-      output[0] = 1;
+      output[0] = INT_CODEC_COPY;
       memcpy(output + 1, input, byte_limit - 1);
       return byte_limit;
     }
   }
 
   // set the indicator.
-  output[0] = 0;
+  output[0] = INT_CODEC_SIMPLE8B;
   return opos;
 }
 
+static FORCE_INLINE int64_t tsGetIntValue(const char *const input, int32_t i, const char type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return *((int8_t *)input + i);
+    case TSDB_DATA_TYPE_SMALLINT:
+      return *((int16_t *)input + i);
+    case TSDB_DATA_TYPE_INT:
+      return *((int32_t *)input + i);
+    default:
+      return *((int64_t *)input + i);
+  }
+}
+
+static FORCE_INLINE int32_t tsBitWidth(uint64_t range) {
+  return (range == 0) ? 0 : (LONG_BYTES * BITS_PER_BYTE) - BUILDIN_CLZL(range);
+}
+
+static FORCE_INLINE int32_t tsBitPackedSize(int32_t nelements, int32_t width) {
+  return (int32_t)(((int64_t)nelements * width + BITS_PER_BYTE - 1) / BITS_PER_BYTE);
+}
+
+// pack (value[i] - base) or (value[i] - value[i - 1] - base) of the input with fixed width, width is less than 57.
+static int32_t tsBitPackINT(const char *const input, int32_t start, const int32_t nelements, const char type,
+                            int64_t base, bool delta, int32_t width, char *const output) {
+  uint64_t acc = 0;
+  int32_t  nbit = 0;
+  int32_t  opos = 0;
+
+  if (width == 0) {
+    return 0;
+  }
+
+  for (int32_t i = start; i < nelements; ++i) {
+    int64_t  v = tsGetIntValue(input, i, type);
+    uint64_t u = delta ? (uint64_t)v - (uint64_t)tsGetIntValue(input, i - 1, type) - (uint64_t)base
+                       : (uint64_t)v - (uint64_t)base;
+
+    acc |= (u << nbit);
+    nbit += width;
+    while (nbit >= BITS_PER_BYTE) {
+      output[opos++] = (char)(acc & 0xFF);
+      acc >>= BITS_PER_BYTE;
+      nbit -= BITS_PER_BYTE;
+    }
+  }
+
+  if (nbit > 0) {
+    output[opos++] = (char)(acc & 0xFF);
+  }
+
+  return opos;
+}
+
+static FORCE_INLINE uint64_t tsBitUnpackOne(const uint8_t *in, int32_t nBytes, int64_t bitPos, uint64_t mask) {
+  int32_t  pos = (int32_t)(bitPos >> 3);
+  uint64_t w = 0;
+  if (pos + LONG_BYTES <= nBytes) {
+    memcpy(&w, in + pos, LONG_BYTES);
+  } else {
+    memcpy(&w, in + pos, nBytes - pos);
+  }
+  return (w >> (bitPos & 0x7)) & mask;
+}
+
+// unpack the num values from index start into uint64_t, byte aligned widths are copied directly
+static void tsBitUnpackINT(const uint8_t *in, int32_t nBytes, int32_t start, int32_t num, int32_t width,
+                           uint64_t *out) {
+  switch (width) {
+    case 0:
+      memset(out, 0, sizeof(uint64_t) * num);
+      break;
+    case 8:
+      for (int32_t i = 0; i < num; ++i) out[i] = in[start + i];
+      break;
+    case 16:
+      for (int32_t i = 0; i < num; ++i) {
+        uint16_t v;
+        memcpy(&v, in + (int64_t)(start + i) * sizeof(uint16_t), sizeof(uint16_t));
+        out[i] = v;
+      }
+      break;
+    case 32:
+      for (int32_t i = 0; i < num; ++i) {
+        uint32_t v;
+        memcpy(&v, in + (int64_t)(start + i) * sizeof(uint32_t), sizeof(uint32_t));
+        out[i] = v;
+      }
+      break;
+    default: {
+      uint64_t mask = INT64MASK(width);
+      for (int32_t i = 0; i < num; ++i) {
+        out[i] = tsBitUnpackOne(in, nBytes, (int64_t)(start + i) * width, mask);
+      }
+    }
+  }
+}
+
+#define INT_CODEC_BITPACK_MAX_WIDTH 56
+#define INT_CODEC_CONST_SIZE        ((int32_t)(1 + sizeof(int64_t)))      // codec + value
+#define INT_CODEC_BITPACK_HEAD      ((int32_t)(1 + 1 + sizeof(int64_t)))  // codec + width + base
+#define INT_CODEC_DELTA_HEAD        ((int32_t)(INT_CODEC_BITPACK_HEAD + sizeof(int64_t)))
+#define INT_CODEC_PREFER_WIDTH      8
+#define INT_CODEC_UNPACK_BATCH      256
+
+/*
+ * Compress Integer. The codec is chosen according to the min/max value and delta of current data:
+ *  1. constant value, if all values are the same;
+ *  2. frame of reference, (value - min) bit-packed with a fixed width;
+ *  3. delta, (value - previous value - min delta) bit-packed with a fixed width, for counters and slowly changing
+ *     values;
+ *  4. simple8b, if the values can not be packed narrowly.
+ */
+int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type) {
+  int32_t word_length = getWordLength(type);
+  int32_t byte_limit = nelements * word_length + 1;
+
+  if (tsLegacyCmprFormat) {
+    return tsCompressINTSimple8b(input, nelements, output, type);
+  }
+
+  int64_t min = tsGetIntValue(input, 0, type);
+  int64_t max = min;
+  int64_t minDelta = INT64_MAX;
+  int64_t maxDelta = INT64_MIN;
+  bool    deltaValid = (nelements > 1);
+
+  for (int32_t i = 1; i < nelements; ++i) {
+    int64_t v = tsGetIntValue(input, i, type);
+    int64_t prev = tsGetIntValue(input, i - 1, type);
+    if (v < min) min = v;
+    if (v > max) max = v;
+
+    // the delta wraps around on overflow, it is restored exactly since the prefix sum also wraps around
+    int64_t d = (int64_t)((uint64_t)v - (uint64_t)prev);
+    if (d < minDelta) minDelta = d;
+    if (d > maxDelta) maxDelta = d;
+  }
+
+  if (min == max && INT_CODEC_CONST_SIZE <= byte_limit) {
+    output[0] = INT_CODEC_CONST;
+    memcpy(output + 1, &min, sizeof(int64_t));
+    return 1 + sizeof(int64_t);
+  }
+
+  int32_t forWidth = tsBitWidth((uint64_t)max - (uint64_t)min);
+  int32_t forSize = INT_CODEC_BITPACK_HEAD + tsBitPackedSize(nelements, forWidth);
+  int32_t deltaWidth = deltaValid ? tsBitWidth((uint64_t)maxDelta - (uint64_t)minDelta) : INT32_MAX;
+  int32_t deltaSize = deltaValid ? INT_CODEC_DELTA_HEAD + tsBitPackedSize(nelements - 1, deltaWidth) : INT32_MAX;
+
+  bool    delta = (deltaSize < forSize);
+  int32_t width = delta ? deltaWidth : forWidth;
+  int32_t size = delta ? deltaSize : forSize;
+  if (width > INT_CODEC_BITPACK_MAX_WIDTH || size > byte_limit) {
+    return tsCompressINTSimple8b(input, nelements, output, type);
+  }
+
+  // simple8b adapts to the local deltas, keep it if the fixed width is wide and simple8b does better.
+  if (width > INT_CODEC_PREFER_WIDTH) {
+    int32_t len = tsCompressINTSimple8b(input, nelements, output, type);
+    if (len < size) {
+      return len;
+    }
+  }
+
+  int32_t opos = 0;
+  output[opos++] = delta ? INT_CODEC_DELTA : INT_CODEC_FOR;
+  output[opos++] = (char)width;
+  if (delta) {
+    int64_t first = tsGetIntValue(input, 0, type);
+    memcpy(output + opos, &first, sizeof(int64_t));
+    opos += sizeof(int64_t);
+    memcpy(output + opos, &minDelta, sizeof(int64_t));
+    opos += sizeof(int64_t);
+    opos += tsBitPackINT(input, 1, nelements, type, minDelta, true, width, output + opos);
+  } else {
+    memcpy(output + opos, &min, sizeof(int64_t));
+    opos += sizeof(int64_t);
+    opos += tsBitPackINT(input, 0, nelements, type, min, false, width, output + opos);
+  }
+
+  return opos;
+}
+
+#define INT_CODEC_PUT_VALUES(T, out, offset, n, expr) \
+  do {                                                \
+    T *_o = (T *)(out) + (offset);                    \
+    for (int32_t i = 0; i < (n); ++i) {               \
+      _o[i] = (T)(expr);                              \
+    }                                                 \
+  } while (0)
+
+#define INT_CODEC_PUT_BASE(type, out, v)                         \
+  do {                                                           \
+    switch (type) {                                              \
+      case TSDB_DATA_TYPE_TINYINT:                               \
+        *(int8_t *)(out) = (int8_t)(v);                          \
+        break;                                                   \
+      case TSDB_DATA_TYPE_SMALLINT:                              \
+        *(int16_t *)(out) = (int16_t)(v);                        \
+        break;                                                   \
+      case TSDB_DATA_TYPE_INT:                                   \
+        *(int32_t *)(out) = (int32_t)(v);                        \
+        break;                                                   \
+      default:                                                   \
+        *(int64_t *)(out) = (int64_t)(v);                        \
+    }                                                            \
+  } while (0)
+
+static int32_t tsDecompressINTBitPacked(const char *const input, const int32_t nelements, char *const output,
+                                        const char type) {
+  int32_t word_length = getWordLength(type);
+  int8_t  codec = input[0];
+
+  if (codec == INT_CODEC_CONST) {
+    int64_t v = 0;
+    memcpy(&v, input + 1, sizeof(int64_t));
+    switch (type) {
+      case TSDB_DATA_TYPE_TINYINT:
+        memset(output, (int8_t)v, nelements);
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        INT_CODEC_PUT_VALUES(int16_t, output, 0, nelements, v);
+        break;
+      case TSDB_DATA_TYPE_INT:
+        INT_CODEC_PUT_VALUES(int32_t, output, 0, nelements, v);
+        break;
+      default:
+        INT_CODEC_PUT_VALUES(int64_t, output, 0, nelements, v);
+    }
+    return nelements * word_length;
+  }
+
+  int32_t width = (uint8_t)input[1];
+  int64_t base = 0;
+  memcpy(&base, input + 2, sizeof(int64_t));
+  if (width > INT_CODEC_BITPACK_MAX_WIDTH) {
+    uError("invalid bit width of compressed integer:%d", width);
+    return -1;
+  }
+
+  // for delta codec, the first value is the base, and the deltas of the rest values are restored by prefix sum
+  bool           delta = (codec == INT_CODEC_DELTA);
+  int32_t        num = delta ? nelements - 1 : nelements;
+  const uint8_t *in = (const uint8_t *)input + (delta ? INT_CODEC_DELTA_HEAD : INT_CODEC_BITPACK_HEAD);
+  int32_t        nBytes = tsBitPackedSize(num, width);
+  int64_t        minDelta = 0;
+  uint64_t       sum = 0;
+  uint64_t       buf[INT_CODEC_UNPACK_BATCH];
+
+  if (delta) {
+    memcpy(&minDelta, input + INT_CODEC_BITPACK_HEAD, sizeof(int64_t));
+    INT_CODEC_PUT_BASE(type, output, base);
+  }
+
+  for (int32_t start = 0; start < num; start += INT_CODEC_UNPACK_BATCH) {
+    int32_t n = TMIN(INT_CODEC_UNPACK_BATCH, num - start);
+    tsBitUnpackINT(in, nBytes, start, n, width, buf);
+
+    if (delta) {
+      for (int32_t i = 0; i < n; ++i) {
+        sum += buf[i] + (uint64_t)minDelta;
+        buf[i] = sum;
+      }
+    }
+
+    int32_t offset = delta ? start + 1 : start;
+    switch (type) {
+      case TSDB_DATA_TYPE_TINYINT:
+        INT_CODEC_PUT_VALUES(int8_t, output, offset, n, (uint64_t)base + buf[i]);
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        INT_CODEC_PUT_VALUES(int16_t, output, offset, n, (uint64_t)base + buf[i]);
+        break;
+      case TSDB_DATA_TYPE_INT:
+        INT_CODEC_PUT_VALUES(int32_t, output, offset, n, (uint64_t)base + buf[i]);
+        break;
+      default:
+        INT_CODEC_PUT_VALUES(int64_t, output, offset, n, (uint64_t)base + buf[i]);
+    }
+  }
+
+  return nelements * word_length;
+}
+
 int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type) {
   int32_t word_length = getWordLength(type);
   if (word_length == -1) {
@@ -209,11 +503,15 @@ int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, cha
   }
 
   // If not compressed.
-  if (input[0] == 1) {
+  if (input[0] == INT_CODEC_COPY) {
     memcpy(output, input + 1, nelements * word_length);
     return nelements * word_length;
   }
 
+  if (input[0] == INT_CODEC_CONST || input[0] == INT_CODEC_FOR || input[0] == INT_CODEC_DELTA) {
+    return tsDecompressINTBitPacked(input, nelements, output, type);
+  }
+
 #if __AVX2__
   tsDecompressIntImpl_Hw(input, nelements, output, type);
   return nelements * word_length;
@@ -605,6 +903,211 @@ int32_t tsDecompressTimestampImp(const char *const input, const int32_t nelement
   return nelements * longBytes;
 }
 
+/*
+ * Compress Float/Double (ALP).
+ *   Floating values of sensors are mostly decimals with a few fractional digits. If most values of the block are
+ *   restored exactly by d / 10^e, where d is an integer, the integers are compressed by the integer codecs, and the
+ *   other values are kept as exceptions. Otherwise the XOR compressor is used.
+ *
+ *   | ALGO_ALP << 1 | MODE_COMPRESS | e | nExceptions | len | integers(len) | exception positions | exception values |
+ */
+#define ALP_HEAD_SIZE           ((int32_t)(1 + 1 + sizeof(int32_t) * 2))
+#define ALP_MIN_ELEMENTS        16
+#define ALP_SAMPLES             64
+#define ALP_DOUBLE_MAX_EXP      18
+#define ALP_FLOAT_MAX_EXP       10
+#define ALP_MAX_EXCEPTION_RATE  16                  // at most 1/16 of the values are exceptions
+#define ALP_DOUBLE_ENCODE_LIMIT 4503599627370496.0  // 2^52
+#define ALP_FLOAT_ENCODE_LIMIT  2147483647.0
+
+static const double ALP_F10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+                                 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+
+static FORCE_INLINE bool alpEncodeDouble(double v, int32_t e, int64_t *d) {
+  double x = v * ALP_F10[e];
+  if (!(fabs(x) < ALP_DOUBLE_ENCODE_LIMIT)) return false;
+
+  int64_t  r = llround(x);
+  double   restored = (double)r / ALP_F10[e];
+  uint64_t b1, b2;
+  memcpy(&b1, &v, sizeof(double));
+  memcpy(&b2, &restored, sizeof(double));
+  *d = r;
+  return b1 == b2;
+}
+
+static FORCE_INLINE bool alpEncodeFloat(float v, int32_t e, int64_t *d) {
+  double x = (double)v * ALP_F10[e];
+  if (!(fabs(x) < ALP_FLOAT_ENCODE_LIMIT)) return false;
+
+  int64_t  r = llround(x);
+  float    restored = (float)((double)r / ALP_F10[e]);
+  uint32_t b1, b2;
+  memcpy(&b1, &v, sizeof(float));
+  memcpy(&b2, &restored, sizeof(float));
+  *d = r;
+  return b1 == b2;
+}
+
+static FORCE_INLINE bool alpEncode(const char *const input, int32_t i, bool isDouble, int32_t e, int64_t *d) {
+  return isDouble ? alpEncodeDouble(((const double *)input)[i], e, d)
+                  : alpEncodeFloat(((const float *)input)[i], e, d);
+}
+
+// find the smallest exponent that restores most of the sampled values
+static int32_t alpChooseExponent(const char *const input, const int32_t nelements, bool isDouble) {
+  int32_t maxExp = isDouble ? ALP_DOUBLE_MAX_EXP : ALP_FLOAT_MAX_EXP;
+  int32_t nSample = TMIN(nelements, ALP_SAMPLES);
+  int32_t step = nelements / nSample;
+  int32_t bestExp = -1;
+  int32_t bestHit = 0;
+
+  for (int32_t e = 0; e <= maxExp; ++e) {
+    int32_t hit = 0;
+    int64_t d = 0;
+    for (int32_t k = 0; k < nSample; ++k) {
+      hit += alpEncode(input, k * step, isDouble, e, &d) ? 1 : 0;
+    }
+
+    if (hit > bestHit) {
+      bestHit = hit;
+      bestExp = e;
+      if (hit == nSample) break;
+    }
+  }
+
+  if (bestHit < nSample - nSample / ALP_MAX_EXCEPTION_RATE) {
+    return -1;
+  }
+  return bestExp;
+}
+
+// return -1 if the values are not suitable for ALP
+static int32_t tsCompressAlpImp(const char *const input, const int32_t nelements, char *const output, bool isDouble) {
+  int32_t bytes = isDouble ? DOUBLE_BYTES : FLOAT_BYTES;
+  int32_t byte_limit = nelements * bytes + 1;
+  int32_t code = -1;
+
+  if (nelements < ALP_MIN_ELEMENTS || tsLegacyCmprFormat) {
+    return -1;
+  }
+
+  int32_t e = alpChooseExponent(input, nelements, isDouble);
+  if (e < 0) {
+    return -1;
+  }
+
+  // doubles are encoded as bigint, floats as int
+  int32_t  maxExceptions = nelements / ALP_MAX_EXCEPTION_RATE;
+  int32_t  nExceptions = 0;
+  char     intType = isDouble ? TSDB_DATA_TYPE_BIGINT : TSDB_DATA_TYPE_INT;
+  int32_t  intBytes = isDouble ? LONG_BYTES : INT_BYTES;
+  char    *pInt = taosMemoryMalloc(intBytes * nelements);
+  char    *pIntCmpr = taosMemoryMalloc(intBytes * nelements + 1 + COMP_OVERFLOW_BYTES);
+  int32_t *pPos = taosMemoryMalloc(sizeof(int32_t) * (maxExceptions + 1));
+  if (pInt == NULL || pIntCmpr == NULL || pPos == NULL) {
+    goto _exit;
+  }
+
+  int64_t last = 0;
+  for (int32_t i = 0; i < nelements; ++i) {
+    int64_t d = 0;
+    if (alpEncode(input, i, isDouble, e, &d)) {
+      last = d;
+    } else {
+      if (nExceptions >= maxExceptions) goto _exit;
+      pPos[nExceptions++] = i;
+      d = last;  // keep the integers narrow
+    }
+
+    if (isDouble) {
+      ((int64_t *)pInt)[i] = d;
+    } else {
+      ((int32_t *)pInt)[i] = (int32_t)d;
+    }
+  }
+
+  int32_t len = tsCompressINTImp(pInt, nelements, pIntCmpr, intType);
+  int32_t size = ALP_HEAD_SIZE + len + nExceptions * (int32_t)sizeof(int32_t) + nExceptions * bytes;
+  if (len <= 0 || size >= byte_limit) {
+    goto _exit;
+  }
+
+  int32_t opos = 0;
+  output[opos++] = (ALGO_ALP << 1) | MODE_COMPRESS;
+  output[opos++] = (char)e;
+  memcpy(output + opos, &nExceptions, sizeof(int32_t));
+  opos += sizeof(int32_t);
+  memcpy(output + opos, &len, sizeof(int32_t));
+  opos += sizeof(int32_t);
+  memcpy(output + opos, pIntCmpr, len);
+  opos += len;
+  memcpy(output + opos, pPos, sizeof(int32_t) * nExceptions);
+  opos += sizeof(int32_t) * nExceptions;
+  for (int32_t k = 0; k < nExceptions; ++k) {
+    memcpy(output + opos, input + (int64_t)pPos[k] * bytes, bytes);
+    opos += bytes;
+  }
+  code = opos;
+
+_exit:
+  taosMemoryFree(pInt);
+  taosMemoryFree(pIntCmpr);
+  taosMemoryFree(pPos);
+  return code;
+}
+
+static int32_t tsDecompressAlpImp(const char *const input, const int32_t nelements, char *const output,
+                                  bool isDouble) {
+  int32_t bytes = isDouble ? DOUBLE_BYTES : FLOAT_BYTES;
+  int32_t e = (uint8_t)input[1];
+  int32_t nExceptions = 0;
+  int32_t len = 0;
+  int32_t ipos = 2;
+
+  memcpy(&nExceptions, input + ipos, sizeof(int32_t));
+  ipos += sizeof(int32_t);
+  memcpy(&len, input + ipos, sizeof(int32_t));
+  ipos += sizeof(int32_t);
+
+  if (e > (isDouble ? ALP_DOUBLE_MAX_EXP : ALP_FLOAT_MAX_EXP) || nExceptions < 0 || nExceptions > nelements) {
+    uError("invalid ALP compressed data, exp:%d, exceptions:%d", e, nExceptions);
+    return -1;
+  }
+
+  // the integers are decoded into the output buffer, and converted in place
+  double f10 = ALP_F10[e];
+  if (isDouble) {
+    if (tsDecompressINTImp(input + ipos, nelements, output, TSDB_DATA_TYPE_BIGINT) < 0) return -1;
+    int64_t *pInt = (int64_t *)output;
+    double  *pOut = (double *)output;
+    for (int32_t i = 0; i < nelements; ++i) {
+      pOut[i] = (double)pInt[i] / f10;
+    }
+  } else {
+    if (tsDecompressINTImp(input + ipos, nelements, output, TSDB_DATA_TYPE_INT) < 0) return -1;
+    int32_t *pInt = (int32_t *)output;
+    float   *pOut = (float *)output;
+    for (int32_t i = 0; i < nelements; ++i) {
+      pOut[i] = (float)((double)pInt[i] / f10);
+    }
+  }
+  ipos += len;
+
+  const char *pVal = input + ipos + sizeof(int32_t) * nExceptions;
+  for (int32_t k = 0; k < nExceptions; ++k) {
+    int32_t pos = 0;
+    memcpy(&pos, input + ipos + sizeof(int32_t) * k, sizeof(int32_t));
+    if (pos < 0 || pos >= nelements) {
+      uError("invalid ALP exception position:%d, elements:%d", pos, nelements);
+      return -1;
+    }
+    memcpy(output + (int64_t)pos * bytes, pVal + (int64_t)k * bytes, bytes);
+  }
+
+  return nelements * bytes;
+}
+
 /* --------------------------------------------Double Compression ---------------------------------------------- */
 void encodeDoubleValue(uint64_t diff, uint8_t flag, char *const output, int32_t *const pos) {
   int32_t longBytes = LONG_BYTES;
@@ -621,6 +1124,15 @@ void encodeDoubleValue(uint64_t diff, uint8_t flag, char *const output, int32_t
 }
 
 int32_t tsCompressDoubleImp(const char *const input, const int32_t nelements, char *const output) {
+  int32_t len = tsCompressAlpImp(input, nelements, output, true);
+  if (len > 0) {
+    return len;
+  }
+
+  return tsCompressDoubleXorImp(input, nelements, output);
+}
+
+int32_t tsCompressDoubleXorImp(const char *const input, const int32_t nelements, char *const output) {
   int32_t byte_limit = nelements * DOUBLE_BYTES + 1;
   int32_t opos = 1;
 
@@ -727,6 +1239,10 @@ int32_t tsDecompressDoubleImp(const char *const input, const int32_t nelements,
     return nelements * DOUBLE_BYTES;
   }
 
+  if (HEAD_ALGO((uint8_t)input[0]) == ALGO_ALP) {
+    return tsDecompressAlpImp(input, nelements, output, true);
+  }
+
   uint8_t  flags = 0;
   int32_t  ipos = 1;
   int32_t  opos = 0;
@@ -767,6 +1283,15 @@ void encodeFloatValue(uint32_t diff, uint8_t flag, char *const output, int32_t *
 }
 
 int32_t tsCompressFloatImp(const char *const input, const int32_t nelements, char *const output) {
+  int32_t len = tsCompressAlpImp(input, nelements, output, false);
+  if (len > 0) {
+    return len;
+  }
+
+  return tsCompressFloatXorImp(input, nelements, output);
+}
+
+int32_t tsCompressFloatXorImp(const char *const input, const int32_t nelements, char *const output) {
   float  *istream = (float *)input;
   int32_t byte_limit = nelements * FLOAT_BYTES + 1;
   int32_t opos = 1;
@@ -895,6 +1420,10 @@ int32_t tsDecompressFloatImp(const char *const input, const int32_t nelements, c
     return nelements * FLOAT_BYTES;
   }
 
+  if (HEAD_ALGO((uint8_t)input[0]) == ALGO_ALP) {
+    return tsDecompressAlpImp(input, nelements, output, false);
+  }
+
   if (tsSIMDEnable && tsAVX2Enable) {
     tsDecompressFloatImplAvx2(input, nelements, output);
   } else if (tsSIMDEnable && tsAVX512Enable) {
@@ -156,6 +156,11 @@ void taosFreeQitem(void *pItem) {
   taosMemoryFree(pNode);
 }
 
+int64_t taosQitemGetTimestamp(const void *pItem) {
+  const STaosQnode *pNode = (const STaosQnode *)((const char *)pItem - sizeof(STaosQnode));
+  return pNode->timestamp;
+}
+
 int32_t taosWriteQitem(STaosQueue *queue, void *pItem) {
   int32_t     code = 0;
   STaosQnode *pNode = (STaosQnode *)(((char *)pItem) - sizeof(STaosQnode));
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
+#include <set>
 
 #include "taoserror.h"
+#include "tcompression.h"
 #include "tscalablebf.h"
 
 using namespace std;
@@ -138,4 +140,80 @@ TEST(TD_UTIL_BLOOMFILTER_TEST, scalable_bloomFilter) {
 
   tScalableBfDestroy(pSBF1);
   tScalableBfDestroy(pSBF4);
-}
\ No newline at end of file
+}
+// point lookup over compressed blocks, with and without the per-block bloom filter used by the tsdb data file
+TEST(TD_UTIL_BLOOMFILTER_TEST, block_bloomFilter_perf) {
+  const int32_t numOfBlocks = 2000;
+  const int32_t rowsPerBlock = 4096;
+  const int32_t nBytes = rowsPerBlock * sizeof(int64_t);
+
+  int64_t *pList = (int64_t *)taosMemoryMalloc(nBytes);
+  char    *pOutput = (char *)taosMemoryMalloc(nBytes);
+  char   **pBlocks = (char **)taosMemoryCalloc(numOfBlocks, POINTER_BYTES);
+  int32_t *pLens = (int32_t *)taosMemoryCalloc(numOfBlocks, sizeof(int32_t));
+  SBloomFilter **pBFs = (SBloomFilter **)taosMemoryCalloc(numOfBlocks, POINTER_BYTES);
+
+  // each block keeps a small set of codes, the looked up code only exists in one block
+  uint32_t seed = 100;
+  const int64_t target = 99999;
+  for (int32_t i = 0; i < numOfBlocks; ++i) {
+    for (int32_t j = 0; j < rowsPerBlock; ++j) {
+      pList[j] = 1000 + taosRandR(&seed) % 64;
+    }
+    if (i == numOfBlocks / 2) {
+      pList[rowsPerBlock / 2] = target;
+    }
+
+    pBlocks[i] = (char *)taosMemoryMalloc(nBytes + 1);
+    pLens[i] = tsCompressBigint(pList, nBytes, rowsPerBlock, pBlocks[i], nBytes + 1, ONE_STAGE_COMP, NULL, 0);
+
+    std::set<int64_t> codes(pList, pList + rowsPerBlock);
+    pBFs[i] = tBloomFilterInit(codes.size(), 0.01);
+    for (int64_t code : codes) {
+      tBloomFilterPut(pBFs[i], &code, sizeof(int64_t));
+    }
+  }
+
+  int64_t st = taosGetTimestampUs();
+  int32_t found1 = 0;
+  for (int32_t i = 0; i < numOfBlocks; ++i) {
+    tsDecompressBigint(pBlocks[i], pLens[i], rowsPerBlock, pOutput, nBytes, ONE_STAGE_COMP, NULL, 0);
+    for (int32_t j = 0; j < rowsPerBlock; ++j) {
+      found1 += (((int64_t *)pOutput)[j] == target);
+    }
+  }
+  int64_t el1 = taosGetTimestampUs() - st;
+
+  st = taosGetTimestampUs();
+  int32_t found2 = 0;
+  int32_t loaded = 0;
+  for (int32_t i = 0; i < numOfBlocks; ++i) {
+    uint64_t h1 = (uint64_t)pBFs[i]->hashFn1((const char *)&target, sizeof(int64_t));
+    uint64_t h2 = (uint64_t)pBFs[i]->hashFn2((const char *)&target, sizeof(int64_t));
+    if (tBloomFilterNoContain(pBFs[i], h1, h2) == TSDB_CODE_SUCCESS) continue;
+
+    loaded += 1;
+    tsDecompressBigint(pBlocks[i], pLens[i], rowsPerBlock, pOutput, nBytes, ONE_STAGE_COMP, NULL, 0);
+    for (int32_t j = 0; j < rowsPerBlock; ++j) {
+      found2 += (((int64_t *)pOutput)[j] == target);
+    }
+  }
+  int64_t el2 = taosGetTimestampUs() - st;
+
+  std::cout << "scan all blocks elapsed time:" << el1 << " us" << std::endl;
+  std::cout << "scan with block bloom filter elapsed time:" << el2 << " us, loaded blocks:" << loaded << std::endl;
+
+  GTEST_ASSERT_EQ(found1, 1);
+  GTEST_ASSERT_EQ(found2, 1);
+  ASSERT_LT(loaded, numOfBlocks / 10);
+
+  for (int32_t i = 0; i < numOfBlocks; ++i) {
+    taosMemoryFree(pBlocks[i]);
+    tBloomFilterDestroy(pBFs[i]);
+  }
+  taosMemoryFree(pBlocks);
+  taosMemoryFree(pLens);
+  taosMemoryFree(pBFs);
+  taosMemoryFree(pList);
+  taosMemoryFree(pOutput);
+}
@@ -92,3 +92,215 @@ TEST(utilTest, decompress_perf_test) {
   taosMemoryFree(px);
 }
 
+
+namespace {
+template <typename T>
+void checkIntCompress(const std::vector<T>& data, int8_t type, int8_t expectCodec, int32_t offset = 0) {
+  int32_t num = data.size();
+  int32_t bytes = sizeof(T);
+
+  // the compressed data is not aligned when offset is not zero
+  std::vector<char> px(num * bytes + 1 + COMP_OVERFLOW_BYTES + offset);
+  char*             pIn = px.data() + offset;
+  int32_t           len = tsCompressINTImp(reinterpret_cast<const char*>(data.data()), num, pIn, type);
+  ASSERT_GT(len, 0);
+  ASSERT_LE(len, num * bytes + 1);
+  if (expectCodec >= 0) {
+    ASSERT_EQ(pIn[0], expectCodec);
+  }
+
+  std::vector<T> out(num);
+  ASSERT_EQ(tsDecompressINTImp(pIn, num, reinterpret_cast<char*>(out.data()), type), num * bytes);
+  for (int32_t i = 0; i < num; ++i) {
+    ASSERT_EQ(out[i], data[i]) << "index:" << i;
+  }
+}
+}  // namespace
+
+TEST(utilTest, int_codec_test) {
+  std::mt19937_64 rng(1234);
+
+  // constant
+  checkIntCompress(std::vector<int32_t>(4096, -7), TSDB_DATA_TYPE_INT, 2);
+  checkIntCompress(std::vector<int8_t>(1, 3), TSDB_DATA_TYPE_TINYINT, -1);
+
+  // frame of reference
+  std::vector<int64_t> v1(4096);
+  for (auto& v : v1) v = 1000000000LL + rng() % 200;
+  checkIntCompress(v1, TSDB_DATA_TYPE_BIGINT, 3);
+
+  std::vector<int16_t> v2(1000);
+  for (auto& v : v2) v = (int16_t)(rng() % 65536);
+  checkIntCompress(v2, TSDB_DATA_TYPE_SMALLINT, -1);
+
+  // delta of counters
+  std::vector<int64_t> v3(4097);
+  int64_t              c = INT64_MIN / 2;
+  for (auto& v : v3) v = (c += 10 + rng() % 4);
+  checkIntCompress(v3, TSDB_DATA_TYPE_BIGINT, 4);
+
+  std::vector<int32_t> v4(333);
+  for (int32_t i = 0; i < (int32_t)v4.size(); ++i) v4[i] = i * 3;
+  checkIntCompress(v4, TSDB_DATA_TYPE_INT, 4);
+
+  // extreme values
+  std::vector<int64_t> v5(100);
+  for (auto& v : v5) v = (rng() & 1) ? INT64_MAX : INT64_MIN;
+  checkIntCompress(v5, TSDB_DATA_TYPE_BIGINT, -1);
+
+  std::vector<int8_t> v6(4096);
+  for (auto& v : v6) v = (int8_t)rng();
+  checkIntCompress(v6, TSDB_DATA_TYPE_TINYINT, -1);
+
+  // each of the widths
+  for (int32_t w = 1; w <= 62; ++w) {
+    std::vector<int64_t> v7(517);
+    for (auto& v : v7) v = -5 + (int64_t)(rng() & ((1ULL << w) - 1));
+    checkIntCompress(v7, TSDB_DATA_TYPE_BIGINT, -1);
+  }
+
+  // the deltas overflow int64
+  std::vector<int64_t> v8 = {INT64_MIN, INT64_MAX, INT64_MIN, 0, INT64_MIN, INT64_MIN + 1, INT64_MAX, -1};
+  checkIntCompress(v8, TSDB_DATA_TYPE_BIGINT, -1);
+
+  std::vector<int64_t> v9(1000);
+  for (int32_t i = 0; i < (int32_t)v9.size(); ++i) v9[i] = (i & 1) ? INT64_MIN + (int64_t)(rng() % 16) : INT64_MAX - 3;
+  checkIntCompress(v9, TSDB_DATA_TYPE_BIGINT, -1);
+
+  std::vector<int64_t> v10(300);
+  uint64_t             w = INT64_MAX - 1000;
+  for (auto& v : v10) v = (int64_t)(w += 7);  // wraps around to INT64_MIN
+  checkIntCompress(v10, TSDB_DATA_TYPE_BIGINT, 4);
+
+  // byte aligned widths from unaligned input
+  for (int32_t offset = 1; offset < 4; ++offset) {
+    std::vector<int64_t> v11(1001);
+    for (auto& v : v11) v = 100 + (int64_t)(rng() % 60000);
+    checkIntCompress(v11, TSDB_DATA_TYPE_BIGINT, 3, offset);
+
+    std::vector<int64_t> v12(1001);
+    for (auto& v : v12) v = -(int64_t)(rng() % 4000000000LL);
+    checkIntCompress(v12, TSDB_DATA_TYPE_BIGINT, -1, offset);
+
+    std::vector<int32_t> v13(777);
+    for (auto& v : v13) v = (int32_t)(rng() % 50000);
+    checkIntCompress(v13, TSDB_DATA_TYPE_INT, -1, offset);
+  }
+}
+
+TEST(utilTest, int_codec_perf_test) {
+  int32_t num = 4096;
+  int32_t loops = 10000;
+
+  std::vector<int64_t> data(num);
+  uint32_t             seed = 100;
+  for (int32_t i = 0; i < num; ++i) {
+    data[i] = 1000 + taosRandR(&seed) % 1000;
+  }
+
+  std::vector<char> px(num * sizeof(int64_t) + 1 + COMP_OVERFLOW_BYTES);
+  std::vector<char> out(num * sizeof(int64_t));
+
+  int32_t len = tsCompressINTImp(reinterpret_cast<const char*>(data.data()), num, px.data(), TSDB_DATA_TYPE_BIGINT);
+  int64_t st = taosGetTimestampUs();
+  for (int32_t k = 0; k < loops; ++k) {
+    tsDecompressINTImp(px.data(), num, out.data(), TSDB_DATA_TYPE_BIGINT);
+  }
+  int64_t el = taosGetTimestampUs() - st;
+  std::cout << "codec:" << (int32_t)px[0] << " size:" << len << " decompress elapsed time:" << el << " us, "
+            << (double)num * sizeof(int64_t) * loops / (el + 1) << " MB/s" << std::endl;
+}
+
+namespace {
+template <typename T>
+void checkFloatCompress(const std::vector<T>& data, bool expectAlp) {
+  int32_t num = data.size();
+  int32_t bytes = sizeof(T);
+  bool    isDouble = (sizeof(T) == sizeof(double));
+
+  std::vector<char> px(num * bytes + 1 + COMP_OVERFLOW_BYTES);
+  int32_t           len = isDouble ? tsCompressDoubleImp(reinterpret_cast<const char*>(data.data()), num, px.data())
+                                   : tsCompressFloatImp(reinterpret_cast<const char*>(data.data()), num, px.data());
+  ASSERT_GT(len, 0);
+  ASSERT_LE(len, num * bytes + 1);
+  ASSERT_EQ(HEAD_ALGO((uint8_t)px[0]) == ALGO_ALP, expectAlp);
+
+  std::vector<T> out(num);
+  int32_t        ret = isDouble ? tsDecompressDoubleImp(px.data(), num, reinterpret_cast<char*>(out.data()))
+                                : tsDecompressFloatImp(px.data(), num, reinterpret_cast<char*>(out.data()));
+  ASSERT_EQ(ret, num * bytes);
+  ASSERT_EQ(memcmp(out.data(), data.data(), num * bytes), 0);
+}
+}  // namespace
+
+TEST(utilTest, alp_codec_test) {
+  std::mt19937_64 rng(4321);
+
+  // decimals with 1-3 fractional digits
+  std::vector<double> v1(4096);
+  for (auto& v : v1) v = ((int64_t)(rng() % 100000) - 30000) / 100.0;
+  checkFloatCompress(v1, true);
+
+  std::vector<float> v2(4096);
+  for (auto& v : v2) v = (int32_t)(rng() % 4000) / 10.0f;
+  checkFloatCompress(v2, true);
+
+  // a few exceptions
+  std::vector<double> v3(1024);
+  for (auto& v : v3) v = (int64_t)(rng() % 1000) / 1000.0;
+  v3[7] = M_PI;
+  v3[100] = -0.0;
+  v3[1000] = NAN;
+  v3[1023] = 1e300;
+  checkFloatCompress(v3, true);
+
+  // irregular data falls back to XOR compression
+  std::vector<double> v4(4096);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for (auto& v : v4) v = dist(rng);
+  checkFloatCompress(v4, false);
+
+  std::vector<float> v5(8, 1.5f);
+  checkFloatCompress(v5, false);
+}
+
+TEST(utilTest, alp_codec_perf_test) {
+  int32_t num = 4096;
+  int32_t loops = 2000;
+
+  // temperature like decimals with 2 fractional digits, random walk
+  std::vector<double> data(num);
+  uint32_t            seed = 100;
+  int64_t             cur = 2000;
+  for (int32_t i = 0; i < num; ++i) {
+    cur += (int64_t)(taosRandR(&seed) % 21) - 10;
+    data[i] = cur / 100.0;
+  }
+
+  std::vector<char> pAlp(num * sizeof(double) + 1 + COMP_OVERFLOW_BYTES);
+  std::vector<char> pXor(num * sizeof(double) + 1 + COMP_OVERFLOW_BYTES);
+  std::vector<char> out(num * sizeof(double));
+
+  int32_t lenAlp = tsCompressDoubleImp(reinterpret_cast<const char*>(data.data()), num, pAlp.data());
+  int32_t lenXor = tsCompressDoubleXorImp(reinterpret_cast<const char*>(data.data()), num, pXor.data());
+  ASSERT_EQ(HEAD_ALGO((uint8_t)pAlp[0]), ALGO_ALP);
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t k = 0; k < loops; ++k) {
+    tsDecompressDoubleImp(pAlp.data(), num, out.data());
+  }
+  int64_t elAlp = taosGetTimestampUs() - st;
+  ASSERT_EQ(memcmp(out.data(), data.data(), num * sizeof(double)), 0);
+
+  st = taosGetTimestampUs();
+  for (int32_t k = 0; k < loops; ++k) {
+    tsDecompressDoubleImp(pXor.data(), num, out.data());
+  }
+  int64_t elXor = taosGetTimestampUs() - st;
+  ASSERT_EQ(memcmp(out.data(), data.data(), num * sizeof(double)), 0);
+
+  std::cout << "ALP ratio:" << (double)num * sizeof(double) / lenAlp << " decompress elapsed time:" << elAlp << " us"
+            << std::endl;
+  std::cout << "XOR ratio:" << (double)num * sizeof(double) / lenXor << " decompress elapsed time:" << elXor << " us"
+            << std::endl;
+}
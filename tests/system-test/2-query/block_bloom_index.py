@@ -0,0 +1,102 @@
+import time
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+
+class TDTestCase:
+    # an index on a normal column of a super table is the block bloom filter of the column
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+        self.dbname = 'db'
+        self.stbname = f'{self.dbname}.stb'
+        self.ctbNum = 3
+        self.rowsPerTbl = 3000
+        self.startTs = 1700000000000
+
+    def prepare_data(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        tdSql.execute(f"create database {self.dbname} vgroups 1 minrows 100")
+        tdSql.execute(f"create table {self.stbname} (ts timestamp, c1 int, c2 varchar(20), c3 float, c4 bigint) tags (t1 int)")
+        for i in range(self.ctbNum):
+            tdSql.execute(f"create table {self.dbname}.ctb{i} using {self.stbname} tags({i})")
+
+    def insert_data(self, offset):
+        for i in range(self.ctbNum):
+            sql = f"insert into {self.dbname}.ctb{i} values"
+            for j in range(self.rowsPerTbl):
+                k = offset + j
+                c1 = 'null' if k % 97 == 0 else k
+                sql += f" ({self.startTs + k}, {c1}, 'v{k}', {k}.5, {k % 10})"
+                if (j + 1) % 500 == 0:
+                    tdSql.execute(sql)
+                    sql = f"insert into {self.dbname}.ctb{i} values"
+
+    def check_eq_query(self):
+        for k in [1, 98, 1500, 2999, 3001, 4500]:
+            tdSql.query(f"select ts, c1 from {self.stbname} where c1 = {k}")
+            tdSql.checkRows(self.ctbNum if k < self.rowsPerTbl * 2 and k % 97 != 0 else 0)
+            tdSql.query(f"select count(*) from {self.stbname} where c2 = 'v{k}'")
+            tdSql.checkData(0, 0, self.ctbNum if k < self.rowsPerTbl * 2 else 0)
+
+        # values that are not in any block
+        tdSql.query(f"select * from {self.stbname} where c1 = {self.rowsPerTbl * 10}")
+        tdSql.checkRows(0)
+        tdSql.query(f"select * from {self.stbname} where c2 = 'none'")
+        tdSql.checkRows(0)
+        tdSql.query(f"select count(*) from {self.stbname} where c1 = 97")
+        tdSql.checkData(0, 0, 0)
+        tdSql.query(f"select count(*) from {self.stbname} where c1 is null")
+        tdSql.checkData(0, 0, self.ctbNum * len([k for k in range(self.rowsPerTbl * 2) if k % 97 == 0]))
+
+    def check_index(self):
+        tdSql.execute(f"create index idx_c1 on {self.stbname}(c1)")
+        tdSql.execute(f"create index idx_c2 on {self.stbname}(c2)")
+        tdSql.error(f"create index idx_c1_2 on {self.stbname}(c1)")
+        # the bloom filter of floating point columns is not supported
+        tdSql.error(f"create index idx_c3 on {self.stbname}(c3)")
+
+        tdSql.query(f"select index_name, column_name, index_type from information_schema.ins_indexes "
+                    f"where db_name = '{self.dbname}' and index_name like 'idx_c%' order by index_name")
+        tdSql.checkRows(2)
+        tdSql.checkData(0, 1, 'c1')
+        tdSql.checkData(0, 2, 'bloom_index')
+        tdSql.checkData(1, 1, 'c2')
+        tdSql.checkData(1, 2, 'bloom_index')
+
+    def run(self):
+        self.prepare_data()
+
+        # files written before the index is created have no bloom filter of the column
+        self.insert_data(0)
+        tdSql.execute(f"flush database {self.dbname}")
+        self.check_index()
+        self.insert_data(self.rowsPerTbl)
+        tdSql.execute(f"flush database {self.dbname}")
+        self.check_eq_query()
+
+        tdSql.execute(f"compact database {self.dbname}")
+        time.sleep(5)
+        self.check_eq_query()
+
+        tdSql.execute(f"drop index {self.dbname}.idx_c1")
+        tdSql.query(f"select * from information_schema.ins_indexes where index_name = 'idx_c1'")
+        tdSql.checkRows(0)
+        self.check_eq_query()
+
+        # dropping the column drops the index on it
+        tdSql.execute(f"alter table {self.stbname} drop column c2")
+        tdSql.query(f"select * from information_schema.ins_indexes where index_name = 'idx_c2'")
+        tdSql.checkRows(0)
+        tdSql.query(f"select count(*) from {self.stbname} where c1 = 1500")
+        tdSql.checkData(0, 0, self.ctbNum)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())
@@ -0,0 +1,109 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+
+class TDTestCase:
+    # the tumbling interval on a super table combines the partial rows of all vgroups by hash on the merge node, and
+    # the results must be the same as the ones of the sorted merge, which is still used under a limit
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+        self.dbname = 'db'
+        self.stbname = f'{self.dbname}.stb'
+        self.vgroups = 4
+        self.tbnum = 20
+        self.rowsPerTbl = 600
+        self.startTs = 1700000000000
+        self.tsStep = 1300
+
+    def prepare_data(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        tdSql.execute(f"create database {self.dbname} vgroups {self.vgroups} minrows 10 maxrows 200")
+        tdSql.execute(f"create table {self.stbname} (ts timestamp, c1 int, c2 double, c3 tinyint unsigned) tags (t1 int)")
+        for i in range(self.tbnum):
+            tdSql.execute(f"create table {self.dbname}.ctb{i} using {self.stbname} tags({i % 3})")
+
+        for i in range(self.tbnum):
+            sql = f"insert into {self.dbname}.ctb{i} values"
+            for j in range(self.rowsPerTbl):
+                # the timestamps of all tables are different, so the first and last rows of a window are unique
+                ts = self.startTs + j * self.tsStep + i
+                c1 = 'null' if (i + j) % 13 == 0 else (i * 31 + j * 7) % 1000 - 500
+                sql += f" ({ts}, {c1}, {i}.{j % 10}, {(i + j) % 256})"
+                if (j + 1) % 200 == 0:
+                    tdSql.execute(sql)
+                    sql = f"insert into {self.dbname}.ctb{i} values"
+            # the first half of tables are in the data files, the others are in memory
+            if i == self.tbnum // 2:
+                tdSql.execute(f"flush database {self.dbname}")
+
+    def check_plan(self, sql, hashMerge):
+        tdSql.query(f"explain {sql}")
+        plan = '\n'.join([str(row[0]) for row in tdSql.queryResult])
+        if hashMerge:
+            if 'SortMerge' in plan or f'Data Exchange {self.vgroups}:1' not in plan:
+                tdLog.exit(f"the partial rows are not combined by hash, sql: {sql}\n{plan}")
+        elif 'SortMerge' not in plan:
+            tdLog.exit(f"the partial rows are not sort merged, sql: {sql}\n{plan}")
+
+    def check_same_value(self, sql, i, j, res, exp):
+        if isinstance(exp, float) and res is not None:
+            same = abs(res - exp) <= 1e-9 * max(1.0, abs(exp))
+        else:
+            same = res == exp
+        if not same:
+            tdLog.exit(f"row {i} col {j} is {res}, expect {exp}, sql: {sql}")
+
+    def check_same_result(self, window, funcs, cond="", partition=False, order="asc"):
+        where = f"where {cond}" if cond else ""
+        if partition:
+            sql = f"select t1, _wstart, _wend, {funcs} from {self.stbname} {where} partition by t1 {window}"
+            # a slimit above the window keeps the sorted merge
+            seqSql = f"{sql} slimit 1000"
+        else:
+            sql = f"select _wstart, _wend, {funcs} from {self.stbname} {where} {window} order by _wstart {order}"
+            # a limit above the window keeps the sorted merge
+            seqSql = f"{sql} limit 1000000"
+
+        self.check_plan(seqSql, False)
+        tdSql.query(seqSql)
+        expected = tdSql.queryResult
+        self.check_plan(sql, True)
+        tdSql.query(sql)
+        res = tdSql.queryResult
+        if partition:
+            # the order of the groups is not defined
+            expected = sorted(expected, key=lambda row: (row[0], row[1]))
+            res = sorted(res, key=lambda row: (row[0], row[1]))
+
+        tdSql.checkRows(len(expected))
+        if len(expected) == 0:
+            tdLog.exit(f"no result, sql: {sql}")
+        for i in range(len(expected)):
+            for j in range(len(expected[i])):
+                self.check_same_value(sql, i, j, res[i][j], expected[i][j])
+
+    def run(self):
+        self.prepare_data()
+
+        funcs = "count(*), count(c1), sum(c1), min(c1), max(c2), avg(c2), first(c1), last(c1), spread(c3)"
+        for window in ["interval(10s)", "interval(7s, 3s)", "interval(1m)", "interval(10s) sliding(10s)"]:
+            for order in ["asc", "desc"]:
+                self.check_same_result(window, funcs, order=order)
+                # the windows of some vgroups are empty
+                self.check_same_result(window, funcs, "c1 > 300", order=order)
+            self.check_same_result(window, funcs, partition=True)
+            self.check_same_result(window, funcs, "c1 > 300", partition=True)
+
+        # the windows are filtered after being combined
+        self.check_same_result("interval(10s) having count(*) > 10", funcs)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())
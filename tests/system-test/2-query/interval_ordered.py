@@ -0,0 +1,84 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+
+class TDTestCase:
+    # the interval on the rows of a single table in ascending order keeps the open windows in a ring, and finalizes them
+    # once the rows move past their end
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+        self.dbname = 'db'
+        self.stbname = f'{self.dbname}.stb'
+        self.tbname = f'{self.dbname}.ctb0'
+        self.rowsPerTbl = 3000
+        self.startTs = 1700000000000
+        self.tsStep = 700
+
+    def prepare_data(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        tdSql.execute(f"create database {self.dbname} vgroups 1 minrows 10 maxrows 200")
+        tdSql.execute(f"create table {self.stbname} (ts timestamp, c1 int, c2 double, c3 tinyint unsigned) tags (t1 int)")
+        tdSql.execute(f"create table {self.tbname} using {self.stbname} tags(0)")
+        tdSql.execute(f"create table {self.dbname}.ctb1 using {self.stbname} tags(1)")
+
+        sql = f"insert into {self.tbname} values"
+        n = 0
+        for j in range(self.rowsPerTbl):
+            # leave gaps of several windows without any row
+            if 1000 <= j < 1100 or 2000 <= j < 2003:
+                continue
+            c1 = 'null' if j % 17 == 0 else (j * 7) % 1000 - 500
+            sql += f" ({self.startTs + j * self.tsStep}, {c1}, {j}.5, {j % 256})"
+            n += 1
+            if n % 500 == 0:
+                tdSql.execute(sql)
+                sql = f"insert into {self.tbname} values"
+            # the first half of rows are in the data files, the others are in memory
+            if j == self.rowsPerTbl // 2:
+                tdSql.execute(sql)
+                sql = f"insert into {self.tbname} values"
+                tdSql.execute(f"flush database {self.dbname}")
+        tdSql.execute(sql)
+        tdSql.execute(f"insert into {self.dbname}.ctb1 values ({self.startTs}, 1, 1.5, 1)")
+
+    def check_same_result(self, fromClause, window, funcs, cond=""):
+        # the interval on a subquery is not above a table scan, so the windows are kept in the hashed result rows
+        tdSql.query(f"select _wstart, _wend, {funcs} from (select * from {self.tbname} {'where ' + cond if cond else ''}) "
+                    f"{window}")
+        expected = tdSql.queryResult
+        if cond:
+            fromClause += f" {'and' if 'where' in fromClause else 'where'} {cond}"
+        tdSql.query(f"select _wstart, _wend, {funcs} from {fromClause} {window}")
+        tdSql.checkRows(len(expected))
+        for i in range(len(expected)):
+            for j in range(len(expected[i])):
+                tdSql.checkData(i, j, expected[i][j])
+
+    def run(self):
+        self.prepare_data()
+
+        funcs = "count(*), count(c1), sum(c1), min(c1), max(c2), avg(c2), first(c1), last(c1), spread(c3)"
+        # the function can not be combined, so the sliding windows are not aggregated by panes
+        slidingFuncs = funcs + ", irate(c2)"
+        for fromClause in [self.tbname, f"{self.stbname} where t1 = 0"]:
+            # the windows cross the boundaries of data blocks, and of the data in files and memory
+            for window in ["interval(7s)", "interval(1s)", "interval(60s)", "interval(7s, 3s)",
+                           "interval(10s) sliding(10s)"]:
+                self.check_same_result(fromClause, window, funcs)
+            for window in ["interval(10s) sliding(3s)", "interval(9s) sliding(2s)", "interval(60s) sliding(7s)"]:
+                self.check_same_result(fromClause, window, slidingFuncs)
+
+            # the ring is only filled partly if the range of timestamp is smaller than the interval
+            self.check_same_result(fromClause, "interval(10s) sliding(3s)", slidingFuncs,
+                                   f"ts < {self.startTs + 5 * self.tsStep}")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())
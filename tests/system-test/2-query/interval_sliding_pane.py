@@ -0,0 +1,92 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+
+class TDTestCase:
+    # the interval with a sliding smaller than it aggregates the rows into panes, and then combines the panes into the
+    # windows that cover them
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+        self.dbname = 'db'
+        self.stbname = f'{self.dbname}.stb'
+        self.ctbNum = 3
+        self.rowsPerTbl = 600
+        self.startTs = 1700000000000
+        self.tsStep = 500
+        self.cols = ['c1', 'c2', 'c3', 'c4', 'c5', 'c6', 'c7', 'c8', 'c9', 'c10']
+
+    def prepare_data(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        tdSql.execute(f"create database {self.dbname} vgroups 1 minrows 10 maxrows 200")
+        tdSql.execute(f"create table {self.stbname} (ts timestamp, c1 tinyint, c2 tinyint unsigned, c3 smallint, "
+                      f"c4 smallint unsigned, c5 int, c6 int unsigned, c7 bigint unsigned, c8 float, c9 double, "
+                      f"c10 timestamp) tags (t1 int)")
+        for i in range(self.ctbNum):
+            tdSql.execute(f"create table {self.dbname}.ctb{i} using {self.stbname} tags({i})")
+
+        for i in range(self.ctbNum):
+            sql = f"insert into {self.dbname}.ctb{i} values"
+            for j in range(self.rowsPerTbl):
+                # the values cover both halves of the unsigned types and the negative floating point values
+                k = (j * 37 + i * 11) % 256
+                if (j + i) % 29 == 0:
+                    sql += f" ({self.startTs + j * self.tsStep}, null, null, null, null, null, null, null, null, null, null)"
+                else:
+                    sql += (f" ({self.startTs + j * self.tsStep}, {k - 128}, {k}, {(k - 128) * 250}, {k * 250}, "
+                            f"{(k - 128) * 16000000}, {k * 16000000}, {k * 72000000000000000}, {k - 128}.25, "
+                            f"{(k - 128) * 1000}.125, {self.startTs - (k - 128) * 1000})")
+                if (j + 1) % 200 == 0:
+                    tdSql.execute(sql)
+                    sql = f"insert into {self.dbname}.ctb{i} values"
+
+            # part of the rows are in the data files, the others are in memory
+            if i == 0:
+                tdSql.execute(f"flush database {self.dbname}")
+
+    def agg_exprs(self):
+        exprs = ["count(*)"]
+        for c in self.cols:
+            exprs += [f"min({c})", f"max({c})", f"count({c})"]
+        exprs += ["sum(c1)", "sum(c6)", "sum(c9)", "spread(c5)"]
+        return ", ".join(exprs)
+
+    def check_sliding(self, tbname, interval, sliding, where=""):
+        cond = f"where {where}" if where else ""
+        tdSql.query(f"select _wstart, {self.agg_exprs()} from {tbname} {cond} interval({interval}s) "
+                    f"sliding({sliding}s)")
+        res = tdSql.queryResult
+        tdLog.debug(f"check {tbname} interval({interval}s) sliding({sliding}s) {cond}, {len(res)} windows")
+        if len(res) == 0:
+            tdLog.exit(f"no window of {tbname} interval({interval}s) sliding({sliding}s)")
+
+        # each window is compared with the aggregation of the rows in it, which is not done by panes
+        for i in range(len(res)):
+            wstart = int(res[i][0].timestamp() * 1000)
+            wend = wstart + interval * 1000
+            range_cond = f"ts >= {wstart} and ts < {wend}"
+            tdSql.query(f"select {self.agg_exprs()} from {tbname} where {range_cond} {'and ' + where if where else ''}")
+            expected = tdSql.queryResult[0]
+            for j in range(len(expected)):
+                if expected[j] != res[i][j + 1]:
+                    tdLog.exit(f"window [{wstart}, {wend}) of {tbname} interval({interval}s) sliding({sliding}s), "
+                               f"column {j + 1}: {res[i][j + 1]} != {expected[j]}")
+
+    def run(self):
+        self.prepare_data()
+
+        for tbname in [f"{self.dbname}.ctb0", f"{self.dbname}.ctb1", self.stbname]:
+            # the pane is the gcd of the interval and sliding, it is smaller than the sliding in the last two cases
+            for (interval, sliding) in [(10, 2), (30, 10), (10, 4), (9, 6)]:
+                self.check_sliding(tbname, interval, sliding)
+            self.check_sliding(tbname, 10, 3, "c5 > 0")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())
@@ -0,0 +1,107 @@
+import taos
+import threading
+
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+
+class TDTestCase:
+    # the partial window states of interval queries are cached by vnode
+    updatecfgDict = {'winResCacheSize': 16}
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+        self.dbname = 'db'
+        self.stbname = f'{self.dbname}.stb'
+        self.ctbNum = 4
+        self.rowsPerTbl = 2000
+        self.startTs = 1700000000000
+        self.tsStep = 1000
+        self.rounds = 10
+
+    def prepare_data(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        tdSql.execute(f"create database {self.dbname} vgroups 1")
+        tdSql.execute(f"create table {self.stbname} (ts timestamp, c1 int, c2 double) tags (t1 int)")
+        for i in range(self.ctbNum):
+            tdSql.execute(f"create table {self.dbname}.ctb{i} using {self.stbname} tags({i})")
+
+        for i in range(self.ctbNum):
+            sql = f"insert into {self.dbname}.ctb{i} values"
+            for j in range(self.rowsPerTbl):
+                sql += f" ({self.startTs + j * self.tsStep}, {j}, {j * 0.5})"
+                if (j + 1) % 500 == 0:
+                    tdSql.execute(sql)
+                    sql = f"insert into {self.dbname}.ctb{i} values"
+
+    def range_cond(self):
+        return f"ts >= {self.startTs} and ts < {self.startTs + self.rowsPerTbl * self.tsStep}"
+
+    def cached_sql(self):
+        return f"select _wstart, count(*), sum(c1), max(c2) from {self.stbname} where {self.range_cond()} interval(1m)"
+
+    def expected_sql(self):
+        # the interval on a subquery is not served from the cache
+        return (f"select _wstart, count(*), sum(c1), max(c2) from (select ts, c1, c2 from {self.stbname} "
+                f"where {self.range_cond()}) interval(1m)")
+
+    def check_same_result(self):
+        tdSql.query(self.expected_sql())
+        expected = tdSql.queryResult
+        tdSql.query(self.cached_sql())
+        tdSql.checkRows(len(expected))
+        for i in range(len(expected)):
+            for j in range(len(expected[i])):
+                tdSql.checkData(i, j, expected[i][j])
+
+    def insert_rows(self, round):
+        conn = taos.connect()
+        cursor = conn.cursor()
+        for i in range(self.ctbNum):
+            # overwrite and add rows inside of the windows that are cached already
+            ts = self.startTs + ((round * 37 + i * 101) % self.rowsPerTbl) * self.tsStep
+            cursor.execute(f"insert into {self.dbname}.ctb{i} values ({ts}, {round * 1000 + i}, {round}.25) "
+                           f"({ts + 1}, {round}, 0.75)")
+        cursor.close()
+        conn.close()
+
+    def query_rows(self):
+        conn = taos.connect()
+        cursor = conn.cursor()
+        cursor.execute(self.cached_sql())
+        cursor.fetchall()
+        cursor.close()
+        conn.close()
+
+    def run(self):
+        self.prepare_data()
+
+        # fill the cache, and then read from it
+        self.check_same_result()
+        self.check_same_result()
+
+        # the inserts run while the cached query is in progress, the entry put back by the query must not cover them
+        for round in range(self.rounds):
+            threads = [threading.Thread(target=self.query_rows), threading.Thread(target=self.insert_rows, args=(round,))]
+            for t in threads:
+                t.start()
+            for t in threads:
+                t.join()
+            self.check_same_result()
+
+        tdSql.execute(f"delete from {self.stbname} where ts < {self.startTs + 600 * self.tsStep}")
+        self.check_same_result()
+
+        tdSql.execute(f"flush database {self.dbname}")
+        self.check_same_result()
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())
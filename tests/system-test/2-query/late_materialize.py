@@ -0,0 +1,122 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+
+class TDTestCase:
+    # the table scan loads the filter columns of a file block first, and the rest columns only if some rows qualify,
+    # the results must be the same as the ones of the block loaded as a whole
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+        self.dbname = 'db'
+        self.tbname = f'{self.dbname}.tb'
+        self.fileRows = 30000
+        self.memRows = 1000
+        self.startTs = 1700000000000
+        self.tsStep = 100
+        self.rows = {}
+
+    def make_row(self, k, c1):
+        return [self.startTs + k * self.tsStep, c1, k * 7, f'v{k % 50}', k / 2]
+
+    def insert_rows(self, rows):
+        sql = f"insert into {self.tbname} values"
+        for i, row in enumerate(rows):
+            c1 = 'null' if row[1] is None else row[1]
+            sql += f" ({row[0]}, {c1}, {row[2]}, '{row[3]}', {row[4]})"
+            self.rows[row[0]] = row
+            if (i + 1) % 1000 == 0:
+                tdSql.execute(sql)
+                sql = f"insert into {self.tbname} values"
+        if len(rows) % 1000 != 0:
+            tdSql.execute(sql)
+
+    def prepare_data(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        # the file blocks are larger than the capacity of the result block of the reader
+        tdSql.execute(f"create database {self.dbname} vgroups 1 minrows 10 maxrows 10000")
+        tdSql.execute(f"create table {self.tbname} (ts timestamp, c1 int, c2 bigint, c3 varchar(16), c4 double)")
+
+        self.insert_rows([self.make_row(k, None if k % 101 == 0 else k) for k in range(self.fileRows)])
+        tdSql.execute(f"flush database {self.dbname}")
+
+        # the rows updated in memory are merged with the file blocks into the composed blocks
+        self.insert_rows([self.make_row(k, k + 100000) for k in range(10000, 10500)])
+        self.insert_rows([self.make_row(k, k) for k in range(self.fileRows, self.fileRows + self.memRows)])
+
+    def model_rows(self, pred):
+        return [self.rows[ts] for ts in sorted(self.rows.keys()) if pred(self.rows[ts])]
+
+    def check_same_result(self, sql, refSql):
+        tdSql.query(refSql)
+        expected = tdSql.queryResult
+        tdSql.query(sql)
+        tdSql.checkRows(len(expected))
+        for i in range(len(expected)):
+            if list(tdSql.queryResult[i]) != list(expected[i]):
+                tdLog.exit(f"row {i} is {tdSql.queryResult[i]}, expect {expected[i]}, sql: {sql}")
+
+    def check_filter(self, cond, pred):
+        # the filter refers to all the scan columns, so the data blocks are loaded as a whole
+        refCond = f"({cond}) and (c2 is null or c2 is not null) and (c3 is null or c3 is not null) and (c4 is null or c4 is not null)"
+        exp = self.model_rows(pred)
+
+        for order in ["asc", "desc"]:
+            sql = f"select ts, c2, c3, c4 from {self.tbname} where {cond} order by ts {order}"
+            self.check_same_result(sql, f"select ts, c2, c3, c4 from {self.tbname} where {refCond} order by ts {order}")
+            tdSql.checkRows(len(exp))
+            if len(exp) > 0:
+                first = exp[0] if order == "asc" else exp[-1]
+                tdSql.checkData(0, 1, first[2])
+                tdSql.checkData(0, 2, first[3])
+
+        c1 = [r[1] for r in exp if r[1] is not None]
+        tdSql.query(f"select count(*), count(c1), sum(c2), max(c4) from {self.tbname} where {cond}")
+        tdSql.checkData(0, 0, len(exp))
+        tdSql.checkData(0, 1, len(c1))
+        tdSql.checkData(0, 2, sum([r[2] for r in exp]) if exp else None)
+        tdSql.checkData(0, 3, max([r[4] for r in exp]) if exp else None)
+
+    def check_interp(self, cond):
+        refCond = f"({cond}) and (c2 is null or c2 is not null) and (c3 is null or c3 is not null) and (c4 is null or c4 is not null)"
+        # the range starts and ends in the middle of the data, so the rows out of it are read by the external reader
+        skey = self.startTs + 2500 * self.tsStep + 50
+        ekey = self.startTs + (self.fileRows + 200) * self.tsStep
+        for fill in ["prev", "next", "null", "linear", "value, 1, 1.0"]:
+            sql = f"select _irowts, interp(c2), interp(c4) from {self.tbname} where {{}} range({skey}, {ekey}) every(7s) fill({fill})"
+            self.check_same_result(sql.format(cond), sql.format(refCond))
+
+    def run(self):
+        self.prepare_data()
+
+        filters = [
+            # selective filters, most blocks are filtered out by the filter columns
+            ("c1 = 12345", lambda r: r[1] == 12345),
+            ("c1 < 0", lambda r: r[1] is not None and r[1] < 0),
+            ("c1 > 100000", lambda r: r[1] is not None and r[1] > 100000),
+            ("c1 >= 5000 and c1 < 5100", lambda r: r[1] is not None and 5000 <= r[1] < 5100),
+            # the filters matching part of the rows of the blocks, including the composed ones and the ones in memory
+            ("c1 between 9900 and 10600", lambda r: r[1] is not None and 9900 <= r[1] <= 10600),
+            ("c1 % 97 = 0", lambda r: r[1] is not None and r[1] % 97 == 0),
+            ("c1 is null", lambda r: r[1] is None),
+            ("c1 > 20000", lambda r: r[1] is not None and r[1] > 20000),
+        ]
+        for cond, pred in filters:
+            self.check_filter(cond, pred)
+
+        # the filter on a column other than c1
+        tdSql.query(f"select count(*) from {self.tbname} where c3 = 'v7' and c1 > 1000")
+        tdSql.checkData(0, 0, len(self.model_rows(lambda r: r[3] == 'v7' and r[1] is not None and r[1] > 1000)))
+
+        for cond in ["c1 % 97 = 0", "c1 >= 5000 and c1 < 5100", "c1 > 100000"]:
+            self.check_interp(cond)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())
@@ -0,0 +1,132 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+
+class TDTestCase:
+    # the sort operator of ORDER BY col LIMIT n pushes the bound of the top-N rows down to the table scan, which skips
+    # the data blocks behind the bound by block SMA
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+        self.dbname = 'db'
+        self.tbname = f'{self.dbname}.ntb'
+        self.rowsPerRound = 1000
+        self.rounds = 6
+        self.startTs = 1700000000000
+        self.tieValue = 2500
+
+    def value(self, round, j):
+        k = round * self.rowsPerRound + j
+        # the first round has all rows with the same value, other rounds have distinct values in their own range,
+        # some of them equal to the tie value again
+        if round == 0 or k % 331 == 0:
+            return self.tieValue
+        if round == 3:
+            return None
+        if k % 53 == 0:
+            return None
+        return (k * 7919) % (self.rowsPerRound * self.rounds)
+
+    def prepare_data(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        tdSql.execute(f"create database {self.dbname} vgroups 1 minrows 10 maxrows 200 stt_trigger 1")
+        tdSql.execute(f"create table {self.tbname} (ts timestamp, ci int, cd double, ct timestamp, cu int unsigned, "
+                      f"cb bigint)")
+
+        # each round is flushed to data files of its own, so that the blocks cover different ranges of values
+        for round in [0, 4, 1, 3, 5, 2]:
+            sql = f"insert into {self.tbname} values"
+            for j in range(self.rowsPerRound):
+                k = round * self.rowsPerRound + j
+                v = self.value(round, j)
+                if v is None:
+                    sql += f" ({self.startTs + k}, null, null, null, null, null)"
+                else:
+                    sql += (f" ({self.startTs + k}, {v - 3000}, {v - 3000}.5, {self.startTs + v * 1000}, {v}, "
+                            f"{(v - 3000) * 1000000000000})")
+                if (j + 1) % 500 == 0:
+                    tdSql.execute(sql)
+                    sql = f"insert into {self.tbname} values"
+            tdSql.execute(f"flush database {self.dbname}")
+
+    def check_same_result(self, order, limit):
+        cols = "ts, ci, cd, ct, cu, cb"
+        # the sort operator on a subquery is not directly above the table scan, so no bound is pushed down
+        tdSql.query(f"select {cols} from (select {cols} from {self.tbname}) order by {order} {limit}")
+        expected = tdSql.queryResult
+        tdSql.query(f"select {cols} from {self.tbname} order by {order} {limit}")
+        tdSql.checkRows(len(expected))
+        for i in range(len(expected)):
+            for j in range(len(expected[i])):
+                tdSql.checkData(i, j, expected[i][j])
+
+    def check_order_by_limit(self):
+        for col in ['ci', 'cd', 'ct', 'cu', 'cb']:
+            for order in ['asc', 'desc']:
+                for nulls in ['', 'nulls first', 'nulls last']:
+                    for limit in ['limit 1', 'limit 10', 'limit 100 offset 7', 'limit 1500', 'limit 5 offset 5990']:
+                        self.check_same_result(f"{col} {order} {nulls}, ts", limit)
+
+    def check_tie_on_bound(self):
+        # all rows with the tie value are kept, the blocks of them can not be skipped although their SMA equals to the
+        # bound of the top-N rows
+        tdSql.query(f"select count(*) from {self.tbname} where cu = {self.tieValue}")
+        numOfTies = tdSql.queryResult[0][0]
+        tdSql.query(f"select count(*) from {self.tbname} where cu < {self.tieValue}")
+        numOfLess = tdSql.queryResult[0][0]
+
+        limit = numOfLess + numOfTies
+        for order in ['ts asc', 'ts desc']:
+            self.check_same_result(f"cu asc nulls last, {order}", f"limit {limit}")
+            self.check_same_result(f"cu asc nulls last, {order}", f"limit {numOfTies} offset {numOfLess}")
+            self.check_same_result(f"cu asc nulls last, {order}", f"limit 1 offset {limit - 1}")
+            tdSql.query(f"select cu from {self.tbname} order by cu asc nulls last, {order} limit {numOfTies} "
+                        f"offset {numOfLess}")
+            tdSql.checkRows(numOfTies)
+            for i in range(numOfTies):
+                tdSql.checkData(i, 0, self.tieValue)
+
+    def check_nulls(self):
+        tdSql.query(f"select count(*) from {self.tbname} where ci is null")
+        numOfNulls = tdSql.queryResult[0][0]
+        tdSql.query(f"select count(*) from {self.tbname}")
+        numOfRows = tdSql.queryResult[0][0]
+
+        # the whole block of null values is kept by nulls first, and is behind the bound otherwise
+        for order in ['asc', 'desc']:
+            tdSql.query(f"select ci from {self.tbname} order by ci {order} nulls first, ts limit {numOfNulls + 1}")
+            tdSql.checkRows(numOfNulls + 1)
+            for i in range(numOfNulls):
+                tdSql.checkData(i, 0, None)
+            tdSql.query(f"select ci from {self.tbname} order by ci {order} nulls last, ts limit {numOfNulls} "
+                        f"offset {numOfRows - numOfNulls}")
+            tdSql.checkRows(numOfNulls)
+            for i in range(numOfNulls):
+                tdSql.checkData(i, 0, None)
+            tdSql.query(f"select ci from {self.tbname} order by ci {order} nulls last, ts limit 10")
+            for i in range(10):
+                if tdSql.queryResult[i][0] is None:
+                    tdLog.exit(f"null value in row {i} of order by ci {order} nulls last")
+
+    def run(self):
+        self.prepare_data()
+        self.check_order_by_limit()
+        self.check_tie_on_bound()
+        self.check_nulls()
+
+        # the rows in memory are merged with the blocks in data files
+        tdSql.execute(f"insert into {self.tbname} values ({self.startTs - 1}, -100000, -100000.5, 0, 0, "
+                      f"-100000000000000000) ({self.startTs - 2}, 100000, 100000.5, {self.startTs * 2}, 4000000000, "
+                      f"100000000000000000)")
+        self.check_order_by_limit()
+        self.check_tie_on_bound()
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())
@@ -0,0 +1,97 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+
+class TDTestCase:
+    # the data blocks whose rows all qualify by the block sma are answered from the sma without loading the data, and
+    # the results must be the same as the ones of the filter applied row by row
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+        self.dbname = 'db'
+        self.tbname = f'{self.dbname}.tb'
+        self.rows = 5000
+        self.startTs = 1700000000000
+        self.rows_data = []
+
+    def prepare_data(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        tdSql.execute(f"create database {self.dbname} vgroups 1 minrows 10 maxrows 200")
+        tdSql.execute(f"create table {self.tbname} (ts timestamp, c1 int, c2 bigint, c3 double, c4 tinyint)")
+
+        sql = f"insert into {self.tbname} values"
+        for k in range(self.rows):
+            # c1 increases with the timestamp, so the blocks have disjoint ranges of c1, and only a few of them have
+            # null values of c2
+            c2 = None if 1200 <= k < 1400 and k % 7 == 0 else k * 3 - 2000
+            row = (self.startTs + k, k, c2, k / 4, k % 100 - 50)
+            self.rows_data.append(row)
+            sql += f" ({row[0]}, {row[1]}, {'null' if c2 is None else c2}, {row[3]}, {row[4]})"
+            if (k + 1) % 500 == 0:
+                tdSql.execute(sql)
+                sql = f"insert into {self.tbname} values"
+        tdSql.execute(f"flush database {self.dbname}")
+
+    def expected(self, pred):
+        rows = [r for r in self.rows_data if pred(r)]
+        c2 = [r[2] for r in rows if r[2] is not None]
+        c3 = [r[3] for r in rows]
+        return [len(rows), len(c2), sum(c2) if c2 else None, min(c2) if c2 else None, max(c2) if c2 else None,
+                min(c3) if c3 else None, max(c3) if c3 else None]
+
+    def check_same_value(self, sql, j, res, exp):
+        if isinstance(exp, float) and res is not None:
+            same = abs(res - exp) <= 1e-9 * max(1.0, abs(exp))
+        else:
+            same = res == exp
+        if not same:
+            tdLog.exit(f"col {j} is {res}, expect {exp}, sql: {sql}")
+
+    def check_filter(self, cond, pred):
+        funcs = "count(*), count(c2), sum(c2), min(c2), max(c2), min(c3), max(c3)"
+        exp = self.expected(pred)
+        sql = f"select {funcs} from {self.tbname} where {cond}"
+        tdSql.query(sql)
+        tdSql.checkRows(1)
+        for j in range(len(exp)):
+            self.check_same_value(sql, j, tdSql.queryResult[0][j], exp[j])
+
+        # the rows of the subquery are filtered one by one
+        rowSql = f"select {funcs} from (select * from {self.tbname} where {cond})"
+        tdSql.query(rowSql)
+        tdSql.checkRows(1)
+        for j in range(len(exp)):
+            self.check_same_value(rowSql, j, tdSql.queryResult[0][j], exp[j])
+
+    def run(self):
+        self.prepare_data()
+
+        # most blocks are in the range, and the ones on the edges are partly qualified
+        self.check_filter("c1 > 333 and c1 <= 4444", lambda r: 333 < r[1] <= 4444)
+        self.check_filter("c1 >= 0", lambda r: r[1] >= 0)
+        self.check_filter("c1 < 2500", lambda r: r[1] < 2500)
+        self.check_filter("c2 >= -2000 and c2 < 10000", lambda r: r[2] is not None and -2000 <= r[2] < 10000)
+        self.check_filter("c3 > 100.25 and c3 < 1000", lambda r: 100.25 < r[3] < 1000)
+        # the blocks with null values of c2 are never qualified as a whole
+        self.check_filter("c2 > 1000 and c2 < 3000", lambda r: r[2] is not None and 1000 < r[2] < 3000)
+        self.check_filter("c1 >= 1000 and c1 < 1500 and c2 > 0", lambda r: 1000 <= r[1] < 1500 and r[2] is not None and r[2] > 0)
+        # the rows of all blocks are qualified by c4, which has the whole range in each block
+        self.check_filter("c4 >= -50 and c4 <= 49", lambda r: -50 <= r[4] <= 49)
+        self.check_filter("c4 > -50", lambda r: r[4] > -50)
+        # the constant is out of the range of the column type
+        self.check_filter("c4 < 1000", lambda r: r[4] < 1000)
+        self.check_filter("c4 > -1000 and c1 > 4000", lambda r: r[4] > -1000 and r[1] > 4000)
+        # the blocks out of the range are skipped
+        self.check_filter("c1 > 10000", lambda r: r[1] > 10000)
+        self.check_filter("c1 > 1000 or c1 < 10", lambda r: r[1] > 1000 or r[1] < 10)
+        self.check_filter(f"ts >= {self.startTs + 100} and c1 < 4900", lambda r: r[0] >= self.startTs + 100 and r[1] < 4900)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())
@@ -0,0 +1,148 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+
+class TDTestCase:
+    # the state window operator finds the state changes of a block without null states at once, and aggregates each run
+    # of equal states as a whole, the blocks with null states are handled row by row
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+        self.dbname = 'db'
+        self.stbname = f'{self.dbname}.stb'
+        self.ctbNum = 4
+        self.rowsPerTbl = 3000
+        self.startTs = 1700000000000
+        self.tsStep = 1000
+        # the long runs cross the boundaries of data blocks, the short ones change the state in the middle of a block
+        self.runLens = [1, 1, 2, 3, 250, 7, 700, 1, 5, 430, 2, 1, 90]
+        self.stateCols = ['s_int', 's_bool', 's_tiny', 's_big', 's_str', 's_nchar']
+        self.funcs = "count(*), sum(v), min(v), max(v), first(v), last(v)"
+
+    def state_of_run(self, run, last):
+        # each table starts and ends with the same state, so the window of the next group starts with the state of the
+        # open window of the previous group
+        return 0 if run == 0 or last else run % 9 + 1
+
+    def row_values(self, k, j):
+        s_null = 'null' if (j % 97 == 0 or (j // 200) % 3 == 1 and j % 13 == 0) else k % 4
+        return (f"{k}, {'true' if k % 2 else 'false'}, {k % 3 - 1}, {k * 100000000000}, "
+                f"'{'s' * (k % 5)}{k % 7}', '{'n' * (k % 3)}{k % 4}', {s_null}")
+
+    def prepare_data(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        tdSql.execute(f"create database {self.dbname} vgroups 1 minrows 10 maxrows 200")
+        tdSql.execute(f"create table {self.stbname} (ts timestamp, v int, s_int int, s_bool bool, s_tiny tinyint, "
+                      f"s_big bigint, s_str varchar(20), s_nchar nchar(8), s_null int) tags (t1 int)")
+        for i in range(self.ctbNum):
+            tdSql.execute(f"create table {self.dbname}.ctb{i} using {self.stbname} tags({i % 2})")
+
+        for i in range(self.ctbNum):
+            sql = f"insert into {self.dbname}.ctb{i} values"
+            j = 0
+            run = 0
+            while j < self.rowsPerTbl:
+                runLen = self.runLens[(run + i) % len(self.runLens)]
+                last = (j + runLen >= self.rowsPerTbl)
+                if last:
+                    runLen = self.rowsPerTbl - j
+                k = self.state_of_run(run, last)
+                for _ in range(runLen):
+                    # the rows of different tables never have the same timestamp
+                    ts = self.startTs + j * self.tsStep + i
+                    sql += f" ({ts}, {(j * 7 + i) % 1000 - 500}, {self.row_values(k, j)})"
+                    j += 1
+                    if j % 500 == 0:
+                        tdSql.execute(sql)
+                        sql = f"insert into {self.dbname}.ctb{i} values"
+                run += 1
+            if j % 500 != 0:
+                tdSql.execute(sql)
+
+            # part of the rows are in the data files, the others are in memory
+            if i < self.ctbNum // 2:
+                tdSql.execute(f"flush database {self.dbname}")
+
+    def expected_windows(self, rows):
+        # rows of (ts, state, v) in the order of ts, the rows of null state do not break the window
+        windows = []
+        cur = None
+        for (ts, state, v) in rows:
+            if state is None:
+                continue
+            if cur is None or state != cur['state']:
+                cur = {'state': state, 'rows': []}
+                windows.append(cur)
+            cur['rows'].append((ts, v))
+
+        res = []
+        for w in windows:
+            vals = [r[1] for r in w['rows']]
+            res.append((w['rows'][0][0], w['rows'][-1][0], len(vals), sum(vals), min(vals), max(vals), vals[0],
+                        vals[-1], w['state']))
+        return res
+
+    def query_rows(self, col, cond):
+        tdSql.query(f"select ts, {col}, v from {self.stbname} {'where ' + cond if cond else ''} order by ts")
+        return tdSql.queryResult
+
+    def check_windows(self, col, fromClause, cond):
+        tdSql.query(f"select _wstart, _wend, {self.funcs}, first({col}) from {fromClause} state_window({col}) "
+                    f"order by _wstart")
+        res = tdSql.queryResult
+        expected = self.expected_windows(self.query_rows(col, cond))
+        if len(res) != len(expected):
+            tdLog.exit(f"state_window({col}) from {fromClause}: {len(res)} windows, expect {len(expected)}")
+        for i in range(len(expected)):
+            if tuple(res[i]) != expected[i]:
+                tdLog.exit(f"state_window({col}) from {fromClause}, window {i}: {res[i]} != {expected[i]}")
+
+    def check_partition(self, col, partCol, groups):
+        tdSql.query(f"select {partCol}, _wstart, _wend, {self.funcs}, first({col}) from {self.stbname} "
+                    f"partition by {partCol} state_window({col})")
+        res = sorted([tuple(r) for r in tdSql.queryResult])
+        expected = []
+        for (name, cond) in groups.items():
+            expected += [(name,) + w for w in self.expected_windows(self.query_rows(col, cond))]
+        expected = sorted(expected)
+        if res != expected:
+            tdLog.exit(f"state_window({col}) partition by {partCol}: {len(res)} windows, expect {len(expected)}")
+
+    def check_null_state(self, fromClause, cond):
+        # the count of the windows with null rows inside depends on the rows kept, only the window starts are compared
+        tdSql.query(f"select _wstart, first(s_null) from {fromClause} state_window(s_null) order by _wstart")
+        res = [(r[0], r[1]) for r in tdSql.queryResult]
+        expected = [(w[0], w[8]) for w in self.expected_windows(self.query_rows('s_null', cond))]
+        if res != expected:
+            tdLog.exit(f"state_window(s_null) from {fromClause}: {len(res)} windows, expect {len(expected)}")
+
+    def run(self):
+        self.prepare_data()
+
+        for col in self.stateCols:
+            # the state continues across the data blocks, of the files and memory
+            for i in range(self.ctbNum):
+                self.check_windows(col, f"{self.dbname}.ctb{i}", f"tbname = 'ctb{i}'")
+            # the rows of the tables are merged in the order of timestamp, the state changes between them
+            self.check_windows(col, f"{self.stbname} where t1 = 1", "t1 = 1")
+            self.check_windows(col, self.stbname, None)
+
+            # the group is changed between blocks while the state of the new group equals to the previous one
+            self.check_partition(col, "tbname", {f"ctb{i}": f"tbname = 'ctb{i}'" for i in range(self.ctbNum)})
+            # the rows of two tables are merged into one group
+            self.check_partition(col, "t1", {i: f"t1 = {i}" for i in range(2)})
+
+        # the blocks with null states are aggregated row by row, the others in batch
+        for i in range(self.ctbNum):
+            self.check_null_state(f"{self.dbname}.ctb{i}", f"tbname = 'ctb{i}'")
+        self.check_null_state(f"{self.stbname} where t1 = 1", "t1 = 1")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())
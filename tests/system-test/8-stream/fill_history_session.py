@@ -0,0 +1,100 @@
+import time
+
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+
+class TDTestCase:
+    # the session and state windows of the history data are written by the fill history task, and the rows written
+    # after the stream is created are merged into them by the stream task, the results must be the same as the query
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+        self.dbname = 'db'
+        self.stbname = f'{self.dbname}.stb'
+        self.tbnum = 4
+        self.rowsPerTbl = 300
+        self.startTs = 1700000000000
+
+    def insert_rows(self, tbIndex, rows):
+        sql = f"insert into {self.dbname}.ctb{tbIndex} values"
+        for ts, c1 in rows:
+            sql += f" ({ts}, {c1})"
+        tdSql.execute(sql)
+
+    def history_rows(self, tbIndex):
+        rows = []
+        for j in range(self.rowsPerTbl):
+            # a gap of 30s after every 20 rows starts a new session, the state changes every 7 rows
+            ts = self.startTs + j * 1000 + (j // 20) * 30000
+            rows.append((ts, (j // 7 + tbIndex) % 3))
+        return rows
+
+    def prepare_data(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        tdSql.execute(f"create database {self.dbname} vgroups 2")
+        tdSql.execute(f"create table {self.stbname} (ts timestamp, c1 int) tags (t1 int)")
+        for i in range(self.tbnum):
+            tdSql.execute(f"create table {self.dbname}.ctb{i} using {self.stbname} tags({i})")
+            self.insert_rows(i, self.history_rows(i))
+        tdSql.execute(f"flush database {self.dbname}")
+
+    def create_streams(self):
+        options = "trigger at_once ignore expired 0 ignore update 0 fill_history 1"
+        tdSql.execute(f"create stream s_sess {options} into {self.dbname}.out_sess as "
+                      f"select _wstart, count(*) cnt, sum(c1) s from {self.stbname} partition by t1 session(ts, 10s)")
+        tdSql.execute(f"create stream s_state {options} into {self.dbname}.out_state as "
+                      f"select _wstart, count(*) cnt, sum(c1) s from {self.stbname} partition by t1 state_window(c1)")
+
+    def new_rows(self, tbIndex):
+        rows = []
+        for k in range(self.rowsPerTbl // 20):
+            # the rows in the gaps of the history sessions bridge them, and the ones at the end extend the last state
+            gapStart = self.startTs + (k * 20 + 19) * 1000 + k * 30000
+            if k % 3 == tbIndex % 3:
+                rows.append((gapStart + 9000, 1))
+                rows.append((gapStart + 18000, 1))
+                rows.append((gapStart + 27000, 1))
+            elif k % 3 == (tbIndex + 1) % 3:
+                rows.append((gapStart + 5000, 2))
+        last = self.history_rows(tbIndex)[-1]
+        rows.append((last[0] + 1000, last[1]))
+        rows.append((last[0] + 60000, 0))
+        return rows
+
+    def query_rows(self, sql):
+        tdSql.query(sql)
+        return [list(row) for row in tdSql.queryResult]
+
+    def check_stream(self, outTable, window):
+        sql = f"select t1, _wstart, count(*), sum(c1) from {self.stbname} partition by t1 {window}"
+        expected = sorted(self.query_rows(sql), key=lambda row: (row[0], row[1]))
+        outSql = f"select t1, _wstart, cnt, s from {self.dbname}.{outTable}"
+        for i in range(120):
+            res = sorted(self.query_rows(outSql), key=lambda row: (row[0], row[1]))
+            if res == expected:
+                return
+            time.sleep(0.5)
+        tdLog.exit(f"the result of {outTable} is {res}, expect {expected}")
+
+    def run(self):
+        self.prepare_data()
+        self.create_streams()
+
+        # the windows of the history data are written by the fill history task
+        self.check_stream("out_sess", "session(ts, 10s)")
+        self.check_stream("out_state", "state_window(c1)")
+
+        for i in range(self.tbnum):
+            self.insert_rows(i, self.new_rows(i))
+        self.check_stream("out_sess", "session(ts, 10s)")
+        self.check_stream("out_state", "state_window(c1)")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+
+tdCases.addLinux(__file__, TDTestCase())